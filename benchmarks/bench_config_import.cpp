@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include "iec104_config.hpp"
+#include "bench_utility.hpp"
+
+using namespace std;
+
+/*
+ * Import of the exchanged_data configuration and teardown of the derived objects (data points, point store).
+ *
+ * Argument: number of points, spread over CAs of 10000 points. Each import first releases the objects of the
+ * previous one, as a reconfiguration does.
+ */
+
+static const int POINTS_PER_CA = 10000;
+
+static string
+createExchangedData(int numberOfPoints)
+{
+    vector<Iec104Bench::PointDefinition> points;
+
+    for (int i = 0; i < numberOfPoints; i++) {
+        points.push_back({(i / POINTS_PER_CA) + 1, (i % POINTS_PER_CA) + 1, (i % 2) ? "M_ME_TF_1" : "M_SP_TB_1", ""});
+    }
+
+    return Iec104Bench::exchangedData(points);
+}
+
+static void
+BM_ImportExchangeConfig(benchmark::State& state)
+{
+    string exchangedData = createExchangedData(static_cast<int>(state.range(0)));
+
+    IEC104Config config;
+
+    for (auto _ : state) {
+        config.importExchangeConfig(exchangedData);
+
+        benchmark::DoNotOptimize(config.getExchangeDefinitions());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void
+BM_DeleteExchangeDefinitions(benchmark::State& state)
+{
+    string exchangedData = createExchangedData(static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        IEC104Config* config = new IEC104Config();
+        config->importExchangeConfig(exchangedData);
+        state.ResumeTiming();
+
+        delete config;
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ImportExchangeConfig)->ArgName("points")->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DeleteExchangeDefinitions)->ArgName("points")->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
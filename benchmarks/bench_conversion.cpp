@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+#include "iec104_conversion.hpp"
+#include "iec104_datapoint.hpp"
+
+/*
+ * Conversion of measured values, one point per value with its own conversion: branches on the range checks
+ * against IEC104Conversion::apply (min/max and selects).
+ *
+ * Argument: one value out of N is out of range (64: mostly in range, 2: alternating, mispredicted by the
+ * branches). Raw counts are converted to a scaled value (x10, range 0..4095 + point index % 8).
+ */
+
+static const int VALUES = 50000;
+
+static std::vector<IEC104Conversion>
+createConversions()
+{
+    std::vector<IEC104Conversion> conversions;
+
+    for (int i = 0; i < VALUES; i++) {
+        double max = 4095.0 + static_cast<double>(i % 8);
+
+        conversions.push_back(IEC104Conversion::create(IEC60870_TYPE_SCALED, 10.0, 0.0, true, 0.0, max));
+    }
+
+    return conversions;
+}
+
+static std::vector<double>
+createInputs(int64_t outOfRange)
+{
+    std::vector<double> inputs(VALUES);
+
+    for (size_t i = 0; i < inputs.size(); i++) {
+        inputs[i] = ((i % outOfRange) == 0) ? 5000.0 : static_cast<double>(i % 400);
+    }
+
+    return inputs;
+}
+
+static float
+convertWithBranches(const IEC104Conversion& conversion, double input, bool& overflow)
+{
+    double y = input * conversion.a + conversion.b;
+
+    overflow = false;
+
+    if (std::isnan(y)) {
+        overflow = true;
+        return 0.0f;
+    }
+
+    if (y < conversion.low) {
+        overflow = true;
+        y = conversion.low;
+    }
+    else if (y > conversion.high) {
+        overflow = true;
+        y = conversion.high;
+    }
+
+    if (conversion.integer) {
+        y = std::round(y);
+    }
+
+    return static_cast<float>(y);
+}
+
+static void
+BM_Branches(benchmark::State& state)
+{
+    std::vector<IEC104Conversion> conversions = createConversions();
+    std::vector<double> inputs = createInputs(state.range(0));
+    std::vector<float> outputs(VALUES);
+    std::vector<uint8_t> qualities(VALUES);
+
+    for (auto _ : state) {
+        for (int i = 0; i < VALUES; i++) {
+            bool overflow = false;
+
+            outputs[i] = convertWithBranches(conversions[i], inputs[i], overflow);
+            qualities[i] = overflow ? IEC60870_QUALITY_OVERFLOW : IEC60870_QUALITY_GOOD;
+        }
+
+        benchmark::DoNotOptimize(outputs.data());
+        benchmark::DoNotOptimize(qualities.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * VALUES);
+}
+
+static void
+BM_Apply(benchmark::State& state)
+{
+    std::vector<IEC104Conversion> conversions = createConversions();
+    std::vector<double> inputs = createInputs(state.range(0));
+    std::vector<float> outputs(VALUES);
+    std::vector<uint8_t> qualities(VALUES);
+
+    for (auto _ : state) {
+        for (int i = 0; i < VALUES; i++) {
+            bool overflow = false;
+
+            outputs[i] = conversions[i].apply(inputs[i], overflow);
+            qualities[i] = overflow ? IEC60870_QUALITY_OVERFLOW : IEC60870_QUALITY_GOOD;
+        }
+
+        benchmark::DoNotOptimize(outputs.data());
+        benchmark::DoNotOptimize(qualities.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * VALUES);
+}
+
+BENCHMARK(BM_Branches)->ArgName("out_of_range_1_in")->Arg(64)->Arg(2);
+BENCHMARK(BM_Apply)->ArgName("out_of_range_1_in")->Arg(64)->Arg(2);
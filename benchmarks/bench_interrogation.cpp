@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+
+#include "iec104.h"
+#include "bench_utility.hpp"
+
+using namespace std;
+
+/*
+ * General interrogation latency and throughput.
+ *
+ * Arguments: number of configured points, QOI (20 station, 21..36 group 1..16).
+ * The points are spread over NUMBER_OF_CAS CAs, every point belongs to the station group and to one of the
+ * 16 groups. A broadcast interrogation is sent and timed from the first ACT-CON to the last ACT-TERM.
+ */
+
+static const int NUMBER_OF_CAS = 10;
+static const int NUMBER_OF_GROUPS = 16;
+static const int GI_TIMEOUT = 300000; /* in ms */
+
+static const char* const giTypes[] = {"M_SP_NA_1", "M_DP_NA_1", "M_ME_NC_1", "M_ME_NB_1", "M_SP_TB_1", "M_ME_TF_1"};
+
+class InterrogationBenchmark : public benchmark::Fixture
+{
+public:
+    void SetUp(const benchmark::State& state) override
+    {
+        int numberOfPoints = static_cast<int>(state.range(0));
+
+        vector<Iec104Bench::PointDefinition> points;
+        points.reserve(numberOfPoints);
+
+        for (int i = 0; i < numberOfPoints; i++) {
+            int ca = (i % NUMBER_OF_CAS) + 1;
+            int ioa = (i / NUMBER_OF_CAS) + 1;
+            string giGroups = "station," + to_string((i % NUMBER_OF_GROUPS) + 1);
+
+            points.push_back({ca, ioa, giTypes[i % (sizeof(giTypes) / sizeof(giTypes[0]))], giGroups});
+        }
+
+        m_server = new IEC104Server();
+        m_server->setJsonConfig(Iec104Bench::protocolStack(), Iec104Bench::exchangedData(points), Iec104Bench::tlsConfig());
+        m_server->startSlave();
+
+        Thread_sleep(500); /* wait for the server to start */
+
+        m_master = new Iec104Bench::LoopbackMaster();
+        m_master->connect();
+
+        Thread_sleep(200);
+    }
+
+    void TearDown(const benchmark::State& state) override
+    {
+        (void)state;
+
+        delete m_master;
+        m_master = nullptr;
+
+        m_server->stop();
+        delete m_server;
+        m_server = nullptr;
+    }
+
+protected:
+    IEC104Server* m_server = nullptr;
+    Iec104Bench::LoopbackMaster* m_master = nullptr;
+};
+
+BENCHMARK_DEFINE_F(InterrogationBenchmark, Interrogation)(benchmark::State& state)
+{
+    int qoi = static_cast<int>(state.range(1));
+    uint64_t asdus = 0;
+    uint64_t informationObjects = 0;
+    uint64_t bytes = 0;
+    double totalDuration = 0.0;
+
+    for (auto _ : state) {
+        uint64_t asdusBefore = m_master->Asdus();
+        uint64_t informationObjectsBefore = m_master->InformationObjects();
+        uint64_t bytesBefore = m_master->BytesReceived();
+
+        m_master->interrogate(0xffff, qoi);
+
+        if (!m_master->waitForInterrogation(NUMBER_OF_CAS, GI_TIMEOUT)) {
+            state.SkipWithError("interrogation not terminated");
+            break;
+        }
+
+        double duration = static_cast<double>(m_master->InterrogationDuration()) / 1e9;
+
+        state.SetIterationTime(duration);
+        totalDuration += duration;
+
+        /* ACT-CON and ACT-TERM are not counted */
+        asdus += m_master->Asdus() - asdusBefore - 2 * NUMBER_OF_CAS;
+        informationObjects += m_master->InformationObjects() - informationObjectsBefore - 2 * NUMBER_OF_CAS;
+        bytes += m_master->BytesReceived() - bytesBefore;
+    }
+
+    double iterations = static_cast<double>(state.iterations());
+
+    if (iterations > 0) {
+        state.counters["asdus"] = static_cast<double>(asdus) / iterations;
+        state.counters["points"] = static_cast<double>(informationObjects) / iterations;
+        state.counters["bytes"] = static_cast<double>(bytes) / iterations;
+    }
+
+    if (totalDuration > 0) {
+        state.counters["points_per_s"] = static_cast<double>(informationObjects) / totalDuration;
+        state.counters["bytes_per_s"] = static_cast<double>(bytes) / totalDuration;
+    }
+}
+
+BENCHMARK_REGISTER_F(InterrogationBenchmark, Interrogation)
+    ->ArgNames({"points", "qoi"})
+    ->ArgsProduct({{1000, 10000, 100000, 500000}, {IEC60870_QOI_STATION, IEC60870_QOI_STATION + 1}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include "iec104.h"
+#include "bench_utility.hpp"
+
+using namespace std;
+
+/*
+ * Throughput of IEC104Server::send with the readings decoded by 1, 2, 4 and 8 workers.
+ *
+ * Arguments: decode workers, data_objects per send() call (one data_object per reading, as sent by the south
+ * plugins). The points are M_ME_TF_1 spread over several CAs, the updates of a point stay in order whatever
+ * the number of workers.
+ */
+
+static const int NUMBER_OF_CAS = 8;
+static const int POINTS_PER_CA = 1000;
+
+class ParallelDecodeBenchmark : public benchmark::Fixture
+{
+public:
+    void SetUp(const benchmark::State& state) override
+    {
+        int workers = static_cast<int>(state.range(0));
+        int readingsPerBatch = static_cast<int>(state.range(1));
+
+        vector<Iec104Bench::PointDefinition> points;
+
+        for (int ca = 1; ca <= NUMBER_OF_CAS; ca++) {
+            for (int ioa = 1; ioa <= POINTS_PER_CA; ioa++) {
+                points.push_back({ca, ioa, "M_ME_TF_1", ""});
+            }
+        }
+
+        m_server = new IEC104Server();
+        m_server->setJsonConfig(Iec104Bench::protocolStack(10000, vector<string>(), "", workers),
+                                Iec104Bench::exchangedData(points), Iec104Bench::tlsConfig());
+        m_server->startSlave();
+
+        Thread_sleep(500); /* wait for the server to start */
+
+        m_master = new Iec104Bench::LoopbackMaster();
+        m_master->connect();
+
+        Thread_sleep(200);
+
+        uint64_t timestamp = Hal_getTimeInMs();
+
+        for (int r = 0; r < readingsPerBatch; r++) {
+            int ca = (r % NUMBER_OF_CAS) + 1;
+            int ioa = ((r / NUMBER_OF_CAS) % POINTS_PER_CA) + 1;
+
+            vector<Datapoint*> dataObjects;
+            dataObjects.push_back(Iec104Bench::createDataObject("M_ME_TF_1", ca, ioa, CS101_COT_SPONTANEOUS, r, timestamp));
+
+            m_readings.push_back(new Reading("TM", dataObjects));
+        }
+    }
+
+    void TearDown(const benchmark::State& state) override
+    {
+        (void)state;
+
+        delete m_master;
+        m_master = nullptr;
+
+        m_server->stop();
+        delete m_server;
+        m_server = nullptr;
+
+        for (Reading* reading : m_readings) {
+            delete reading;
+        }
+
+        m_readings.clear();
+    }
+
+protected:
+    IEC104Server* m_server = nullptr;
+    Iec104Bench::LoopbackMaster* m_master = nullptr;
+    vector<Reading*> m_readings;
+};
+
+BENCHMARK_DEFINE_F(ParallelDecodeBenchmark, Send)(benchmark::State& state)
+{
+    int64_t pointsPerCall = state.range(1);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m_server->send(m_readings));
+    }
+
+    state.SetItemsProcessed(state.iterations() * pointsPerCall);
+    state.counters["points_per_s"] = benchmark::Counter(static_cast<double>(state.iterations() * pointsPerCall),
+                                                        benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(ParallelDecodeBenchmark, Send)
+    ->ArgNames({"workers", "batch"})
+    ->ArgsProduct({{1, 2, 4, 8}, {100, 1000}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+
+#include "iec104.h"
+#include "bench_utility.hpp"
+
+using namespace std;
+
+/*
+ * Throughput of IEC104Server::send for each supported monitoring type.
+ *
+ * Arguments: monitoring type index, do_ts (0/1, selects the time tagged type), data_objects per reading,
+ * readings per send() call. The readings are built once and replayed, only send() is measured.
+ */
+
+struct MonitoringType
+{
+    const char* withoutTimestamp;
+    const char* withTimestamp;
+};
+
+static const MonitoringType monitoringTypes[] = {
+    {"M_SP_NA_1", "M_SP_TB_1"},
+    {"M_DP_NA_1", "M_DP_TB_1"},
+    {"M_ST_NA_1", "M_ST_TB_1"},
+    {"M_ME_NA_1", "M_ME_TD_1"},
+    {"M_ME_NB_1", "M_ME_TE_1"},
+    {"M_ME_NC_1", "M_ME_TF_1"}
+};
+
+static const int NUMBER_OF_TYPES = sizeof(monitoringTypes) / sizeof(monitoringTypes[0]);
+
+/* every type gets its own CA (type index + 1) and IOAs 1..POINTS_PER_TYPE */
+static const int POINTS_PER_TYPE = 1000;
+
+class SendBenchmark : public benchmark::Fixture
+{
+public:
+    void SetUp(const benchmark::State& state) override
+    {
+        const MonitoringType& type = monitoringTypes[state.range(0)];
+        bool withTimestamp = state.range(1) != 0;
+        int pointsPerReading = static_cast<int>(state.range(2));
+        int readingsPerBatch = static_cast<int>(state.range(3));
+
+        m_typeId = withTimestamp ? type.withTimestamp : type.withoutTimestamp;
+        int ca = static_cast<int>(state.range(0)) + 1;
+
+        vector<Iec104Bench::PointDefinition> points;
+
+        for (int i = 0; i < NUMBER_OF_TYPES; i++) {
+            for (int ioa = 1; ioa <= POINTS_PER_TYPE; ioa++) {
+                points.push_back({i + 1, ioa, monitoringTypes[i].withoutTimestamp, ""});
+                points.push_back({i + 1, ioa + POINTS_PER_TYPE, monitoringTypes[i].withTimestamp, ""});
+            }
+        }
+
+        m_server = new IEC104Server();
+        m_server->setJsonConfig(Iec104Bench::protocolStack(), Iec104Bench::exchangedData(points), Iec104Bench::tlsConfig());
+        m_server->startSlave();
+
+        Thread_sleep(500); /* wait for the server to start */
+
+        m_master = new Iec104Bench::LoopbackMaster();
+        m_master->connect();
+
+        Thread_sleep(200);
+
+        uint64_t timestamp = withTimestamp ? Hal_getTimeInMs() : 0;
+        int ioaOffset = withTimestamp ? POINTS_PER_TYPE : 0;
+        uint64_t seq = 0;
+
+        for (int r = 0; r < readingsPerBatch; r++) {
+            vector<Datapoint*> dataObjects;
+
+            for (int p = 0; p < pointsPerReading; p++) {
+                int ioa = static_cast<int>(seq % POINTS_PER_TYPE) + 1 + ioaOffset;
+                dataObjects.push_back(Iec104Bench::createDataObject(m_typeId, ca, ioa, CS101_COT_SPONTANEOUS, seq, timestamp));
+                seq++;
+            }
+
+            m_readings.push_back(new Reading(m_typeId, dataObjects));
+        }
+    }
+
+    void TearDown(const benchmark::State& state) override
+    {
+        (void)state;
+
+        delete m_master;
+        m_master = nullptr;
+
+        m_server->stop();
+        delete m_server;
+        m_server = nullptr;
+
+        for (Reading* reading : m_readings) {
+            delete reading;
+        }
+
+        m_readings.clear();
+    }
+
+protected:
+    IEC104Server* m_server = nullptr;
+    Iec104Bench::LoopbackMaster* m_master = nullptr;
+    vector<Reading*> m_readings;
+    string m_typeId;
+};
+
+BENCHMARK_DEFINE_F(SendBenchmark, Send)(benchmark::State& state)
+{
+    int64_t pointsPerCall = state.range(2) * state.range(3);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m_server->send(m_readings));
+    }
+
+    state.SetLabel(m_typeId);
+    state.SetItemsProcessed(state.iterations() * pointsPerCall);
+    state.counters["points_per_s"] = benchmark::Counter(static_cast<double>(state.iterations() * pointsPerCall),
+                                                        benchmark::Counter::kIsRate);
+    state.counters["asdu_received"] = static_cast<double>(m_master->Asdus());
+}
+
+BENCHMARK_REGISTER_F(SendBenchmark, Send)
+    ->ArgNames({"type", "do_ts", "points", "batch"})
+    ->ArgsProduct({benchmark::CreateDenseRange(0, NUMBER_OF_TYPES - 1, 1), {0, 1}, {1, 10, 100}, {1, 100}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <lib60870/hal_time.h>
+
+#include "iec104_time_encoder.hpp"
+
+/*
+ * CP56Time2a conversion of do_ts values: lib60870 (gmtime for every timestamp) against IEC104TimeEncoder,
+ * one timestamp at a time and in batches.
+ *
+ * Argument: step between consecutive timestamps in ms (10 ms: one hour change every 360000 timestamps,
+ * 60 s: one hour change every 60 timestamps).
+ */
+
+static const int TIMESTAMPS = 4096;
+
+static std::vector<uint64_t>
+createTimestamps(int64_t step)
+{
+    std::vector<uint64_t> timestamps(TIMESTAMPS);
+
+    uint64_t timestamp = Hal_getTimeInMs();
+
+    for (uint64_t& value : timestamps) {
+        value = timestamp;
+        timestamp += static_cast<uint64_t>(step);
+    }
+
+    return timestamps;
+}
+
+static void
+BM_Lib60870(benchmark::State& state)
+{
+    std::vector<uint64_t> timestamps = createTimestamps(state.range(0));
+    std::vector<struct sCP56Time2a> encoded(TIMESTAMPS);
+
+    for (auto _ : state) {
+        for (int i = 0; i < TIMESTAMPS; i++) {
+            CP56Time2a_createFromMsTimestamp(&encoded[i], timestamps[i]);
+        }
+
+        benchmark::DoNotOptimize(encoded.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * TIMESTAMPS);
+}
+
+static void
+BM_TimeEncoder(benchmark::State& state)
+{
+    std::vector<uint64_t> timestamps = createTimestamps(state.range(0));
+    std::vector<struct sCP56Time2a> encoded(TIMESTAMPS);
+
+    IEC104TimeEncoder encoder;
+
+    for (auto _ : state) {
+        for (int i = 0; i < TIMESTAMPS; i++) {
+            encoder.encode(&encoded[i], timestamps[i]);
+        }
+
+        benchmark::DoNotOptimize(encoded.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * TIMESTAMPS);
+}
+
+static void
+BM_TimeEncoderBatch(benchmark::State& state)
+{
+    std::vector<uint64_t> timestamps = createTimestamps(state.range(0));
+    std::vector<struct sCP56Time2a> encoded(TIMESTAMPS);
+
+    IEC104TimeEncoder encoder;
+
+    for (auto _ : state) {
+        encoder.encode(timestamps.data(), timestamps.size(), encoded.data());
+
+        benchmark::DoNotOptimize(encoded.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * TIMESTAMPS);
+}
+
+BENCHMARK(BM_Lib60870)->ArgName("step_ms")->Arg(10)->Arg(60000);
+BENCHMARK(BM_TimeEncoder)->ArgName("step_ms")->Arg(10)->Arg(60000);
+BENCHMARK(BM_TimeEncoderBatch)->ArgName("step_ms")->Arg(10)->Arg(60000);
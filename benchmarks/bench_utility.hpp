@@ -0,0 +1,305 @@
+#ifndef IEC104_BENCH_UTILITY_H
+#define IEC104_BENCH_UTILITY_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <datapoint.h>
+#include <reading.h>
+
+#include <lib60870/hal_thread.h>
+#include <lib60870/hal_time.h>
+
+#include "cs104_connection.h"
+
+/*
+ * Helpers shared by the benchmarks: generated configurations, synthetic data_object readings
+ * and a lib60870 master connected over loopback.
+ */
+namespace Iec104Bench {
+
+    static const int PORT = 2404;
+
+    /// @brief Protocol stack listening on all interfaces
+    /// @param clientIps one redundancy group per client IP, no redundancy group when empty
+    /// @param southAsset asset of the monitored south plugin, no south monitoring when empty
+    /// @param decodeWorkers threads decoding the readings in send()
+    inline std::string protocolStack(int asduQueueSize = 1000, const std::vector<std::string>& clientIps = std::vector<std::string>(),
+                                     const std::string& southAsset = "", int decodeWorkers = 1)
+    {
+        std::string redundancyGroups;
+
+        for (size_t i = 0; i < clientIps.size(); i++) {
+            redundancyGroups += (i == 0) ? "\"redundancy_groups\":[" : ",";
+            redundancyGroups += "{\"rg_name\":\"rg-" + std::to_string(i + 1) + "\",\"connections\":[{\"clt_ip\":\"" +
+                                clientIps[i] + "\"}]}";
+        }
+
+        if (!redundancyGroups.empty()) {
+            redundancyGroups += "],";
+        }
+
+        std::string southMonitoring;
+
+        if (!southAsset.empty()) {
+            southMonitoring = ",\"south_monitoring\":[{\"asset\":\"" + southAsset + "\"}]";
+        }
+
+        return std::string("{\"protocol_stack\":{\"name\":\"iec104server\",\"version\":\"1.0\",") +
+               "\"transport_layer\":{" + redundancyGroups + "\"bind_on_ip\":false,\"srv_ip\":\"0.0.0.0\",\"port\":" +
+               std::to_string(PORT) + "," +
+               "\"tls\":false,\"k_value\":12,\"w_value\":8,\"t0_timeout\":10,\"t1_timeout\":15,\"t2_timeout\":10,\"t3_timeout\":20}," +
+               "\"application_layer\":{\"ca_asdu_size\":2,\"ioaddr_size\":3,\"asdu_size\":0,\"asdu_queue_size\":" +
+               std::to_string(asduQueueSize) + ",\"time_sync\":false,\"cmd_exec_timeout\":5,\"cmd_recv_timeout\":1," +
+               "\"accept_cmd_with_time\":2,\"decode_workers\":" + std::to_string(decodeWorkers) + "}" + southMonitoring + "}}";
+    }
+
+    inline std::string tlsConfig()
+    {
+        return "{\"tls_conf\":{}}";
+    }
+
+    struct PointDefinition
+    {
+        int ca;
+        int ioa;
+        std::string typeId;
+        std::string giGroups;
+    };
+
+    /// @brief exchanged_data configuration with one iec104 protocol entry per point
+    inline std::string exchangedData(const std::vector<PointDefinition>& points)
+    {
+        std::string json;
+        json.reserve(points.size() * 150 + 100);
+
+        json += "{\"exchanged_data\":{\"name\":\"iec104server\",\"version\":\"1.0\",\"datapoints\":[";
+
+        for (size_t i = 0; i < points.size(); i++) {
+            const PointDefinition& point = points[i];
+
+            if (i > 0) {
+                json += ",";
+            }
+
+            std::string address = std::to_string(point.ca) + "-" + std::to_string(point.ioa);
+
+            json += "{\"label\":\"P" + address + "\",\"protocols\":[{\"name\":\"iec104\",\"address\":\"" + address +
+                    "\",\"typeid\":\"" + point.typeId + "\"";
+
+            if (!point.giGroups.empty()) {
+                json += ",\"gi_groups\":\"" + point.giGroups + "\"";
+            }
+
+            json += "}]}";
+        }
+
+        json += "]}}";
+
+        return json;
+    }
+
+    template <class T>
+    inline Datapoint* createDatapoint(const std::string& name, const T value)
+    {
+        DatapointValue dpv(value);
+        return new Datapoint(name, dpv);
+    }
+
+    /// @brief Value of a data_object of the given type, varying with seq so that every update is a change
+    inline Datapoint* createValue(const std::string& typeId, uint64_t seq)
+    {
+        if (typeId.compare(0, 4, "M_SP") == 0) {
+            return createDatapoint("do_value", static_cast<long>(seq & 1));
+        }
+        else if (typeId.compare(0, 4, "M_DP") == 0) {
+            return createDatapoint("do_value", static_cast<long>((seq & 1) + 1));
+        }
+        else if (typeId.compare(0, 4, "M_ST") == 0) {
+            return createDatapoint("do_value", std::string("[") + std::to_string(static_cast<int>(seq % 64)) + ",false]");
+        }
+        else if ((typeId == "M_ME_NA_1") || (typeId == "M_ME_TD_1")) {
+            return createDatapoint("do_value", static_cast<double>(seq % 100) / 100.0);
+        }
+        else if ((typeId == "M_ME_NB_1") || (typeId == "M_ME_TE_1")) {
+            return createDatapoint("do_value", static_cast<long>(seq % 30000));
+        }
+        else {
+            return createDatapoint("do_value", static_cast<double>(seq % 1000) * 0.5);
+        }
+    }
+
+    /// @brief data_object datapoint as produced by the south plugins
+    /// @param timestamp do_ts in ms, 0 to omit the timestamp
+    inline Datapoint* createDataObject(const std::string& typeId, int ca, int ioa, int cot, uint64_t seq, uint64_t timestamp)
+    {
+        std::vector<Datapoint*>* datapoints = new std::vector<Datapoint*>;
+
+        datapoints->push_back(createDatapoint("do_type", typeId));
+        datapoints->push_back(createDatapoint("do_ca", static_cast<long>(ca)));
+        datapoints->push_back(createDatapoint("do_oa", 0L));
+        datapoints->push_back(createDatapoint("do_cot", static_cast<long>(cot)));
+        datapoints->push_back(createDatapoint("do_test", 0L));
+        datapoints->push_back(createDatapoint("do_negative", 0L));
+        datapoints->push_back(createDatapoint("do_ioa", static_cast<long>(ioa)));
+        datapoints->push_back(createValue(typeId, seq));
+        datapoints->push_back(createDatapoint("do_quality_iv", 0L));
+        datapoints->push_back(createDatapoint("do_quality_bl", 0L));
+        datapoints->push_back(createDatapoint("do_quality_ov", 0L));
+        datapoints->push_back(createDatapoint("do_quality_sb", 0L));
+        datapoints->push_back(createDatapoint("do_quality_nt", 0L));
+
+        if (timestamp != 0) {
+            datapoints->push_back(createDatapoint("do_ts", static_cast<long>(timestamp)));
+            datapoints->push_back(createDatapoint("do_ts_iv", 0L));
+            datapoints->push_back(createDatapoint("do_ts_su", 0L));
+            datapoints->push_back(createDatapoint("do_ts_sub", 0L));
+        }
+
+        DatapointValue dpv(datapoints, true);
+
+        return new Datapoint("data_object", dpv);
+    }
+
+    /// @brief lib60870 master connected over loopback, counts everything it receives
+    class LoopbackMaster
+    {
+    public:
+        explicit LoopbackMaster(const char* ip = "127.0.0.1", int port = PORT)
+        {
+            m_connection = CS104_Connection_create(ip, port);
+
+            CS104_Connection_setASDUReceivedHandler(m_connection, asduHandler, this);
+            CS104_Connection_setRawMessageHandler(m_connection, rawMessageHandler, this);
+        }
+
+        ~LoopbackMaster()
+        {
+            CS104_Connection_destroy(m_connection);
+        }
+
+        /// @brief Connect and activate the data transfer (STARTDT)
+        bool connect()
+        {
+            if (!CS104_Connection_connect(m_connection)) {
+                return false;
+            }
+
+            CS104_Connection_sendStartDT(m_connection);
+
+            return true;
+        }
+
+        CS104_Connection Connection() {return m_connection;};
+
+        /// @brief Send an interrogation command (C_IC_NA_1) and reset the interrogation tracking
+        bool interrogate(int ca, int qoi)
+        {
+            m_actCons.store(0, std::memory_order_relaxed);
+            m_actTerms.store(0, std::memory_order_relaxed);
+            m_firstActCon.store(0, std::memory_order_relaxed);
+            m_lastActTerm.store(0, std::memory_order_relaxed);
+
+            return CS104_Connection_sendInterrogationCommand(m_connection, CS101_COT_ACTIVATION, ca, static_cast<uint8_t>(qoi));
+        }
+
+        /// @brief Wait for the ACT-TERM of the interrogated CAs (one per CA for a broadcast interrogation)
+        bool waitForInterrogation(int terminations, int timeout)
+        {
+            uint64_t start = Hal_getTimeInMs();
+
+            while (m_actTerms.load(std::memory_order_acquire) < static_cast<uint64_t>(terminations)) {
+                if (Hal_getTimeInMs() - start > static_cast<uint64_t>(timeout)) {
+                    return false;
+                }
+
+                Thread_sleep(1);
+            }
+
+            return true;
+        }
+
+        /// @brief Time from the first ACT-CON to the last ACT-TERM of the last interrogation in ns
+        uint64_t InterrogationDuration() const
+        {
+            return m_lastActTerm.load(std::memory_order_acquire) - m_firstActCon.load(std::memory_order_acquire);
+        }
+
+        uint64_t Asdus() const {return m_asdus.load(std::memory_order_relaxed);};
+        uint64_t InformationObjects() const {return m_informationObjects.load(std::memory_order_relaxed);};
+        uint64_t BytesReceived() const {return m_bytesReceived.load(std::memory_order_relaxed);};
+
+        /// @brief Wait until no ASDU has been received for the given time
+        void waitForIdle(int idleTime, int timeout)
+        {
+            uint64_t start = Hal_getTimeInMs();
+            uint64_t lastCount = Asdus();
+            uint64_t lastChange = start;
+
+            while (Hal_getTimeInMs() - start < static_cast<uint64_t>(timeout)) {
+                Thread_sleep(10);
+
+                uint64_t count = Asdus();
+
+                if (count != lastCount) {
+                    lastCount = count;
+                    lastChange = Hal_getTimeInMs();
+                }
+                else if (Hal_getTimeInMs() - lastChange >= static_cast<uint64_t>(idleTime)) {
+                    return;
+                }
+            }
+        }
+
+    private:
+        static bool asduHandler(void* parameter, int address, CS101_ASDU asdu)
+        {
+            (void)address;
+            LoopbackMaster* self = static_cast<LoopbackMaster*>(parameter);
+
+            self->m_asdus.fetch_add(1, std::memory_order_relaxed);
+            self->m_informationObjects.fetch_add(CS101_ASDU_getNumberOfElements(asdu), std::memory_order_relaxed);
+
+            if (CS101_ASDU_getTypeID(asdu) == C_IC_NA_1) {
+                uint64_t now = Hal_getTimeInNs();
+
+                if (CS101_ASDU_getCOT(asdu) == CS101_COT_ACTIVATION_CON) {
+                    if (self->m_actCons.fetch_add(1, std::memory_order_relaxed) == 0) {
+                        self->m_firstActCon.store(now, std::memory_order_release);
+                    }
+                }
+                else if (CS101_ASDU_getCOT(asdu) == CS101_COT_ACTIVATION_TERMINATION) {
+                    self->m_lastActTerm.store(now, std::memory_order_release);
+                    self->m_actTerms.fetch_add(1, std::memory_order_release);
+                }
+            }
+
+            return true;
+        }
+
+        static void rawMessageHandler(void* parameter, uint8_t* msg, int msgSize, bool sent)
+        {
+            (void)msg;
+            LoopbackMaster* self = static_cast<LoopbackMaster*>(parameter);
+
+            if (!sent) {
+                self->m_bytesReceived.fetch_add(msgSize, std::memory_order_relaxed);
+            }
+        }
+
+        CS104_Connection m_connection;
+
+        std::atomic<uint64_t> m_asdus{0};
+        std::atomic<uint64_t> m_informationObjects{0};
+        std::atomic<uint64_t> m_bytesReceived{0};
+
+        std::atomic<uint64_t> m_actCons{0};
+        std::atomic<uint64_t> m_actTerms{0};
+        std::atomic<uint64_t> m_firstActCon{0};
+        std::atomic<uint64_t> m_lastActTerm{0};
+    };
+}
+
+#endif /* IEC104_BENCH_UTILITY_H */
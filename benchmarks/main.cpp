@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+#include <logger.h>
+#include <string.h>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char **argv) {
+    // Results are reported as JSON unless another format is requested on the command line
+    vector<char*> args(argv, argv + argc);
+    bool formatRequested = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--benchmark_format", strlen("--benchmark_format")) == 0) {
+            formatRequested = true;
+        }
+    }
+
+    static char jsonFormat[] = "--benchmark_format=json";
+
+    if (!formatRequested) {
+        args.push_back(jsonFormat);
+    }
+
+    int count = static_cast<int>(args.size());
+
+    benchmark::Initialize(&count, args.data());
+
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) {
+        return 1;
+    }
+
+    // Same log level as a production service, the per data point logs must not dominate the measures
+    Logger::getLogger()->setMinLevel("warning");
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -14,16 +14,27 @@
 // clang-format off
 
 #include <plugin_api.h>
+#include <atomic>
+#include <condition_variable>
 #include <vector>
 #include <map>
 #include <mutex>
 #include <thread>
 #include <memory>
+#include <unordered_map>
 
 #include "lib60870/cs104_slave.h"
 #include "lib60870/cs101_information_objects.h"
 
+#include "iec104_background_scan.hpp"
 #include "iec104_config.hpp"
+#include "iec104_counters.hpp"
+#include "iec104_cyclic.hpp"
+#include "iec104_latency.hpp"
+#include "iec104_log_limiter.hpp"
+#include "iec104_spsc_ring.hpp"
+#include "iec104_statistics.hpp"
+#include "iec104_worker_pool.hpp"
 
 // clang-format on
 
@@ -98,6 +109,8 @@ public:
                                 const std::string& tlsConfig);
 
     void configure(const ConfigCategory* conf);
+    void reconfigure(const ConfigCategory* conf);
+    void setDiagnosticsConfig(const std::string& diagnosticsConfig);
     bool startSlave();
     uint32_t send(const std::vector<Reading*>& readings);
     void stop();
@@ -122,11 +135,47 @@ private:
     std::vector<IEC104OutstandingCommand*> m_outstandingCommands;
     std::mutex m_outstandingCommandsLock;
     std::recursive_mutex m_connectionEventsLock; // Lock used in audits, based on connections events from lib60870
-    std::map<int, std::map<int, IEC104DataPoint*>> m_exchangeDefinitions;
-    
+    /* points of the configuration, shared with IEC104Config (definitions, (CA, IOA) index, values) */
+    std::shared_ptr<const IEC104PointTable> m_pointTable;
+
+    /* attributes of a data_object, decoded before the data point is updated */
+    struct DecodedDataObject
+    {
+        int ca = -1;
+        int ioa = -1;
+        CS101_CauseOfTransmission cot = CS101_COT_UNKNOWN_COT;
+        int type = -1;
+        bool hasInteger = false; /* integer do_value of a single/double point or integrated totals */
+        int64_t integerValue = 0;
+        bool hasAnalog = false; /* numeric do_value of a measured value, converted by the decoder */
+        float analogValue = 0.0f; /* protocol value, integral for the scaled values */
+        bool hasStepPos = false;
+        int stepPosValue = 0;
+        bool stepPosTransient = false;
+        bool isNegative = false;
+        uint8_t qd = IEC60870_QUALITY_GOOD;
+        bool hasTimestamp = false;
+        uint64_t timestamp = 0;
+        bool ts_iv = false;
+        bool ts_su = false;
+        bool ts_sub = false;
+        IEC104DataPoint* dp = nullptr;
+        uint64_t ingestTime = 0; /* ingest time of the block in ns, 0 when latency tracing is disabled */
+    };
+
+    /* data objects per worker below which a block is decoded on the calling thread */
+    static const int PARALLEL_DECODE_MIN_OBJECTS = 64;
+    /* data objects applied by the encoder thread between two transmissions of the updated packed objects */
+    static const int ENCODER_PACK_FLUSH_OBJECTS = 256;
+
+    void decodeDataObject(Datapoint* dataObject, DecodedDataObject& decoded);
+    void m_updateDataPoint(IEC104DataPoint* dp, IEC60870_5_TypeID typeId, const DecodedDataObject& decoded, CP56Time2a ts);
+    void applyDataObject(DecodedDataObject& decoded, std::vector<IEC104DataPoint*>& pendingPacks);
+    void sendPendingPacks(std::vector<IEC104DataPoint*>& pendingPacks);
+
+    IEC104DataPoint* m_findDataPoint(int ca, int ioa) const;
     IEC104DataPoint* m_getDataPoint(int ca, int ioa, int typeId);
     void m_enqueueSpontDatapoint(IEC104DataPoint* dp, CS101_CauseOfTransmission cot, IEC60870_5_TypeID typeId);
-    void m_updateDataPoint(IEC104DataPoint* dp, IEC60870_5_TypeID typeId, DatapointValue* value, CP56Time2a ts, uint8_t quality);
 
     bool checkIfSouthConnected();
 
@@ -145,6 +194,15 @@ private:
     static void printCP56Time2a(CP56Time2a time);
     static void rawMessageHandler(void* parameter, IMasterConnection connection,
                                   uint8_t* msg, int msgSize, bool sent);
+    void traceSentApdu(const uint8_t* msg, int msgSize);
+
+    /**
+     * @brief Publish the diagnostics (latency histograms, statistics) when their period has elapsed
+     */
+    void publishDiagnostics(uint64_t currentTime);
+    void publishDiagnostic(const std::string& diagnostic, const std::string& auditCode);
+    void sampleQueueDepth();
+    int queueDepth();
     static bool clockSyncHandler(void* parameter, IMasterConnection connection,
                                  CS101_ASDU asdu, CP56Time2a newTime);
 
@@ -153,6 +211,28 @@ private:
     static bool interrogationHandler(void* parameter,
                                      IMasterConnection connection,
                                      CS101_ASDU asdu, uint8_t qoi);
+    InformationObject m_createInformationObject(IEC104DataPoint* dp, uint8_t* ioBuf, bool sendWithTimestamp);
+    /**
+     * @brief Encode the current values of points of one CA in ASDUs of the given COT, shared by the interrogation,
+     *        the cyclic data and the background scan
+     */
+    void m_sendDataPoints(const std::vector<IEC104DataPoint*>& points, CS101_CauseOfTransmission cot, int oa, int ca,
+                          CS101_AppLayerParameters alParams, IMasterConnection connection);
+    /**
+     * @brief Enqueue the cyclic data points that are due (COT periodic), called by the monitoring thread
+     */
+    void sendCyclicData(uint64_t currentTime);
+    /**
+     * @brief Enqueue the next points of the background scan (COT background scan) within the configured rate,
+     *        nothing is sent while the ASDU queue is not empty
+     */
+    void sendBackgroundScan(uint64_t currentTime);
+    static bool readHandler(void* parameter, IMasterConnection connection, CS101_ASDU asdu, int ioa);
+    void sendCounterInterrogationResponse(IMasterConnection connection, CS101_ASDU asdu, int ca, int group, int frz);
+
+    static bool counterInterrogationHandler(void* parameter,
+                                            IMasterConnection connection,
+                                            CS101_ASDU asdu, QualifierOfCIC qcc);
     static bool asduHandler(void* parameter, IMasterConnection connection,
                             CS101_ASDU asdu);
     static bool connectionRequestHandler(void* parameter,
@@ -184,8 +264,31 @@ private:
 
     CS104_Slave m_slave{};
     TLSConfiguration m_tlsConfig = nullptr;
+    /* configuration items applied by setJsonConfig, a change requires a restart of the service */
+    std::string m_appliedStackConfig;
+    std::string m_appliedExchangeConfig;
+    std::string m_appliedTlsConfig;
     CS101_AppLayerParameters alParams = nullptr;
     IEC104Config* m_config = nullptr;
+    IEC104ClientRateLimiter m_connRateLimiter;
+    IEC104Capture m_capture;
+    IEC104LatencyTracer m_latencyTracer;
+    IEC104Statistics m_statistics;
+    IEC104CounterStore m_counters;
+    IEC104CyclicScheduler m_cyclicScheduler;
+    IEC104BackgroundScan m_backgroundScan;
+    /* repeated per data object errors, summarized by the monitoring thread */
+    Iec104Utility::LogLimiter m_logLimiter;
+    int m_logSiteUnknownPoint = 0;
+    int m_logSiteInvalidStepPos = 0;
+    int m_logSiteNotRunning = 0;
+    std::unique_ptr<IEC104WorkerPool> m_decodePool; /* only when several decode workers are configured */
+    /* data objects decoded by send() (producer) and applied by the encoder thread (consumer) */
+    std::unique_ptr<IEC104SpscRing<DecodedDataObject>> m_encoderQueue;
+    /* in ms, only used by the monitoring thread */
+    uint64_t m_nextLatencyPublication = 0;
+    uint64_t m_nextStatisticsPublication = 0;
+    uint64_t m_lastStatisticsPublication = 0;
 
     int m_actConTimeout = 1000;
     int m_actTermTimeout = 1000;
@@ -196,6 +299,16 @@ private:
     std::thread* m_monitoringThread = nullptr;
     void _monitoringThread();
 
+    std::atomic<bool> m_encoderRunning{false};
+    std::thread* m_encoderThread = nullptr;
+    std::mutex m_encoderLock;
+    std::condition_variable m_encoderWakeup;
+    uint64_t m_encoderPushed = 0; /* data objects queued by send() */
+    std::atomic<uint64_t> m_encoderDrained{0}; /* data objects applied by the encoder, published when the queue is empty */
+    void _encoderThread();
+    /// @brief Wait until the encoder thread applied all the data objects queued by send()
+    void drainEncoderQueue();
+
     bool createTLSConfiguration();
     std::string m_service_name;    // Service name used to generate audits
     std::string m_last_connection_audit;      // Last audit sent. Prevent from sending the same audit multiple times
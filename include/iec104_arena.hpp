@@ -0,0 +1,73 @@
+#ifndef IEC104_ARENA_H
+#define IEC104_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// @brief Monotonic arena for the objects derived from a configuration: objects are carved from large blocks and
+///        are never freed individually, release() destroys them all and frees the blocks at once. The destructors of
+///        objects that are not trivially destructible are recorded in the arena itself (no allocation).
+///        The first block is kept for the next configuration. Not thread safe.
+class IEC104Arena
+{
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+
+    explicit IEC104Arena(size_t blockSize = DEFAULT_BLOCK_SIZE) : m_blockSize(blockSize) {};
+    ~IEC104Arena();
+
+    IEC104Arena(const IEC104Arena&) = delete;
+    IEC104Arena& operator=(const IEC104Arena&) = delete;
+
+    /// @brief Uninitialized memory, valid until release()
+    void* allocate(size_t size, size_t alignment);
+
+    /// @brief Construct an object in the arena, destroyed by release()
+    template <class T, class... Args>
+    T* create(Args&&... args)
+    {
+        void* memory = allocate(sizeof(T), alignof(T));
+        T* object = new (memory) T(std::forward<Args>(args)...);
+
+        if (!std::is_trivially_destructible<T>::value) {
+            addDestructor(object, &destroy<T>);
+        }
+
+        return object;
+    }
+
+    /// @brief Destroy the objects (in reverse order of creation) and free the memory
+    void release();
+
+    size_t BytesUsed() const {return m_bytesUsed;};
+    size_t Blocks() const {return m_blocks.size();};
+
+private:
+    struct Destructor
+    {
+        void (*destroy)(void*);
+        void* object;
+        Destructor* next;
+    };
+
+    template <class T>
+    static void destroy(void* object)
+    {
+        static_cast<T*>(object)->~T();
+    }
+
+    void addDestructor(void* object, void (*destroy)(void*));
+
+    size_t m_blockSize;
+    std::vector<char*> m_blocks;
+    char* m_current = nullptr; /* next free byte of the last block */
+    char* m_end = nullptr;
+    size_t m_bytesUsed = 0;
+    Destructor* m_destructors = nullptr; /* last created object first */
+};
+
+#endif /* IEC104_ARENA_H */
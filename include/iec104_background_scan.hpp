@@ -0,0 +1,47 @@
+#ifndef IEC104_BACKGROUND_SCAN_H
+#define IEC104_BACKGROUND_SCAN_H
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+class IEC104DataPoint;
+
+/// @brief Background scan (COT background scan): the point table is walked incrementally and the current values are
+///        transmitted in complete ASDUs at a limited rate (token bucket in bytes/s), so that the masters are refreshed
+///        without the burst of a general interrogation. Only used by the monitoring thread, not thread safe.
+class IEC104BackgroundScan
+{
+public:
+    /// @brief Build the scan order from the exchanged data (CA, type, IOA)
+    /// @param rate maximum rate in bytes/s (APCI included), 0 to disable the background scan
+    /// @param maxSizeOfASDU, sizeOfCA, sizeOfIOA application layer parameters, used to fill complete ASDUs
+    void configure(const std::map<int, std::map<int, IEC104DataPoint*>>& exchangeDefinitions, int rate,
+                   int maxSizeOfASDU, int sizeOfCA, int sizeOfIOA);
+
+    bool isEnabled() const {return (m_rate > 0) && !m_points.empty();};
+
+    /// @brief Add the budget earned since the last call, the budget is capped to avoid bursts after idle periods
+    void refill(uint64_t currentTime);
+
+    /// @brief Next points to transmit: consecutive points of the same CA and type that fit in one ASDU.
+    ///        The cursor wraps at the end of the table, a new scan starts immediately.
+    /// @return false when the budget is not sufficient for the next ASDU (the cursor is not moved)
+    bool nextBatch(std::vector<IEC104DataPoint*>& batch);
+
+    int Budget() const {return m_budget;};
+    int Cursor() const {return static_cast<int>(m_cursor);};
+
+private:
+    std::vector<IEC104DataPoint*> m_points;
+    size_t m_cursor = 0;
+    int m_rate = 0; /* bytes/s */
+    int m_maxBudget = 0;
+    int m_budget = 0;
+    uint64_t m_lastRefill = 0; /* in ms, 0 until the first call of refill() */
+    int m_maxSizeOfASDU = 0;
+    int m_sizeOfCA = 0;
+    int m_sizeOfIOA = 0;
+};
+
+#endif /* IEC104_BACKGROUND_SCAN_H */
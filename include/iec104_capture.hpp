@@ -0,0 +1,166 @@
+#ifndef IEC104_CAPTURE_H
+#define IEC104_CAPTURE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "iec104_client_ip.hpp"
+
+/// @brief Settings of the raw APDU capture (diagnostics.capture configuration)
+struct IEC104CaptureSettings
+{
+    bool enabled = false;
+    std::string path;            /* empty - use the default path chosen by the server */
+    int maxFileSize = 10240;     /* in kB, the file is rotated when it is exceeded */
+    int maxFiles = 5;            /* number of rotated files kept in addition to the current one */
+    int ringSize = 4096;         /* number of APDUs buffered between the connection threads and the writer */
+};
+
+/// @brief Bounded multi-producer/single-consumer ring of raw APDUs.
+///        Producers (lib60870 connection threads) never block: when the ring is full the APDU is dropped and counted.
+class IEC104CaptureRing
+{
+public:
+    static const int MAX_APDU_SIZE = 256;
+
+    struct Record
+    {
+        uint64_t timestamp;      /* ns since epoch */
+        uint64_t connectionKey;
+        uint16_t length;
+        bool sent;
+        uint8_t data[MAX_APDU_SIZE];
+    };
+
+    /// @param capacity Number of records, rounded up to a power of two
+    explicit IEC104CaptureRing(size_t capacity);
+
+    bool push(uint64_t connectionKey, const uint8_t* data, int length, bool sent, uint64_t timestamp);
+    bool pop(Record& record);
+
+    size_t Capacity() const {return m_mask + 1;};
+    uint64_t Dropped() const {return m_dropped.load(std::memory_order_relaxed);};
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        Record record;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask;
+
+    /* producer and consumer positions are kept on separate cache lines */
+    std::atomic<size_t> m_enqueuePos;
+    char m_padding1[64];
+    std::atomic<size_t> m_dequeuePos;
+    char m_padding2[64];
+    std::atomic<uint64_t> m_dropped;
+};
+
+/// @brief Minimal pcapng writer producing Wireshark readable captures of IEC 104 APDUs.
+///        APDUs are wrapped in synthetic IPv4/IPv6 + TCP headers (LINKTYPE_RAW) so that the 104apci dissector applies.
+class IEC104PcapngWriter
+{
+public:
+    IEC104PcapngWriter() = default;
+    ~IEC104PcapngWriter() {close();};
+
+    bool open(const std::string& path, int maxFileSize, int maxFiles);
+    void close();
+    bool isOpen() const {return m_file != nullptr;};
+
+    /// @brief Write one APDU as a TCP segment between the server and the client
+    void writeApdu(const IEC104CaptureRing::Record& record, const IEC104ClientAddress& client, int clientPort,
+                   uint32_t& serverSeq, uint32_t& clientSeq);
+    void flush();
+
+    /// @brief Local endpoint used in the synthetic headers
+    void setServerEndpoint(const IEC104ClientAddress& address, int port) {m_serverAddress = address; m_serverPort = port;};
+
+private:
+    bool openFile();
+    void rotate();
+    void writeHeaderBlocks();
+    void write(const void* data, size_t size);
+
+    FILE* m_file = nullptr;
+    std::string m_path;
+    long m_maxFileSize = 0;
+    int m_maxFiles = 0;
+    long m_fileSize = 0;
+
+    IEC104ClientAddress m_serverAddress;
+    int m_serverPort = 2404;
+
+    std::vector<uint8_t> m_block;
+};
+
+/// @brief Raw APDU capture: lock-free ring fed by rawMessageHandler, drained into a rotating pcapng file
+///        by a background thread. When disabled, recording an APDU costs a single acquire load and branch.
+class IEC104Capture
+{
+public:
+    IEC104Capture() = default;
+    ~IEC104Capture() {stop();};
+
+    /// @brief Acquire load: the ring created by configure() before enabling the capture is visible to the caller
+    inline bool isEnabled() const {return m_enabled.load(std::memory_order_acquire);};
+
+    /// @brief Apply new settings: start, stop or restart the capture
+    void configure(const IEC104CaptureSettings& settings, const std::string& defaultPath);
+    void stop();
+
+    /// @brief Server endpoint used in the synthetic IP/TCP headers
+    void setServerEndpoint(const std::string& ip, int port);
+
+    void recordApdu(uint64_t connectionKey, const uint8_t* data, int length, bool sent);
+
+    /// @brief Track the peer of a connection, called on connection events
+    void registerConnection(uint64_t connectionKey, const char* peerAddress);
+    void unregisterConnection(uint64_t connectionKey);
+
+    uint64_t Dropped() const {return m_ring ? m_ring->Dropped() : 0;};
+
+private:
+    struct Peer
+    {
+        uint64_t id = 0;
+        IEC104ClientAddress address;
+        int port = 0;
+    };
+
+    struct PeerState
+    {
+        Peer peer;
+        uint32_t serverSeq = 1;
+        uint32_t clientSeq = 1;
+    };
+
+    void writerThread();
+    void writeRecord(const IEC104CaptureRing::Record& record);
+
+    std::atomic<bool> m_enabled{false};
+    std::atomic<bool> m_running{false};
+    std::mutex m_configLock;
+
+    std::unique_ptr<IEC104CaptureRing> m_ring;
+    int m_ringSize = 0; /* ring size the ring was created with */
+    std::thread* m_writerThread = nullptr;
+    IEC104PcapngWriter m_writer;
+
+    std::mutex m_peersLock;
+    std::map<uint64_t, Peer> m_peers;
+    uint64_t m_nextPeerId = 1;
+    std::map<uint64_t, PeerState> m_writerPeers; /* only used by the writer thread */
+};
+
+#endif /* IEC104_CAPTURE_H */
@@ -0,0 +1,126 @@
+#ifndef IEC104_CLIENT_IP_H
+#define IEC104_CLIENT_IP_H
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+class IEC104ServerRedGroup;
+class RedGroupCon;
+
+/// @brief Binary representation of a client IP address.
+///        IPv4 addresses are stored as IPv4-mapped IPv6 addresses (::ffff:a.b.c.d) so that
+///        both families share the same key space and "::ffff:" peers match IPv4 entries.
+class IEC104ClientAddress
+{
+public:
+    IEC104ClientAddress() { memset(m_bytes, 0, sizeof(m_bytes)); };
+
+    /// @brief Parse an IPv4 or IPv6 address (IPv6 may be enclosed in brackets) without allocating
+    /// @param str Address text, does not need to be null terminated
+    /// @param len Length of the address text
+    /// @param address Parsed address
+    /// @return true if the text is a valid address, else false
+    static bool parse(const char* str, size_t len, IEC104ClientAddress& address);
+
+    /// @brief Parse a peer address as returned by IMasterConnection_getPeerAddress ("ip:port" or "[ip]:port")
+    /// @param peer Null terminated peer address
+    /// @param address Parsed address
+    /// @param port Parsed port
+    /// @return true if both the address and the port are valid, else false
+    static bool parsePeer(const char* peer, IEC104ClientAddress& address, int& port);
+
+    bool isV4() const;
+    const uint8_t* Bytes() const {return m_bytes;};
+
+    size_t hash() const;
+
+    bool operator==(const IEC104ClientAddress& other) const {return memcmp(m_bytes, other.m_bytes, sizeof(m_bytes)) == 0;};
+
+private:
+    uint8_t m_bytes[16];
+};
+
+struct IEC104ClientAddressHash
+{
+    size_t operator()(const IEC104ClientAddress& address) const {return address.hash();};
+};
+
+/// @brief Redundancy group and connection slots a client address belongs to
+struct IEC104ClientIpEntry
+{
+    IEC104ServerRedGroup* redGroup = nullptr;
+    std::vector<RedGroupCon*> connections;
+
+    /// @brief Get the connection slot currently used by the given peer port, or else the first free slot
+    /// @param port The peer port
+    /// @return The connection slot, nullptr if all slots are used by other ports
+    RedGroupCon* GetSlot(int port) const;
+};
+
+/// @brief Client IP to redundancy group lookup table, built once at configuration import.
+///        Client addresses are resolved with a single hash probe. Subnets are not supported: lib60870 only
+///        dispatches the connections of exact client addresses to their redundancy group.
+///        The table only holds raw pointers, the redundancy groups and their connections are owned by IEC104Config.
+class IEC104ClientIpLookup
+{
+public:
+    void clear();
+
+    /// @brief Register a connection slot for a client address
+    /// @return false if the address is already registered in another redundancy group
+    bool add(const IEC104ClientAddress& address, IEC104ServerRedGroup* redGroup, RedGroupCon* connection);
+
+    /// @brief Find the entry associated with a client address
+    /// @return The matching entry, nullptr if the address does not belong to any configured redundancy group
+    const IEC104ClientIpEntry* find(const IEC104ClientAddress& address) const;
+
+    bool empty() const {return m_hosts.empty();};
+
+private:
+    std::unordered_map<IEC104ClientAddress, IEC104ClientIpEntry, IEC104ClientAddressHash> m_hosts;
+};
+
+/// @brief Per source IP token bucket limiting the rate of accepted connection requests.
+///        Each client address owns a bucket of "burst" tokens refilled at "ratePerMinute" tokens per minute,
+///        every accepted connection request consumes one token.
+class IEC104ClientRateLimiter
+{
+public:
+    /// @brief Configure the limiter, a rate of 0 disables it
+    void configure(int ratePerMinute, int burst);
+
+    bool isEnabled() const {return m_ratePerMinute > 0;};
+
+    /// @brief Consume a token for a connection request
+    /// @param address The client address
+    /// @param currentTime The current time in ms
+    /// @return true if the connection request is allowed, false if the client exceeded its rate or cannot be tracked
+    bool allow(const IEC104ClientAddress& address, uint64_t currentTime);
+
+    /// @brief Maximum number of tracked client addresses. Above this size, the least recently seen client is dropped
+    ///        when its bucket is full again, else the new client is refused.
+    static const size_t MAX_TRACKED_CLIENTS = 4096;
+
+private:
+    struct Bucket
+    {
+        double tokens;
+        uint64_t lastRefill;
+        std::list<IEC104ClientAddress>::iterator lruPosition;
+    };
+
+    double refill(Bucket& bucket, uint64_t currentTime) const;
+
+    std::mutex m_lock;
+    int m_ratePerMinute = 0;
+    int m_burst = 1;
+    std::unordered_map<IEC104ClientAddress, Bucket, IEC104ClientAddressHash> m_buckets;
+    std::list<IEC104ClientAddress> m_lru; /* tracked clients, least recently seen first */
+};
+
+#endif /* IEC104_CLIENT_IP_H */
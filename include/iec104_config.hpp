@@ -2,6 +2,7 @@
 #define IEC104_CONFIG_H
 
 #include <map>
+#include <string>
 #include <vector>
 #include <memory>
 #include <algorithm>
@@ -9,9 +10,26 @@
 #include <lib60870/cs104_slave.h>
 #include <rapidjson/document.h>
 
+#include "iec104_arena.hpp"
+#include "iec104_client_ip.hpp"
+#include "iec104_capture.hpp"
+#include "iec104_point_table.hpp"
+
 class IEC104DataPoint;
 class IEC104ServerRedGroup;
 
+/// @brief Periodic diagnostics settings (diagnostics.latency, diagnostics.statistics and diagnostics.audit_code).
+///        Imported as a whole and published as a new immutable instance, so that the monitoring thread reads a
+///        consistent snapshot while the configuration thread applies a change.
+struct IEC104DiagnosticsSettings
+{
+    bool latencyTracing = false;
+    int latencyPeriod = 60; /* in s */
+    bool statisticsEnabled = false;
+    int statisticsPeriod = 60; /* in s */
+    std::string auditCode; /* empty - diagnostics are only logged */
+};
+
 class IEC104Config
 {
 public:
@@ -22,15 +40,21 @@ public:
     void importProtocolConfig(const std::string& protocolConfig);
     void importExchangeConfig(const std::string& exchangeConfig);
     void importTlsConfig(const std::string& tlsConfig);
+    void importDiagnosticsConfig(const std::string& diagnosticsConfig);
 
-    std::map<int, std::map<int, IEC104DataPoint*>>* getExchangeDefinitions() {return m_exchangeDefinitions;};
+    const std::map<int, std::map<int, IEC104DataPoint*>>* getExchangeDefinitions() const
+    {
+        return m_pointTable ? &(m_pointTable->Definitions()) : nullptr;
+    };
+    /// @brief Points of the last imported exchanged data, shared with the server
+    std::shared_ptr<const IEC104PointTable> getPointTable() const {return m_pointTable;};
 
     int GetMaxRedGroups() const {return m_maxRedundancyGroups;};
     std::vector<std::shared_ptr<IEC104ServerRedGroup>>& RedundancyGroups() {return m_redundancyGroups;};
-    /// @brief Get the IEC104ServerRedGroup associated with the given IP
-    /// @param ip The client IP
-    /// @return std::shared_ptr<IEC104ServerRedGroup>
-    std::shared_ptr<IEC104ServerRedGroup> GetRedundancyGroup(const std::string& ip);
+    /// @brief Get the lookup table resolving a client IP to its redundancy group and connection slots
+    const IEC104ClientIpLookup& ClientIpLookup() const {return m_clientIpLookup;};
+    /// @brief Check if a redundancy group without any connection accepts the clients not listed in the other groups
+    bool HasCatchAllRedGroup() const {return m_hasCatchAllRedGroup;};
 
     int TcpPort();
     bool bindOnIp() {return m_bindOnIp;};
@@ -40,6 +64,8 @@ public:
     int T1() {return m_t1;};
     int T2() {return m_t2;};
     int T3() {return m_t3;};
+    int ConnRateLimit() {return m_connRateLimit;};
+    int ConnRateBurst() {return m_connRateBurst;};
     int UseTLS() {return m_useTls;};
     const char* GetLocalIP() {return m_ip.c_str();};
 
@@ -48,6 +74,9 @@ public:
     int AsduSize() {return m_asduSize;};
 
     int AsduQueueSize() {return m_asduQueueSize;};
+    int BkgScanRate() {return m_bkgScanRate;};
+    int DecodeWorkers() {return m_decodeWorkers;};
+    int EncoderQueueSize() {return m_encoderQueueSize;};
 
     bool TimeSync() {return m_timeSync;};
 
@@ -66,6 +95,13 @@ public:
     std::vector<std::string>& GetRemoteCertificates() {return m_remoteCertificates;};
     std::vector<std::string>& GetCaCertificates() {return m_caCertificates;};
 
+    const IEC104CaptureSettings& CaptureSettings() const {return m_captureSettings;};
+    /// @brief Snapshot of the diagnostics settings, safe to call from any thread
+    std::shared_ptr<const IEC104DiagnosticsSettings> DiagnosticsSettings() const
+    {
+        return std::atomic_load(&m_diagnosticsSettings);
+    };
+
     enum class Mode
     {
         CONNECT_ALWAYS,
@@ -117,6 +153,24 @@ private:
     void importApplicationLayer(const rapidjson::Value& applicationLayer);
     void importRedundancyGroups(const rapidjson::Value& redundancyGroups);
     void importRedundancyGroupConnections(const rapidjson::Value& connection, std::shared_ptr<IEC104ServerRedGroup> redundancyGroup) const;
+    void buildClientIpLookup();
+    void importCaptureConfig(const rapidjson::Value& capture);
+    void importPeriodicDiagnosticConfig(const rapidjson::Value& diagnostic, const std::string& name, bool& enabled, int& period);
+    /// @brief Create the data points of exchanged_data in the point table
+    void importDataPoints(const std::string& exchangeConfig);
+    /// @brief Value conversion of an analog point: scale, offset and engineering range min/max
+    void importConversion(const rapidjson::Value& conversion, IEC104DataPoint* dp);
+
+    /// @brief Single point transmitted as a bit of a packed object (M_PS_NA_1, M_BO_NA_1)
+    struct PackMembership
+    {
+        IEC104DataPoint* member;
+        int packCa;
+        int packIoa;
+        int bit;
+    };
+
+    void linkPackedPoints(const std::vector<PackMembership>& memberships);
 
     static bool isValidIPAddress(const std::string& addrStr);
 
@@ -138,11 +192,17 @@ private:
     int m_t2 = 10;
     int m_t3 = 20;
 
+    int m_connRateLimit = 0; /* accepted connection requests per minute and per client IP, 0 - no limit */
+    int m_connRateBurst = 5;
+
     int m_caSize = 2;
     int m_ioaSize = 3;
     int m_asduSize = 0;
 
     int m_asduQueueSize = 100;
+    int m_bkgScanRate = 0; /* bytes/s, 0: background scan disabled */
+    int m_decodeWorkers = 1; /* threads decoding the readings, 1: decoded by the north thread */
+    int m_encoderQueueSize = 0; /* decoded data objects, 0: applied and enqueued by the north thread */
 
     bool m_timeSync = false;
     bool m_filterOriginators = false;
@@ -158,16 +218,23 @@ private:
 
     int m_maxRedundancyGroups = 2;
     std::vector<std::shared_ptr<IEC104ServerRedGroup>> m_redundancyGroups;
+    IEC104ClientIpLookup m_clientIpLookup;
+    bool m_hasCatchAllRedGroup = false;
 
     std::vector<SouthPluginMonitor*> m_monitoredSouthPlugins;
 
-    std::map<int, std::map<int, IEC104DataPoint*>>* m_exchangeDefinitions = nullptr;
+    std::shared_ptr<IEC104PointTable> m_pointTable; /* data points, allocated in the arena of the table */
+    IEC104Arena m_protocolArena; /* south plugin monitors, released at once when the protocol stack is imported again */
     std::map<int, int> m_allowedOriginators;
 
     std::string m_privateKey;
     std::string m_ownCertificate;
     std::vector<std::string> m_remoteCertificates;
     std::vector<std::string> m_caCertificates;
+
+    IEC104CaptureSettings m_captureSettings;
+    /* replaced with std::atomic_store, read with std::atomic_load */
+    std::shared_ptr<const IEC104DiagnosticsSettings> m_diagnosticsSettings = std::make_shared<IEC104DiagnosticsSettings>();
 };
 
 #endif /* IEC104_CONFIG_H */
\ No newline at end of file
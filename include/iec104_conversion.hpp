@@ -0,0 +1,45 @@
+#ifndef IEC104_CONVERSION_H
+#define IEC104_CONVERSION_H
+
+#include <cstdint>
+
+/// @brief Engineering to protocol conversion of an analog point: y = x * a + b saturated to [low, high].
+///        The coefficients are computed once from the configured scale, offset and range for the data type:
+///        normalized values map the range to [-1, 1] (max sent as 1 - 2^-15), scaled values are rounded to int16,
+///        short floats are clamped.
+///        A saturated or non-numeric result sets the overflow quality bit.
+struct IEC104Conversion
+{
+    double a = 1.0;
+    double b = 0.0;
+    double low = 0.0;
+    double high = 0.0;
+    double overflowHigh = 0.0; /* above: overflow, 1.0 for the normalized values (full scale, transmitted as high) */
+    bool integer = false; /* rounded to the nearest integer (scaled values) */
+
+    /// @brief Conversion of a data type (IEC60870_TYPE_NORMALIZED, _SCALED or _SHORT)
+    /// @param hasRange the engineering range [min, max] is configured (min < max)
+    static IEC104Conversion create(int dataType, double scale, double offset, bool hasRange, double min, double max);
+
+    /// @brief Saturation only, used for the points without configured conversion
+    static const IEC104Conversion& defaultFor(int dataType);
+
+    /// @brief Convert a value without branch (min/max and selects), NaN is converted to 0 with overflow
+    float apply(double input, bool& overflow) const
+    {
+        double y = input * a + b;
+        double clamped = (y < low) ? low : y;
+        clamped = (clamped > high) ? high : clamped;
+
+        overflow = !((y >= low) & (y <= overflowHigh)); /* also true for NaN */
+        clamped = (y == y) ? clamped : 0.0;
+
+        /* half away from zero, the integer range is within int16 so the truncation cannot overflow */
+        double half = (clamped < 0.0) ? -0.5 : 0.5;
+        double rounded = static_cast<double>(static_cast<int32_t>(clamped + (integer ? half : 0.0)));
+
+        return static_cast<float>(integer ? rounded : clamped);
+    }
+};
+
+#endif /* IEC104_CONVERSION_H */
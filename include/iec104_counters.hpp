@@ -0,0 +1,76 @@
+#ifndef IEC104_COUNTERS_H
+#define IEC104_COUNTERS_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "lib60870/cs101_information_objects.h"
+
+class IEC104DataPoint;
+
+/// @brief Integrated totals (M_IT_NA_1, M_IT_TB_1) served by the counter interrogation.
+///        The counters of a CA and counter group are kept in a copy-on-write array: a freeze only keeps a reference
+///        to the current array (O(1) whatever the number of counters) and the next update from send() copies it once.
+///        Frozen arrays are immutable and are streamed to the masters without holding any lock.
+class IEC104CounterStore
+{
+public:
+    static const int MAX_COUNTER_GROUP = 4;
+
+    struct Counter
+    {
+        int ioa;
+        int typeId;
+        int32_t value;
+        bool carry;
+        bool adjusted;
+        bool invalid;
+        struct sCP56Time2a ts;
+    };
+
+    typedef std::vector<Counter> CounterArray;
+
+    struct Snapshot
+    {
+        std::shared_ptr<const CounterArray> counters;
+        int sequence; /* sequence number of the freeze (5 bits) */
+    };
+
+    /// @brief Build the counter banks from the exchanged data, must be called before the server is started
+    void configure(const std::map<int, std::map<int, IEC104DataPoint*>>& exchangeDefinitions);
+
+    bool hasCounters(int ca) const {return m_banks.find(ca) != m_banks.end();};
+    std::vector<int> Cas() const;
+
+    /// @brief Copy the value of a counter data point in its bank
+    /// @param typeId type ID of the last update (M_IT_NA_1 or M_IT_TB_1), used in the interrogation response
+    void update(const IEC104DataPoint* dp, int typeId);
+
+    /// @brief Freeze the counters of a CA
+    /// @param group counter group 1..4, 0 for the general request (all counters of the CA)
+    void freeze(int ca, int group);
+
+    /// @brief Frozen counters of a CA, the current values of the banks that were never frozen
+    /// @param group counter group 1..4, 0 for the general request (one snapshot per bank)
+    std::vector<Snapshot> snapshots(int ca, int group);
+
+private:
+    class Bank
+    {
+    public:
+        Bank() : m_live(std::make_shared<CounterArray>()) {};
+
+        std::mutex m_lock;
+        std::shared_ptr<CounterArray> m_live;
+        std::shared_ptr<const CounterArray> m_frozen;
+        int m_sequence = 0;
+    };
+
+    typedef std::vector<std::unique_ptr<Bank>> CaBanks; /* index: counter group, 0 for counters without group */
+
+    std::map<int, CaBanks> m_banks;
+};
+
+#endif /* IEC104_COUNTERS_H */
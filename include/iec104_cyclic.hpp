@@ -0,0 +1,52 @@
+#ifndef IEC104_CYCLIC_H
+#define IEC104_CYCLIC_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+class IEC104DataPoint;
+
+/// @brief Scheduler of the cyclic transmission (COT periodic) of the points configured with a cycle period.
+///        The points are split in batches of one ASDU (same CA and type), the batches of a period are spread evenly
+///        over the period to avoid bursts. Due batches are found with a hashed timer wheel, the cost of a tick does
+///        not depend on the number of cyclic points. Only used by the monitoring thread, not thread safe.
+class IEC104CyclicScheduler
+{
+public:
+    static const int TICK = 100; /* resolution in ms, period of the monitoring thread */
+    static const int WHEEL_SIZE = 256; /* one turn of the wheel is 25.6 s */
+
+    struct Batch
+    {
+        int ca;
+        int period; /* in ticks */
+        std::vector<IEC104DataPoint*> points;
+        int rounds; /* remaining turns of the wheel before the batch is due */
+    };
+
+    /// @brief Build the batches from the exchanged data
+    /// @param maxSizeOfASDU, sizeOfCA, sizeOfIOA application layer parameters, used to fill complete ASDUs
+    void configure(const std::map<int, std::map<int, IEC104DataPoint*>>& exchangeDefinitions,
+                   int maxSizeOfASDU, int sizeOfCA, int sizeOfIOA);
+
+    bool isEmpty() const {return m_batches.empty();};
+
+    /// @brief Advance the wheel up to the given time
+    /// @param due batches that are due, they are scheduled again for their next period
+    void advance(uint64_t currentTime, std::vector<const Batch*>& due);
+
+    /// @brief Number of information objects of a data type in one ASDU (without time tag)
+    static int objectsPerAsdu(int dataType, int maxSizeOfASDU, int sizeOfCA, int sizeOfIOA);
+
+private:
+    void schedule(Batch* batch, int delay);
+
+    std::vector<std::unique_ptr<Batch>> m_batches;
+    std::vector<Batch*> m_wheel[WHEEL_SIZE];
+    int m_currentSlot = 0;
+    uint64_t m_nextTick = 0; /* in ms, 0 until the first call of advance() */
+};
+
+#endif /* IEC104_CYCLIC_H */
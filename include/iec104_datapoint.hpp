@@ -1,7 +1,9 @@
 #ifndef IEC104_DATAPOINT_H
 #define IEC104_DATAPOINT_H
 
+#include <atomic>
 #include <string>
+#include <vector>
 
 #include "lib60870/cs101_information_objects.h"
 
@@ -11,39 +13,17 @@
 #define IEC60870_TYPE_NORMALIZED 4
 #define IEC60870_TYPE_SCALED 5
 #define IEC60870_TYPE_SHORT 6
+#define IEC60870_TYPE_BITSTRING 7
+#define IEC60870_TYPE_PACKED_SP 8
+#define IEC60870_TYPE_COUNTER 9
+
+class DatapointValue;
+struct IEC104Conversion;
 
 class IEC104DataPoint
 {
 public:
-
-    IEC104DataPoint(std::string label, int ca, int ioa, int type, bool isCommand, int gi_groups);
-    ~IEC104DataPoint(){};
-
-    static bool isSupportedCommandType(int typeId);
-    static bool isCommandWithTimestamp(int typeId);
-    static bool isSupportedMonitoringType(int typeId);
-    static int typeIdToDataType(int typeId);
-    static int getTypeIdFromString(std::string typeIdStr);
-    static std::string getStringFromTypeID(int typeId);
-
-    bool isMonitoringType();
-
-    bool isCommand();
-
-    bool isMessageTypeMatching(int msgTypeId);
-
-    bool isMatchingCommand(int typeId);
-
-    int m_ca = 0;
-    int m_ioa = 0;
-    int m_type = 0;
-    bool m_isCommand = false;
-    std::string m_label;
-    int m_gi_groups = 0;
-
-    int terminationTimeout = 0; /* termination timeout for commands in ms */
-
-    union {
+    union Value {
         struct {
             unsigned int value : 1;
             uint8_t quality;
@@ -75,7 +55,14 @@ public:
             uint8_t quality;
         } mv_short; /* IEC60870_TYPE_SHORT */
 
-        uint32_t bitstring; /* IEC60870_TYPE_BITSTRING */
+        struct {
+            uint32_t value; /* the quality is computed from the members */
+        } bitstring; /* IEC60870_TYPE_BITSTRING */
+
+        struct {
+            uint16_t st; /* status */
+            uint16_t cd; /* status change detection, reset when transmitted spontaneously */
+        } packed_sp; /* IEC60870_TYPE_PACKED_SP */
 
         struct {
             int32_t value;
@@ -113,9 +100,92 @@ public:
             unsigned int active : 1;
             unsigned int refIoa : 24;
         } param_mv; /* IEC60870_TYPE_PARAM_MV_... */
-    } m_value;
+    };
+
+
+    IEC104DataPoint(std::string label, int ca, int ioa, int type, bool isCommand, int gi_groups);
+    ~IEC104DataPoint(){};
+
+    /// @brief Use external storage (IEC104PointStore) for the value and time tag, the value is initialized to the
+    ///        invalid state of the type. The point has no value before.
+    void attachStorage(Value* value, struct sCP56Time2a* ts);
+
+    static bool isSupportedCommandType(int typeId);
+    static bool isCommandWithTimestamp(int typeId);
+    static bool isSupportedMonitoringType(int typeId);
+    /// @brief Monitoring type with a CP24Time2a time tag (M_xx_TA_1)
+    static bool hasCP24TimeTag(int typeId);
+    /// @brief CP24Time2a variant of a CP56Time2a time tagged type, other types are returned unchanged
+    static int cp24Variant(int typeId);
+    static int typeIdToDataType(int typeId);
+    /// @brief Size of the information element of a data type without IOA and time tag, in octets
+    static int encodedSize(int dataType);
+    /// @return type ID, 0 when the name is unknown
+    static int getTypeIdFromString(const std::string& typeIdStr);
+    /// @return type name, empty string when the type ID is unknown
+    static const char* getStringFromTypeID(int typeId);
+    /// @brief Read a step position do_value without copying it: dict {"value": v, "transient": t},
+    ///        two-element list [v, t] or string "[v,true]"/"[v,false]"
+    /// @return false when the format is not recognized or the value is out of range [-64..63]
+    static bool parseStepPosition(DatapointValue& value, int& posValue, bool& transient);
+
+    bool isMonitoringType();
+
+    bool isCommand();
+
+    bool isMessageTypeMatching(int msgTypeId);
+
+    bool isMatchingCommand(int typeId);
+
+    /// @brief Number of single points a packed object (M_PS_NA_1, M_BO_NA_1) can hold, 0 for other types
+    static int packedBitCount(int dataType);
+    /// @brief Type ID the packed object is transmitted with
+    int packedTypeId() const;
+    /// @brief Add a single point to this packed object
+    /// @return false when the bit is out of range or already used by another single point
+    bool addPackMember(IEC104DataPoint* member, int bit);
+    /// @brief Set a status bit of this packed object, the change detection bit is set when the status changes
+    void updatePackedBit(int bit, bool state);
+    /// @brief Quality of the packed object: union of the quality flags of its members
+    uint8_t packedQuality() const;
+    void encodeStatusAndChangeDetection(StatusAndStatusChangeDetection scd) const;
+
+    int m_ca = 0;
+    int m_ioa = 0;
+    int m_type = 0;
+    bool m_isCommand = false;
+    std::string m_label;
+    int m_gi_groups = 0;
+
+    int terminationTimeout = 0; /* termination timeout for commands in ms */
+
+    /* value and quality, stored in the IEC104PointStore arrays, nullptr until the point is attached */
+    Value* m_value = nullptr;
+    struct sCP56Time2a* m_ts = nullptr;
+
+    bool m_cp24TimeTag = false; /* time tagged values are transmitted with the CP24Time2a variant of their type */
+
+    /* packed transmission: the member single points are only reported as a bit of their packed object */
+    IEC104DataPoint* m_pack = nullptr; /* packed object of a member single point */
+    int m_packBit = 0;
+    std::vector<IEC104DataPoint*> m_packMembers; /* members of a packed object */
+    bool m_packPending = false; /* packed object to be transmitted at the end of the current send() call */
+    int m_packCot = 0;
+
+    /* engineering to protocol conversion of analog points, nullptr: saturation to the range of the type only */
+    const IEC104Conversion* m_conversion = nullptr;
+
+    int m_cyclicPeriod = 0; /* period of the cyclic transmission in ms, 0 when not transmitted cyclically */
+
+    /* integrated totals */
+    int m_counterGroup = 0; /* counter interrogation group 1..4, 0 when only part of the general request */
+    int m_counterIndex = -1; /* index in the counter bank of its CA and group */
 
-    struct sCP56Time2a m_ts;
+    /* latency tracing timestamps in ns, 0 when not traced */
+    struct {
+        std::atomic<uint64_t> ingest{0};
+        std::atomic<uint64_t> enqueue{0};
+    } m_trace;
 };
 
 #endif /* IEC104_DATAPOINT_H */
\ No newline at end of file
@@ -0,0 +1,81 @@
+#ifndef IEC104_LATENCY_H
+#define IEC104_LATENCY_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/// @brief Lock-free log-linear latency histogram (HdrHistogram layout).
+///        Values are in ns, each power of two is split in 32 sub-buckets (relative error below 3.2%).
+class IEC104LatencyHistogram
+{
+public:
+    static const int SUB_BUCKET_BITS = 5;
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const int MAX_MAGNITUDE = 40; /* values above 2^40 ns (~18 min) are counted in the last bucket */
+    static const int BUCKET_COUNT = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    IEC104LatencyHistogram();
+
+    void record(uint64_t value);
+    void reset();
+
+    uint64_t Count() const {return m_count.load(std::memory_order_relaxed);};
+    uint64_t Max() const {return m_max.load(std::memory_order_relaxed);};
+    uint64_t Sum() const {return m_sum.load(std::memory_order_relaxed);};
+
+    /// @brief Get the value below which the given percentage of the recorded values fall
+    /// @param percentile Percentile in [0..100]
+    /// @return Upper bound of the bucket holding the percentile, 0 if the histogram is empty
+    uint64_t percentile(double percentile) const;
+
+    static int bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(int index);
+
+private:
+    std::atomic<uint64_t> m_buckets[BUCKET_COUNT];
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_max;
+};
+
+/// @brief Latency of the monitoring data path, from the reading ingest in send() to the I-frame transmission,
+///        for each stage and each type ID. Histograms of a type ID are only allocated when the type is first seen.
+class IEC104LatencyTracer
+{
+public:
+    enum Stage
+    {
+        INGEST_TO_ENQUEUE = 0,
+        ENQUEUE_TO_WIRE,
+        INGEST_TO_WIRE,
+        STAGE_COUNT
+    };
+
+    static const int MAX_TYPE_ID = 128;
+
+    IEC104LatencyTracer();
+    ~IEC104LatencyTracer();
+
+    inline bool isEnabled() const {return m_enabled.load(std::memory_order_relaxed);};
+    void setEnabled(bool enabled) {m_enabled.store(enabled, std::memory_order_relaxed);};
+
+    void record(Stage stage, int typeId, uint64_t latency);
+
+    /// @brief Compact JSON snapshot of all stages, latencies are given in us
+    std::string toJson() const;
+    void reset();
+
+    const IEC104LatencyHistogram& Histogram(Stage stage) const {return m_stages[stage];};
+    const IEC104LatencyHistogram* Histogram(Stage stage, int typeId) const;
+
+    static const char* stageName(Stage stage);
+
+private:
+    std::atomic<bool> m_enabled{false};
+
+    IEC104LatencyHistogram m_stages[STAGE_COUNT];
+    std::atomic<IEC104LatencyHistogram*> m_types[STAGE_COUNT][MAX_TYPE_ID];
+};
+
+#endif /* IEC104_LATENCY_H */
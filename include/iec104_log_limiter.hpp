@@ -0,0 +1,74 @@
+#ifndef IEC104_LOG_LIMITER_H
+#define IEC104_LOG_LIMITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Iec104Utility {
+
+/// @brief Suppression of repeated logs, keyed by message site and (CA, IOA): the first occurrence of a key is logged
+///        by the caller, the next ones are only counted and a summary per site is logged once per period.
+///        The number of first occurrences logged per period and the number of remembered keys are bounded, a
+///        misconfigured south sending thousands of unknown points cannot flood the syslog. Thread safe.
+class LogLimiter
+{
+public:
+    static const uint64_t DEFAULT_PERIOD = 10000; /* ms */
+    static const int DEFAULT_MAX_FIRST_PER_PERIOD = 10;
+    static const size_t DEFAULT_MAX_KEYS = 65536;
+
+    explicit LogLimiter(uint64_t period = DEFAULT_PERIOD, int maxFirstPerPeriod = DEFAULT_MAX_FIRST_PER_PERIOD,
+                        size_t maxKeys = DEFAULT_MAX_KEYS);
+
+    /// @brief Register a message site, its summary is logged at error level as "<prefix> <description>: ..."
+    /// @return site ID passed to accept()
+    int addSite(const char* prefix, const char* description);
+
+    /// @brief Count an occurrence, a single hash probe
+    /// @return true when the occurrence has to be logged (first occurrence of the key), false when it is suppressed
+    bool accept(int site, int ca, int ioa);
+
+    /// @brief Log the summary of the occurrences suppressed since the last summary, at most once per period
+    void summarize(uint64_t currentTime);
+
+    /// @brief Occurrences suppressed since the last summary
+    uint64_t Suppressed(int site);
+
+private:
+    struct Site
+    {
+        std::string prefix;
+        std::string description;
+        uint64_t suppressed = 0; /* occurrences since the last summary */
+        size_t keys = 0; /* CA/IOA with suppressed occurrences since the last summary */
+        int firstLogged = 0; /* first occurrences logged in the current period */
+    };
+
+    struct Count
+    {
+        uint64_t suppressed = 0; /* occurrences since the last summary */
+        bool logged = false; /* first occurrence logged */
+    };
+
+    static uint64_t key(int site, int ca, int ioa)
+    {
+        return (static_cast<uint64_t>(site) << 48) | (static_cast<uint64_t>(ca & 0xffff) << 32) |
+               static_cast<uint64_t>(ioa & 0xffffff);
+    }
+
+    std::mutex m_lock;
+    std::vector<Site> m_sites;
+    std::unordered_map<uint64_t, Count> m_counts;
+    uint64_t m_period;
+    int m_maxFirstPerPeriod;
+    size_t m_maxKeys;
+    uint64_t m_lastSummary = 0;
+};
+
+}
+
+#endif /* IEC104_LOG_LIMITER_H */
@@ -0,0 +1,52 @@
+#ifndef IEC104_POINT_STORE_H
+#define IEC104_POINT_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "iec104_datapoint.hpp"
+
+/// @brief Hot state of the exchanged points: value with quality and CP56Time2a time tag in contiguous arrays, one
+///        block per CA ordered by IOA. The IEC104DataPoint objects point into these arrays, the metadata the scans
+///        of a CA filter on (type, groups, packing) is copied next to them so that a general interrogation reads
+///        the arrays sequentially and only dereferences the points it transmits.
+///        Built once per configuration, the arrays are never resized afterwards.
+class IEC104PointStore
+{
+public:
+    /* flags of a point in its block */
+    static const uint8_t FLAG_MONITORING = 0x01; /* monitoring point, not a command */
+    static const uint8_t FLAG_PACKED = 0x02; /* member single point, only reported in its packed object */
+
+    struct Block
+    {
+        int ca = 0;
+        std::vector<IEC104DataPoint*> points; /* ordered by IOA */
+        std::vector<int> types;
+        std::vector<int> giGroups;
+        std::vector<uint8_t> flags;
+        std::vector<IEC104DataPoint::Value> values;
+        std::vector<struct sCP56Time2a> timestamps;
+    };
+
+    /// @brief Allocate the arrays of all points and attach the points to them, their values are initialized to
+    ///        the invalid state of their type. The packed objects must be linked before.
+    void build(const std::map<int, std::map<int, IEC104DataPoint*>>& exchangeDefinitions);
+
+    /// @brief Release the arrays, the points attached to them must have been deleted
+    void clear();
+
+    /// @return block of the CA, nullptr when the CA has no point
+    const Block* findBlock(int ca) const;
+
+    const std::vector<Block>& Blocks() const {return m_blocks;};
+    size_t Size() const {return m_size;};
+
+private:
+    std::vector<Block> m_blocks; /* ordered by CA */
+    size_t m_size = 0;
+};
+
+#endif /* IEC104_POINT_STORE_H */
@@ -0,0 +1,63 @@
+#ifndef IEC104_POINT_TABLE_H
+#define IEC104_POINT_TABLE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include "iec104_arena.hpp"
+#include "iec104_point_store.hpp"
+
+class IEC104DataPoint;
+struct IEC104Conversion;
+
+/// @brief Exchanged points of one configuration: definitions by CA and IOA, (CA, IOA) index and point store.
+///        Built by IEC104Config::importExchangeConfig, then shared read-only with the server through a
+///        std::shared_ptr. The points are allocated in the arena of the table and destroyed with the last reference,
+///        so a new table can replace it while a previous user still holds the old one.
+class IEC104PointTable
+{
+public:
+    typedef std::map<int, std::map<int, IEC104DataPoint*>> ExchangeDefinitions;
+
+    IEC104PointTable() = default;
+
+    IEC104PointTable(const IEC104PointTable&) = delete;
+    IEC104PointTable& operator=(const IEC104PointTable&) = delete;
+
+    /// @brief Create a point and add it to the definitions and the index (import only)
+    IEC104DataPoint* addDataPoint(const std::string& label, int ca, int ioa, int type, bool isCommand, int gi_groups);
+
+    /// @brief Set the value conversion of an analog point, stored in the arena of the table (import only)
+    void setConversion(IEC104DataPoint* dp, const IEC104Conversion& conversion);
+
+    /// @brief Attach the points to the point store, called when all points are imported and linked
+    void finalize();
+
+    /// @return point of (CA, IOA), nullptr when not defined
+    IEC104DataPoint* findDataPoint(int ca, int ioa) const
+    {
+        auto it = m_index.find(key(ca, ioa));
+
+        if (it == m_index.end()) {
+            return nullptr;
+        }
+
+        return it->second;
+    }
+
+    const ExchangeDefinitions& Definitions() const {return m_definitions;};
+    const IEC104PointStore& Store() const {return m_store;};
+    size_t Size() const {return m_index.size();};
+
+private:
+    static uint64_t key(int ca, int ioa) {return (static_cast<uint64_t>(ca) << 32) | static_cast<uint32_t>(ioa);};
+
+    ExchangeDefinitions m_definitions;
+    std::unordered_map<uint64_t, IEC104DataPoint*> m_index;
+    IEC104PointStore m_store;
+    IEC104Arena m_arena; /* last member: the points are destroyed before the containers pointing to them */
+};
+
+#endif /* IEC104_POINT_TABLE_H */
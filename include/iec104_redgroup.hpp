@@ -12,22 +12,23 @@ class RedGroupCon
 {
 public:
     explicit RedGroupCon(const std::string& clientIp);
-    RedGroupCon(const std::string& clientIp, const std::string& port, const std::string &pathLetter);
+    RedGroupCon(const std::string& clientIp, int port, const std::string &pathLetter);
     ~RedGroupCon() = default;
 
     const std::string& ClientIP() const {return m_clientIp;};
-    const std::string& Port() const {return m_port;};
+    /// @brief Peer port of the TCP connection currently using this slot, 0 if the slot is free
+    int Port() const {return m_port;};
     const std::string& PathLetter() const {return m_pathLetter;};
     const bool& isActive() const {return m_isActive;};
 
-    void SetPort(const std::string& port) { m_port = port; };
+    void SetPort(int port) { m_port = port; };
     void SetPathLetter(const std::string& pathLetter) { m_pathLetter = pathLetter; };
     void SetActive(const bool& isActive) { m_isActive = isActive; };
 
 private:
     /* configuration properties */
     std::string m_clientIp;
-    std::string m_port;
+    int m_port = 0;
     std::string m_pathLetter;
     bool m_isActive = false;
 };
@@ -49,14 +50,6 @@ public:
 
     int GetMaxConnections() const {return m_maxConnections;};
 
-    /// @brief Get the RedGroupCon object associated with an IP and, if provided, a PORT. 
-    ///        If no PORT is provided, the empty value will be used. Meaning that the method
-    ///         will return the first RedGroupCon with an empty PORT.
-    /// @param ip The client IP
-    /// @param port The port. Default value = ""
-    /// @return std::shared_ptr<RedGroupCon>
-    std::shared_ptr<RedGroupCon> GetRedGroupCon(const std::string& ip, const std::string &port="");
-
 private:
 
     std::vector<std::shared_ptr<RedGroupCon>> m_connections;
@@ -0,0 +1,87 @@
+#ifndef IEC104_SPSC_RING_H
+#define IEC104_SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/// @brief Bounded lock-free ring for exactly one producer thread and one consumer thread.
+///        The capacity is rounded up to a power of two. The producer and consumer indexes are on their own cache
+///        lines, each side only writes its own index (release) and reads the other one (acquire).
+template <class T>
+class IEC104SpscRing
+{
+public:
+    explicit IEC104SpscRing(size_t capacity)
+    {
+        size_t size = 1;
+
+        while (size < capacity) {
+            size <<= 1;
+        }
+
+        m_slots.resize(size);
+        m_mask = size - 1;
+    }
+
+    IEC104SpscRing(const IEC104SpscRing&) = delete;
+    IEC104SpscRing& operator=(const IEC104SpscRing&) = delete;
+
+    size_t Capacity() const {return m_slots.size();};
+
+    /// @brief Free slots, exact for the producer (the consumer can only free more slots)
+    size_t FreeSpace() const
+    {
+        return m_slots.size() - (m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_acquire));
+    }
+
+    bool isEmpty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    /// @brief Add an item, producer side
+    /// @return false when the ring is full (the item is not moved)
+    bool push(T&& item)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail - m_head.load(std::memory_order_acquire) == m_slots.size()) {
+            return false;
+        }
+
+        m_slots[tail & m_mask] = std::move(item);
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /// @brief Remove the oldest item, consumer side
+    /// @return false when the ring is empty
+    bool pop(T& item)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        item = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+private:
+    std::vector<T> m_slots;
+    size_t m_mask = 0;
+
+    char m_padding1[64];
+    std::atomic<size_t> m_head{0}; /* next slot to read, written by the consumer */
+    char m_padding2[64];
+    std::atomic<size_t> m_tail{0}; /* next slot to write, written by the producer */
+    char m_padding3[64];
+};
+
+#endif /* IEC104_SPSC_RING_H */
@@ -0,0 +1,104 @@
+#ifndef IEC104_STATISTICS_H
+#define IEC104_STATISTICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "iec104_latency.hpp"
+
+/// @brief Runtime statistics of the server: global counters, ASDU queue depth, GI durations and per-connection
+///        frame counters. Counters are relaxed atomics updated from the lib60870 threads and send(); the lock is only
+///        taken when a connection is opened or closed and when a snapshot is built.
+class IEC104Statistics
+{
+public:
+    static const int MAX_LINKS = 32;
+
+    IEC104Statistics() = default;
+
+    /// @brief Frames are only recorded while the statistics are enabled (see IEC104Server::rawMessageHandler)
+    void setEnabled(bool enabled);
+    inline bool isEnabled() const {return m_enabled.load(std::memory_order_relaxed);};
+
+    /// @brief Size of the k window, used to detect stalled connections
+    void setWindowSize(int k) {m_k.store(k, std::memory_order_relaxed);};
+
+    void countReadings(int readings) {m_readings.fetch_add(readings, std::memory_order_relaxed);};
+    void countAsduEnqueued() {m_asdusEnqueued.fetch_add(1, std::memory_order_relaxed);};
+    void countConnectionRequest(bool accepted);
+    void countCommand(uint64_t connectionKey, bool rejected);
+    void recordInterrogation(uint64_t connectionKey, uint64_t duration);
+
+    /// @brief Sample the depth of the ASDU queue, called periodically by the monitoring thread
+    void sampleQueueDepth(int depth, int capacity);
+
+    void openLink(uint64_t connectionKey, const std::string& peer);
+    void closeLink(uint64_t connectionKey);
+
+    /// @brief Count a raw APDU sent or received on a connection and track its k window
+    void recordFrame(uint64_t connectionKey, const uint8_t* msg, int msgSize, bool sent);
+
+    /// @brief Compact JSON snapshot, rates and period values (queue max, GI durations) are reset afterwards
+    /// @param period Time elapsed since the previous snapshot in ms
+    std::string toJson(uint64_t period);
+
+private:
+    struct Link
+    {
+        std::atomic<uint64_t> key{0}; /* 0 - free slot */
+
+        std::atomic<uint64_t> iFramesSent{0};
+        std::atomic<uint64_t> iFramesReceived{0};
+        std::atomic<uint64_t> sFramesSent{0};
+        std::atomic<uint64_t> sFramesReceived{0};
+        std::atomic<uint64_t> uFramesSent{0};
+        std::atomic<uint64_t> uFramesReceived{0};
+        std::atomic<uint64_t> bytesSent{0};
+        std::atomic<uint64_t> bytesReceived{0};
+        std::atomic<uint64_t> windowStalls{0};
+        std::atomic<uint64_t> commands{0};
+        std::atomic<uint64_t> commandsRejected{0};
+        std::atomic<uint64_t> interrogations{0};
+
+        /* k window tracking, only updated by the connection thread */
+        std::atomic<int> nextSendSequence{0}; /* -1 - unknown until the next I-frame is sent */
+        std::atomic<int> acknowledgedSequence{0};
+        std::atomic<bool> stalled{false};
+
+        /* only accessed with m_linksLock held */
+        std::string peer;
+        uint64_t lastIFramesSent = 0;
+        uint64_t lastIFramesReceived = 0;
+    };
+
+    Link* findLink(uint64_t connectionKey);
+    void updateWindow(Link* link, int outstanding);
+
+    std::atomic<bool> m_enabled{false};
+    std::atomic<int> m_k{12};
+
+    std::atomic<uint64_t> m_readings{0};
+    std::atomic<uint64_t> m_asdusEnqueued{0};
+    std::atomic<uint64_t> m_connectionsAccepted{0};
+    std::atomic<uint64_t> m_connectionsRejected{0};
+    std::atomic<uint64_t> m_connectionsOpened{0};
+    std::atomic<uint64_t> m_commands{0};
+    std::atomic<uint64_t> m_commandsRejected{0};
+    std::atomic<uint64_t> m_interrogations{0};
+
+    std::atomic<int> m_queueDepth{0};
+    std::atomic<int> m_queueMaxDepth{0};
+    std::atomic<int> m_queueCapacity{0};
+    std::atomic<uint64_t> m_queueFullSamples{0};
+
+    IEC104LatencyHistogram m_interrogationDurations;
+
+    uint64_t m_lastReadings = 0; /* only accessed with m_linksLock held */
+
+    std::mutex m_linksLock;
+    Link m_links[MAX_LINKS];
+};
+
+#endif /* IEC104_STATISTICS_H */
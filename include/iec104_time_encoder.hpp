@@ -0,0 +1,59 @@
+#ifndef IEC104_TIME_ENCODER_H
+#define IEC104_TIME_ENCODER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "lib60870/iec60870_common.h"
+
+/// @brief CP56Time2a encoder caching the calendar fields (hour, day, month, year) of the current hour.
+///        Timestamps of the cached hour only need the milliseconds and the minute, the others are decomposed by
+///        lib60870 (gmtime) once per hour. The encoding is identical to CP56Time2a_createFromMsTimestamp.
+///        An instance is not thread safe, threadInstance() gives one encoder per thread.
+class IEC104TimeEncoder
+{
+public:
+    static const uint64_t MS_PER_MINUTE = 60000;
+    static const uint64_t MS_PER_HOUR = 3600000;
+
+    /// @brief Encode a timestamp (ms since epoch, UTC), the flags (IV, SU, substituted) are cleared
+    void encode(CP56Time2a dest, uint64_t timestamp)
+    {
+        uint64_t offset = timestamp - m_hourStart;
+
+        if (offset >= MS_PER_HOUR) {
+            refresh(timestamp);
+            offset = timestamp - m_hourStart;
+        }
+
+        encodeInHour(dest, static_cast<uint32_t>(offset));
+    }
+
+    /// @brief Encode an array of timestamps, the timestamps of a batch usually share the same hour
+    void encode(const uint64_t* timestamps, size_t count, struct sCP56Time2a* dest);
+
+    /// @brief Encoder of the calling thread
+    static IEC104TimeEncoder& threadInstance();
+
+private:
+    void refresh(uint64_t timestamp);
+
+    void encodeInHour(CP56Time2a dest, uint32_t offset) const
+    {
+        uint32_t minute = offset / static_cast<uint32_t>(MS_PER_MINUTE);
+        uint32_t millisecond = offset - minute * static_cast<uint32_t>(MS_PER_MINUTE);
+
+        dest->encodedValue[0] = static_cast<uint8_t>(millisecond & 0xff);
+        dest->encodedValue[1] = static_cast<uint8_t>(millisecond >> 8);
+        dest->encodedValue[2] = static_cast<uint8_t>(minute);
+        dest->encodedValue[3] = m_hourFields[0];
+        dest->encodedValue[4] = m_hourFields[1];
+        dest->encodedValue[5] = m_hourFields[2];
+        dest->encodedValue[6] = m_hourFields[3];
+    }
+
+    uint64_t m_hourStart = UINT64_MAX - MS_PER_HOUR; /* no hour cached */
+    uint8_t m_hourFields[4] = {0, 0, 0, 0}; /* octets 4 to 7 of the CP56Time2a: hour, day, month, year */
+};
+
+#endif /* IEC104_TIME_ENCODER_H */
@@ -12,62 +12,131 @@
 #ifndef _IEC104_UTILITY_H
 #define _IEC104_UTILITY_H
 
+#include <atomic>
 #include <string>
 #include <logger.h>
 #include <audit_logger.h>
 
 #define PLUGIN_NAME "iec104"
 
+/*
+ * Prefix of the log messages of a function, built at compile time: LOG_PREFIX("IEC104Server::send")
+ */
+#define LOG_PREFIX(function) PLUGIN_NAME " - " function " -"
+
+/*
+ * Debug and info logs of the hot paths (per data object, per point of a response): the arguments are only
+ * evaluated when the level is enabled. Built with IEC104_STRIP_HOT_PATH_LOGS, the calls are removed entirely.
+ */
+#ifdef IEC104_STRIP_HOT_PATH_LOGS
+#define IEC104_HOT_LOG_DEBUG(...) do { if (false) Iec104Utility::log_debug(__VA_ARGS__); } while (0)
+#define IEC104_HOT_LOG_INFO(...) do { if (false) Iec104Utility::log_info(__VA_ARGS__); } while (0)
+#else
+#define IEC104_HOT_LOG_DEBUG(...) \
+    do { if (Iec104Utility::isLogEnabled(Iec104Utility::LOG_LEVEL_DEBUG)) Iec104Utility::log_debug(__VA_ARGS__); } while (0)
+#define IEC104_HOT_LOG_INFO(...) \
+    do { if (Iec104Utility::isLogEnabled(Iec104Utility::LOG_LEVEL_INFO)) Iec104Utility::log_info(__VA_ARGS__); } while (0)
+#endif
+
 namespace Iec104Utility {
 
     static const std::string PluginName = PLUGIN_NAME;
 
+    /*
+     * Minimum level of the Fledge logger, cached so that the hot paths can skip a log call before its
+     * arguments are evaluated (see IEC104_HOT_LOG_DEBUG/IEC104_HOT_LOG_INFO)
+     */
+    enum LogLevel {
+        LOG_LEVEL_DEBUG = 0,
+        LOG_LEVEL_INFO,
+        LOG_LEVEL_WARNING,
+        LOG_LEVEL_ERROR,
+        LOG_LEVEL_FATAL
+    };
+
+    inline std::atomic<int>& minLogLevel() {
+        // Everything is enabled until the first refreshLogLevel() call, Logger still filters by itself
+        static std::atomic<int> level{LOG_LEVEL_DEBUG};
+        return level;
+    }
+
+    inline bool isLogEnabled(LogLevel level) {
+        return level >= minLogLevel().load(std::memory_order_relaxed);
+    }
+
+    /*
+     * Update the cached level from the Fledge logger, the service can change it at any time
+     */
+    inline void refreshLogLevel() {
+        const std::string& levelStr = Logger::getLogger()->getMinLevel();
+        int level = LOG_LEVEL_WARNING;
+
+        if (levelStr == "debug") {
+            level = LOG_LEVEL_DEBUG;
+        }
+        else if (levelStr == "info") {
+            level = LOG_LEVEL_INFO;
+        }
+        else if (levelStr == "error") {
+            level = LOG_LEVEL_ERROR;
+        }
+        else if (levelStr == "fatal") {
+            level = LOG_LEVEL_FATAL;
+        }
+
+        minLogLevel().store(level, std::memory_order_relaxed);
+    }
+
     /*
      * Log helper function that will log both in the Fledge syslog file and in stdout for unit tests
      */
     template<class... Args>
-    void log_debug(const std::string& format, Args&&... args) {  
+    void log_debug(const char* format, Args&&... args) {
+        if (!isLogEnabled(LOG_LEVEL_DEBUG)) return;
         #ifdef UNIT_TEST
         printf(std::string(format).append("\n").c_str(), std::forward<Args>(args)...);
         fflush(stdout);
         #endif
-        Logger::getLogger()->debug(format.c_str(), std::forward<Args>(args)...);
+        Logger::getLogger()->debug(format, std::forward<Args>(args)...);
     }
 
     template<class... Args>
-    void log_info(const std::string& format, Args&&... args) {    
+    void log_info(const char* format, Args&&... args) {
+        if (!isLogEnabled(LOG_LEVEL_INFO)) return;
         #ifdef UNIT_TEST
         printf(std::string(format).append("\n").c_str(), std::forward<Args>(args)...);
         fflush(stdout);
         #endif
-        Logger::getLogger()->info(format.c_str(), std::forward<Args>(args)...);
+        Logger::getLogger()->info(format, std::forward<Args>(args)...);
     }
 
     template<class... Args>
-    void log_warn(const std::string& format, Args&&... args) { 
-        #ifdef UNIT_TEST  
+    void log_warn(const char* format, Args&&... args) {
+        if (!isLogEnabled(LOG_LEVEL_WARNING)) return;
+        #ifdef UNIT_TEST
         printf(std::string(format).append("\n").c_str(), std::forward<Args>(args)...);
         fflush(stdout);
         #endif
-        Logger::getLogger()->warn(format.c_str(), std::forward<Args>(args)...);
+        Logger::getLogger()->warn(format, std::forward<Args>(args)...);
     }
 
     template<class... Args>
-    void log_error(const std::string& format, Args&&... args) {   
+    void log_error(const char* format, Args&&... args) {
+        if (!isLogEnabled(LOG_LEVEL_ERROR)) return;
         #ifdef UNIT_TEST
         printf(std::string(format).append("\n").c_str(), std::forward<Args>(args)...);
         fflush(stdout);
         #endif
-        Logger::getLogger()->error(format.c_str(), std::forward<Args>(args)...);
+        Logger::getLogger()->error(format, std::forward<Args>(args)...);
     }
 
     template<class... Args>
-    void log_fatal(const std::string& format, Args&&... args) {  
+    void log_fatal(const char* format, Args&&... args) {
         #ifdef UNIT_TEST
         printf(std::string(format).append("\n").c_str(), std::forward<Args>(args)...);
         fflush(stdout);
         #endif
-        Logger::getLogger()->fatal(format.c_str(), std::forward<Args>(args)...);
+        Logger::getLogger()->fatal(format, std::forward<Args>(args)...);
     }
 
 
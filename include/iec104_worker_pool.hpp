@@ -0,0 +1,47 @@
+#ifndef IEC104_WORKER_POOL_H
+#define IEC104_WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief Fixed pool of worker threads running one data parallel task at a time.
+///        The range of the task is split in one contiguous chunk per worker, the calling thread processes the first
+///        chunk and waits for the others: run() returns when the whole range is processed.
+class IEC104WorkerPool
+{
+public:
+    /// @param workers number of workers including the calling thread, 1 runs the tasks on the calling thread only
+    explicit IEC104WorkerPool(int workers);
+    ~IEC104WorkerPool();
+
+    IEC104WorkerPool(const IEC104WorkerPool&) = delete;
+    IEC104WorkerPool& operator=(const IEC104WorkerPool&) = delete;
+
+    int Workers() const {return static_cast<int>(m_threads.size()) + 1;};
+
+    /// @brief Run task(first, last) on the chunks of [0, count), must not be called concurrently
+    void run(size_t count, const std::function<void(size_t, size_t)>& task);
+
+private:
+    void workerLoop(int worker);
+    void chunk(int worker, size_t& first, size_t& last) const;
+
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_lock;
+    std::condition_variable m_taskAvailable;
+    std::condition_variable m_taskDone;
+
+    const std::function<void(size_t, size_t)>* m_task = nullptr;
+    size_t m_count = 0;
+    uint64_t m_generation = 0; /* incremented for each task */
+    int m_pending = 0; /* workers that did not finish the current task */
+    bool m_stopping = false;
+};
+
+#endif /* IEC104_WORKER_POOL_H */
@@ -11,6 +11,7 @@
 #include <utils.h>
 #include <config_category.h>
 #include <reading.h>
+#include <algorithm>
 #include <string>
 
 #include <lib60870/hal_thread.h>
@@ -18,8 +19,10 @@
 
 #include "iec104.h"
 #include "iec104_utility.hpp"
+#include "iec104_conversion.hpp"
 #include "iec104_datapoint.hpp"
 #include "iec104_redgroup.hpp"
+#include "iec104_time_encoder.hpp"
 
 using namespace std;
 
@@ -32,9 +35,18 @@ static const char* conEvent2string[4] = {
     "CS104_CON_EVENT_DEACTIVATED"
 };
 
+const int IEC104Server::PARALLEL_DECODE_MIN_OBJECTS;
+const int IEC104Server::ENCODER_PACK_FLUSH_OBJECTS;
+
 IEC104Server::IEC104Server() :
     m_config(new IEC104Config())
 {
+    m_logSiteUnknownPoint = m_logLimiter.addSite(LOG_PREFIX("IEC104Server::applyDataObject"),
+                                                 "Data point not found or type not expected");
+    m_logSiteInvalidStepPos = m_logLimiter.addSite(LOG_PREFIX("IEC104Server::m_updateDataPoint"),
+                                                   "Missing or invalid step position value");
+    m_logSiteNotRunning = m_logLimiter.addSite(LOG_PREFIX("IEC104Server::send"),
+                                               "Failed to send data: server not running");
 }
 
 IEC104Server::~IEC104Server()
@@ -46,10 +58,21 @@ IEC104Server::~IEC104Server()
     delete m_config;
 }
 
+IEC104DataPoint*
+IEC104Server::m_findDataPoint(int ca, int ioa) const
+{
+    /* lookup only, the table is read concurrently by the lib60870 threads */
+    if (!m_pointTable) {
+        return nullptr;
+    }
+
+    return m_pointTable->findDataPoint(ca, ioa);
+}
+
 IEC104DataPoint*
 IEC104Server::m_getDataPoint(int ca, int ioa, int typeId)
 {
-    IEC104DataPoint* dp = m_exchangeDefinitions[ca][ioa];
+    IEC104DataPoint* dp = m_findDataPoint(ca, ioa);
 
     if (dp) {
         if (!dp->isMessageTypeMatching(typeId))
@@ -62,7 +85,7 @@ IEC104Server::m_getDataPoint(int ca, int ioa, int typeId)
 bool
 IEC104Server::createTLSConfiguration()
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::createTLSConfiguration -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::createTLSConfiguration"); //LCOV_EXCL_LINE
     TLSConfiguration tlsConfig = TLSConfiguration_create();
 
     if (tlsConfig)
@@ -73,7 +96,7 @@ IEC104Server::createTLSConfiguration()
         string certificateStorePem = getDataDir() + string("/etc/certs/pem/");
 
         if (m_config->GetOwnCertificate().empty() || m_config->GetPrivateKey().empty()) {
-            Iec104Utility::log_error("%s No private key and/or certificate configured for client", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_error("%s No private key and/or certificate configured for client", beforeLog); //LCOV_EXCL_LINE
             tlsConfigOk = false;
         }
 
@@ -93,16 +116,16 @@ IEC104Server::createTLSConfiguration()
             if (access(ownCertFile.c_str(), R_OK) == 0) {
 
                 if (TLSConfiguration_setOwnCertificateFromFile(tlsConfig, ownCertFile.c_str()) == false) {
-                    Iec104Utility::log_error("%s Failed to load own certificate from file: %s", beforeLog.c_str(), ownCertFile.c_str()); //LCOV_EXCL_LINE
+                    Iec104Utility::log_error("%s Failed to load own certificate from file: %s", beforeLog, ownCertFile.c_str()); //LCOV_EXCL_LINE
                     tlsConfigOk = false;
                 }
                 else {
-                    Iec104Utility::log_info("%s Loaded own certificate file: %s", beforeLog.c_str(), ownCertFile.c_str()); //LCOV_EXCL_LINE
+                    Iec104Utility::log_info("%s Loaded own certificate file: %s", beforeLog, ownCertFile.c_str()); //LCOV_EXCL_LINE
                 }
 
             }
             else {
-                Iec104Utility::log_error("%s Failed to access own certificate file: %s", beforeLog.c_str(), ownCertFile.c_str()); //LCOV_EXCL_LINE
+                Iec104Utility::log_error("%s Failed to access own certificate file: %s", beforeLog, ownCertFile.c_str()); //LCOV_EXCL_LINE
                 tlsConfigOk = false;
             }
         }
@@ -114,15 +137,15 @@ IEC104Server::createTLSConfiguration()
             if (access(privateKeyFile.c_str(), R_OK) == 0) {
 
                 if (!TLSConfiguration_setOwnKeyFromFile(tlsConfig, privateKeyFile.c_str(), NULL)) {
-                    Iec104Utility::log_error("%s Failed to load private key from file: %s", beforeLog.c_str(), privateKeyFile.c_str()); //LCOV_EXCL_LINE
+                    Iec104Utility::log_error("%s Failed to load private key from file: %s", beforeLog, privateKeyFile.c_str()); //LCOV_EXCL_LINE
                     tlsConfigOk = false;
                 }
                 else {
-                    Iec104Utility::log_info("%s Loaded private key file: %s", beforeLog.c_str(), privateKeyFile.c_str()); //LCOV_EXCL_LINE
+                    Iec104Utility::log_info("%s Loaded private key file: %s", beforeLog, privateKeyFile.c_str()); //LCOV_EXCL_LINE
                 }
             }
             else {
-                Iec104Utility::log_error("%s Failed to access private key file: %s", beforeLog.c_str(), privateKeyFile.c_str()); //LCOV_EXCL_LINE
+                Iec104Utility::log_error("%s Failed to access private key file: %s", beforeLog, privateKeyFile.c_str()); //LCOV_EXCL_LINE
                 tlsConfigOk = false;
             }
         }
@@ -144,21 +167,21 @@ IEC104Server::createTLSConfiguration()
                 if (access(remoteCertFile.c_str(), R_OK) == 0) {
                     if (!TLSConfiguration_addAllowedCertificateFromFile(tlsConfig, remoteCertFile.c_str())) {
                         Iec104Utility::log_warn("%s Failed to load remote certificate file: %s -> ignore certificate", //LCOV_EXCL_LINE
-                                                beforeLog.c_str(), remoteCertFile.c_str()); //LCOV_EXCL_LINE
+                                                beforeLog, remoteCertFile.c_str()); //LCOV_EXCL_LINE
                     }
                     else {
-                        Iec104Utility::log_info("%s Allowed remote certificate file: %s", beforeLog.c_str(), remoteCertFile.c_str()); //LCOV_EXCL_LINE
+                        Iec104Utility::log_info("%s Allowed remote certificate file: %s", beforeLog, remoteCertFile.c_str()); //LCOV_EXCL_LINE
                     }
                 }
                 else {
-                    Iec104Utility::log_warn("%s Failed to access remote certificate file: %s -> ignore certificate", beforeLog.c_str(), //LCOV_EXCL_LINE
+                    Iec104Utility::log_warn("%s Failed to access remote certificate file: %s -> ignore certificate", beforeLog, //LCOV_EXCL_LINE
                                             remoteCertFile.c_str()); //LCOV_EXCL_LINE
                 }
 
             }
         }
         else {
-            Iec104Utility::log_info("%s Allowed unknown certificates", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_info("%s Allowed unknown certificates", beforeLog); //LCOV_EXCL_LINE
             TLSConfiguration_setAllowOnlyKnownCertificates(tlsConfig, false);
         }
 
@@ -178,31 +201,31 @@ IEC104Server::createTLSConfiguration()
 
                 if (access(caCertFile.c_str(), R_OK) == 0) {
                     if (!TLSConfiguration_addCACertificateFromFile(tlsConfig, caCertFile.c_str())) {
-                        Iec104Utility::log_warn("%s Failed to load CA certificate file: %s -> ignore certificate", beforeLog.c_str(), //LCOV_EXCL_LINE
+                        Iec104Utility::log_warn("%s Failed to load CA certificate file: %s -> ignore certificate", beforeLog, //LCOV_EXCL_LINE
                                                 caCertFile.c_str()); //LCOV_EXCL_LINE
                     }
                     else {
-                        Iec104Utility::log_info("%s Allowed CA certificate file: %s", beforeLog.c_str(), caCertFile.c_str()); //LCOV_EXCL_LINE
+                        Iec104Utility::log_info("%s Allowed CA certificate file: %s", beforeLog, caCertFile.c_str()); //LCOV_EXCL_LINE
                     }
                 }
                 else {
-                    Iec104Utility::log_warn("%s Failed to access CA certificate file: %s -> ignore certificate", beforeLog.c_str(), //LCOV_EXCL_LINE
+                    Iec104Utility::log_warn("%s Failed to access CA certificate file: %s -> ignore certificate", beforeLog, //LCOV_EXCL_LINE
                                             caCertFile.c_str()); //LCOV_EXCL_LINE
                 }
 
             }
         }
         else {
-            Iec104Utility::log_info("%s Disabled chain validation", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_info("%s Disabled chain validation", beforeLog); //LCOV_EXCL_LINE
             TLSConfiguration_setChainValidation(tlsConfig, false);
         }
 
         if (tlsConfigOk) {
-            Iec104Utility::log_info("%s TLS configuration complete", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_info("%s TLS configuration complete", beforeLog); //LCOV_EXCL_LINE
             m_tlsConfig = tlsConfig;
         }
         else {
-            Iec104Utility::log_error("%s Error during TLS configuration -> abort", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_error("%s Error during TLS configuration -> abort", beforeLog); //LCOV_EXCL_LINE
             TLSConfiguration_destroy(tlsConfig);
             m_tlsConfig = nullptr;
         }
@@ -210,7 +233,7 @@ IEC104Server::createTLSConfiguration()
         return tlsConfigOk;
     }
     else {
-        Iec104Utility::log_fatal("%s Failed to create TLS configuration", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_fatal("%s Failed to create TLS configuration", beforeLog); //LCOV_EXCL_LINE
         return false;
     }
 }
@@ -220,12 +243,35 @@ IEC104Server::setJsonConfig(const std::string& stackConfig,
                                 const std::string& dataExchangeConfig,
                                 const std::string& tlsConfig)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::setJsonConfig -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::setJsonConfig"); //LCOV_EXCL_LINE
+    m_appliedStackConfig = stackConfig;
+    m_appliedExchangeConfig = dataExchangeConfig;
+    m_appliedTlsConfig = tlsConfig;
+
     m_config->importExchangeConfig(dataExchangeConfig);
     m_config->importProtocolConfig(stackConfig);
     m_config->importTlsConfig(tlsConfig);
 
-    m_exchangeDefinitions = *m_config->getExchangeDefinitions();
+    /* shared with the configuration, not copied */
+    m_pointTable = m_config->getPointTable();
+    m_counters.configure(m_pointTable->Definitions());
+
+    if (m_config->EncoderQueueSize() > 0) {
+        m_encoderQueue.reset(new IEC104SpscRing<DecodedDataObject>(m_config->EncoderQueueSize()));
+    }
+    else {
+        m_encoderQueue.reset();
+    }
+
+    if (m_config->DecodeWorkers() > 1) {
+        m_decodePool.reset(new IEC104WorkerPool(m_config->DecodeWorkers()));
+    }
+    else {
+        m_decodePool.reset();
+    }
+
+    m_connRateLimiter.configure(m_config->ConnRateLimit(), m_config->ConnRateBurst());
+    m_statistics.setWindowSize(m_config->K());
 
     if (m_config->UseTLS()) {
         if (createTLSConfiguration()) {
@@ -240,12 +286,12 @@ IEC104Server::setJsonConfig(const std::string& stackConfig,
     {
         CS104_Slave_setLocalPort(m_slave, m_config->TcpPort());
 
-        Iec104Utility::log_info("%s TCP/IP parameters:", beforeLog.c_str());//LCOV_EXCL_LINE
-        Iec104Utility::log_info("%s  TCP port: %i", beforeLog.c_str(), m_config->TcpPort());//LCOV_EXCL_LINE
+        Iec104Utility::log_info("%s TCP/IP parameters:", beforeLog);//LCOV_EXCL_LINE
+        Iec104Utility::log_info("%s  TCP port: %i", beforeLog, m_config->TcpPort());//LCOV_EXCL_LINE
 
         if (m_config->bindOnIp()) {
             CS104_Slave_setLocalAddress(m_slave, m_config->GetLocalIP());
-            Iec104Utility::log_info("%s  IP address: %s", beforeLog.c_str(), m_config->GetLocalIP());//LCOV_EXCL_LINE
+            Iec104Utility::log_info("%s  IP address: %s", beforeLog, m_config->GetLocalIP());//LCOV_EXCL_LINE
         }
 
         CS104_APCIParameters apciParams = CS104_Slave_getConnectionParameters(m_slave);
@@ -257,13 +303,13 @@ IEC104Server::setJsonConfig(const std::string& stackConfig,
         apciParams->t2 = m_config->T2();
         apciParams->t3 = m_config->T3();
 
-        Iec104Utility::log_info("%s APCI parameters:", beforeLog.c_str()); //LCOV_EXCL_LINE
-        Iec104Utility::log_info("%s  t0: %i", beforeLog.c_str(), apciParams->t0);//LCOV_EXCL_LINE
-        Iec104Utility::log_info("%s  t1: %i", beforeLog.c_str(), apciParams->t1);//LCOV_EXCL_LINE
-        Iec104Utility::log_info("%s  t2: %i", beforeLog.c_str(), apciParams->t2);//LCOV_EXCL_LINE
-        Iec104Utility::log_info("%s  t3: %i", beforeLog.c_str(), apciParams->t3);//LCOV_EXCL_LINE
-        Iec104Utility::log_info("%s  k: %i", beforeLog.c_str(), apciParams->k);//LCOV_EXCL_LINE
-        Iec104Utility::log_info("%s  w: %i", beforeLog.c_str(), apciParams->w);//LCOV_EXCL_LINE
+        Iec104Utility::log_info("%s APCI parameters:", beforeLog); //LCOV_EXCL_LINE
+        Iec104Utility::log_info("%s  t0: %i", beforeLog, apciParams->t0);//LCOV_EXCL_LINE
+        Iec104Utility::log_info("%s  t1: %i", beforeLog, apciParams->t1);//LCOV_EXCL_LINE
+        Iec104Utility::log_info("%s  t2: %i", beforeLog, apciParams->t2);//LCOV_EXCL_LINE
+        Iec104Utility::log_info("%s  t3: %i", beforeLog, apciParams->t3);//LCOV_EXCL_LINE
+        Iec104Utility::log_info("%s  k: %i", beforeLog, apciParams->k);//LCOV_EXCL_LINE
+        Iec104Utility::log_info("%s  w: %i", beforeLog, apciParams->w);//LCOV_EXCL_LINE
 
         CS101_AppLayerParameters appLayerParams = CS104_Slave_getAppLayerParameters(m_slave);
 
@@ -275,12 +321,24 @@ IEC104Server::setJsonConfig(const std::string& stackConfig,
         appLayerParams->sizeOfCA = m_config->CaSize();
         appLayerParams->sizeOfIOA = m_config->IOASize();
 
+        m_cyclicScheduler.configure(m_pointTable->Definitions(), appLayerParams->maxSizeOfASDU, appLayerParams->sizeOfCA,
+                                    appLayerParams->sizeOfIOA);
+
+        m_backgroundScan.configure(m_pointTable->Definitions(), m_config->BkgScanRate(), appLayerParams->maxSizeOfASDU,
+                                   appLayerParams->sizeOfCA, appLayerParams->sizeOfIOA);
+
         /* set the callback handler for the clock synchronization command */
         CS104_Slave_setClockSyncHandler(m_slave, clockSyncHandler, this);
 
         /* set the callback handler for the interrogation command */
         CS104_Slave_setInterrogationHandler(m_slave, interrogationHandler, this);
 
+        /* set the callback handler for the counter interrogation command */
+        CS104_Slave_setCounterInterrogationHandler(m_slave, counterInterrogationHandler, this);
+
+        /* set the callback handler for the read command */
+        CS104_Slave_setReadHandler(m_slave, readHandler, this);
+
         /* set handler for other message types */
         CS104_Slave_setASDUHandler(m_slave, asduHandler, this);
 
@@ -290,31 +348,35 @@ IEC104Server::setJsonConfig(const std::string& stackConfig,
         /* set handler to track connection events */
         CS104_Slave_setConnectionEventHandler(m_slave, connectionEventHandler, this);
 
+        /* set handler to capture raw messages */
+        CS104_Slave_setRawMessageHandler(m_slave, rawMessageHandler, this);
+        m_capture.setServerEndpoint(m_config->bindOnIp() ? m_config->GetLocalIP() : "0.0.0.0", m_config->TcpPort());
+
 
         const auto& redGroups = m_config->RedundancyGroups();
         if (redGroups.empty()) {
-            Iec104Utility::log_info("%s Activating single redundancy group mode", beforeLog.c_str());//LCOV_EXCL_LINE
+            Iec104Utility::log_info("%s Activating single redundancy group mode", beforeLog);//LCOV_EXCL_LINE
             CS104_Slave_setServerMode(m_slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
         }
         else {
-            Iec104Utility::log_info("%s Activating multiple redundancy groups mode (%d groups configured)", beforeLog.c_str(), redGroups.size());//LCOV_EXCL_LINE
+            Iec104Utility::log_info("%s Activating multiple redundancy groups mode (%d groups configured)", beforeLog, redGroups.size());//LCOV_EXCL_LINE
             CS104_Slave_setServerMode(m_slave, CS104_MODE_MULTIPLE_REDUNDANCY_GROUPS);
 
             for (const auto& redGroup : redGroups) {
                 CS104_Slave_addRedundancyGroup(m_slave, redGroup->CS104RedGroup());
             }
         }
-        Iec104Utility::log_info("%s CS104 server initialized", beforeLog.c_str());//LCOV_EXCL_LINE
+        Iec104Utility::log_info("%s CS104 server initialized", beforeLog);//LCOV_EXCL_LINE
     }
     else {
-        Iec104Utility::log_error("%s Failed to create CS104 server instance", beforeLog.c_str());//LCOV_EXCL_LINE
+        Iec104Utility::log_error("%s Failed to create CS104 server instance", beforeLog);//LCOV_EXCL_LINE
     }
 }
 
 void
 IEC104Server::sendInitialAudits()
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::sendInitialAudits -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::sendInitialAudits"); //LCOV_EXCL_LINE
     const auto& redGroups = m_config->RedundancyGroups();
 
     auto configuredRedGroups = static_cast<int>(redGroups.size());
@@ -359,18 +421,18 @@ IEC104Server::sendInitialAudits()
         const auto& connections = redGroup->Connections();
         for (int j = 0; j < connections.size(); j++) {
             auto connection = connections[j];
-            Iec104Utility::log_debug("%s Found redundancy group %d - Connection %d: %s : %s", beforeLog.c_str(), i, j, connection->ClientIP().c_str(), connection->Port().c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_debug("%s Found redundancy group %d - Connection %d: %s : %d", beforeLog, i, j, connection->ClientIP().c_str(), connection->Port()); //LCOV_EXCL_LINE
         }
     }
 }
 
 bool
 IEC104Server::isAnyConnectionEstablished() {
-    auto allRedGroups = Config()->RedundancyGroups();
-    for (auto redGroup : allRedGroups) {
-        auto redGroupConnections = redGroup->Connections();
-        for (auto redGroupConnection : redGroupConnections) {
-            if(!redGroupConnection->Port().empty()){
+    const auto& allRedGroups = Config()->RedundancyGroups();
+    for (const auto& redGroup : allRedGroups) {
+        const auto& redGroupConnections = redGroup->Connections();
+        for (const auto& redGroupConnection : redGroupConnections) {
+            if(redGroupConnection->Port() != 0){
                 return true;
             }
         }
@@ -380,14 +442,23 @@ IEC104Server::isAnyConnectionEstablished() {
 
 bool
 IEC104Server::startSlave(){
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::startSlave -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::startSlave"); //LCOV_EXCL_LINE
     if (!m_slave) {
-        Iec104Utility::log_error("%s CS104 server instance not available, cannot start monitoring thread", beforeLog.c_str());//LCOV_EXCL_LINE
+        Iec104Utility::log_error("%s CS104 server instance not available, cannot start monitoring thread", beforeLog);//LCOV_EXCL_LINE
         return false;
     }
+    Iec104Utility::refreshLogLevel();
     sendInitialAudits();
     m_started = true;
     m_monitoringThread = new std::thread(&IEC104Server::_monitoringThread, this);
+
+    if (m_encoderQueue && (m_encoderThread == nullptr)) {
+        m_encoderPushed = 0;
+        m_encoderDrained.store(0, std::memory_order_relaxed);
+        m_encoderRunning.store(true, std::memory_order_release);
+        m_encoderThread = new std::thread(&IEC104Server::_encoderThread, this);
+    }
+
     return true;
 }
 
@@ -398,16 +469,16 @@ IEC104Server::startSlave(){
 void
 IEC104Server::configure(const ConfigCategory* config)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::configure -"; //LCOV_EXCL_LINE
-    Iec104Utility::log_info("%s configure called", beforeLog.c_str());//LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::configure"); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s configure called", beforeLog);//LCOV_EXCL_LINE
 
     if (!config->itemExists("protocol_stack")) {
-        Iec104Utility::log_error("%s Missing protocol_stack configuration", beforeLog.c_str());//LCOV_EXCL_LINE
+        Iec104Utility::log_error("%s Missing protocol_stack configuration", beforeLog);//LCOV_EXCL_LINE
         return;
     }
 
     if (!config->itemExists("exchanged_data")) {
-        Iec104Utility::log_error("%s Missing exchanged_data configuration", beforeLog.c_str());//LCOV_EXCL_LINE
+        Iec104Utility::log_error("%s Missing exchanged_data configuration", beforeLog);//LCOV_EXCL_LINE
         return;
     }
 
@@ -418,23 +489,188 @@ IEC104Server::configure(const ConfigCategory* config)
     std::string tlsConfig = "";
 
     if (!config->itemExists("tls_conf")) {
-        Iec104Utility::log_error("%s Missing tls_conf configuration", beforeLog.c_str());//LCOV_EXCL_LINE
+        Iec104Utility::log_error("%s Missing tls_conf configuration", beforeLog);//LCOV_EXCL_LINE
     }
     else {
         tlsConfig = config->getValue("tls_conf");
     }
 
     setJsonConfig(protocolStack, dataExchange, tlsConfig);
+
+    if (config->itemExists("diagnostics")) {
+        setDiagnosticsConfig(config->getValue("diagnostics"));
+    }
+}
+
+/**
+ * Apply a configuration change while the plugin is running.
+ * Only the diagnostics settings can be changed without restarting the service, a change of the other items is
+ * reported as an error and the running configuration is kept.
+ *
+ * @param conf	Fledge configuration category
+ */
+void
+IEC104Server::reconfigure(const ConfigCategory* config)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Server::reconfigure"); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s reconfigure called", beforeLog);//LCOV_EXCL_LINE
+
+    const struct {
+        const char* item;
+        const std::string& applied;
+    } restartItems[] = {
+        {"protocol_stack", m_appliedStackConfig},
+        {"exchanged_data", m_appliedExchangeConfig},
+        {"tls_conf", m_appliedTlsConfig}
+    };
+
+    for (const auto& restartItem : restartItems) {
+        std::string value = config->itemExists(restartItem.item) ? config->getValue(restartItem.item) : "";
+
+        if (value != restartItem.applied) {
+            Iec104Utility::log_error("%s %s changed -> not applied, the service must be restarted", beforeLog, //LCOV_EXCL_LINE
+                                     restartItem.item); //LCOV_EXCL_LINE
+        }
+    }
+
+    if (config->itemExists("diagnostics")) {
+        setDiagnosticsConfig(config->getValue("diagnostics"));
+    }
+}
+
+void
+IEC104Server::setDiagnosticsConfig(const std::string& diagnosticsConfig)
+{
+    m_config->importDiagnosticsConfig(diagnosticsConfig);
+
+    std::string defaultCapturePath = getDataDir() + "/logs/" + m_service_name + "_iec104.pcapng";
+    m_capture.configure(m_config->CaptureSettings(), defaultCapturePath);
+
+    std::shared_ptr<const IEC104DiagnosticsSettings> settings = m_config->DiagnosticsSettings();
+
+    m_statistics.setEnabled(settings->statisticsEnabled);
+
+    if (settings->latencyTracing != m_latencyTracer.isEnabled()) {
+        m_latencyTracer.reset();
+        m_latencyTracer.setEnabled(settings->latencyTracing);
+    }
+}
+
+/**
+ * Check if a periodic diagnostic is due, the first period starts when the diagnostic is enabled
+ *
+ * @param nextPublication	time of the next publication in ms, 0 when not scheduled yet
+ * @param period	        publication period in s
+ * @param currentTime	    current time in ms
+ * @return 		            true when the diagnostic has to be published
+ */
+static bool
+isPublicationDue(uint64_t& nextPublication, int period, uint64_t currentTime)
+{
+    uint64_t periodInMs = static_cast<uint64_t>(period) * 1000;
+
+    if (nextPublication == 0) {
+        nextPublication = currentTime + periodInMs;
+        return false;
+    }
+
+    if (currentTime < nextPublication) {
+        return false;
+    }
+
+    nextPublication = currentTime + periodInMs;
+
+    return true;
+}
+
+void
+IEC104Server::publishDiagnostic(const std::string& diagnostic, const std::string& auditCode)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Server::publishDiagnostic"); //LCOV_EXCL_LINE
+
+    Iec104Utility::log_info("%s %s", beforeLog, diagnostic.c_str()); //LCOV_EXCL_LINE
+
+    if (!auditCode.empty()) {
+        Iec104Utility::audit_info(auditCode, diagnostic, false);
+    }
+}
+
+int
+IEC104Server::queueDepth()
+{
+    const auto& redGroups = m_config->RedundancyGroups();
+    int depth = 0;
+
+    if (redGroups.empty()) {
+        depth = CS104_Slave_getNumberOfQueueEntries(m_slave, NULL);
+    }
+    else {
+        /* each redundancy group has its own queue, the fullest one is reported */
+        for (const auto& redGroup : redGroups) {
+            int groupDepth = CS104_Slave_getNumberOfQueueEntries(m_slave, redGroup->CS104RedGroup());
+
+            if (groupDepth > depth) {
+                depth = groupDepth;
+            }
+        }
+    }
+
+    return depth;
+}
+
+void
+IEC104Server::sampleQueueDepth()
+{
+    m_statistics.sampleQueueDepth(queueDepth(), m_config->AsduQueueSize());
+}
+
+void
+IEC104Server::publishDiagnostics(uint64_t currentTime)
+{
+    /* one snapshot per iteration, the settings can be replaced by reconfigure() meanwhile */
+    std::shared_ptr<const IEC104DiagnosticsSettings> settings = m_config->DiagnosticsSettings();
+
+    if (m_latencyTracer.isEnabled()) {
+        if (isPublicationDue(m_nextLatencyPublication, settings->latencyPeriod, currentTime)) {
+            /* histograms cover one publication period */
+            std::string latency = std::string("{\"latency\":") + m_latencyTracer.toJson() + "}";
+            m_latencyTracer.reset();
+
+            publishDiagnostic(latency, settings->auditCode);
+        }
+    }
+    else {
+        m_nextLatencyPublication = 0;
+    }
+
+    if (settings->statisticsEnabled) {
+        sampleQueueDepth();
+
+        if (m_nextStatisticsPublication == 0) {
+            m_lastStatisticsPublication = currentTime;
+        }
+
+        if (isPublicationDue(m_nextStatisticsPublication, settings->statisticsPeriod, currentTime)) {
+            std::string statistics = std::string("{\"statistics\":") +
+                                     m_statistics.toJson(currentTime - m_lastStatisticsPublication) + "}";
+            m_lastStatisticsPublication = currentTime;
+
+            publishDiagnostic(statistics, settings->auditCode);
+        }
+    }
+    else {
+        m_nextStatisticsPublication = 0;
+    }
 }
 
 void
 IEC104Server::registerControl(int (* operation)(char *operation, int paramCount, char *names[], char *parameters[], ControlDestination destination, ...))
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::registerControl -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::registerControl"); //LCOV_EXCL_LINE
 
     m_oper = operation;
 
-    Iec104Utility::log_warn("%s New operation callback registered", beforeLog.c_str());//LCOV_EXCL_LINE
+    Iec104Utility::log_warn("%s New operation callback registered", beforeLog);//LCOV_EXCL_LINE
 }
 
 // Utility function for logging
@@ -455,19 +691,19 @@ static std::string paramsToStr(char** params, int count) {
 int
 IEC104Server::operation(char *operation, int paramCount, char *names[], char *parameters[])
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::operation -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::operation"); //LCOV_EXCL_LINE
     std::string namesStr = paramsToStr(names, paramCount);
     std::string paramsStr = paramsToStr(parameters, paramCount);
     Iec104Utility::log_info("%s Sending operation: {type: \"%s\", nbParams=%d, names=%s, parameters=%s, cmdDest=\"%s\"}", //LCOV_EXCL_LINE
-                            beforeLog.c_str(), operation, paramCount, namesStr.c_str(), paramsStr.c_str(), m_config->CmdDest().c_str()); //LCOV_EXCL_LINE
+                            beforeLog, operation, paramCount, namesStr.c_str(), paramsStr.c_str(), m_config->CmdDest().c_str()); //LCOV_EXCL_LINE
    
     if (m_oper == nullptr) {
         Iec104Utility::log_error("%s No operation callback available -> abort (registerControl must be called first)", //LCOV_EXCL_LINE
-                                beforeLog.c_str()); //LCOV_EXCL_LINE
+                                beforeLog); //LCOV_EXCL_LINE
         return -1;
     }
     if (m_config == nullptr) {
-        Iec104Utility::log_error("%s No config available -> abort", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_error("%s No config available -> abort", beforeLog); //LCOV_EXCL_LINE
         return -1;
     }
 
@@ -478,16 +714,16 @@ IEC104Server::operation(char *operation, int paramCount, char *names[], char *pa
     else {
         res = m_oper(operation, paramCount, names, parameters, DestinationService, m_config->CmdDest().c_str());
     }
-    Iec104Utility::log_debug("%s Operation returned %d", beforeLog.c_str(), res); //LCOV_EXCL_LINE
+    Iec104Utility::log_debug("%s Operation returned %d", beforeLog, res); //LCOV_EXCL_LINE
     return res;
 }
 
 bool
 IEC104Server::requestSouthConnectionStatus()
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::requestSouthConnectionStatus -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::requestSouthConnectionStatus"); //LCOV_EXCL_LINE
 
-    Iec104Utility::log_info("%s Send request_connection_status operation", beforeLog.c_str());//LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s Send request_connection_status operation", beforeLog);//LCOV_EXCL_LINE
 
     char* parameters[1];
     char* names[1];
@@ -504,9 +740,9 @@ IEC104Server::requestSouthConnectionStatus()
 void
 IEC104Server::_monitoringThread()
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::_monitoringThread -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::_monitoringThread"); //LCOV_EXCL_LINE
     bool southStatusRequested = false;
-    Iec104Utility::log_warn("%s Monitoring thread called", beforeLog.c_str()); //LCOV_EXCL_LINE
+    Iec104Utility::log_warn("%s Monitoring thread called", beforeLog); //LCOV_EXCL_LINE
 
     bool serverRunning = false;
 
@@ -519,7 +755,7 @@ IEC104Server::_monitoringThread()
         if (m_config->GetMode() == IEC104Config::Mode::CONNECT_ALWAYS) {
             if (serverRunning == false) {
                 CS104_Slave_start(m_slave);
-                Iec104Utility::log_info("%s Server started - mode: CONNECT_ALWAYS", beforeLog.c_str());//LCOV_EXCL_LINE
+                Iec104Utility::log_info("%s Server started - mode: CONNECT_ALWAYS", beforeLog);//LCOV_EXCL_LINE
                 serverRunning = true;//LCOV_EXCL_LINE
             }
         }
@@ -527,7 +763,7 @@ IEC104Server::_monitoringThread()
             if (serverRunning == false) {
 
                 if (checkIfSouthConnected()) {
-                    Iec104Utility::log_info("%s Server started - mode: CONNECT_IF_SOUTH_CONNX_STARTED", beforeLog.c_str());//LCOV_EXCL_LINE
+                    Iec104Utility::log_info("%s Server started - mode: CONNECT_IF_SOUTH_CONNX_STARTED", beforeLog);//LCOV_EXCL_LINE
                     CS104_Slave_start(m_slave);
                     serverRunning = true;//LCOV_EXCL_LINE
                 }
@@ -542,7 +778,7 @@ IEC104Server::_monitoringThread()
                 }
 
                 if (checkIfSouthConnected() == false) {
-                    Iec104Utility::log_info("%s Server stopped - mode: CONNECT_IF_SOUTH_CONNX_STARTED", beforeLog.c_str());//LCOV_EXCL_LINE
+                    Iec104Utility::log_info("%s Server stopped - mode: CONNECT_IF_SOUTH_CONNX_STARTED", beforeLog);//LCOV_EXCL_LINE
                     CS104_Slave_stop(m_slave);
                     serverRunning = false;//LCOV_EXCL_LINE
                     m_initSocketFinished = false;
@@ -562,9 +798,9 @@ IEC104Server::_monitoringThread()
             IEC104OutstandingCommand* outstandingCommand = *it;
 
             if (outstandingCommand->hasTimedOut(currentTime)) {
-                Iec104Utility::log_warn("%s command %i:%i (type: %s) timeout", beforeLog.c_str(), outstandingCommand->CA(), //LCOV_EXCL_LINE
+                Iec104Utility::log_warn("%s command %i:%i (type: %s) timeout", beforeLog, outstandingCommand->CA(), //LCOV_EXCL_LINE
                                         outstandingCommand->IOA(), //LCOV_EXCL_LINE
-                                        IEC104DataPoint::getStringFromTypeID(outstandingCommand->TypeId()).c_str()); //LCOV_EXCL_LINE
+                                        IEC104DataPoint::getStringFromTypeID(outstandingCommand->TypeId())); //LCOV_EXCL_LINE
 
                 it = m_outstandingCommands.erase(it);
 
@@ -577,6 +813,16 @@ IEC104Server::_monitoringThread()
 
         m_outstandingCommandsLock.unlock();
 
+        sendCyclicData(currentTime);
+
+        sendBackgroundScan(currentTime);
+
+        publishDiagnostics(currentTime);
+
+        m_logLimiter.summarize(currentTime);
+
+        Iec104Utility::refreshLogLevel();
+
         Thread_sleep(100);
     }
 
@@ -586,6 +832,56 @@ IEC104Server::_monitoringThread()
     }
 }
 
+void
+IEC104Server::sendCyclicData(uint64_t currentTime)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Server::sendCyclicData"); //LCOV_EXCL_LINE
+
+    std::vector<const IEC104CyclicScheduler::Batch*> due;
+
+    m_cyclicScheduler.advance(currentTime, due);
+
+    /* paused while no master is connected, the values would be outdated when a master connects */
+    if (due.empty() || (CS104_Slave_getOpenConnections(m_slave) == 0)) {
+        return;
+    }
+
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(m_slave);
+
+    for (const IEC104CyclicScheduler::Batch* batch : due) {
+        IEC104_HOT_LOG_DEBUG("%s Sending %i cyclic data points of CA %i", beforeLog, //LCOV_EXCL_LINE
+                            static_cast<int>(batch->points.size()), batch->ca); //LCOV_EXCL_LINE
+        m_sendDataPoints(batch->points, CS101_COT_PERIODIC, 0, batch->ca, alParams, nullptr);
+    }
+}
+
+void
+IEC104Server::sendBackgroundScan(uint64_t currentTime)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Server::sendBackgroundScan"); //LCOV_EXCL_LINE
+
+    if (!m_backgroundScan.isEnabled()) {
+        return;
+    }
+
+    m_backgroundScan.refill(currentTime);
+
+    /* the background scan yields to the spontaneous and periodic data: it is only fed into an empty queue */
+    if ((CS104_Slave_getOpenConnections(m_slave) == 0) || (queueDepth() > 0)) {
+        return;
+    }
+
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(m_slave);
+
+    std::vector<IEC104DataPoint*> batch;
+
+    while (m_backgroundScan.nextBatch(batch)) {
+        IEC104_HOT_LOG_DEBUG("%s Sending %i background scan data points of CA %i", beforeLog, //LCOV_EXCL_LINE
+                            static_cast<int>(batch.size()), batch.front()->m_ca); //LCOV_EXCL_LINE
+        m_sendDataPoints(batch, CS101_COT_BACKGROUND_SCAN, 0, batch.front()->m_ca, alParams, nullptr);
+    }
+}
+
 static void
 setTimestamp(CP56Time2a destTime, CP56Time2a srcTime)
 {
@@ -593,117 +889,150 @@ setTimestamp(CP56Time2a destTime, CP56Time2a srcTime)
         memcpy(destTime, srcTime, sizeof(struct sCP56Time2a));
     }
     else {
-        CP56Time2a_createFromMsTimestamp(destTime, Hal_getTimeInMs());
+        IEC104TimeEncoder::threadInstance().encode(destTime, Hal_getTimeInMs());
     }
 }
 
+/* the CP24Time2a time tag is encoded as the first three octets of CP56Time2a (milliseconds, minutes and IV),
+ * the hours and the date are given to the masters by the clock synchronization */
+static void
+toCP24Time2a(CP24Time2a destTime, const struct sCP56Time2a* srcTime)
+{
+    memcpy(destTime->encodedValue, srcTime->encodedValue, sizeof(destTime->encodedValue));
+}
+
 void
-IEC104Server::m_updateDataPoint(IEC104DataPoint* dp, IEC60870_5_TypeID typeId, DatapointValue* value, CP56Time2a ts, uint8_t quality)
+IEC104Server::m_updateDataPoint(IEC104DataPoint* dp, IEC60870_5_TypeID typeId, const DecodedDataObject& decoded, CP56Time2a ts)
 {
+    const char* beforeLog = LOG_PREFIX("IEC104Server::m_updateDataPoint"); //LCOV_EXCL_LINE
+    uint8_t quality = decoded.qd;
+
     switch (typeId) {
         case M_SP_NA_1:
+        case M_SP_TA_1:
         case M_SP_TB_1:
             {
-                if (value && (value->getType() == DatapointValue::dataTagType::T_INTEGER)) {
-                    dp->m_value.sp.value = (unsigned int)value->toInt();
+                if (decoded.hasInteger) {
+                    dp->m_value->sp.value = (unsigned int)decoded.integerValue;
                 }
 
-                dp->m_value.sp.quality = quality;
+                dp->m_value->sp.quality = quality;
 
-                if (typeId == M_SP_TB_1) {
-                    setTimestamp(&(dp->m_ts), ts);
+                if ((typeId == M_SP_TA_1) || (typeId == M_SP_TB_1)) {
+                    setTimestamp(dp->m_ts, ts);
                 }
             }
 
             break;//LCOV_EXCL_LINE
 
         case M_DP_NA_1:
+        case M_DP_TA_1:
         case M_DP_TB_1:
             {
-                if (value && (value->getType() == DatapointValue::dataTagType::T_INTEGER)) {
-                    dp->m_value.dp.value = (unsigned int)value->toInt();
+                if (decoded.hasInteger) {
+                    dp->m_value->dp.value = (unsigned int)decoded.integerValue;
                 }
 
-                dp->m_value.dp.quality = quality;
+                dp->m_value->dp.quality = quality;
 
-                if (typeId == M_DP_TB_1) {
-                    setTimestamp(&(dp->m_ts), ts);
+                if ((typeId == M_DP_TA_1) || (typeId == M_DP_TB_1)) {
+                    setTimestamp(dp->m_ts, ts);
                 }
             }
 
             break;//LCOV_EXCL_LINE
 
         case M_ST_NA_1:
+        case M_ST_TA_1:
         case M_ST_TB_1:
             {
-                if (value && (value->getType() == DatapointValue::dataTagType::T_STRING)) {
-                    int wtrVal;
-                    int transInd;
-                    std::string str = value->toStringValue();
-                    std::string cleaned_str = str.substr(1, str.length() - 2);
-                    std::size_t commaPos = cleaned_str.find(',');
-                    if(commaPos != std::string::npos) {
-                        std::string numStr = cleaned_str.substr(0, commaPos);
-                        std::string boolStr = cleaned_str.substr(commaPos+1);
-                        wtrVal = std::stoi(numStr);
-                        transInd = (boolStr == "true");
-                        dp->m_value.stepPos.posValue = (int)(wtrVal);
-                        dp->m_value.stepPos.transient = (unsigned int)(transInd);
-                    }
+                /* parsed by the decoder, the do_value is not copied */
+                if (decoded.hasStepPos) {
+                    dp->m_value->stepPos.posValue = decoded.stepPosValue;
+                    dp->m_value->stepPos.transient = decoded.stepPosTransient ? 1 : 0;
+                }
+                else if (m_logLimiter.accept(m_logSiteInvalidStepPos, dp->m_ca, dp->m_ioa)) {
+                    Iec104Utility::log_warn("%s Data point %i:%i - missing or invalid step position value -> value unchanged", //LCOV_EXCL_LINE
+                                            beforeLog, dp->m_ca, dp->m_ioa); //LCOV_EXCL_LINE
                 }
 
-                dp->m_value.stepPos.quality = quality;
+                dp->m_value->stepPos.quality = quality;
 
-                if (typeId == M_ST_TB_1) {
-                    setTimestamp(&(dp->m_ts), ts);
+                if ((typeId == M_ST_TA_1) || (typeId == M_ST_TB_1)) {
+                    setTimestamp(dp->m_ts, ts);
                 }
             }
             break;//LCOV_EXCL_LINE
 
         case M_ME_NA_1: /* normalized value */
+        case M_ME_TA_1:
         case M_ME_TD_1:
             {
-                if (value && (value->getType() == DatapointValue::dataTagType::T_FLOAT)) {
-                    dp->m_value.mv_normalized.value = (float)value->toDouble();
+                if (decoded.hasAnalog) {
+                    dp->m_value->mv_normalized.value = decoded.analogValue;
                 }
 
-                dp->m_value.mv_normalized.quality = quality;
+                dp->m_value->mv_normalized.quality = quality;
 
-                if (typeId == M_ME_TD_1) {
-                    setTimestamp(&(dp->m_ts), ts);
+                if ((typeId == M_ME_TA_1) || (typeId == M_ME_TD_1)) {
+                    setTimestamp(dp->m_ts, ts);
                 }
             }
 
             break;//LCOV_EXCL_LINE
 
         case M_ME_NB_1: /* scaled value */
+        case M_ME_TB_1:
         case M_ME_TE_1:
             {
-                if (value && (value->getType() == DatapointValue::dataTagType::T_INTEGER)) {
-                    dp->m_value.mv_scaled.value = (unsigned int)value->toInt();
+                if (decoded.hasAnalog) {
+                    dp->m_value->mv_scaled.value = static_cast<int16_t>(decoded.analogValue);
                 }
 
-                dp->m_value.mv_scaled.quality = quality;
+                dp->m_value->mv_scaled.quality = quality;
 
-                if (typeId == M_ME_TE_1) {
-                    setTimestamp(&(dp->m_ts), ts);
+                if ((typeId == M_ME_TB_1) || (typeId == M_ME_TE_1)) {
+                    setTimestamp(dp->m_ts, ts);
                 }
             }
 
             break;//LCOV_EXCL_LINE
 
         case M_ME_NC_1: /* short float value */
+        case M_ME_TC_1:
         case M_ME_TF_1:
             {
-                if (value && (value->getType() == DatapointValue::dataTagType::T_FLOAT)) {
-                    dp->m_value.mv_short.value = (float)value->toDouble();
+                if (decoded.hasAnalog) {
+                    dp->m_value->mv_short.value = decoded.analogValue;
+                }
+
+                dp->m_value->mv_short.quality = quality;
+
+                if ((typeId == M_ME_TC_1) || (typeId == M_ME_TF_1)) {
+                    setTimestamp(dp->m_ts, ts);
+                }
+            }
+
+            break;//LCOV_EXCL_LINE
+
+        case M_IT_NA_1: /* integrated totals */
+        case M_IT_TA_1:
+        case M_IT_TB_1:
+            {
+                if (decoded.hasInteger) {
+                    dp->m_value->counter.value = (int32_t)decoded.integerValue;
                 }
 
-                dp->m_value.mv_short.quality = quality;
+                /* the counter reading has no quality descriptor: overflow is reported as carry, substituted as adjusted */
+                dp->m_value->counter.quality.invalid = (quality & IEC60870_QUALITY_INVALID) ? 1 : 0;
+                dp->m_value->counter.quality.cy = (quality & IEC60870_QUALITY_OVERFLOW) ? 1 : 0;
+                dp->m_value->counter.quality.ca = (quality & IEC60870_QUALITY_SUBSTITUTED) ? 1 : 0;
 
-                if (typeId == M_ME_TF_1) {
-                    setTimestamp(&(dp->m_ts), ts);
+                if ((typeId == M_IT_TA_1) || (typeId == M_IT_TB_1)) {
+                    setTimestamp(dp->m_ts, ts);
                 }
+
+                m_counters.update(dp, dp->m_cp24TimeTag ? IEC104DataPoint::cp24Variant(typeId) : typeId);
             }
 
             break;//LCOV_EXCL_LINE
@@ -714,7 +1043,7 @@ IEC104Server::m_updateDataPoint(IEC104DataPoint* dp, IEC60870_5_TypeID typeId, D
 void
 IEC104Server::m_enqueueSpontDatapoint(IEC104DataPoint* dp, CS101_CauseOfTransmission cot, IEC60870_5_TypeID typeId)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::m_enqueueSpontDatapoint -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::m_enqueueSpontDatapoint"); //LCOV_EXCL_LINE
     CS101_ASDU asdu = CS101_ASDU_create(CS104_Slave_getAppLayerParameters(m_slave), false, cot, 0, dp->m_ca, false, false);
 
     if (asdu)
@@ -725,79 +1054,184 @@ IEC104Server::m_enqueueSpontDatapoint(IEC104DataPoint* dp, CS101_CauseOfTransmis
 
             case M_SP_NA_1:
                 {
-                    io = (InformationObject)SinglePointInformation_create(NULL, dp->m_ioa, dp->m_value.sp.value, dp->m_value.sp.quality);
+                    io = (InformationObject)SinglePointInformation_create(NULL, dp->m_ioa, dp->m_value->sp.value, dp->m_value->sp.quality);
                 }
                 break;//LCOV_EXCL_LINE
 
             case M_SP_TB_1:
                 {
-                    io = (InformationObject)SinglePointWithCP56Time2a_create(NULL, dp->m_ioa, dp->m_value.sp.value, dp->m_value.sp.quality, &(dp->m_ts));
+                    io = (InformationObject)SinglePointWithCP56Time2a_create(NULL, dp->m_ioa, dp->m_value->sp.value, dp->m_value->sp.quality, dp->m_ts);
+                }
+                break;//LCOV_EXCL_LINE
+
+            case M_SP_TA_1:
+                {
+                    struct sCP24Time2a ts24;
+
+                    toCP24Time2a(&ts24, dp->m_ts);
+
+                    io = (InformationObject)SinglePointWithCP24Time2a_create(NULL, dp->m_ioa, dp->m_value->sp.value, dp->m_value->sp.quality, &ts24);
                 }
                 break;//LCOV_EXCL_LINE
 
             case M_DP_NA_1:
                 {
-                    io = (InformationObject)DoublePointInformation_create(NULL, dp->m_ioa, (DoublePointValue)dp->m_value.dp.value, dp->m_value.dp.quality);
+                    io = (InformationObject)DoublePointInformation_create(NULL, dp->m_ioa, (DoublePointValue)dp->m_value->dp.value, dp->m_value->dp.quality);
                 }
                 break;//LCOV_EXCL_LINE
 
             case M_DP_TB_1:
                 {
-                    io = (InformationObject)DoublePointWithCP56Time2a_create(NULL, dp->m_ioa, (DoublePointValue)dp->m_value.dp.value, dp->m_value.dp.quality, &(dp->m_ts));
+                    io = (InformationObject)DoublePointWithCP56Time2a_create(NULL, dp->m_ioa, (DoublePointValue)dp->m_value->dp.value, dp->m_value->dp.quality, dp->m_ts);
+                }
+                break;//LCOV_EXCL_LINE
+
+            case M_DP_TA_1:
+                {
+                    struct sCP24Time2a ts24;
+
+                    toCP24Time2a(&ts24, dp->m_ts);
+
+                    io = (InformationObject)DoublePointWithCP24Time2a_create(NULL, dp->m_ioa, (DoublePointValue)dp->m_value->dp.value, dp->m_value->dp.quality, &ts24);
                 }
                 break;//LCOV_EXCL_LINE
 
             case M_ST_NA_1:
                 {
-                    io = (InformationObject)StepPositionInformation_create(NULL, dp->m_ioa, dp->m_value.stepPos.posValue, dp->m_value.stepPos.transient, dp->m_value.stepPos.quality);
+                    io = (InformationObject)StepPositionInformation_create(NULL, dp->m_ioa, dp->m_value->stepPos.posValue, dp->m_value->stepPos.transient, dp->m_value->stepPos.quality);
                 }
                 break;//LCOV_EXCL_LINE
 
             case M_ST_TB_1:
                 {
-                    io = (InformationObject)StepPositionWithCP56Time2a_create(NULL, dp->m_ioa, dp->m_value.stepPos.posValue, dp->m_value.stepPos.transient, dp->m_value.stepPos.quality, &(dp->m_ts));
+                    io = (InformationObject)StepPositionWithCP56Time2a_create(NULL, dp->m_ioa, dp->m_value->stepPos.posValue, dp->m_value->stepPos.transient, dp->m_value->stepPos.quality, dp->m_ts);
+                }
+                break;//LCOV_EXCL_LINE
+
+            case M_ST_TA_1:
+                {
+                    struct sCP24Time2a ts24;
+
+                    toCP24Time2a(&ts24, dp->m_ts);
+
+                    io = (InformationObject)StepPositionWithCP24Time2a_create(NULL, dp->m_ioa, dp->m_value->stepPos.posValue, dp->m_value->stepPos.transient, dp->m_value->stepPos.quality, &ts24);
                 }
                 break;//LCOV_EXCL_LINE
 
             case M_ME_NA_1:
                 {
-                    io = (InformationObject)MeasuredValueNormalized_create(NULL, dp->m_ioa, dp->m_value.mv_normalized.value, dp->m_value.mv_normalized.quality);
+                    io = (InformationObject)MeasuredValueNormalized_create(NULL, dp->m_ioa, dp->m_value->mv_normalized.value, dp->m_value->mv_normalized.quality);
                 }
                 break;//LCOV_EXCL_LINE
 
              case M_ME_TD_1:
                 {
-                    io = (InformationObject)MeasuredValueNormalizedWithCP56Time2a_create(NULL, dp->m_ioa, dp->m_value.mv_normalized.value, dp->m_value.mv_normalized.quality, &(dp->m_ts));
+                    io = (InformationObject)MeasuredValueNormalizedWithCP56Time2a_create(NULL, dp->m_ioa, dp->m_value->mv_normalized.value, dp->m_value->mv_normalized.quality, dp->m_ts);
+                }
+                break;//LCOV_EXCL_LINE
+
+            case M_ME_TA_1:
+                {
+                    struct sCP24Time2a ts24;
+
+                    toCP24Time2a(&ts24, dp->m_ts);
+
+                    io = (InformationObject)MeasuredValueNormalizedWithCP24Time2a_create(NULL, dp->m_ioa, dp->m_value->mv_normalized.value, dp->m_value->mv_normalized.quality, &ts24);
                 }
                 break;//LCOV_EXCL_LINE
 
             case M_ME_NB_1:
                 {
-                    io = (InformationObject)MeasuredValueScaled_create(NULL, dp->m_ioa, dp->m_value.mv_scaled.value, dp->m_value.mv_scaled.quality);
+                    io = (InformationObject)MeasuredValueScaled_create(NULL, dp->m_ioa, dp->m_value->mv_scaled.value, dp->m_value->mv_scaled.quality);
                 }
                 break;//LCOV_EXCL_LINE
 
             case M_ME_TE_1:
                 {
-                    io = (InformationObject)MeasuredValueScaledWithCP56Time2a_create(NULL, dp->m_ioa, dp->m_value.mv_scaled.value, dp->m_value.mv_scaled.quality, &(dp->m_ts));
+                    io = (InformationObject)MeasuredValueScaledWithCP56Time2a_create(NULL, dp->m_ioa, dp->m_value->mv_scaled.value, dp->m_value->mv_scaled.quality, dp->m_ts);
+                }
+                break;//LCOV_EXCL_LINE
+
+            case M_ME_TB_1:
+                {
+                    struct sCP24Time2a ts24;
+
+                    toCP24Time2a(&ts24, dp->m_ts);
+
+                    io = (InformationObject)MeasuredValueScaledWithCP24Time2a_create(NULL, dp->m_ioa, dp->m_value->mv_scaled.value, dp->m_value->mv_scaled.quality, &ts24);
                 }
                 break;//LCOV_EXCL_LINE
 
             case M_ME_NC_1:
                 {
-                    io = (InformationObject)MeasuredValueShort_create(NULL, dp->m_ioa, dp->m_value.mv_short.value, dp->m_value.mv_short.quality);
+                    io = (InformationObject)MeasuredValueShort_create(NULL, dp->m_ioa, dp->m_value->mv_short.value, dp->m_value->mv_short.quality);
                 }
                 break;//LCOV_EXCL_LINE
 
             case M_ME_TF_1:
                 {
-                    io = (InformationObject)MeasuredValueShortWithCP56Time2a_create(NULL, dp->m_ioa, dp->m_value.mv_short.value, dp->m_value.mv_short.quality, &(dp->m_ts));
+                    io = (InformationObject)MeasuredValueShortWithCP56Time2a_create(NULL, dp->m_ioa, dp->m_value->mv_short.value, dp->m_value->mv_short.quality, dp->m_ts);
+                }
+                break;//LCOV_EXCL_LINE
+
+            case M_ME_TC_1:
+                {
+                    struct sCP24Time2a ts24;
+
+                    toCP24Time2a(&ts24, dp->m_ts);
+
+                    io = (InformationObject)MeasuredValueShortWithCP24Time2a_create(NULL, dp->m_ioa, dp->m_value->mv_short.value, dp->m_value->mv_short.quality, &ts24);
+                }
+                break;//LCOV_EXCL_LINE
+
+            case M_PS_NA_1:
+                {
+                    struct sStatusAndStatusChangeDetection scd;
+
+                    dp->encodeStatusAndChangeDetection(&scd);
+
+                    io = (InformationObject)PackedSinglePointWithSCD_create(NULL, dp->m_ioa, &scd, dp->packedQuality());
+
+                    /* the changes are reported, following ones are detected from the transmitted status */
+                    dp->m_value->packed_sp.cd = 0;
+                }
+                break;//LCOV_EXCL_LINE
+
+            case M_BO_NA_1:
+                {
+                    io = (InformationObject)BitString32_createEx(NULL, dp->m_ioa, dp->m_value->bitstring.value, dp->packedQuality());
+                }
+                break;//LCOV_EXCL_LINE
+
+            case M_IT_NA_1:
+            case M_IT_TA_1:
+            case M_IT_TB_1:
+                {
+                    struct sBinaryCounterReading bcr;
+
+                    BinaryCounterReading_create(&bcr, dp->m_value->counter.value, dp->m_value->counter.quality.seq,
+                                                dp->m_value->counter.quality.cy, dp->m_value->counter.quality.ca,
+                                                dp->m_value->counter.quality.invalid);
+
+                    if (typeId == M_IT_TB_1) {
+                        io = (InformationObject)IntegratedTotalsWithCP56Time2a_create(NULL, dp->m_ioa, &bcr, dp->m_ts);
+                    }
+                    else if (typeId == M_IT_TA_1) {
+                        struct sCP24Time2a ts24;
+
+                        toCP24Time2a(&ts24, dp->m_ts);
+
+                        io = (InformationObject)IntegratedTotalsWithCP24Time2a_create(NULL, dp->m_ioa, &bcr, &ts24);
+                    }
+                    else {
+                        io = (InformationObject)IntegratedTotals_create(NULL, dp->m_ioa, &bcr);
+                    }
                 }
                 break;//LCOV_EXCL_LINE
 
             default:
-                Iec104Utility::log_error("%s Unsupported type ID %s (%d)", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                        IEC104DataPoint::getStringFromTypeID(typeId).c_str(), typeId); //LCOV_EXCL_LINE
+                Iec104Utility::log_error("%s Unsupported type ID %s (%d)", beforeLog, //LCOV_EXCL_LINE
+                                        IEC104DataPoint::getStringFromTypeID(typeId), typeId); //LCOV_EXCL_LINE
 
                 break;//LCOV_EXCL_LINE
         }
@@ -805,7 +1239,17 @@ IEC104Server::m_enqueueSpontDatapoint(IEC104DataPoint* dp, CS101_CauseOfTransmis
         if (io) {
             CS101_ASDU_addInformationObject(asdu, io);
 
+            uint64_t ingestTime = dp->m_trace.ingest.load(std::memory_order_relaxed);
+
+            if (ingestTime != 0) {
+                uint64_t enqueueTime = Hal_getTimeInNs();
+
+                m_latencyTracer.record(IEC104LatencyTracer::INGEST_TO_ENQUEUE, typeId, enqueueTime - ingestTime);
+                dp->m_trace.enqueue.store(enqueueTime, std::memory_order_relaxed);
+            }
+
             CS104_Slave_enqueueASDU(m_slave, asdu);
+            m_statistics.countAsduEnqueued();
 
             InformationObject_destroy(io);
         }
@@ -865,7 +1309,7 @@ IEC104Server::addToOutstandingCommands(CS101_ASDU asdu, IMasterConnection connec
 void
 IEC104Server::removeOutstandingCommands(IMasterConnection connection)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::removeOutstandingCommands -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::removeOutstandingCommands"); //LCOV_EXCL_LINE
     m_outstandingCommandsLock.lock(); //LCOV_EXCL_LINE
 
     std::vector<IEC104OutstandingCommand*>::iterator it;
@@ -876,7 +1320,7 @@ IEC104Server::removeOutstandingCommands(IMasterConnection connection)
 
         if (outstandingCommand->isSentFromConnection(connection))
         {
-            Iec104Utility::log_warn("%s Remove outstanding command to %i:%i while waiting for feedback", beforeLog.c_str(), //LCOV_EXCL_LINE
+            Iec104Utility::log_warn("%s Remove outstanding command to %i:%i while waiting for feedback", beforeLog, //LCOV_EXCL_LINE
                                     outstandingCommand->CA(), outstandingCommand->IOA());  //LCOV_EXCL_LINE
 
             it = m_outstandingCommands.erase(it);
@@ -914,7 +1358,7 @@ IEC104Server::removeAllOutstandingCommands()
 void
 IEC104Server::handleActCon(int type, int ca, int ioa, bool isNegative)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::handleActCon -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::handleActCon"); //LCOV_EXCL_LINE
     m_outstandingCommandsLock.lock(); //LCOV_EXCL_LINE
 
     std::vector<IEC104OutstandingCommand*>::iterator it;
@@ -930,7 +1374,7 @@ IEC104Server::handleActCon(int type, int ca, int ioa, bool isNegative)
             if (outstandingCommand->isSelect()) {
                 m_outstandingCommands.erase(it);
 
-                Iec104Utility::log_info("%s Outstanding command %i:%i sent ACT-CON(select) -> remove", beforeLog.c_str(), //LCOV_EXCL_LINE
+                Iec104Utility::log_info("%s Outstanding command %i:%i sent ACT-CON(select) -> remove", beforeLog, //LCOV_EXCL_LINE
                                         outstandingCommand->CA(), outstandingCommand->IOA());  //LCOV_EXCL_LINE
 
                 delete outstandingCommand;
@@ -941,7 +1385,7 @@ IEC104Server::handleActCon(int type, int ca, int ioa, bool isNegative)
     }
     if (!found) {
         Iec104Utility::log_warn("%s Received ACT-CON(select) for unexpected outstanding command %i:%i, type=%d, negative=%s", //LCOV_EXCL_LINE
-                                beforeLog.c_str(), ca, ioa, type, isNegative?"true":"false");  //LCOV_EXCL_LINE
+                                beforeLog, ca, ioa, type, isNegative?"true":"false");  //LCOV_EXCL_LINE
     }
 
     m_outstandingCommandsLock.unlock();
@@ -950,7 +1394,7 @@ IEC104Server::handleActCon(int type, int ca, int ioa, bool isNegative)
 void
 IEC104Server::handleActTerm(int type, int ca, int ioa, bool isNegative)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::handleActTerm -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::handleActTerm"); //LCOV_EXCL_LINE
     m_outstandingCommandsLock.lock(); //LCOV_EXCL_LINE
 
     std::vector<IEC104OutstandingCommand*>::iterator it;
@@ -964,7 +1408,7 @@ IEC104Server::handleActTerm(int type, int ca, int ioa, bool isNegative)
         {
             outstandingCommand->sendActTerm(isNegative);
 
-            Iec104Utility::log_info("%s Outstanding command %i:%i sent ACT-TERM -> remove", beforeLog.c_str(), //LCOV_EXCL_LINE
+            Iec104Utility::log_info("%s Outstanding command %i:%i sent ACT-TERM -> remove", beforeLog, //LCOV_EXCL_LINE
                                     outstandingCommand->CA(), outstandingCommand->IOA());  //LCOV_EXCL_LINE
 
             m_outstandingCommands.erase(it);
@@ -976,7 +1420,7 @@ IEC104Server::handleActTerm(int type, int ca, int ioa, bool isNegative)
     }
     if (!found) {
         Iec104Utility::log_warn("%s Received ACT-TERM for unexpected outstanding command %i:%i, type=%d, negative=%s", //LCOV_EXCL_LINE
-                                beforeLog.c_str(), ca, ioa, type, isNegative?"true":"false");  //LCOV_EXCL_LINE
+                                beforeLog, ca, ioa, type, isNegative?"true":"false");  //LCOV_EXCL_LINE
     }
 
     m_outstandingCommandsLock.unlock();
@@ -997,7 +1441,7 @@ enum CommandParameters{
 bool
 IEC104Server::forwardCommand(CS101_ASDU asdu, InformationObject command, IMasterConnection connection)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::forwardCommand -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::forwardCommand"); //LCOV_EXCL_LINE
     int res = -1;
     IEC60870_5_TypeID typeId = CS101_ASDU_getTypeID(asdu);
 
@@ -1273,8 +1717,8 @@ IEC104Server::forwardCommand(CS101_ASDU asdu, InformationObject command, IMaster
             break;//LCOV_EXCL_LINE
 
         default:
-            Iec104Utility::log_error("%s Unsupported command type: %s (%d)", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                    IEC104DataPoint::getStringFromTypeID(typeId).c_str(), typeId); //LCOV_EXCL_LINE
+            Iec104Utility::log_error("%s Unsupported command type: %s (%d)", beforeLog, //LCOV_EXCL_LINE
+                                    IEC104DataPoint::getStringFromTypeID(typeId), typeId); //LCOV_EXCL_LINE
             return false;
     }
 
@@ -1284,7 +1728,7 @@ IEC104Server::forwardCommand(CS101_ASDU asdu, InformationObject command, IMaster
 void
 IEC104Server::updateSouthMonitoringInstance(Datapoint* dp, IEC104Config::SouthPluginMonitor* southPluginMonitor)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::updateSouthMonitoringInstance -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::updateSouthMonitoringInstance"); //LCOV_EXCL_LINE
     DatapointValue dpv = dp->getData();
 
     vector<Datapoint*>* sdp = dpv.getDpVec();
@@ -1305,7 +1749,7 @@ IEC104Server::updateSouthMonitoringInstance(Datapoint* dp, IEC104Config::SouthPl
                 connxStatus = IEC104Config::ConnectionStatus::STARTED;
             }
 
-            Iec104Utility::log_info("%s south connection status for %s changed to %s", beforeLog.c_str(), //LCOV_EXCL_LINE
+            Iec104Utility::log_info("%s south connection status for %s changed to %s", beforeLog, //LCOV_EXCL_LINE
                                     southPluginMonitor->GetAssetName().c_str(), connxStatusValue.c_str());  //LCOV_EXCL_LINE
 
             southPluginMonitor->SetConnxStatus(connxStatus);
@@ -1328,7 +1772,7 @@ IEC104Server::updateSouthMonitoringInstance(Datapoint* dp, IEC104Config::SouthPl
                 giStatus = IEC104Config::GiStatus::FINISHED;//LCOV_EXCL_LINE
             }
 
-            Iec104Utility::log_info("%s south gi status for %s changed to %s", beforeLog.c_str(), //LCOV_EXCL_LINE
+            Iec104Utility::log_info("%s south gi status for %s changed to %s", beforeLog, //LCOV_EXCL_LINE
                                     southPluginMonitor->GetAssetName().c_str(), giStatusValue.c_str());  //LCOV_EXCL_LINE
 
             southPluginMonitor->SetGiStatus(giStatus);
@@ -1345,12 +1789,12 @@ IEC104Server::updateSouthMonitoringInstance(Datapoint* dp, IEC104Config::SouthPl
  */
 bool
 IEC104Server::validateCommand(IMasterConnection connection, CS101_ASDU asdu) {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::validateCommand -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::validateCommand"); //LCOV_EXCL_LINE
     
     IEC60870_5_TypeID typeId = CS101_ASDU_getTypeID(asdu);
     if (!checkIfSouthConnected()) {
-        Iec104Utility::log_warn("%s command (%s) received while south plugin is not connected -> reject", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                IEC104DataPoint::getStringFromTypeID(typeId).c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_warn("%s command (%s) received while south plugin is not connected -> reject", beforeLog, //LCOV_EXCL_LINE
+                                IEC104DataPoint::getStringFromTypeID(typeId)); //LCOV_EXCL_LINE
         CS101_ASDU_setCOT(asdu, CS101_COT_ACTIVATION_CON);
         CS101_ASDU_setNegative(asdu, true);
         return true;
@@ -1358,8 +1802,8 @@ IEC104Server::validateCommand(IMasterConnection connection, CS101_ASDU asdu) {
     
     CS101_CauseOfTransmission cot = CS101_ASDU_getCOT(asdu);
     if (cot != CS101_COT_ACTIVATION) {
-        Iec104Utility::log_warn("%s command (%s) - Unexpected COT: %d", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                IEC104DataPoint::getStringFromTypeID(typeId).c_str(), cot); //LCOV_EXCL_LINE
+        Iec104Utility::log_warn("%s command (%s) - Unexpected COT: %d", beforeLog, //LCOV_EXCL_LINE
+                                IEC104DataPoint::getStringFromTypeID(typeId), cot); //LCOV_EXCL_LINE
         CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_COT);
         CS101_ASDU_setNegative(asdu, true);
         return true;
@@ -1368,18 +1812,17 @@ IEC104Server::validateCommand(IMasterConnection connection, CS101_ASDU asdu) {
     InformationObject io = CS101_ASDU_getElement(asdu, 0);
     InformationObject_RAII io_raii(io);
     if (!io) {
-        Iec104Utility::log_warn("%s command (%s) - Unknown type or information object missing", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                IEC104DataPoint::getStringFromTypeID(typeId).c_str());  //LCOV_EXCL_LINE
+        Iec104Utility::log_warn("%s command (%s) - Unknown type or information object missing", beforeLog, //LCOV_EXCL_LINE
+                                IEC104DataPoint::getStringFromTypeID(typeId));  //LCOV_EXCL_LINE
         CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_TYPE_ID);
         CS101_ASDU_setNegative(asdu, true);
         return true;
     }
 
     int ca = CS101_ASDU_getCA(asdu);
-    std::map<int, IEC104DataPoint*> ld = m_exchangeDefinitions[ca];
-    if (ld.empty()) {
-        Iec104Utility::log_warn("%s command (%s) - Unknown CA: %i", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                IEC104DataPoint::getStringFromTypeID(typeId).c_str(), ca);  //LCOV_EXCL_LINE
+    if (m_pointTable->Store().findBlock(ca) == nullptr) {
+        Iec104Utility::log_warn("%s command (%s) - Unknown CA: %i", beforeLog, //LCOV_EXCL_LINE
+                                IEC104DataPoint::getStringFromTypeID(typeId), ca);  //LCOV_EXCL_LINE
         CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_CA);
         CS101_ASDU_setNegative(asdu, true);
         return true;
@@ -1388,25 +1831,25 @@ IEC104Server::validateCommand(IMasterConnection connection, CS101_ASDU asdu) {
     /* check if command has an allowed OA */
     int oa = CS101_ASDU_getOA(asdu);
     if (!m_config->IsOriginatorAllowed(oa)) {
-        Iec104Utility::log_warn("%s command (%s) for %i - Originator address %i not allowed", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                IEC104DataPoint::getStringFromTypeID(typeId).c_str(), ca, oa);  //LCOV_EXCL_LINE
+        Iec104Utility::log_warn("%s command (%s) for %i - Originator address %i not allowed", beforeLog, //LCOV_EXCL_LINE
+                                IEC104DataPoint::getStringFromTypeID(typeId), ca, oa);  //LCOV_EXCL_LINE
         CS101_ASDU_setCOT(asdu, CS101_COT_ACTIVATION_CON);
         CS101_ASDU_setNegative(asdu, true);
         return true;
     }
 
     int ioa = InformationObject_getObjectAddress(io);
-    IEC104DataPoint* dp = ld[ioa];
+    IEC104DataPoint* dp = m_findDataPoint(ca, ioa);
     if (!dp) {
-        Iec104Utility::log_warn("%s command (%s) for %i:%i - Unknown IOA", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                IEC104DataPoint::getStringFromTypeID(typeId).c_str(), ca, ioa);  //LCOV_EXCL_LINE
+        Iec104Utility::log_warn("%s command (%s) for %i:%i - Unknown IOA", beforeLog, //LCOV_EXCL_LINE
+                                IEC104DataPoint::getStringFromTypeID(typeId), ca, ioa);  //LCOV_EXCL_LINE
         CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_IOA);
         CS101_ASDU_setNegative(asdu, true);
         return true;
     }
     if (!dp->isMatchingCommand(typeId)) {
-        Iec104Utility::log_warn("%s command (%s) for %i:%i - Unknown command type %d", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                IEC104DataPoint::getStringFromTypeID(typeId).c_str(), ca, ioa, typeId);  //LCOV_EXCL_LINE
+        Iec104Utility::log_warn("%s command (%s) for %i:%i - Unknown command type %d", beforeLog, //LCOV_EXCL_LINE
+                                IEC104DataPoint::getStringFromTypeID(typeId), ca, ioa, typeId);  //LCOV_EXCL_LINE
         CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_TYPE_ID);
         CS101_ASDU_setNegative(asdu, true);
         return true;
@@ -1415,14 +1858,14 @@ IEC104Server::validateCommand(IMasterConnection connection, CS101_ASDU asdu) {
     bool acceptCommand = true;
     if (IEC104DataPoint::isCommandWithTimestamp(typeId)) {
         if (!m_config->AllowCmdWithTime()) {
-            Iec104Utility::log_warn("%s command (%s) for %i:%i - Commands with timestamp are not allowed", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                    IEC104DataPoint::getStringFromTypeID(typeId).c_str(), ca, ioa);  //LCOV_EXCL_LINE
+            Iec104Utility::log_warn("%s command (%s) for %i:%i - Commands with timestamp are not allowed", beforeLog, //LCOV_EXCL_LINE
+                                    IEC104DataPoint::getStringFromTypeID(typeId), ca, ioa);  //LCOV_EXCL_LINE
             acceptCommand = false;
         }
         else {
             if (!checkIfCmdTimeIsValid(typeId, io)) {
-                Iec104Utility::log_warn("%s command (%s) for %i:%i - Invalid timestamp -> ignore", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                        IEC104DataPoint::getStringFromTypeID(typeId).c_str(), ca, ioa); //LCOV_EXCL_LINE
+                Iec104Utility::log_warn("%s command (%s) for %i:%i - Invalid timestamp -> ignore", beforeLog, //LCOV_EXCL_LINE
+                                        IEC104DataPoint::getStringFromTypeID(typeId), ca, ioa); //LCOV_EXCL_LINE
                                         
                 /* send negative response -> according to IEC 60870-5-104 the command should be silently ignored instead! */
                 CS101_ASDU_setCOT(asdu, CS101_COT_ACTIVATION_CON);
@@ -1433,15 +1876,15 @@ IEC104Server::validateCommand(IMasterConnection connection, CS101_ASDU asdu) {
                 return false;
             }
             else {
-                Iec104Utility::log_debug("%s command (%s) for %i:%i - Valid timestamp -> accept", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                        IEC104DataPoint::getStringFromTypeID(typeId).c_str(), ca, ioa); //LCOV_EXCL_LINE
+                Iec104Utility::log_debug("%s command (%s) for %i:%i - Valid timestamp -> accept", beforeLog, //LCOV_EXCL_LINE
+                                        IEC104DataPoint::getStringFromTypeID(typeId), ca, ioa); //LCOV_EXCL_LINE
             }
         }
     }
     else {
         if (!m_config->AllowCmdWithoutTime()) {
-            Iec104Utility::log_warn("%s command (%s) for %i:%i - Commands without timestamp are not allowed", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                    IEC104DataPoint::getStringFromTypeID(typeId).c_str(), ca, ioa);  //LCOV_EXCL_LINE
+            Iec104Utility::log_warn("%s command (%s) for %i:%i - Commands without timestamp are not allowed", beforeLog, //LCOV_EXCL_LINE
+                                    IEC104DataPoint::getStringFromTypeID(typeId), ca, ioa);  //LCOV_EXCL_LINE
             acceptCommand = false;
         }
     }
@@ -1449,8 +1892,8 @@ IEC104Server::validateCommand(IMasterConnection connection, CS101_ASDU asdu) {
     if (acceptCommand) {
         CS101_ASDU_setCOT(asdu, CS101_COT_ACTIVATION_CON);
         if (!forwardCommand(asdu, io, connection)) {
-            Iec104Utility::log_warn("%s command (%s) for %i:%i - Failed to forward command, set negative response", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                    IEC104DataPoint::getStringFromTypeID(typeId).c_str(), ca, ioa);  //LCOV_EXCL_LINE
+            Iec104Utility::log_warn("%s command (%s) for %i:%i - Failed to forward command, set negative response", beforeLog, //LCOV_EXCL_LINE
+                                    IEC104DataPoint::getStringFromTypeID(typeId), ca, ioa);  //LCOV_EXCL_LINE
             CS101_ASDU_setNegative(asdu, true);       
         }
         else {
@@ -1459,8 +1902,8 @@ IEC104Server::validateCommand(IMasterConnection connection, CS101_ASDU asdu) {
         }
     }
     else {
-        Iec104Utility::log_warn("%s command (%s) for %i:%i - Command not accepted", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                IEC104DataPoint::getStringFromTypeID(typeId).c_str(), ca, ioa);  //LCOV_EXCL_LINE
+        Iec104Utility::log_warn("%s command (%s) for %i:%i - Command not accepted", beforeLog, //LCOV_EXCL_LINE
+                                IEC104DataPoint::getStringFromTypeID(typeId), ca, ioa);  //LCOV_EXCL_LINE
         CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_TYPE_ID);
         CS101_ASDU_setNegative(asdu, true);
     }
@@ -1469,205 +1912,466 @@ IEC104Server::validateCommand(IMasterConnection connection, CS101_ASDU asdu) {
 }
 
 /**
- * Send a block of reading to IEC104 Server
+ * Extract the attributes of a data_object and look up the data point, called by the decode workers.
+ * Only reads the reading and the data point index.
  *
- * @param readings	The readings to send
- * @return 		The number of readings sent
+ * @param dataObject	The data_object datapoint
+ * @param decoded	The decoded attributes
  */
-uint32_t
-IEC104Server::send(const vector<Reading*>& readings)
+void
+IEC104Server::decodeDataObject(Datapoint* dataObject, DecodedDataObject& decoded)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::send -"; //LCOV_EXCL_LINE
-    int n = 0;
+    DatapointValue& dpv = dataObject->getData();
+
+    vector<Datapoint*>* sdp = dpv.getDpVec();
 
-    for (auto reading = readings.cbegin(); reading != readings.cend(); reading++)
+    DatapointValue* valueAttr = nullptr;
+    double analogInput = 0.0; /* engineering value of a measured value */
+
+    for (Datapoint* objDp : *sdp)
     {
-        vector<Datapoint*>& dataPoints = (*reading)->getReadingData();
-        string assetName = (*reading)->getAssetName();
+        DatapointValue& attrVal = objDp->getData();
+        const std::string& name = objDp->getName();
 
-        for (Datapoint* dp : dataPoints) {
+        if (name == "do_ca") {
+            decoded.ca = attrVal.toInt();
+        }
+        else if (name == "do_ioa") {
+            decoded.ioa = attrVal.toInt();
+        }
+        else if (name == "do_cot") {
+            decoded.cot = (CS101_CauseOfTransmission)attrVal.toInt();
+        }
+        else if (name == "do_type") {
+            decoded.type = IEC104DataPoint::getTypeIdFromString(attrVal.toStringValue());
+        }
+        else if (name == "do_value") {
+            valueAttr = &attrVal;
+        }
+        else if (name == "do_negative") {
+            if (attrVal.toInt() != 0)
+                decoded.isNegative = true;
+        }
+        else if (name == "do_quality_iv") {
+            if (attrVal.toInt() != 0)
+                decoded.qd |= IEC60870_QUALITY_INVALID;
+        }
+        else if (name == "do_quality_bl") {
+            if (attrVal.toInt() != 0)
+                decoded.qd |= IEC60870_QUALITY_BLOCKED;
+        }
+        else if (name == "do_quality_ov") {
+            if (attrVal.toInt() != 0)
+                decoded.qd |= IEC60870_QUALITY_OVERFLOW;
+        }
+        else if (name == "do_quality_sb") {
+            if (attrVal.toInt() != 0)
+                decoded.qd |= IEC60870_QUALITY_SUBSTITUTED;
+        }
+        else if (name == "do_quality_nt") {
+            if (attrVal.toInt() != 0)
+                decoded.qd |= IEC60870_QUALITY_NON_TOPICAL;
+        }
+        else if (name == "do_ts") {
+            decoded.timestamp = (uint64_t)attrVal.toInt();
+            decoded.hasTimestamp = true;
+        }
+        else if (name == "do_ts_iv" && attrVal.toInt() != 0) {
+            decoded.ts_iv = true;
+        }
+        else if (name == "do_ts_su" && attrVal.toInt() != 0) {
+            decoded.ts_su = true;
+        }
+        else if (name == "do_ts_sub" && attrVal.toInt() != 0) {
+            decoded.ts_sub = true;
+        }
+    }
 
-            if (dp->getName() == "south_event") {
+    if (valueAttr) {
+        int dataType = IEC104DataPoint::typeIdToDataType(decoded.type);
 
-                Iec104Utility::log_info("%s Process south_event", beforeLog.c_str());//LCOV_EXCL_LINE
+        if ((decoded.type == M_ST_NA_1) || (decoded.type == M_ST_TA_1) || (decoded.type == M_ST_TB_1)) {
+            decoded.hasStepPos = IEC104DataPoint::parseStepPosition(*valueAttr, decoded.stepPosValue, decoded.stepPosTransient);
+        }
+        else if ((dataType == IEC60870_TYPE_NORMALIZED) || (dataType == IEC60870_TYPE_SCALED) || (dataType == IEC60870_TYPE_SHORT)) {
+            /* converted below once the data point is known, the do_value is not copied */
+            if (valueAttr->getType() == DatapointValue::dataTagType::T_FLOAT) {
+                decoded.hasAnalog = true;
+                analogInput = valueAttr->toDouble();
+            }
+            else if (valueAttr->getType() == DatapointValue::dataTagType::T_INTEGER) {
+                decoded.hasAnalog = true;
+                analogInput = static_cast<double>(valueAttr->toInt());
+            }
+        }
+        else if (valueAttr->getType() == DatapointValue::dataTagType::T_INTEGER) {
+            /* the do_value is not copied */
+            decoded.hasInteger = true;
+            decoded.integerValue = valueAttr->toInt();
+        }
+    }
 
-                // check if we know the south plugin
-                bool found = false;
-                for (auto southPluginMonitor : m_config->GetMonitoredSouthPlugins()) {
-                    if (assetName == southPluginMonitor->GetAssetName()) {
-                        Iec104Utility::log_info("%s Found matching monitored plugin for south_event (%s)", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                                assetName.c_str());  //LCOV_EXCL_LINE
-                        updateSouthMonitoringInstance(dp, southPluginMonitor);
-                        found = true;
-                        break;//LCOV_EXCL_LINE
+    if ((decoded.ca != -1) && (decoded.ioa != -1) && (decoded.type != -1)) {
+        decoded.dp = m_getDataPoint(decoded.ca, decoded.ioa, decoded.type);
+    }
+
+    if (decoded.hasAnalog && decoded.dp) {
+        const IEC104Conversion& conversion = decoded.dp->m_conversion ? *decoded.dp->m_conversion
+                                                                      : IEC104Conversion::defaultFor(decoded.dp->m_type);
+        bool overflow = false;
+
+        decoded.analogValue = conversion.apply(analogInput, overflow);
+
+        if (overflow) {
+            decoded.qd |= IEC60870_QUALITY_OVERFLOW;
+        }
+    }
+}
+
+/**
+ * Update the data point of a decoded data_object and enqueue it, called in the order of the readings
+ *
+ * @param decoded	The decoded attributes
+ * @param pendingPacks	Packed objects to transmit at the end of the block
+ */
+void
+IEC104Server::applyDataObject(DecodedDataObject& decoded, std::vector<IEC104DataPoint*>& pendingPacks)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Server::applyDataObject"); //LCOV_EXCL_LINE
+
+    int ca = decoded.ca;
+    int ioa = decoded.ioa;
+    int type = decoded.type;
+    CS101_CauseOfTransmission cot = decoded.cot;
+    uint64_t ingestTime = decoded.ingestTime;
+
+    if (cot == CS101_COT_ACTIVATION_CON)
+    {
+        handleActCon(type, ca, ioa, decoded.isNegative);
+    }
+    else if (cot == CS101_COT_ACTIVATION_TERMINATION)
+    {
+        handleActTerm(type, ca, ioa, decoded.isNegative);
+    }
+    else if (ca != -1 && ioa != -1 && cot != CS101_COT_UNKNOWN_COT && type != -1) {
+
+        IEC104DataPoint* dp = decoded.dp;
+
+        if (dp) {
+
+            CP56Time2a ts = NULL;
+
+            struct sCP56Time2a _ts;
+
+            if (decoded.hasTimestamp) {
+                IEC104TimeEncoder::threadInstance().encode(&_ts, decoded.timestamp);
+                ts = &_ts;
+
+                if (ts) {
+                    CP56Time2a_setInvalid(ts, decoded.ts_iv);
+                    CP56Time2a_setSummerTime(ts, decoded.ts_su);
+                    CP56Time2a_setSubstituted(ts, decoded.ts_sub);
+                    IEC104_HOT_LOG_DEBUG("%s Data point %i:%i (%s) timestamp info: TS=%llu, IV=%d, SU=%d, SUB=%d", //LCOV_EXCL_LINE
+                                        beforeLog, ca, ioa, IEC104DataPoint::getStringFromTypeID(type), //LCOV_EXCL_LINE
+                                        decoded.timestamp, static_cast<int>(decoded.ts_iv), static_cast<int>(decoded.ts_su),
+                                        static_cast<int>(decoded.ts_sub)); //LCOV_EXCL_LINE
+                }
+            }
+
+            // update internal value
+            m_updateDataPoint(dp, (IEC60870_5_TypeID)type, decoded, ts);
+
+            if (dp->m_pack) {
+                dp->m_pack->updatePackedBit(dp->m_packBit, dp->m_value->sp.value != 0);
+            }
+
+            if (cot == CS101_COT_PERIODIC || cot == CS101_COT_SPONTANEOUS ||
+                cot == CS101_COT_RETURN_INFO_REMOTE || cot == CS101_COT_RETURN_INFO_LOCAL ||
+                cot == CS101_COT_BACKGROUND_SCAN)
+            {
+                if (dp->m_pack) {
+                    IEC104DataPoint* pack = dp->m_pack;
+
+                    IEC104_HOT_LOG_INFO("%s Data point %i:%i (%s) reported in packed object %i:%i", //LCOV_EXCL_LINE
+                                        beforeLog, ca, ioa, IEC104DataPoint::getStringFromTypeID(type), //LCOV_EXCL_LINE
+                                        pack->m_ca, pack->m_ioa); //LCOV_EXCL_LINE
+
+                    pack->m_packCot = cot;
+                    pack->m_trace.ingest.store(ingestTime, std::memory_order_relaxed);
+
+                    if (!pack->m_packPending) {
+                        pack->m_packPending = true;
+                        pendingPacks.push_back(pack);
                     }
                 }
-                if (!found) {
-                    Iec104Utility::log_warn("%s Received south_event with unknown asset name: %s -> ignore", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                            assetName.c_str());  //LCOV_EXCL_LINE
+                else {
+                    IEC104_HOT_LOG_INFO("%s Sending data point %i:%i (%s)", //LCOV_EXCL_LINE
+                                        beforeLog, ca, ioa, IEC104DataPoint::getStringFromTypeID(type));  //LCOV_EXCL_LINE
+
+                    dp->m_trace.ingest.store(ingestTime, std::memory_order_relaxed);
+
+                    /* CP56Time2a time tagged values of points configured with a CP24Time2a type are shortened */
+                    int sendType = dp->m_cp24TimeTag ? IEC104DataPoint::cp24Variant(type) : type;
+
+                    m_enqueueSpontDatapoint(dp, cot, (IEC60870_5_TypeID)sendType);
                 }
             }
-            else if (dp->getName() == "data_object")
-            {
-                Iec104Utility::log_info("%s Forward data_object", beforeLog.c_str());//LCOV_EXCL_LINE
+            else {
+                IEC104_HOT_LOG_INFO("%s Data point %i:%i (%s) has unhandled COT: %d -> ignored", //LCOV_EXCL_LINE
+                                    beforeLog, ca, ioa, IEC104DataPoint::getStringFromTypeID(type), cot);  //LCOV_EXCL_LINE
+            }
+        }
+        else if (m_logLimiter.accept(m_logSiteUnknownPoint, ca, ioa)) {
+            /* repeated occurrences are summarized by the monitoring thread */
+            Iec104Utility::log_error("%s Data point %i:%i not found or type %s (%d) not expected", beforeLog, //LCOV_EXCL_LINE
+                                    ca, ioa, IEC104DataPoint::getStringFromTypeID(type), type);  //LCOV_EXCL_LINE
+        }
+    }
+    else {
+        IEC104_HOT_LOG_INFO("%s Data point was ignored due to one of those values: CA=%d, IOA=%d, type=%s (%d), COT=%d", //LCOV_EXCL_LINE
+                            beforeLog, ca, ioa, IEC104DataPoint::getStringFromTypeID(type), type, cot);  //LCOV_EXCL_LINE
+    }
+}
 
-                if ((m_slave == nullptr) || !CS104_Slave_isRunning(m_slave)) {
-                    Iec104Utility::log_warn("%s Failed to send data: server not running", beforeLog.c_str()); //LCOV_EXCL_LINE
-                    continue;
+/**
+ * Transmit the packed objects updated since the last call
+ *
+ * @param pendingPacks	Packed objects updated by the applied data objects
+ */
+void
+IEC104Server::sendPendingPacks(std::vector<IEC104DataPoint*>& pendingPacks)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Server::sendPendingPacks"); //LCOV_EXCL_LINE
+
+    for (IEC104DataPoint* pack : pendingPacks) {
+        IEC104_HOT_LOG_INFO("%s Sending packed object %i:%i (%s)", beforeLog, pack->m_ca, pack->m_ioa, //LCOV_EXCL_LINE
+                            IEC104DataPoint::getStringFromTypeID(pack->packedTypeId())); //LCOV_EXCL_LINE
+
+        pack->m_packPending = false;
+
+        m_enqueueSpontDatapoint(pack, (CS101_CauseOfTransmission)pack->m_packCot, (IEC60870_5_TypeID)pack->packedTypeId());
+    }
+
+    pendingPacks.clear();
+}
+
+/**
+ * Encoder thread: applies the data objects decoded by send() in the order they were queued.
+ * The packed objects are transmitted when the queue is drained, and at least every ENCODER_PACK_FLUSH_OBJECTS
+ * data objects so that they are not delayed while send() keeps the queue busy.
+ */
+void
+IEC104Server::_encoderThread()
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Server::_encoderThread"); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s Encoder thread started", beforeLog); //LCOV_EXCL_LINE
+
+    std::vector<IEC104DataPoint*> pendingPacks;
+    DecodedDataObject decoded;
+    int appliedSinceFlush = 0;
+    uint64_t popped = 0;
+
+    while (m_encoderRunning.load(std::memory_order_acquire)) {
+        if (m_encoderQueue->pop(decoded)) {
+            popped++;
+
+            if ((m_slave == nullptr) || !CS104_Slave_isRunning(m_slave)) {
+                /* same site as send(), summarized by the monitoring thread */
+                if (m_logLimiter.accept(m_logSiteNotRunning, 0, 0)) {
+                    Iec104Utility::log_warn("%s Failed to send data: server not running", beforeLog); //LCOV_EXCL_LINE
                 }
+                continue;
+            }
 
-                int ca = -1;
-                int ioa = -1;
-                CS101_CauseOfTransmission cot = CS101_COT_UNKNOWN_COT;
-                int type = -1;
+            applyDataObject(decoded, pendingPacks);
 
-                DatapointValue dpv = dp->getData();
+            if (++appliedSinceFlush >= ENCODER_PACK_FLUSH_OBJECTS) {
+                sendPendingPacks(pendingPacks);
+                appliedSinceFlush = 0;
+            }
 
-                vector<Datapoint*>* sdp = dpv.getDpVec();
+            continue;
+        }
 
-                bool hasTimestamp = false;
-                uint64_t timestamp = 0;
-                bool ts_iv = false;
-                bool ts_su = false;
-                bool ts_sub = false;
+        sendPendingPacks(pendingPacks);
+        appliedSinceFlush = 0;
 
-                bool isNegative = false;
+        m_encoderDrained.store(popped, std::memory_order_release);
 
-                DatapointValue* value = nullptr;
+        /* the timeout covers a notification sent between the empty check and the wait */
+        std::unique_lock<std::mutex> lock(m_encoderLock);
 
-                uint8_t qd = IEC60870_QUALITY_GOOD;
+        m_encoderWakeup.wait_for(lock, std::chrono::milliseconds(10), [this] {
+            return !m_encoderQueue->isEmpty() || !m_encoderRunning.load(std::memory_order_acquire);
+        });
+    }
+}
 
-                for (Datapoint* objDp : *sdp)
-                {
-                    DatapointValue attrVal = objDp->getData();
+void
+IEC104Server::drainEncoderQueue()
+{
+    while (m_encoderRunning.load(std::memory_order_acquire) &&
+           (m_encoderDrained.load(std::memory_order_acquire) < m_encoderPushed)) {
+        m_encoderWakeup.notify_one();
+        Thread_sleep(1);
+    }
+}
 
-                    if (objDp->getName() == "do_ca") {
-                        ca = attrVal.toInt();
-                    }
-                    else if (objDp->getName() == "do_ioa") {
-                        ioa = attrVal.toInt();
-                    }
-                    else if (objDp->getName() == "do_cot") {
-                        cot = (CS101_CauseOfTransmission)attrVal.toInt();
-                    }
-                    else if (objDp->getName() == "do_type") {
-                        type = IEC104DataPoint::getTypeIdFromString(attrVal.toStringValue());
-                    }
-                    else if (objDp->getName() == "do_value") {
-                        value = new DatapointValue(attrVal);
-                    }
-                    else if (objDp->getName() == "do_negative") {
-                        if (attrVal.toInt() != 0)
-                            isNegative = true;
-                    }
-                    else if (objDp->getName() == "do_quality_iv") {
-                        if (attrVal.toInt() != 0)
-                            qd |= IEC60870_QUALITY_INVALID;
-                    }
-                    else if (objDp->getName() == "do_quality_bl") {
-                        if (attrVal.toInt() != 0)
-                            qd |= IEC60870_QUALITY_BLOCKED;
-                    }
-                    else if (objDp->getName() == "do_quality_ov") {
-                        if (attrVal.toInt() != 0)
-                            qd |= IEC60870_QUALITY_OVERFLOW;
-                    }
-                    else if (objDp->getName() == "do_quality_sb") {
-                        if (attrVal.toInt() != 0)
-                            qd |= IEC60870_QUALITY_SUBSTITUTED;
-                    }
-                    else if (objDp->getName() == "do_quality_nt") {
-                        if (attrVal.toInt() != 0)
-                            qd |= IEC60870_QUALITY_NON_TOPICAL;
-                    }
-                    else if (objDp->getName() == "do_ts") {
-                        timestamp = (uint64_t)attrVal.toInt();
-                        hasTimestamp = true;
-                    }
-                    else if (objDp->getName() == "do_ts_iv" && attrVal.toInt() != 0) {
-                        ts_iv = true;
-                    }
-                    else if (objDp->getName() == "do_ts_su" && attrVal.toInt() != 0) {
-                        ts_su = true;
-                    }
-                    else if (objDp->getName() == "do_ts_sub" && attrVal.toInt() != 0) {
-                        ts_sub = true;
-                    }
+/**
+ * Send a block of reading to IEC104 Server
+ *
+ * The data_object items are decoded first, on the decode workers when configured, then applied in the order
+ * of the readings: the events of each data point are transmitted in the order they were received.
+ * With an encoder queue the decoded items are handed to the encoder thread, a reading is only accepted (and
+ * decoded) when all its items fit in the queue.
+ *
+ * @param readings	The readings to send
+ * @return 		The number of readings sent
+ */
+uint32_t
+IEC104Server::send(const vector<Reading*>& readings)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Server::send"); //LCOV_EXCL_LINE
+    int n = 0;
+
+    /* ingest time of the whole block, 0 when latency tracing is disabled */
+    uint64_t ingestTime = m_latencyTracer.isEnabled() ? Hal_getTimeInNs() : 0;
+
+    bool useEncoder = m_encoderRunning.load(std::memory_order_acquire);
+
+    std::vector<Datapoint*> dataObjects;
+
+    /* readings handled by this call, with an encoder queue only the readings that fit in it */
+    size_t acceptedReadings = 0;
+    size_t freeSpace = useEncoder ? m_encoderQueue->FreeSpace() : 0;
+
+    for (Reading* reading : readings) {
+        size_t firstDataObject = dataObjects.size();
+
+        for (Datapoint* dp : reading->getReadingData()) {
+            if (dp->getName() == "data_object") {
+                dataObjects.push_back(dp);
+            }
+        }
+
+        if (useEncoder) {
+            size_t readingDataObjects = dataObjects.size() - firstDataObject;
+
+            /* backpressure, checked before decoding: the reading and the following ones are left to the caller.
+             * A reading larger than the queue is accepted alone when the queue is empty and pushed as the encoder
+             * frees the slots */
+            if ((readingDataObjects > freeSpace) &&
+                ((readingDataObjects <= m_encoderQueue->Capacity()) || (acceptedReadings > 0) || !m_encoderQueue->isEmpty())) {
+                IEC104_HOT_LOG_DEBUG("%s Encoder queue full -> %i of %i readings accepted", beforeLog, //LCOV_EXCL_LINE
+                                    static_cast<int>(acceptedReadings), static_cast<int>(readings.size())); //LCOV_EXCL_LINE
+                dataObjects.resize(firstDataObject);
+                break;//LCOV_EXCL_LINE
+            }
+
+            freeSpace -= std::min(readingDataObjects, freeSpace);
+        }
+
+        acceptedReadings++;
+    }
+
+    std::vector<DecodedDataObject> decoded(dataObjects.size());
+
+    std::function<void(size_t, size_t)> decode = [this, &dataObjects, &decoded, ingestTime](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            decodeDataObject(dataObjects[i], decoded[i]);
+            decoded[i].ingestTime = ingestTime;
+        }
+    };
+
+    /* small blocks are not worth the synchronization with the workers */
+    if (m_decodePool && (dataObjects.size() >= static_cast<size_t>(m_decodePool->Workers()) * PARALLEL_DECODE_MIN_OBJECTS)) {
+        m_decodePool->run(dataObjects.size(), decode);
+    }
+    else {
+        decode(0, dataObjects.size());
+    }
+
+    /* packed objects updated by the readings, transmitted once at the end of the call */
+    std::vector<IEC104DataPoint*> pendingPacks;
+
+    size_t nextDataObject = 0;
+
+    for (auto reading = readings.cbegin(); reading != readings.cbegin() + acceptedReadings; reading++)
+    {
+        vector<Datapoint*>& dataPoints = (*reading)->getReadingData();
+        string assetName = (*reading)->getAssetName();
+
+        for (Datapoint* dp : dataPoints) {
+
+            if (dp->getName() == "south_event") {
+
+                IEC104_HOT_LOG_INFO("%s Process south_event", beforeLog);//LCOV_EXCL_LINE
+
+                /* the data objects received before the event are applied first */
+                if (useEncoder) {
+                    drainEncoderQueue();
                 }
 
-                if (cot == CS101_COT_ACTIVATION_CON)
-                {
-                    handleActCon(type, ca, ioa, isNegative);
+                // check if we know the south plugin
+                bool found = false;
+                for (auto southPluginMonitor : m_config->GetMonitoredSouthPlugins()) {
+                    if (assetName == southPluginMonitor->GetAssetName()) {
+                        IEC104_HOT_LOG_INFO("%s Found matching monitored plugin for south_event (%s)", beforeLog, //LCOV_EXCL_LINE
+                                            assetName.c_str());  //LCOV_EXCL_LINE
+                        updateSouthMonitoringInstance(dp, southPluginMonitor);
+                        found = true;
+                        break;//LCOV_EXCL_LINE
+                    }
                 }
-                else if (cot == CS101_COT_ACTIVATION_TERMINATION)
-                {
-                    handleActTerm(type, ca, ioa, isNegative);
+                if (!found) {
+                    Iec104Utility::log_warn("%s Received south_event with unknown asset name: %s -> ignore", beforeLog, //LCOV_EXCL_LINE
+                                            assetName.c_str());  //LCOV_EXCL_LINE
                 }
-                else if (ca != -1 && ioa != -1 && cot != CS101_COT_UNKNOWN_COT && type != -1) {
-
-                    IEC104DataPoint* dp = m_getDataPoint(ca, ioa, type);
-
-                    if (dp) {
-
-                        CP56Time2a ts = NULL;
-
-                        struct sCP56Time2a _ts;
-
-                        if (hasTimestamp) {
-                            ts = CP56Time2a_createFromMsTimestamp(&_ts, timestamp);
-
-                            if (ts) {
-                                CP56Time2a_setInvalid(ts, ts_iv);
-                                CP56Time2a_setSummerTime(ts, ts_su);
-                                CP56Time2a_setSubstituted(ts, ts_sub);
-                                Iec104Utility::log_debug("%s Data point %i:%i (%s) timestamp info: TS=%llu, IV=%d, SU=%d, SUB=%d", //LCOV_EXCL_LINE
-                                                        beforeLog.c_str(), ca, ioa, IEC104DataPoint::getStringFromTypeID(type).c_str(), //LCOV_EXCL_LINE
-                                                        timestamp, static_cast<int>(ts_iv), static_cast<int>(ts_su),
-                                                        static_cast<int>(ts_sub)); //LCOV_EXCL_LINE
-                            }
-                        }
-
-                        // update internal value
-                        m_updateDataPoint(dp, (IEC60870_5_TypeID)type, value, ts, qd);
-
-                        if (cot == CS101_COT_PERIODIC || cot == CS101_COT_SPONTANEOUS ||
-                            cot == CS101_COT_RETURN_INFO_REMOTE || cot == CS101_COT_RETURN_INFO_LOCAL ||
-                            cot == CS101_COT_BACKGROUND_SCAN)
-                        {
-			    uint64_t tsInNs = Hal_getTimeInNs();
-                            std::string tsStrInNs = std::to_string(tsInNs);
-                            //Iec104Utility::log_info("%s Sending data point %i:%i (%s)", //LCOV_EXCL_LINE
-                            //                        beforeLog.c_str(), ca, ioa, IEC104DataPoint::getStringFromTypeID(type).c_str());  //LCOV_EXCL_LINE
-			    Iec104Utility::log_info("%s Sending data point %i:%i (%s) TimestampInNs: %s",  //LCOV_EXCL_LINE
-				                      beforeLog.c_str(), ca, ioa, IEC104DataPoint::getStringFromTypeID(type).c_str(), tsStrInNs.c_str());  //LCOV_EXCL_LINE
-
-                            m_enqueueSpontDatapoint(dp, cot, (IEC60870_5_TypeID)type);
-                        }
-                        else {
-                            Iec104Utility::log_info("%s Data point %i:%i (%s) has unhandled COT: %d -> ignored", //LCOV_EXCL_LINE
-                                                    beforeLog.c_str(), ca, ioa, IEC104DataPoint::getStringFromTypeID(type).c_str(), cot);  //LCOV_EXCL_LINE
-                        }
-                    }
-                    else {
-                        Iec104Utility::log_error("%s Data point %i:%i not found or type %s (%d) not expected", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                                ca, ioa, IEC104DataPoint::getStringFromTypeID(type).c_str(), type);  //LCOV_EXCL_LINE
+            }
+            else if (dp->getName() == "data_object")
+            {
+                DecodedDataObject& decodedDataObject = decoded[nextDataObject++];
+
+                if (useEncoder) {
+                    /* only a reading larger than the queue waits for the encoder to free the slots */
+                    while (!m_encoderQueue->push(std::move(decodedDataObject))) {
+                        m_encoderWakeup.notify_one();
+                        Thread_sleep(1);
                     }
+
+                    m_encoderPushed++;
+
+                    continue;
                 }
-                else {
-                    Iec104Utility::log_info("%s Data point was ignored due to one of those values: CA=%d, IOA=%d, type=%s (%d), COT=%d", //LCOV_EXCL_LINE
-                                            beforeLog.c_str(), ca, ioa, IEC104DataPoint::getStringFromTypeID(type).c_str(), type, cot);  //LCOV_EXCL_LINE
+
+                IEC104_HOT_LOG_INFO("%s Forward data_object", beforeLog);//LCOV_EXCL_LINE
+
+                if ((m_slave == nullptr) || !CS104_Slave_isRunning(m_slave)) {
+                    if (m_logLimiter.accept(m_logSiteNotRunning, 0, 0)) {
+                        Iec104Utility::log_warn("%s Failed to send data: server not running", beforeLog); //LCOV_EXCL_LINE
+                    }
+                    continue;
                 }
 
-                if (value != nullptr) delete value;
+                applyDataObject(decodedDataObject, pendingPacks);
             }
             else {
-               Iec104Utility::log_info("%s Unknown data point name: %s -> ignored", beforeLog.c_str(), dp->getName().c_str()); //LCOV_EXCL_LINE
+               IEC104_HOT_LOG_INFO("%s Unknown data point name: %s -> ignored", beforeLog, dp->getName().c_str()); //LCOV_EXCL_LINE
             }
         }
 
         n++;
     }
 
+    if (useEncoder) {
+        m_encoderWakeup.notify_one();
+    }
+    else {
+        sendPendingPacks(pendingPacks);
+    }
+
+    m_statistics.countReadings(n);
+
     return n;
 }
 
@@ -1678,17 +2382,17 @@ IEC104Server::send(const vector<Reading*>& readings)
  */
 void IEC104Server::printCP56Time2a(CP56Time2a time)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::printCP56Time2a -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::printCP56Time2a"); //LCOV_EXCL_LINE
     Iec104Utility::log_info( //LCOV_EXCL_LINE
-        "%s %02i:%02i:%02i %02i/%02i/%04i", beforeLog.c_str(), CP56Time2a_getHour(time), //LCOV_EXCL_LINE
+        "%s %02i:%02i:%02i %02i/%02i/%04i", beforeLog, CP56Time2a_getHour(time), //LCOV_EXCL_LINE
         CP56Time2a_getMinute(time), CP56Time2a_getSecond(time),
         CP56Time2a_getDayOfMonth(time), CP56Time2a_getMonth(time),
         CP56Time2a_getYear(time) + 2000);
 }
 
-//LCOV_EXCL_START
 /**
- * Callback handler to log sent or received messages (optional)
+ * Callback handler for sent or received messages, counted in the statistics and recorded in the capture ring when
+ * they are enabled
  *
  * @param parameter
  * @param connection	connection object
@@ -1702,19 +2406,98 @@ IEC104Server::rawMessageHandler(void* parameter,
                                      int msgSize, bool sent)
 
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::rawMessageHandler -"; //LCOV_EXCL_LINE
-    std::stringstream stream;
-    stream << "[";
-    for (int i = 0; i < msgSize; i++) {
-        if (i > 0) {
-        stream << ", ";
+    IEC104Server* self = (IEC104Server*)parameter;
+
+    if (self->m_statistics.isEnabled()) {
+        self->m_statistics.recordFrame(reinterpret_cast<uintptr_t>(connection), msg, msgSize, sent);
+    }
+
+    if (self->m_capture.isEnabled()) {
+        self->m_capture.recordApdu(reinterpret_cast<uintptr_t>(connection), msg, msgSize, sent);
+    }
+
+    if (sent && self->m_latencyTracer.isEnabled()) {
+        self->traceSentApdu(msg, msgSize);
+    }
+}
+
+/**
+ * Record the wire latency of the data points of a transmitted monitoring I-frame.
+ * Each traced data point is only recorded once, by the first connection sending it.
+ *
+ * @param msg	        APDU sent by lib60870
+ * @param msgSize	    APDU size
+ */
+void
+IEC104Server::traceSentApdu(const uint8_t* msg, int msgSize)
+{
+    static const int APCI_SIZE = 6;
+
+    /* only I-frames carry an ASDU */
+    if ((msgSize <= APCI_SIZE + 2) || ((msg[2] & 0x01) != 0)) {
+        return;
+    }
+
+    CS101_AppLayerParameters appLayerParams = CS104_Slave_getAppLayerParameters(m_slave);
+
+    int typeId = msg[APCI_SIZE];
+    int numberOfElements = msg[APCI_SIZE + 1] & 0x7f;
+    bool isSequence = (msg[APCI_SIZE + 1] & 0x80) != 0;
+    int cot = msg[APCI_SIZE + 2] & 0x3f;
+
+    if ((cot != CS101_COT_PERIODIC) && (cot != CS101_COT_BACKGROUND_SCAN) && (cot != CS101_COT_SPONTANEOUS) &&
+        (cot != CS101_COT_RETURN_INFO_REMOTE) && (cot != CS101_COT_RETURN_INFO_LOCAL)) {
+        return;
+    }
+
+    int headerSize = APCI_SIZE + 2 + appLayerParams->sizeOfCOT + appLayerParams->sizeOfCA;
+    int ioaSize = appLayerParams->sizeOfIOA;
+
+    if ((numberOfElements == 0) || (msgSize < headerSize + ioaSize)) {
+        return;
+    }
+
+    int ca = msg[headerSize - appLayerParams->sizeOfCA];
+
+    if (appLayerParams->sizeOfCA == 2) {
+        ca += msg[headerSize - 1] * 0x100;
+    }
+
+    /* with SQ=1 only the first IOA is present, the spontaneous data path never sends sequences */
+    int elements = isSequence ? 1 : numberOfElements;
+    int elementSize = (msgSize - headerSize) / numberOfElements;
+
+    uint64_t wireTime = Hal_getTimeInNs();
+
+    for (int i = 0; i < elements; i++) {
+        const uint8_t* ioaPtr = msg + headerSize + i * elementSize;
+
+        if (ioaPtr + ioaSize > msg + msgSize) {
+            break;
+        }
+
+        int ioa = ioaPtr[0];
+
+        if (ioaSize > 1) ioa += ioaPtr[1] * 0x100;
+        if (ioaSize > 2) ioa += ioaPtr[2] * 0x10000;
+
+        IEC104DataPoint* dp = m_findDataPoint(ca, ioa);
+
+        if (dp == nullptr) {
+            continue;
+        }
+
+        uint64_t ingestTime = dp->m_trace.ingest.exchange(0, std::memory_order_relaxed);
+        uint64_t enqueueTime = dp->m_trace.enqueue.exchange(0, std::memory_order_relaxed);
+
+        if ((ingestTime == 0) || (enqueueTime == 0)) {
+            continue;
         }
-        stream << "0x" << std::setfill('0') << std::setw(2) << std::hex << static_cast<unsigned int>(msg[i]);
+
+        m_latencyTracer.record(IEC104LatencyTracer::ENQUEUE_TO_WIRE, typeId, wireTime - enqueueTime);
+        m_latencyTracer.record(IEC104LatencyTracer::INGEST_TO_WIRE, typeId, wireTime - ingestTime);
     }
-    stream << "]";
-    Iec104Utility::log_debug("%s %s: %s", beforeLog.c_str(), sent?"SEND":"RCVD", stream.str().c_str()); //LCOV_EXCL_LINE
 }
-//LCOV_EXCL_STOP
 
 /**
  * Callback handler for clock synchronization
@@ -1730,10 +2513,10 @@ IEC104Server::clockSyncHandler(void* parameter,
                                     IMasterConnection connection,
                                     CS101_ASDU asdu, CP56Time2a newTime)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::clockSyncHandler -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::clockSyncHandler"); //LCOV_EXCL_LINE
     IEC104Server* self = (IEC104Server*)parameter;
 
-    Iec104Utility::log_info("%s Received time sync command with time:", beforeLog.c_str()); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s Received time sync command with time:", beforeLog); //LCOV_EXCL_LINE
 
     printCP56Time2a(newTime);
 
@@ -1744,17 +2527,17 @@ IEC104Server::clockSyncHandler(void* parameter,
         nsSinceEpoch nsTime = newSystemTimeInMs * 10000000LLU;
 
         if (Hal_setTimeInNs(nsTime)) {
-            Iec104Utility::log_info("%s Time sync success", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_info("%s Time sync success", beforeLog); //LCOV_EXCL_LINE
         }
         else {
-            Iec104Utility::log_error("%s Time sync failed", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_error("%s Time sync failed", beforeLog); //LCOV_EXCL_LINE
         }
 
         /* Set time for ACT_CON message */
         CP56Time2a_setFromMsTimestamp(newTime, Hal_getTimeInMs());
     }
     else {
-        Iec104Utility::log_info("%s Time sync disabled -> ignore time sync command", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_info("%s Time sync disabled -> ignore time sync command", beforeLog); //LCOV_EXCL_LINE
 
         /* ignore time -> send negative response */
         CS101_ASDU_setNegative(asdu, true);
@@ -1775,169 +2558,259 @@ isBroadcastCA(int ca, CS101_AppLayerParameters alParams)
     return false;
 }
 
-void
-IEC104Server::sendInterrogationResponse(IMasterConnection connection, CS101_ASDU asdu, int ca, int qoi)
+/**
+ * Create the information object reporting the current value of a monitoring data point
+ *
+ * @param dp                    monitoring data point
+ * @param ioBuf                 buffer the information object is created in (static ASDU)
+ * @param sendWithTimestamp     create the CP56 time tagged type, with the current time
+ * @return                      information object, NULL when the type cannot be reported
+ */
+InformationObject
+IEC104Server::m_createInformationObject(IEC104DataPoint* dp, uint8_t* ioBuf, bool sendWithTimestamp)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::sendInterrogationResponse -"; //LCOV_EXCL_LINE
-    Iec104Utility::log_info("%s Sending interrogation response for CA=%d, QOI=%d...", beforeLog.c_str(), ca, qoi); //LCOV_EXCL_LINE
-    CS101_ASDU_setCA(asdu, ca);
+    const char* beforeLog = LOG_PREFIX("IEC104Server::m_createInformationObject"); //LCOV_EXCL_LINE
+    InformationObject io = NULL;
 
-    IMasterConnection_sendACT_CON(connection, asdu, false);
+    switch (dp->m_type) {
+        case IEC60870_TYPE_SP:
+            if (sendWithTimestamp) {
+                sCP56Time2a cpTs;
 
-    std::map<int, IEC104DataPoint*> ld = m_exchangeDefinitions[ca];
+                IEC104TimeEncoder::threadInstance().encode(&cpTs, Hal_getTimeInMs());
 
-    std::map<int, IEC104DataPoint*>::iterator it;
+                io = (InformationObject)SinglePointWithCP56Time2a_create((SinglePointWithCP56Time2a)ioBuf, dp->m_ioa, (bool)(dp->m_value->sp.value), dp->m_value->sp.quality, &cpTs);
+            }
+            else  {
+                io = (InformationObject)SinglePointInformation_create((SinglePointInformation)ioBuf, dp->m_ioa, (bool)(dp->m_value->sp.value), dp->m_value->sp.quality);
+            }
+            break;//LCOV_EXCL_LINE
 
-    sCS101_StaticASDU _asdu;
-    uint8_t ioBuf[250];
+        case IEC60870_TYPE_DP:
+            if (sendWithTimestamp) {
+                sCP56Time2a cpTs;
 
-    CS101_AppLayerParameters alParams =
-            IMasterConnection_getApplicationLayerParameters(connection);
+                IEC104TimeEncoder::threadInstance().encode(&cpTs, Hal_getTimeInMs());
 
-    CS101_ASDU newASDU = CS101_ASDU_initializeStatic(&_asdu, alParams, false, CS101_COT_INTERROGATED_BY_STATION, CS101_ASDU_getOA(asdu), ca, false, false);
-    int ioa = 0;
-    int typeId = CS101_ASDU_getTypeID(asdu);
-    for (it = ld.begin(); it != ld.end(); it++)
-    {
-        IEC104DataPoint* dp = it->second;
+                io = (InformationObject)DoublePointWithCP56Time2a_create((DoublePointWithCP56Time2a)ioBuf, dp->m_ioa, (DoublePointValue)dp->m_value->dp.value, dp->m_value->dp.quality, &cpTs);
+            }
+            else {
+                io = (InformationObject)DoublePointInformation_create((DoublePointInformation)ioBuf, dp->m_ioa, (DoublePointValue)dp->m_value->dp.value, dp->m_value->dp.quality);
+            }
+            break;//LCOV_EXCL_LINE
 
-        if ((dp != nullptr) && dp->isMonitoringType()) {
+        case IEC60870_TYPE_NORMALIZED:
+            if (sendWithTimestamp) {
+                sCP56Time2a cpTs;
 
-            InformationObject io = NULL;
+                IEC104TimeEncoder::threadInstance().encode(&cpTs, Hal_getTimeInMs());
 
-            //TODO when value not initialized use invalid/non-topical for quality
-            //TODO when the value has no original timestamp then create timestamp when sending
+                io = (InformationObject)MeasuredValueNormalizedWithCP56Time2a_create((MeasuredValueNormalizedWithCP56Time2a)ioBuf, dp->m_ioa, dp->m_value->mv_normalized.value, dp->m_value->mv_normalized.quality, &cpTs);
 
-            if(((dp->m_gi_groups >> (qoi - IEC60870_QOI_STATION)) & 1) != 1) {
-                Iec104Utility::log_debug("%s  Skipping response for GI group %d", beforeLog.c_str(), dp->m_gi_groups); //LCOV_EXCL_LINE
-                continue;
             }
+            else {
+                io = (InformationObject)MeasuredValueNormalized_create((MeasuredValueNormalized)ioBuf, dp->m_ioa, dp->m_value->mv_normalized.value, dp->m_value->mv_normalized.quality);
+            }
+            break;//LCOV_EXCL_LINE
 
-            bool sendWithTimestamp = false;
-
-            switch (dp->m_type) {
-                case IEC60870_TYPE_SP:
-                    if (sendWithTimestamp) {
-                        sCP56Time2a cpTs;
+        case IEC60870_TYPE_SCALED:
+            if (sendWithTimestamp) {
+                sCP56Time2a cpTs;
 
-                        CP56Time2a_createFromMsTimestamp(&cpTs, Hal_getTimeInMs());
+                IEC104TimeEncoder::threadInstance().encode(&cpTs, Hal_getTimeInMs());
 
-                        io = (InformationObject)SinglePointWithCP56Time2a_create((SinglePointWithCP56Time2a)&ioBuf, dp->m_ioa, (bool)(dp->m_value.sp.value), dp->m_value.sp.quality, &cpTs);
-                    }
-                    else  {
-                        io = (InformationObject)SinglePointInformation_create((SinglePointInformation)&ioBuf, dp->m_ioa, (bool)(dp->m_value.sp.value), dp->m_value.sp.quality);
-                    }
-                    break;//LCOV_EXCL_LINE
+                io = (InformationObject)MeasuredValueScaledWithCP56Time2a_create((MeasuredValueScaledWithCP56Time2a)ioBuf, dp->m_ioa, dp->m_value->mv_scaled.value, dp->m_value->mv_scaled.quality, &cpTs);
+            }
+            else {
+                io = (InformationObject)MeasuredValueScaled_create((MeasuredValueScaled)ioBuf, dp->m_ioa, dp->m_value->mv_scaled.value, dp->m_value->mv_scaled.quality);
+            }
+            break;//LCOV_EXCL_LINE
 
-                case IEC60870_TYPE_DP:
-                    if (sendWithTimestamp) {
-                        sCP56Time2a cpTs;
+        case IEC60870_TYPE_SHORT:
+            if (sendWithTimestamp) {
+                sCP56Time2a cpTs;
 
-                        CP56Time2a_createFromMsTimestamp(&cpTs, Hal_getTimeInMs());
+                IEC104TimeEncoder::threadInstance().encode(&cpTs, Hal_getTimeInMs());
 
-                        io = (InformationObject)DoublePointWithCP56Time2a_create((DoublePointWithCP56Time2a)&ioBuf, dp->m_ioa, (DoublePointValue)dp->m_value.dp.value, dp->m_value.dp.quality, &cpTs);
-                    }
-                    else {
-                        io = (InformationObject)DoublePointInformation_create((DoublePointInformation)&ioBuf, dp->m_ioa, (DoublePointValue)dp->m_value.dp.value, dp->m_value.dp.quality);
-                    }
-                    break;//LCOV_EXCL_LINE
+                io = (InformationObject)MeasuredValueShortWithCP56Time2a_create((MeasuredValueShortWithCP56Time2a)ioBuf, dp->m_ioa, dp->m_value->mv_short.value, dp->m_value->mv_short.quality, &cpTs);
+            }
+            else {
+                io = (InformationObject)MeasuredValueShort_create((MeasuredValueShort)ioBuf, dp->m_ioa, dp->m_value->mv_short.value, dp->m_value->mv_short.quality);
+            }
+            break;//LCOV_EXCL_LINE
 
-                case IEC60870_TYPE_NORMALIZED:
-                    if (sendWithTimestamp) {
-                        sCP56Time2a cpTs;
+        case IEC60870_TYPE_STEP_POS:
+            if (sendWithTimestamp) {
+                sCP56Time2a cpTs;
 
-                        CP56Time2a_createFromMsTimestamp(&cpTs, Hal_getTimeInMs());
+                IEC104TimeEncoder::threadInstance().encode(&cpTs, Hal_getTimeInMs());
 
-                        io = (InformationObject)MeasuredValueNormalizedWithCP56Time2a_create((MeasuredValueNormalizedWithCP56Time2a)&ioBuf, dp->m_ioa, dp->m_value.mv_normalized.value, dp->m_value.mv_normalized.quality, &cpTs);
+                io = (InformationObject)StepPositionWithCP56Time2a_create((StepPositionWithCP56Time2a)ioBuf, dp->m_ioa, dp->m_value->stepPos.posValue, dp->m_value->stepPos.transient, dp->m_value->stepPos.quality, &cpTs);
+            }
+            else {
+                io = (InformationObject)StepPositionInformation_create((StepPositionInformation)ioBuf, dp->m_ioa, dp->m_value->stepPos.posValue, dp->m_value->stepPos.transient, dp->m_value->stepPos.quality);
+            }
+            break;//LCOV_EXCL_LINE
 
-                    }
-                    else {
-                        io = (InformationObject)MeasuredValueNormalized_create((MeasuredValueNormalized)&ioBuf, dp->m_ioa, dp->m_value.mv_normalized.value, dp->m_value.mv_normalized.quality);
-                    }
-                    break;//LCOV_EXCL_LINE
+        case IEC60870_TYPE_PACKED_SP:
+            {
+                struct sStatusAndStatusChangeDetection scd;
 
-                case IEC60870_TYPE_SCALED:
-                    if (sendWithTimestamp) {
-                        sCP56Time2a cpTs;
+                dp->encodeStatusAndChangeDetection(&scd);
 
-                        CP56Time2a_createFromMsTimestamp(&cpTs, Hal_getTimeInMs());
+                io = (InformationObject)PackedSinglePointWithSCD_create((PackedSinglePointWithSCD)ioBuf, dp->m_ioa, &scd, dp->packedQuality());
+            }
+            break;//LCOV_EXCL_LINE
 
-                        io = (InformationObject)MeasuredValueScaledWithCP56Time2a_create((MeasuredValueScaledWithCP56Time2a)&ioBuf, dp->m_ioa, dp->m_value.mv_scaled.value, dp->m_value.mv_scaled.quality, &cpTs);
-                    }
-                    else {
-                        io = (InformationObject)MeasuredValueScaled_create((MeasuredValueScaled)&ioBuf, dp->m_ioa, dp->m_value.mv_scaled.value, dp->m_value.mv_scaled.quality);
-                    }
-                    break;//LCOV_EXCL_LINE
+        case IEC60870_TYPE_BITSTRING:
+            io = (InformationObject)BitString32_createEx((BitString32)ioBuf, dp->m_ioa, dp->m_value->bitstring.value, dp->packedQuality());
+            break;//LCOV_EXCL_LINE
 
-                case IEC60870_TYPE_SHORT:
-                    if (sendWithTimestamp) {
-                        sCP56Time2a cpTs;
+        case IEC60870_TYPE_COUNTER:
+            {
+                struct sBinaryCounterReading bcr;
 
-                        CP56Time2a_createFromMsTimestamp(&cpTs, Hal_getTimeInMs());
+                BinaryCounterReading_create(&bcr, dp->m_value->counter.value, dp->m_value->counter.quality.seq,
+                                            dp->m_value->counter.quality.cy, dp->m_value->counter.quality.ca,
+                                            dp->m_value->counter.quality.invalid);
 
-                        io = (InformationObject)MeasuredValueShortWithCP56Time2a_create((MeasuredValueShortWithCP56Time2a)&ioBuf, dp->m_ioa, dp->m_value.mv_short.value, dp->m_value.mv_short.quality, &cpTs);
-                    }
-                    else {
-                        io = (InformationObject)MeasuredValueShort_create((MeasuredValueShort)&ioBuf, dp->m_ioa, dp->m_value.mv_short.value, dp->m_value.mv_short.quality);
-                    }
-                    break;//LCOV_EXCL_LINE
+                io = (InformationObject)IntegratedTotals_create((IntegratedTotals)ioBuf, dp->m_ioa, &bcr);
+            }
+            break;//LCOV_EXCL_LINE
 
-                case IEC60870_TYPE_STEP_POS:
-                    if (sendWithTimestamp) {
-                        sCP56Time2a cpTs;
+        default:
+            IEC104_HOT_LOG_INFO("%s  No response to send for %i:%i type %s (%d)", beforeLog, //LCOV_EXCL_LINE
+                                dp->m_ca, dp->m_ioa, IEC104DataPoint::getStringFromTypeID(dp->m_type), dp->m_type); //LCOV_EXCL_LINE
+            break; //LCOV_EXCL_LINE
 
-                        CP56Time2a_createFromMsTimestamp(&cpTs, Hal_getTimeInMs());
+    }
 
-                        io = (InformationObject)StepPositionWithCP56Time2a_create((StepPositionWithCP56Time2a)&ioBuf, dp->m_ioa, dp->m_value.stepPos.posValue, dp->m_value.stepPos.transient, dp->m_value.stepPos.quality, &cpTs);
-                    }
-                    else {
-                        io = (InformationObject)StepPositionInformation_create((StepPositionInformation)&ioBuf, dp->m_ioa, dp->m_value.stepPos.posValue, dp->m_value.stepPos.transient, dp->m_value.stepPos.quality);
-                    }
-                    break;//LCOV_EXCL_LINE
-                default:
-                    Iec104Utility::log_info("%s  No response to send for %i:%i type %s (%d)", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                            ca, dp->m_ioa, IEC104DataPoint::getStringFromTypeID(dp->m_type).c_str(), dp->m_type); //LCOV_EXCL_LINE
-                    break; //LCOV_EXCL_LINE
+    return io;
+}
 
-            }
+/**
+ * Encode the current values of data points of one CA: an ASDU is sent each time it is full, then the last one
+ *
+ * @param points        monitoring data points of the CA, in transmission order
+ * @param cot           cause of transmission of the ASDUs
+ * @param oa            originator address
+ * @param ca            common address of the points
+ * @param alParams      application layer parameters
+ * @param connection    connection the ASDUs are sent to (interrogation), nullptr to enqueue them for the masters
+ */
+void
+IEC104Server::m_sendDataPoints(const std::vector<IEC104DataPoint*>& points, CS101_CauseOfTransmission cot, int oa, int ca,
+                               CS101_AppLayerParameters alParams, IMasterConnection connection)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Server::m_sendDataPoints"); //LCOV_EXCL_LINE
 
-            if (io) {
-                if (!CS101_ASDU_addInformationObject(newASDU, io)) {
-                    Iec104Utility::log_info( //LCOV_EXCL_LINE
-                        "%s  Sending response without information object for %i:%i type %s (%d)", beforeLog.c_str(), //LCOV_EXCL_LINE
-                        ca, dp->m_ioa, IEC104DataPoint::getStringFromTypeID(dp->m_type).c_str(), dp->m_type);//LCOV_EXCL_LINE
-                    IMasterConnection_sendASDU(connection, newASDU);
+    sCS101_StaticASDU _asdu;
+    uint8_t ioBuf[250];
 
-                    newASDU = CS101_ASDU_initializeStatic(&_asdu, alParams, false, CS101_COT_INTERROGATED_BY_STATION, CS101_ASDU_getOA(asdu), ca, false, false);
+    CS101_ASDU newASDU = CS101_ASDU_initializeStatic(&_asdu, alParams, false, cot, oa, ca, false, false);
 
-                    CS101_ASDU_addInformationObject(newASDU, io);
-                    ioa = dp->m_ioa;
-                    typeId = dp->m_type;
-                }
-            }
-            else {
-                Iec104Utility::log_debug("%s  No information object for %i:%i type %s (%d)", beforeLog.c_str(), ca, dp->m_ioa, //LCOV_EXCL_LINE
-                                        IEC104DataPoint::getStringFromTypeID(dp->m_type).c_str(), dp->m_type); //LCOV_EXCL_LINE
-            }
+    auto sendASDU = [this, connection, &newASDU]() {
+        if (connection) {
+            IMasterConnection_sendASDU(connection, newASDU);
         }
         else {
-            Iec104Utility::log_debug("%s  Datapoint is null (%s) or not a monitoring type (true)", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                    (dp == nullptr)?"true":"false"); //LCOV_EXCL_LINE
+            CS104_Slave_enqueueASDU(m_slave, newASDU);
+            m_statistics.countAsduEnqueued();
         }
-    }
+    };
 
-    if (newASDU) {
-        if (CS101_ASDU_getNumberOfElements(newASDU) > 0) {
-            Iec104Utility::log_info("%s  Sending response for %i:%i type %s (%d)", beforeLog.c_str(), ca, ioa, //LCOV_EXCL_LINE
-                                    IEC104DataPoint::getStringFromTypeID(typeId).c_str(), typeId); //LCOV_EXCL_LINE
-            IMasterConnection_sendASDU(connection, newASDU);
+    for (IEC104DataPoint* dp : points) {
+        InformationObject io = m_createInformationObject(dp, ioBuf, false);
+
+        if (io == NULL) {
+            IEC104_HOT_LOG_DEBUG("%s  No information object for %i:%i type %s (%d)", beforeLog, ca, dp->m_ioa, //LCOV_EXCL_LINE
+                                IEC104DataPoint::getStringFromTypeID(dp->m_type), dp->m_type); //LCOV_EXCL_LINE
+            continue;
         }
-        else {
-            Iec104Utility::log_debug("%s  No ASDU elements to send", beforeLog.c_str()); //LCOV_EXCL_LINE
+
+        if (!CS101_ASDU_addInformationObject(newASDU, io)) {
+            IEC104_HOT_LOG_DEBUG("%s  Sending %i data points of CA %i, COT %i", beforeLog, //LCOV_EXCL_LINE
+                                CS101_ASDU_getNumberOfElements(newASDU), ca, cot); //LCOV_EXCL_LINE
+            sendASDU();
+
+            newASDU = CS101_ASDU_initializeStatic(&_asdu, alParams, false, cot, oa, ca, false, false);
+
+            CS101_ASDU_addInformationObject(newASDU, io);
+        }
+    }
+
+    if (CS101_ASDU_getNumberOfElements(newASDU) > 0) {
+        IEC104_HOT_LOG_DEBUG("%s  Sending %i data points of CA %i, COT %i", beforeLog, //LCOV_EXCL_LINE
+                            CS101_ASDU_getNumberOfElements(newASDU), ca, cot); //LCOV_EXCL_LINE
+        sendASDU();
+    }
+    else {
+        IEC104_HOT_LOG_DEBUG("%s  No ASDU elements to send", beforeLog); //LCOV_EXCL_LINE
+    }
+}
+
+void
+IEC104Server::sendInterrogationResponse(IMasterConnection connection, CS101_ASDU asdu, int ca, int qoi)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Server::sendInterrogationResponse"); //LCOV_EXCL_LINE
+    IEC104_HOT_LOG_INFO("%s Sending interrogation response for CA=%d, QOI=%d...", beforeLog, ca, qoi); //LCOV_EXCL_LINE
+    CS101_ASDU_setCA(asdu, ca);
+
+    IMasterConnection_sendACT_CON(connection, asdu, false);
+
+    CS101_AppLayerParameters alParams =
+            IMasterConnection_getApplicationLayerParameters(connection);
+
+    /* points of the requested group, reported individually */
+    std::vector<IEC104DataPoint*> points;
+
+    /* points of the CA in IOA order: filtered on the metadata arrays of the point store, only the selected
+     * points are dereferenced when encoded */
+    const IEC104PointStore::Block* block = m_pointTable->Store().findBlock(ca);
+
+    if (block != nullptr) {
+        const int groupMask = 1 << (qoi - IEC60870_QOI_STATION);
+
+        points.reserve(block->points.size());
+
+        for (size_t i = 0; i < block->points.size(); i++)
+        {
+            //TODO when value not initialized use invalid/non-topical for quality
+            //TODO when the value has no original timestamp then create timestamp when sending
+
+            const uint8_t flags = block->flags[i];
+
+            if ((flags & IEC104PointStore::FLAG_MONITORING) == 0) {
+                IEC104_HOT_LOG_DEBUG("%s  Skipping %i:%i, not a monitoring type", beforeLog, ca, //LCOV_EXCL_LINE
+                                    block->points[i]->m_ioa); //LCOV_EXCL_LINE
+                continue;
+            }
+
+            if ((flags & IEC104PointStore::FLAG_PACKED) != 0) {
+                IEC104_HOT_LOG_DEBUG("%s  Skipping %i:%i, reported in packed object %i:%i", beforeLog, ca, //LCOV_EXCL_LINE
+                                    block->points[i]->m_ioa, block->points[i]->m_pack->m_ca, //LCOV_EXCL_LINE
+                                    block->points[i]->m_pack->m_ioa); //LCOV_EXCL_LINE
+                continue;
+            }
+
+            if (block->types[i] == IEC60870_TYPE_COUNTER) {
+                IEC104_HOT_LOG_DEBUG("%s  Skipping %i:%i, reported by counter interrogation", beforeLog, ca, //LCOV_EXCL_LINE
+                                    block->points[i]->m_ioa); //LCOV_EXCL_LINE
+                continue;
+            }
+
+            if ((block->giGroups[i] & groupMask) == 0) {
+                IEC104_HOT_LOG_DEBUG("%s  Skipping response for GI group %d", beforeLog, block->giGroups[i]); //LCOV_EXCL_LINE
+                continue;
+            }
+
+            points.push_back(block->points[i]);
         }
     }
 
-    Iec104Utility::log_info("%s  Sending ACT-TERM", beforeLog.c_str()); //LCOV_EXCL_LINE
+    m_sendDataPoints(points, CS101_COT_INTERROGATED_BY_STATION, CS101_ASDU_getOA(asdu), ca, alParams, connection);
+
+    IEC104_HOT_LOG_INFO("%s  Sending ACT-TERM", beforeLog); //LCOV_EXCL_LINE
     IMasterConnection_sendACT_TERM(connection, asdu);
 }
 
@@ -1955,44 +2828,237 @@ IEC104Server::interrogationHandler(void* parameter,
                                         IMasterConnection connection,
                                         CS101_ASDU asdu, uint8_t qoi)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::interrogationHandler -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::interrogationHandler"); //LCOV_EXCL_LINE
     IEC104Server* self = (IEC104Server*)parameter;
 
-    Iec104Utility::log_info("%s Received interrogation for group %i", beforeLog.c_str(), qoi); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s Received interrogation for group %i", beforeLog, qoi); //LCOV_EXCL_LINE
 
+    uint64_t startTime = Hal_getTimeInNs();
     int ca = CS101_ASDU_getCA(asdu);
 
     CS101_AppLayerParameters alParams = IMasterConnection_getApplicationLayerParameters(connection);
 
     if (qoi < 20 || qoi >36) {
-        Iec104Utility::log_debug("%s Interrogation group %i out of range [20..36], sending ACT-CON", beforeLog.c_str(), qoi); //LCOV_EXCL_LINE
+        Iec104Utility::log_debug("%s Interrogation group %i out of range [20..36], sending ACT-CON", beforeLog, qoi); //LCOV_EXCL_LINE
         IMasterConnection_sendACT_CON(connection, asdu, true);
         return true;
     }
 
     if (isBroadcastCA(ca, alParams)) {
-        std::map<int, std::map<int, IEC104DataPoint*>>::iterator it;
-        Iec104Utility::log_debug("%s CA %d is boradcast, sending all interrogation responses", beforeLog.c_str(), ca); //LCOV_EXCL_LINE
-        for (it = self->m_exchangeDefinitions.begin(); it != self->m_exchangeDefinitions.end(); it++)
+        Iec104Utility::log_debug("%s CA %d is boradcast, sending all interrogation responses", beforeLog, ca); //LCOV_EXCL_LINE
+        for (const IEC104PointStore::Block& block : self->m_pointTable->Store().Blocks())
         {
-            ca = it->first;
+            ca = block.ca;
 
             self->sendInterrogationResponse(connection, asdu, ca, qoi);
         }
     }
     else {
-        if (self->m_exchangeDefinitions.count(ca) == 0) {
+        if (self->m_pointTable->Definitions().count(ca) == 0) {
             CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_CA);
-            Iec104Utility::log_debug("%s No exchange definition for CA %d, sending ACT-CON", beforeLog.c_str(), ca); //LCOV_EXCL_LINE
+            Iec104Utility::log_debug("%s No exchange definition for CA %d, sending ACT-CON", beforeLog, ca); //LCOV_EXCL_LINE
             IMasterConnection_sendACT_CON(connection, asdu, true);
             return true;
         }
         else {
-            Iec104Utility::log_debug("%s Logical device with CA %i found, sending interrogation response", beforeLog.c_str(), ca); //LCOV_EXCL_LINE
+            Iec104Utility::log_debug("%s Logical device with CA %i found, sending interrogation response", beforeLog, ca); //LCOV_EXCL_LINE
             self->sendInterrogationResponse(connection, asdu, ca, qoi);
         }
     }
 
+    self->m_statistics.recordInterrogation(reinterpret_cast<uintptr_t>(connection), Hal_getTimeInNs() - startTime);
+
+    return true;
+}
+
+void
+IEC104Server::sendCounterInterrogationResponse(IMasterConnection connection, CS101_ASDU asdu, int ca, int group, int frz)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Server::sendCounterInterrogationResponse"); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s Sending counter interrogation response for CA=%d, group=%d...", beforeLog, ca, group); //LCOV_EXCL_LINE
+    CS101_ASDU_setCA(asdu, ca);
+
+    IMasterConnection_sendACT_CON(connection, asdu, false);
+
+    /* a freeze only takes the snapshot, the master reads it with a following read request */
+    if (frz == IEC60870_QCC_FRZ_FREEZE_WITHOUT_RESET) {
+        m_counters.freeze(ca, group);
+
+        Iec104Utility::log_info("%s  Counters frozen, sending ACT-TERM", beforeLog); //LCOV_EXCL_LINE
+        IMasterConnection_sendACT_TERM(connection, asdu);
+        return;
+    }
+
+    /* the snapshots are immutable, counter updates from send() are not blocked while they are transmitted */
+    std::vector<IEC104CounterStore::Snapshot> snapshots = m_counters.snapshots(ca, group);
+
+    CS101_CauseOfTransmission cot = (group == 0) ? CS101_COT_REQUESTED_BY_GENERAL_COUNTER :
+                                    (CS101_CauseOfTransmission)(CS101_COT_REQUESTED_BY_GROUP_1_COUNTER + group - 1);
+
+    sCS101_StaticASDU _asdu;
+    uint8_t ioBuf[250];
+
+    CS101_AppLayerParameters alParams = IMasterConnection_getApplicationLayerParameters(connection);
+
+    CS101_ASDU newASDU = CS101_ASDU_initializeStatic(&_asdu, alParams, false, cot, CS101_ASDU_getOA(asdu), ca, false, false);
+
+    for (const IEC104CounterStore::Snapshot& snapshot : snapshots) {
+        for (const IEC104CounterStore::Counter& counter : *snapshot.counters) {
+            struct sBinaryCounterReading bcr;
+            InformationObject io = NULL;
+
+            BinaryCounterReading_create(&bcr, counter.value, snapshot.sequence, counter.carry, counter.adjusted, counter.invalid);
+
+            if (counter.typeId == M_IT_TB_1) {
+                io = (InformationObject)IntegratedTotalsWithCP56Time2a_create((IntegratedTotalsWithCP56Time2a)&ioBuf, counter.ioa,
+                                                                              &bcr, (CP56Time2a)&(counter.ts));
+            }
+            else if (counter.typeId == M_IT_TA_1) {
+                struct sCP24Time2a ts24;
+
+                toCP24Time2a(&ts24, &(counter.ts));
+
+                io = (InformationObject)IntegratedTotalsWithCP24Time2a_create((IntegratedTotalsWithCP24Time2a)&ioBuf, counter.ioa,
+                                                                              &bcr, &ts24);
+            }
+            else {
+                io = (InformationObject)IntegratedTotals_create((IntegratedTotals)&ioBuf, counter.ioa, &bcr);
+            }
+
+            if (!CS101_ASDU_addInformationObject(newASDU, io)) {
+                IMasterConnection_sendASDU(connection, newASDU);
+
+                newASDU = CS101_ASDU_initializeStatic(&_asdu, alParams, false, cot, CS101_ASDU_getOA(asdu), ca, false, false);
+
+                CS101_ASDU_addInformationObject(newASDU, io);
+            }
+        }
+    }
+
+    if (CS101_ASDU_getNumberOfElements(newASDU) > 0) {
+        IMasterConnection_sendASDU(connection, newASDU);
+    }
+
+    Iec104Utility::log_info("%s  Sending ACT-TERM", beforeLog); //LCOV_EXCL_LINE
+    IMasterConnection_sendACT_TERM(connection, asdu);
+}
+
+/**
+ * Callback handler for read command, the current value of the data point is sent with COT requested
+ *
+ * @param parameter
+ * @param connection	connection object
+ * @param asdu	        asdu
+ * @param ioa	        information object address of the data point to read
+ * @return 		boolean
+ */
+bool
+IEC104Server::readHandler(void* parameter, IMasterConnection connection, CS101_ASDU asdu, int ioa)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Server::readHandler"); //LCOV_EXCL_LINE
+    IEC104Server* self = (IEC104Server*)parameter;
+
+    int ca = CS101_ASDU_getCA(asdu);
+
+    Iec104Utility::log_info("%s Received read command for %i:%i", beforeLog, ca, ioa); //LCOV_EXCL_LINE
+
+    IEC104DataPoint* dp = self->m_findDataPoint(ca, ioa);
+
+    if ((dp == nullptr) || !dp->isMonitoringType()) {
+        Iec104Utility::log_warn("%s read command for %i:%i - Unknown IOA", beforeLog, ca, ioa); //LCOV_EXCL_LINE
+        CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_IOA);
+        CS101_ASDU_setNegative(asdu, true);
+        IMasterConnection_sendASDU(connection, asdu);
+        return true;
+    }
+
+    /* a single point of a packed object is only reported as a bit of the packed object */
+    if (dp->m_pack != nullptr) {
+        dp = dp->m_pack;
+    }
+
+    sCS101_StaticASDU _asdu;
+    uint8_t ioBuf[250];
+
+    CS101_AppLayerParameters alParams = IMasterConnection_getApplicationLayerParameters(connection);
+
+    CS101_ASDU newASDU = CS101_ASDU_initializeStatic(&_asdu, alParams, false, CS101_COT_REQUEST, CS101_ASDU_getOA(asdu), ca, false, false);
+
+    InformationObject io = self->m_createInformationObject(dp, ioBuf, false);
+
+    if ((io == NULL) || !CS101_ASDU_addInformationObject(newASDU, io)) {
+        Iec104Utility::log_warn("%s read command for %i:%i - Type %s (%d) cannot be read", beforeLog, ca, ioa, //LCOV_EXCL_LINE
+                                IEC104DataPoint::getStringFromTypeID(dp->m_type), dp->m_type); //LCOV_EXCL_LINE
+        CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_IOA);
+        CS101_ASDU_setNegative(asdu, true);
+        IMasterConnection_sendASDU(connection, asdu);
+        return true;
+    }
+
+    IMasterConnection_sendASDU(connection, newASDU);
+
+    return true;
+}
+
+/**
+ * Callback handler for counter interrogation
+ *
+ * @param parameter
+ * @param connection	connection object
+ * @param asdu	        asdu
+ * @param qcc	        qualifier of counter interrogation (RQT and FRZ)
+ * @return 		boolean
+ */
+bool
+IEC104Server::counterInterrogationHandler(void* parameter,
+                                          IMasterConnection connection,
+                                          CS101_ASDU asdu, QualifierOfCIC qcc)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Server::counterInterrogationHandler"); //LCOV_EXCL_LINE
+    IEC104Server* self = (IEC104Server*)parameter;
+
+    int rqt = qcc & 0x3f;
+    int frz = qcc & 0xc0;
+
+    Iec104Utility::log_info("%s Received counter interrogation RQT=%i FRZ=%i", beforeLog, rqt, frz >> 6); //LCOV_EXCL_LINE
+
+    int ca = CS101_ASDU_getCA(asdu);
+
+    CS101_AppLayerParameters alParams = IMasterConnection_getApplicationLayerParameters(connection);
+
+    if (rqt < 1 || rqt > IEC60870_QCC_RQT_GENERAL) {
+        Iec104Utility::log_debug("%s Counter request %i out of range [1..5], sending ACT-CON", beforeLog, rqt); //LCOV_EXCL_LINE
+        IMasterConnection_sendACT_CON(connection, asdu, true);
+        return true;
+    }
+
+    /* the counters are owned by the south plugins and cannot be reset from here */
+    if ((frz == IEC60870_QCC_FRZ_COUNTER_RESET) || (frz == IEC60870_QCC_FRZ_FREEZE_WITH_RESET)) {
+        Iec104Utility::log_warn("%s Counter reset is not supported, sending ACT-CON", beforeLog); //LCOV_EXCL_LINE
+        IMasterConnection_sendACT_CON(connection, asdu, true);
+        return true;
+    }
+
+    int group = (rqt == IEC60870_QCC_RQT_GENERAL) ? 0 : rqt;
+
+    if (isBroadcastCA(ca, alParams)) {
+        Iec104Utility::log_debug("%s CA %d is broadcast, sending all counter interrogation responses", beforeLog, ca); //LCOV_EXCL_LINE
+        for (int counterCa : self->m_counters.Cas()) {
+            self->sendCounterInterrogationResponse(connection, asdu, counterCa, group, frz);
+        }
+    }
+    else {
+        if (!self->m_counters.hasCounters(ca)) {
+            CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_CA);
+            Iec104Utility::log_debug("%s No counter for CA %d, sending ACT-CON", beforeLog, ca); //LCOV_EXCL_LINE
+            IMasterConnection_sendACT_CON(connection, asdu, true);
+            return true;
+        }
+        else {
+            self->sendCounterInterrogationResponse(connection, asdu, ca, group, frz);
+        }
+    }
+
     return true;
 }
 
@@ -2033,7 +3099,7 @@ isSupportedCommandType(IEC60870_5_TypeID typeId)
 bool
 IEC104Server::checkIfCmdTimeIsValid(int typeId, InformationObject io)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::checkIfCmdTimeIsValid -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::checkIfCmdTimeIsValid"); //LCOV_EXCL_LINE
     if (m_config->CmdRecvTimeout() == 0)
         return true;
 
@@ -2065,8 +3131,8 @@ IEC104Server::checkIfCmdTimeIsValid(int typeId, InformationObject io)
             break;//LCOV_EXCL_LINE
 
         default:
-            Iec104Utility::log_warn("%s Command with type %s (%d) is not supported", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                    IEC104DataPoint::getStringFromTypeID(typeId).c_str(), typeId); //LCOV_EXCL_LINE
+            Iec104Utility::log_warn("%s Command with type %s (%d) is not supported", beforeLog, //LCOV_EXCL_LINE
+                                    IEC104DataPoint::getStringFromTypeID(typeId), typeId); //LCOV_EXCL_LINE
             return false;
     }
 
@@ -2090,23 +3156,25 @@ bool
 IEC104Server::asduHandler(void* parameter, IMasterConnection connection,
                                CS101_ASDU asdu)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::asduHandler -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::asduHandler"); //LCOV_EXCL_LINE
     IEC104Server* self = (IEC104Server*)parameter;
 
     IEC60870_5_TypeID typeId = CS101_ASDU_getTypeID(asdu);
     if (!isSupportedCommandType(typeId)) {
-        Iec104Utility::log_warn("%s command (%s) - unsupported command type: %d -> ignore", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                IEC104DataPoint::getStringFromTypeID(typeId).c_str(), typeId); //LCOV_EXCL_LINE
+        Iec104Utility::log_warn("%s command (%s) - unsupported command type: %d -> ignore", beforeLog, //LCOV_EXCL_LINE
+                                IEC104DataPoint::getStringFromTypeID(typeId), typeId); //LCOV_EXCL_LINE
+        self->m_statistics.countCommand(reinterpret_cast<uintptr_t>(connection), true);
         return false;
     }
 
-    Iec104Utility::log_info("%s Received command of type %s", beforeLog.c_str(), //LCOV_EXCL_LINE
-                            IEC104DataPoint::getStringFromTypeID(typeId).c_str()); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s Received command of type %s", beforeLog, //LCOV_EXCL_LINE
+                            IEC104DataPoint::getStringFromTypeID(typeId)); //LCOV_EXCL_LINE
 
     bool sendResponse = self->validateCommand(connection, asdu);
+    self->m_statistics.countCommand(reinterpret_cast<uintptr_t>(connection), CS101_ASDU_isNegative(asdu));
     if (sendResponse) {
-        Iec104Utility::log_debug("%s command (%s) - Sending response", beforeLog.c_str(), //LCOV_EXCL_LINE
-                                IEC104DataPoint::getStringFromTypeID(typeId).c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_debug("%s command (%s) - Sending response", beforeLog, //LCOV_EXCL_LINE
+                                IEC104DataPoint::getStringFromTypeID(typeId)); //LCOV_EXCL_LINE
         IMasterConnection_sendASDU(connection, asdu);
     }
 
@@ -2115,17 +3183,45 @@ IEC104Server::asduHandler(void* parameter, IMasterConnection connection,
 
 /**
  * Callback handler for connection request handling
+ * Admits the client only if its IP belongs to a redundancy group and did not exceed its connection rate
  *
  * @param parameter
  * @param ipAddress	    incoming connection request IP address
- * @return 		boolean
+ * @return 		true to accept the connection, false to close it
  */
 bool
 IEC104Server::connectionRequestHandler(void* parameter,
                                             const char* ipAddress)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::connectionRequestHandler -"; //LCOV_EXCL_LINE
-    Iec104Utility::log_info("%s New connection request from %s", beforeLog.c_str(), ipAddress);//LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::connectionRequestHandler"); //LCOV_EXCL_LINE
+    IEC104Server* self = (IEC104Server*)parameter;
+
+    IEC104ClientAddress address;
+    if (!IEC104ClientAddress::parse(ipAddress, strlen(ipAddress), address)) {
+        Iec104Utility::log_warn("%s Invalid client address %s -> reject connection", beforeLog, ipAddress);//LCOV_EXCL_LINE
+        self->m_statistics.countConnectionRequest(false);
+        return false;
+    }
+
+    // Checked before anything else so that a client in a reconnect loop only costs a hash probe
+    if (!self->m_connRateLimiter.allow(address, Hal_getTimeInMs())) {
+        Iec104Utility::log_debug("%s Connection rate exceeded for %s -> reject connection", beforeLog, ipAddress);//LCOV_EXCL_LINE
+        self->m_statistics.countConnectionRequest(false);
+        return false;
+    }
+
+    // Reject unknown clients here, before the TLS handshake is started
+    IEC104Config* config = self->Config();
+    if (!config->RedundancyGroups().empty() && !config->HasCatchAllRedGroup()) {
+        if (config->ClientIpLookup().find(address) == nullptr) {
+            Iec104Utility::log_warn("%s %s is not part of any redundancy group -> reject connection", beforeLog, ipAddress);//LCOV_EXCL_LINE
+            self->m_statistics.countConnectionRequest(false);
+            return false;
+        }
+    }
+
+    Iec104Utility::log_info("%s New connection request from %s", beforeLog, ipAddress);//LCOV_EXCL_LINE
+    self->m_statistics.countConnectionRequest(true);
 
     return true;
 }
@@ -2142,7 +3238,7 @@ IEC104Server::connectionEventHandler(void* parameter,
                                           IMasterConnection con,
                                           CS104_PeerConnectionEvent event)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::connectionEventHandler -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::connectionEventHandler"); //LCOV_EXCL_LINE
     IEC104Server* self = (IEC104Server*)parameter;
     std::lock_guard<std::recursive_mutex> lock(self->m_connectionEventsLock); //LCOV_EXCL_LINE
 
@@ -2151,37 +3247,40 @@ IEC104Server::connectionEventHandler(void* parameter,
 
     IMasterConnection_getPeerAddress(con, ipAddrBuf, 100);
 
-    // Extract ip and port
-    std::string ipAddrStr(ipAddrBuf);
-    std::string ip;
-    std::string port;
-    size_t pos = ipAddrStr.find(':');
-    if (pos != std::string::npos) {
-        ip = ipAddrStr.substr(0, pos);
-        port = ipAddrStr.substr(pos + 1);
+    Iec104Utility::log_info("%s Received connection event %s on %s", beforeLog, conEvent2string[(int)event], ipAddrBuf); //LCOV_EXCL_LINE
+
+    if (event == CS104_CON_EVENT_CONNECTION_OPENED) {
+        self->m_capture.registerConnection(reinterpret_cast<uintptr_t>(con), ipAddrBuf);
+        self->m_statistics.openLink(reinterpret_cast<uintptr_t>(con), ipAddrBuf);
+    }
+    else if (event == CS104_CON_EVENT_CONNECTION_CLOSED) {
+        self->m_capture.unregisterConnection(reinterpret_cast<uintptr_t>(con));
+        self->m_statistics.closeLink(reinterpret_cast<uintptr_t>(con));
     }
 
-    Iec104Utility::log_info("%s Received connection event %s on %s", beforeLog.c_str(), conEvent2string[(int)event], ipAddrBuf); //LCOV_EXCL_LINE
+    // Extract ip and port
+    IEC104ClientAddress address;
+    int port = 0;
+    if (!IEC104ClientAddress::parsePeer(ipAddrBuf, address, port)) {
+        Iec104Utility::log_error("%s Invalid peer address %s", beforeLog, ipAddrBuf); //LCOV_EXCL_LINE
+        return;
+    }
 
     // Find the RedundancyGroup associated with the IP
-    std::shared_ptr<IEC104ServerRedGroup> currentRedGroup = self->Config()->GetRedundancyGroup(ip);
-    if (currentRedGroup == nullptr) {
-        Iec104Utility::log_error("%s Redundancy group not found for IP %s", beforeLog.c_str(), ipAddrBuf); //LCOV_EXCL_LINE
+    const IEC104ClientIpEntry* clientEntry = self->Config()->ClientIpLookup().find(address);
+    if (clientEntry == nullptr) {
+        Iec104Utility::log_error("%s Redundancy group not found for IP %s", beforeLog, ipAddrBuf); //LCOV_EXCL_LINE
         return;
     }
+    IEC104ServerRedGroup* currentRedGroup = clientEntry->redGroup;
 
-    // Find the RedGroupCon associated with the IP and PORT
-    std::shared_ptr<RedGroupCon> currentConnection = currentRedGroup->GetRedGroupCon(ip, port);
+    // Find the RedGroupCon already associated with the PORT or, for a new connection, the first free one
+    RedGroupCon* currentConnection = clientEntry->GetSlot(port);
     if (currentConnection == nullptr) {
-        // RedGroupCon was not found with the given PORT, meaning this connection is a new one !
-        // Search for the first available RedGroupCon with an empty PORT
-        currentConnection = currentRedGroup->GetRedGroupCon(ip);
-        if (currentConnection == nullptr) {
-            Iec104Utility::log_error("%s Redundancy group connection not found for IP %s", beforeLog.c_str(), ipAddrBuf); //LCOV_EXCL_LINE
-            return;
-        }
-        currentConnection->SetPort(port);
+        Iec104Utility::log_error("%s Redundancy group connection not found for IP %s", beforeLog, ipAddrBuf); //LCOV_EXCL_LINE
+        return;
     }
+    currentConnection->SetPort(port);
 
     if (event == CS104_CON_EVENT_CONNECTION_OPENED)
     {
@@ -2190,7 +3289,7 @@ IEC104Server::connectionEventHandler(void* parameter,
     else if (event == CS104_CON_EVENT_CONNECTION_CLOSED)
     {
         self->sendConnectionStatusAudit("disconnected", std::to_string(currentRedGroup->Index()), currentConnection->PathLetter());
-        currentConnection->SetPort("");
+        currentConnection->SetPort(0);
         self->removeOutstandingCommands(con);
 
         // If another connection is available to become active, the switch is made before this connection is closed
@@ -2219,12 +3318,12 @@ IEC104Server::connectionEventHandler(void* parameter,
 void
 IEC104Server::stop()
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Server::stop -"; //LCOV_EXCL_LINE
-    Iec104Utility::log_info("%s IEC104 server stopping...", beforeLog.c_str()); //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Server::stop"); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s IEC104 server stopping...", beforeLog); //LCOV_EXCL_LINE
     if (m_started == true)
     {
         m_started = false;
-        Iec104Utility::log_debug("%s Waiting for monitoring thread to join", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_debug("%s Waiting for monitoring thread to join", beforeLog); //LCOV_EXCL_LINE
         if (m_monitoringThread != nullptr) {
             m_monitoringThread->join();
             delete m_monitoringThread;
@@ -2232,20 +3331,32 @@ IEC104Server::stop()
         }
     }
 
+    if (m_encoderThread != nullptr)
+    {
+        Iec104Utility::log_debug("%s Waiting for encoder thread to join", beforeLog); //LCOV_EXCL_LINE
+        m_encoderRunning.store(false, std::memory_order_release);
+        m_encoderWakeup.notify_one();
+        m_encoderThread->join();
+        delete m_encoderThread;
+        m_encoderThread = nullptr;
+    }
+
     if (m_slave)
     {
-        Iec104Utility::log_debug("%s Stopping CS104 slave", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_debug("%s Stopping CS104 slave", beforeLog); //LCOV_EXCL_LINE
         CS104_Slave_destroy(m_slave);
         m_slave = nullptr;
     }
 
+    m_capture.stop();
+
     if (m_tlsConfig)
     {
-        Iec104Utility::log_debug("%s Deleting TLS configuration", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_debug("%s Deleting TLS configuration", beforeLog); //LCOV_EXCL_LINE
         TLSConfiguration_destroy(m_tlsConfig);
         m_tlsConfig = nullptr;
     }
-    Iec104Utility::log_info("%s IEC104 server stopped!", beforeLog.c_str()); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s IEC104 server stopped!", beforeLog); //LCOV_EXCL_LINE
 }
 
 void
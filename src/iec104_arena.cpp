@@ -0,0 +1,75 @@
+#include "iec104_arena.hpp"
+
+const size_t IEC104Arena::DEFAULT_BLOCK_SIZE;
+
+IEC104Arena::~IEC104Arena()
+{
+    release();
+
+    for (char* block : m_blocks) {
+        delete[] block;
+    }
+}
+
+void*
+IEC104Arena::allocate(size_t size, size_t alignment)
+{
+    uintptr_t current = reinterpret_cast<uintptr_t>(m_current);
+    uintptr_t aligned = (current + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+
+    if ((m_current == nullptr) || (aligned + size > reinterpret_cast<uintptr_t>(m_end))) {
+        /* new block, objects larger than the block size get their own block */
+        size_t blockSize = (size + alignment > m_blockSize) ? (size + alignment) : m_blockSize;
+
+        char* block = new char[blockSize];
+
+        m_blocks.push_back(block);
+        m_current = block;
+        m_end = block + blockSize;
+
+        current = reinterpret_cast<uintptr_t>(m_current);
+        aligned = (current + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    }
+
+    m_current = reinterpret_cast<char*>(aligned + size);
+    m_bytesUsed += size;
+
+    return reinterpret_cast<void*>(aligned);
+}
+
+void
+IEC104Arena::addDestructor(void* object, void (*destroy)(void*))
+{
+    Destructor* destructor = new (allocate(sizeof(Destructor), alignof(Destructor))) Destructor();
+
+    destructor->destroy = destroy;
+    destructor->object = object;
+    destructor->next = m_destructors;
+
+    m_destructors = destructor;
+}
+
+void
+IEC104Arena::release()
+{
+    while (m_destructors != nullptr) {
+        Destructor* destructor = m_destructors;
+
+        m_destructors = destructor->next;
+        destructor->destroy(destructor->object);
+    }
+
+    /* the first block is reused by the next configuration */
+    for (size_t i = 1; i < m_blocks.size(); i++) {
+        delete[] m_blocks[i];
+    }
+
+    if (!m_blocks.empty()) {
+        /* a first block larger than the block size is only reused up to the block size */
+        m_blocks.resize(1);
+        m_current = m_blocks[0];
+        m_end = m_blocks[0] + m_blockSize;
+    }
+
+    m_bytesUsed = 0;
+}
@@ -0,0 +1,107 @@
+#include <algorithm>
+
+#include "iec104_background_scan.hpp"
+#include "iec104_cyclic.hpp"
+#include "iec104_datapoint.hpp"
+
+#define APDU_OVERHEAD 10 /* APCI (6 octets), type ID, VSQ, COT and OA, the CA size is configured */
+
+void
+IEC104BackgroundScan::configure(const std::map<int, std::map<int, IEC104DataPoint*>>& exchangeDefinitions, int rate,
+                                int maxSizeOfASDU, int sizeOfCA, int sizeOfIOA)
+{
+    m_points.clear();
+    m_cursor = 0;
+    m_rate = rate;
+    m_budget = 0;
+    m_lastRefill = 0;
+    m_maxSizeOfASDU = maxSizeOfASDU;
+    m_sizeOfCA = sizeOfCA;
+    m_sizeOfIOA = sizeOfIOA;
+
+    /* the budget of one second, at least one complete ASDU so that low rates still send complete ASDUs */
+    m_maxBudget = std::max(rate, APDU_OVERHEAD + maxSizeOfASDU);
+
+    for (const auto& caDefinitions : exchangeDefinitions) {
+        for (const auto& ioaDefinition : caDefinitions.second) {
+            IEC104DataPoint* dp = ioaDefinition.second;
+
+            /* members of a packed object are transmitted with their packed object, counters by counter interrogation */
+            if ((dp == nullptr) || !dp->isMonitoringType() || (dp->m_pack != nullptr) ||
+                (dp->m_type == IEC60870_TYPE_COUNTER)) {
+                continue;
+            }
+
+            m_points.push_back(dp);
+        }
+    }
+
+    /* points of the same CA and type are adjacent -> complete ASDUs */
+    std::stable_sort(m_points.begin(), m_points.end(), [](const IEC104DataPoint* a, const IEC104DataPoint* b) {
+        if (a->m_ca != b->m_ca) {
+            return a->m_ca < b->m_ca;
+        }
+
+        return a->m_type < b->m_type;
+    });
+}
+
+void
+IEC104BackgroundScan::refill(uint64_t currentTime)
+{
+    if (m_lastRefill == 0) {
+        m_lastRefill = currentTime;
+        return;
+    }
+
+    if (currentTime <= m_lastRefill) {
+        return;
+    }
+
+    uint64_t earned = (currentTime - m_lastRefill) * static_cast<uint64_t>(m_rate) / 1000;
+
+    if (earned == 0) {
+        return;
+    }
+
+    /* the remainder of the division is kept for the next call */
+    m_lastRefill += earned * 1000 / static_cast<uint64_t>(m_rate);
+
+    m_budget = static_cast<int>(std::min(static_cast<uint64_t>(m_budget) + earned, static_cast<uint64_t>(m_maxBudget)));
+}
+
+bool
+IEC104BackgroundScan::nextBatch(std::vector<IEC104DataPoint*>& batch)
+{
+    batch.clear();
+
+    if (m_points.empty()) {
+        return false;
+    }
+
+    const IEC104DataPoint* first = m_points[m_cursor];
+
+    size_t maxObjects = IEC104CyclicScheduler::objectsPerAsdu(first->m_type, m_maxSizeOfASDU, m_sizeOfCA, m_sizeOfIOA);
+
+    size_t last = m_cursor;
+
+    while ((last < m_points.size()) && (last - m_cursor < maxObjects) &&
+           (m_points[last]->m_ca == first->m_ca) && (m_points[last]->m_type == first->m_type)) {
+        last++;
+    }
+
+    int size = APDU_OVERHEAD + m_sizeOfCA +
+               static_cast<int>(last - m_cursor) * (m_sizeOfIOA + IEC104DataPoint::encodedSize(first->m_type));
+
+    if (size > m_budget) {
+        return false;
+    }
+
+    m_budget -= size;
+
+    batch.assign(m_points.begin() + m_cursor, m_points.begin() + last);
+
+    m_cursor = (last < m_points.size()) ? last : 0;
+
+    return true;
+}
@@ -0,0 +1,512 @@
+#include <chrono>
+
+#include "iec104_capture.hpp"
+#include "iec104_utility.hpp"
+
+const int IEC104CaptureRing::MAX_APDU_SIZE;
+
+#define PCAPNG_SHB_TYPE 0x0A0D0D0A
+#define PCAPNG_IDB_TYPE 0x00000001
+#define PCAPNG_EPB_TYPE 0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D
+#define PCAPNG_OPT_ENDOFOPT 0
+#define PCAPNG_OPT_IF_TSRESOL 9
+#define PCAPNG_OPT_EPB_FLAGS 2
+#define PCAPNG_EPB_INBOUND 1
+#define PCAPNG_EPB_OUTBOUND 2
+#define LINKTYPE_RAW 101
+
+#define IPV4_HEADER_SIZE 20
+#define IPV6_HEADER_SIZE 40
+#define TCP_HEADER_SIZE 20
+
+IEC104CaptureRing::IEC104CaptureRing(size_t capacity)
+{
+    size_t size = 2;
+
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    m_cells.reset(new Cell[size]);
+    m_mask = size - 1;
+
+    for (size_t i = 0; i < size; i++) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    m_enqueuePos.store(0, std::memory_order_relaxed);
+    m_dequeuePos.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+}
+
+bool
+IEC104CaptureRing::push(uint64_t connectionKey, const uint8_t* data, int length, bool sent, uint64_t timestamp)
+{
+    Cell* cell;
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+    while (true) {
+        cell = &m_cells[pos & m_mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    if (length > MAX_APDU_SIZE) {
+        length = MAX_APDU_SIZE;
+    }
+
+    cell->record.timestamp = timestamp;
+    cell->record.connectionKey = connectionKey;
+    cell->record.length = static_cast<uint16_t>(length);
+    cell->record.sent = sent;
+    memcpy(cell->record.data, data, length);
+
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    return true;
+}
+
+bool
+IEC104CaptureRing::pop(Record& record)
+{
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    Cell* cell = &m_cells[pos & m_mask];
+    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+
+    if (sequence != pos + 1) {
+        return false;
+    }
+
+    m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+
+    record.timestamp = cell->record.timestamp;
+    record.connectionKey = cell->record.connectionKey;
+    record.length = cell->record.length;
+    record.sent = cell->record.sent;
+    memcpy(record.data, cell->record.data, record.length);
+
+    cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+
+    return true;
+}
+
+static void appendU16(std::vector<uint8_t>& buf, uint16_t value)
+{
+    uint8_t bytes[2];
+    memcpy(bytes, &value, sizeof(bytes));
+    buf.insert(buf.end(), bytes, bytes + sizeof(bytes));
+}
+
+static void appendU32(std::vector<uint8_t>& buf, uint32_t value)
+{
+    uint8_t bytes[4];
+    memcpy(bytes, &value, sizeof(bytes));
+    buf.insert(buf.end(), bytes, bytes + sizeof(bytes));
+}
+
+/* network byte order helpers for the synthetic IP/TCP headers */
+static void appendBE16(std::vector<uint8_t>& buf, uint16_t value)
+{
+    buf.push_back(static_cast<uint8_t>(value >> 8));
+    buf.push_back(static_cast<uint8_t>(value));
+}
+
+static void appendBE32(std::vector<uint8_t>& buf, uint32_t value)
+{
+    appendBE16(buf, static_cast<uint16_t>(value >> 16));
+    appendBE16(buf, static_cast<uint16_t>(value));
+}
+
+static void padTo32(std::vector<uint8_t>& buf)
+{
+    while (buf.size() % 4) {
+        buf.push_back(0);
+    }
+}
+
+static void finishBlock(std::vector<uint8_t>& buf)
+{
+    uint32_t totalLength = static_cast<uint32_t>(buf.size() + 4);
+    memcpy(&buf[4], &totalLength, sizeof(totalLength));
+    appendU32(buf, totalLength);
+}
+
+bool
+IEC104PcapngWriter::open(const std::string& path, int maxFileSize, int maxFiles)
+{
+    close();
+
+    m_path = path;
+    m_maxFileSize = static_cast<long>(maxFileSize) * 1024;
+    m_maxFiles = maxFiles;
+
+    return openFile();
+}
+
+bool
+IEC104PcapngWriter::openFile()
+{
+    m_file = fopen(m_path.c_str(), "wb");
+
+    if (m_file == nullptr) {
+        return false;
+    }
+
+    m_fileSize = 0;
+    writeHeaderBlocks();
+
+    return true;
+}
+
+void
+IEC104PcapngWriter::close()
+{
+    if (m_file) {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+void
+IEC104PcapngWriter::flush()
+{
+    if (m_file) {
+        fflush(m_file);
+    }
+}
+
+void
+IEC104PcapngWriter::write(const void* data, size_t size)
+{
+    if (m_file && (fwrite(data, 1, size, m_file) == size)) {
+        m_fileSize += static_cast<long>(size);
+    }
+}
+
+void
+IEC104PcapngWriter::writeHeaderBlocks()
+{
+    /* Section Header Block */
+    m_block.clear();
+    appendU32(m_block, PCAPNG_SHB_TYPE);
+    appendU32(m_block, 0);
+    appendU32(m_block, PCAPNG_BYTE_ORDER_MAGIC);
+    appendU16(m_block, 1);
+    appendU16(m_block, 0);
+    appendU32(m_block, 0xffffffff); /* section length not specified */
+    appendU32(m_block, 0xffffffff);
+    finishBlock(m_block);
+    write(m_block.data(), m_block.size());
+
+    /* Interface Description Block, timestamps in ns */
+    m_block.clear();
+    appendU32(m_block, PCAPNG_IDB_TYPE);
+    appendU32(m_block, 0);
+    appendU16(m_block, LINKTYPE_RAW);
+    appendU16(m_block, 0);
+    appendU32(m_block, 0);
+    appendU16(m_block, PCAPNG_OPT_IF_TSRESOL);
+    appendU16(m_block, 1);
+    m_block.push_back(9);
+    padTo32(m_block);
+    appendU32(m_block, PCAPNG_OPT_ENDOFOPT);
+    finishBlock(m_block);
+    write(m_block.data(), m_block.size());
+}
+
+void
+IEC104PcapngWriter::rotate()
+{
+    close();
+
+    if (m_maxFiles > 0) {
+        for (int i = m_maxFiles - 1; i > 0; i--) {
+            std::string from = m_path + "." + std::to_string(i);
+            std::string to = m_path + "." + std::to_string(i + 1);
+            rename(from.c_str(), to.c_str());
+        }
+
+        std::string first = m_path + ".1";
+        rename(m_path.c_str(), first.c_str());
+    }
+
+    openFile();
+}
+
+void
+IEC104PcapngWriter::writeApdu(const IEC104CaptureRing::Record& record, const IEC104ClientAddress& client, int clientPort,
+                              uint32_t& serverSeq, uint32_t& clientSeq)
+{
+    if (m_file == nullptr) {
+        return;
+    }
+
+    const uint8_t* srcAddr = record.sent ? m_serverAddress.Bytes() : client.Bytes();
+    const uint8_t* dstAddr = record.sent ? client.Bytes() : m_serverAddress.Bytes();
+    int srcPort = record.sent ? m_serverPort : clientPort;
+    int dstPort = record.sent ? clientPort : m_serverPort;
+    uint32_t seq = record.sent ? serverSeq : clientSeq;
+    uint32_t ack = record.sent ? clientSeq : serverSeq;
+
+    bool v4 = client.isV4();
+    static const uint8_t anyAddress[16] = {0};
+
+    /* when the server and the client are not in the same family, use the unspecified server address */
+    if (v4 != m_serverAddress.isV4()) {
+        if (record.sent) {
+            srcAddr = anyAddress;
+        }
+        else {
+            dstAddr = anyAddress;
+        }
+    }
+
+    size_t ipHeaderSize = v4 ? IPV4_HEADER_SIZE : IPV6_HEADER_SIZE;
+    uint32_t packetLength = static_cast<uint32_t>(ipHeaderSize + TCP_HEADER_SIZE + record.length);
+
+    m_block.clear();
+    appendU32(m_block, PCAPNG_EPB_TYPE);
+    appendU32(m_block, 0);
+    appendU32(m_block, 0); /* interface id */
+    appendU32(m_block, static_cast<uint32_t>(record.timestamp >> 32));
+    appendU32(m_block, static_cast<uint32_t>(record.timestamp));
+    appendU32(m_block, packetLength);
+    appendU32(m_block, packetLength);
+
+    size_t ipStart = m_block.size();
+
+    if (v4) {
+        appendBE16(m_block, 0x4500);
+        appendBE16(m_block, static_cast<uint16_t>(packetLength));
+        appendBE32(m_block, 0x00004000); /* id 0, don't fragment */
+        appendBE16(m_block, 0x4006);     /* ttl 64, TCP */
+        appendBE16(m_block, 0);
+        m_block.insert(m_block.end(), srcAddr + 12, srcAddr + 16);
+        m_block.insert(m_block.end(), dstAddr + 12, dstAddr + 16);
+
+        uint32_t checksum = 0;
+        for (size_t i = 0; i < IPV4_HEADER_SIZE; i += 2) {
+            checksum += (m_block[ipStart + i] << 8) | m_block[ipStart + i + 1];
+        }
+        while (checksum >> 16) {
+            checksum = (checksum & 0xffff) + (checksum >> 16);
+        }
+        checksum = ~checksum & 0xffff;
+        m_block[ipStart + 10] = static_cast<uint8_t>(checksum >> 8);
+        m_block[ipStart + 11] = static_cast<uint8_t>(checksum);
+    }
+    else {
+        appendBE32(m_block, 0x60000000);
+        appendBE16(m_block, static_cast<uint16_t>(TCP_HEADER_SIZE + record.length));
+        m_block.push_back(6);  /* TCP */
+        m_block.push_back(64); /* hop limit */
+        m_block.insert(m_block.end(), srcAddr, srcAddr + 16);
+        m_block.insert(m_block.end(), dstAddr, dstAddr + 16);
+    }
+
+    appendBE16(m_block, static_cast<uint16_t>(srcPort));
+    appendBE16(m_block, static_cast<uint16_t>(dstPort));
+    appendBE32(m_block, seq);
+    appendBE32(m_block, ack);
+    appendBE16(m_block, 0x5018);  /* header length 20, PSH ACK */
+    appendBE16(m_block, 0xffff);  /* window */
+    appendBE16(m_block, 0);       /* checksum not computed */
+    appendBE16(m_block, 0);
+
+    m_block.insert(m_block.end(), record.data, record.data + record.length);
+    padTo32(m_block);
+
+    appendU16(m_block, PCAPNG_OPT_EPB_FLAGS);
+    appendU16(m_block, 4);
+    appendU32(m_block, record.sent ? PCAPNG_EPB_OUTBOUND : PCAPNG_EPB_INBOUND);
+    appendU32(m_block, PCAPNG_OPT_ENDOFOPT);
+    finishBlock(m_block);
+
+    if ((m_maxFileSize > 0) && (m_fileSize + static_cast<long>(m_block.size()) > m_maxFileSize)) {
+        rotate();
+
+        if (m_file == nullptr) {
+            return;
+        }
+    }
+
+    write(m_block.data(), m_block.size());
+
+    if (record.sent) {
+        serverSeq += record.length;
+    }
+    else {
+        clientSeq += record.length;
+    }
+}
+
+void
+IEC104Capture::setServerEndpoint(const std::string& ip, int port)
+{
+    IEC104ClientAddress address;
+
+    if (!IEC104ClientAddress::parse(ip.c_str(), ip.size(), address)) {
+        IEC104ClientAddress::parse("0.0.0.0", 7, address);
+    }
+
+    std::lock_guard<std::mutex> lock(m_configLock);
+    m_writer.setServerEndpoint(address, port);
+}
+
+void
+IEC104Capture::configure(const IEC104CaptureSettings& settings, const std::string& defaultPath)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Capture::configure"); //LCOV_EXCL_LINE
+
+    stop();
+
+    if (!settings.enabled) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_configLock);
+
+    /* the ring is never replaced once created: a connection thread may still be pushing into it */
+    if (m_ring == nullptr) {
+        m_ring.reset(new IEC104CaptureRing(static_cast<size_t>(settings.ringSize)));
+        m_ringSize = settings.ringSize;
+    }
+    else if (settings.ringSize != m_ringSize) {
+        Iec104Utility::log_warn("%s capture.ring_size changed -> keeping %d records, the service must be restarted", //LCOV_EXCL_LINE
+                                beforeLog, static_cast<int>(m_ring->Capacity())); //LCOV_EXCL_LINE
+    }
+
+    const std::string& path = settings.path.empty() ? defaultPath : settings.path;
+
+    if (!m_writer.open(path, settings.maxFileSize, settings.maxFiles)) {
+        Iec104Utility::log_error("%s Cannot open capture file %s -> capture disabled", beforeLog, path.c_str()); //LCOV_EXCL_LINE
+        return;
+    }
+
+    m_running = true;
+    m_writerThread = new std::thread(&IEC104Capture::writerThread, this);
+    /* release: publishes the ring to the connection threads checking isEnabled() */
+    m_enabled.store(true, std::memory_order_release);
+
+    Iec104Utility::log_info("%s Capturing raw APDUs to %s", beforeLog, path.c_str()); //LCOV_EXCL_LINE
+}
+
+void
+IEC104Capture::stop()
+{
+    std::lock_guard<std::mutex> lock(m_configLock);
+
+    m_enabled = false;
+
+    if (m_writerThread != nullptr) {
+        m_running = false;
+        m_writerThread->join();
+        delete m_writerThread;
+        m_writerThread = nullptr;
+    }
+
+    m_writer.close();
+}
+
+void
+IEC104Capture::recordApdu(uint64_t connectionKey, const uint8_t* data, int length, bool sent)
+{
+    uint64_t timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch()).count());
+
+    m_ring->push(connectionKey, data, length, sent, timestamp);
+}
+
+void
+IEC104Capture::registerConnection(uint64_t connectionKey, const char* peerAddress)
+{
+    Peer peer;
+
+    if (!IEC104ClientAddress::parsePeer(peerAddress, peer.address, peer.port)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_peersLock);
+    peer.id = m_nextPeerId++;
+    m_peers[connectionKey] = peer;
+}
+
+void
+IEC104Capture::unregisterConnection(uint64_t connectionKey)
+{
+    std::lock_guard<std::mutex> lock(m_peersLock);
+    m_peers.erase(connectionKey);
+}
+
+void
+IEC104Capture::writeRecord(const IEC104CaptureRing::Record& record)
+{
+    PeerState& state = m_writerPeers[record.connectionKey];
+
+    {
+        std::lock_guard<std::mutex> lock(m_peersLock);
+        auto peerIt = m_peers.find(record.connectionKey);
+
+        /* a new connection may reuse the key of a closed one: restart its TCP sequence numbers */
+        if ((peerIt != m_peers.end()) && (peerIt->second.id != state.peer.id)) {
+            state = PeerState();
+            state.peer = peerIt->second;
+        }
+
+        if (m_writerPeers.size() > m_peers.size() + 64) {
+            for (auto it = m_writerPeers.begin(); it != m_writerPeers.end();) {
+                if ((it->first != record.connectionKey) && (m_peers.count(it->first) == 0)) {
+                    it = m_writerPeers.erase(it);
+                }
+                else {
+                    it++;
+                }
+            }
+        }
+    }
+
+    PeerState& current = m_writerPeers[record.connectionKey];
+    m_writer.writeApdu(record, current.peer.address, current.peer.port, current.serverSeq, current.clientSeq);
+}
+
+void
+IEC104Capture::writerThread()
+{
+    IEC104CaptureRing::Record record;
+
+    while (m_running) {
+        bool written = false;
+
+        while (m_ring->pop(record)) {
+            writeRecord(record);
+            written = true;
+        }
+
+        if (written) {
+            m_writer.flush();
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+
+    while (m_ring->pop(record)) {
+        writeRecord(record);
+    }
+
+    m_writer.flush();
+}
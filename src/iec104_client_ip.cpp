@@ -0,0 +1,215 @@
+#include <arpa/inet.h>
+
+#include "iec104_client_ip.hpp"
+#include "iec104_redgroup.hpp"
+
+const size_t IEC104ClientRateLimiter::MAX_TRACKED_CLIENTS;
+
+static const uint8_t ipv4MappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+
+bool
+IEC104ClientAddress::parse(const char* str, size_t len, IEC104ClientAddress& address)
+{
+    if ((len > 1) && (str[0] == '[') && (str[len - 1] == ']')) {
+        str++;
+        len -= 2;
+    }
+
+    char buf[INET6_ADDRSTRLEN];
+
+    if ((len == 0) || (len >= sizeof(buf))) {
+        return false;
+    }
+
+    memcpy(buf, str, len);
+    buf[len] = 0;
+
+    if (memchr(buf, ':', len) != nullptr) {
+        return inet_pton(AF_INET6, buf, address.m_bytes) == 1;
+    }
+
+    memcpy(address.m_bytes, ipv4MappedPrefix, sizeof(ipv4MappedPrefix));
+
+    return inet_pton(AF_INET, buf, address.m_bytes + sizeof(ipv4MappedPrefix)) == 1;
+}
+
+bool
+IEC104ClientAddress::parsePeer(const char* peer, IEC104ClientAddress& address, int& port)
+{
+    const char* portSep = strrchr(peer, ':');
+
+    if ((portSep == nullptr) || (portSep == peer)) {
+        return false;
+    }
+
+    /* an unbracketed IPv6 address has no port */
+    if ((peer[0] != '[') && (memchr(peer, ':', portSep - peer) != nullptr)) {
+        return false;
+    }
+
+    int value = 0;
+    const char* c = portSep + 1;
+
+    if (*c == 0) {
+        return false;
+    }
+
+    for (; *c != 0; c++) {
+        if ((*c < '0') || (*c > '9') || (value > 65535)) {
+            return false;
+        }
+        value = value * 10 + (*c - '0');
+    }
+
+    if (value > 65535) {
+        return false;
+    }
+
+    port = value;
+
+    return parse(peer, portSep - peer, address);
+}
+
+bool
+IEC104ClientAddress::isV4() const
+{
+    return memcmp(m_bytes, ipv4MappedPrefix, sizeof(ipv4MappedPrefix)) == 0;
+}
+
+size_t
+IEC104ClientAddress::hash() const
+{
+    uint64_t high;
+    uint64_t low;
+
+    memcpy(&high, m_bytes, sizeof(high));
+    memcpy(&low, m_bytes + 8, sizeof(low));
+
+    uint64_t h = (low ^ (high * 0x9E3779B97F4A7C15ULL)) * 0xBF58476D1CE4E5B9ULL;
+
+    return static_cast<size_t>(h ^ (h >> 31));
+}
+
+RedGroupCon*
+IEC104ClientIpEntry::GetSlot(int port) const
+{
+    RedGroupCon* freeSlot = nullptr;
+
+    for (RedGroupCon* connection : connections) {
+        if (connection->Port() == port) {
+            return connection;
+        }
+
+        if ((freeSlot == nullptr) && (connection->Port() == 0)) {
+            freeSlot = connection;
+        }
+    }
+
+    return freeSlot;
+}
+
+void
+IEC104ClientIpLookup::clear()
+{
+    m_hosts.clear();
+}
+
+bool
+IEC104ClientIpLookup::add(const IEC104ClientAddress& address, IEC104ServerRedGroup* redGroup, RedGroupCon* connection)
+{
+    IEC104ClientIpEntry& entry = m_hosts[address];
+
+    if (entry.redGroup == nullptr) {
+        entry.redGroup = redGroup;
+    }
+    else if (entry.redGroup != redGroup) {
+        return false;
+    }
+
+    entry.connections.push_back(connection);
+
+    return true;
+}
+
+const IEC104ClientIpEntry*
+IEC104ClientIpLookup::find(const IEC104ClientAddress& address) const
+{
+    auto hostIt = m_hosts.find(address);
+
+    if (hostIt == m_hosts.end()) {
+        return nullptr;
+    }
+
+    return &(hostIt->second);
+}
+
+void
+IEC104ClientRateLimiter::configure(int ratePerMinute, int burst)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    m_ratePerMinute = (ratePerMinute > 0) ? ratePerMinute : 0;
+    m_burst = (burst > 0) ? burst : 1;
+    m_buckets.clear();
+    m_lru.clear();
+}
+
+double
+IEC104ClientRateLimiter::refill(Bucket& bucket, uint64_t currentTime) const
+{
+    if (currentTime > bucket.lastRefill) {
+        bucket.tokens += static_cast<double>(currentTime - bucket.lastRefill) * m_ratePerMinute / 60000.0;
+
+        if (bucket.tokens > m_burst) {
+            bucket.tokens = m_burst;
+        }
+    }
+
+    bucket.lastRefill = currentTime;
+
+    return bucket.tokens;
+}
+
+bool
+IEC104ClientRateLimiter::allow(const IEC104ClientAddress& address, uint64_t currentTime)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (m_ratePerMinute == 0) {
+        return true;
+    }
+
+    auto bucketIt = m_buckets.find(address);
+
+    if (bucketIt == m_buckets.end()) {
+        if (m_buckets.size() >= MAX_TRACKED_CLIENTS) {
+            /* forget the least recently seen client once its bucket is full again, else the table is flooded */
+            auto oldestIt = m_buckets.find(m_lru.front());
+
+            if (refill(oldestIt->second, currentTime) < m_burst) {
+                return false;
+            }
+
+            m_buckets.erase(oldestIt);
+            m_lru.pop_front();
+        }
+
+        Bucket bucket;
+        bucket.tokens = m_burst;
+        bucket.lastRefill = currentTime;
+        bucket.lruPosition = m_lru.insert(m_lru.end(), address);
+
+        bucketIt = m_buckets.insert(std::make_pair(address, bucket)).first;
+    }
+    else {
+        m_lru.splice(m_lru.end(), m_lru, bucketIt->second.lruPosition);
+    }
+
+    if (refill(bucketIt->second, currentTime) < 1.0) {
+        return false;
+    }
+
+    bucketIt->second.tokens -= 1.0;
+
+    return true;
+}
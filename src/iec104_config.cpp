@@ -1,3 +1,4 @@
+#include <cstdio>
 #include <sstream>
 #include <algorithm>
 
@@ -7,6 +8,7 @@
 #include <rapidjson/error/en.h>
 
 #include "iec104_config.hpp"
+#include "iec104_conversion.hpp"
 #include "iec104_utility.hpp"
 #include "iec104_redgroup.hpp"
 
@@ -22,6 +24,11 @@ using namespace rapidjson;
 #define JSON_PROT_ADDR "address"
 #define JSON_PROT_TYPEID "typeid"
 #define JSON_PROT_GI_GROUPS "gi_groups"
+#define JSON_PROT_PACK_ADDR "pack_address"
+#define JSON_PROT_PACK_BIT "pack_bit"
+#define JSON_PROT_CI_GROUP "ci_group"
+#define JSON_PROT_CYCLIC_PERIOD "cyclic_period_ms"
+#define JSON_PROT_CONVERSION "conversion"
 
 IEC104Config::IEC104Config()
 {
@@ -32,19 +39,8 @@ IEC104Config::IEC104Config()
 void
 IEC104Config::deleteExchangeDefinitions()
 {
-    if (m_exchangeDefinitions != nullptr) {
-        for (auto const& exchangeDefintions : *m_exchangeDefinitions) {
-            for (auto const& dpPair : exchangeDefintions.second) {
-                IEC104DataPoint* dp = dpPair.second;
-
-                delete dp;
-            }
-        }
-
-        delete m_exchangeDefinitions;
-
-        m_exchangeDefinitions = nullptr;
-    }
+    /* the points are destroyed with the last reference to the table */
+    m_pointTable.reset();
 }
 
 IEC104Config::SouthPluginMonitor::SouthPluginMonitor(std::string& assetName)
@@ -56,9 +52,8 @@ IEC104Config::~IEC104Config()
 {
     deleteExchangeDefinitions();
 
-    for (auto southPluginMonitor : m_monitoredSouthPlugins) {
-        delete southPluginMonitor;
-    }
+    m_monitoredSouthPlugins.clear();
+    m_protocolArena.release();
 }
 
 bool
@@ -74,26 +69,32 @@ IEC104Config::isValidIPAddress(const std::string& addrStr)
 void
 IEC104Config::importRedundancyGroupConnections(const Value& connection, std::shared_ptr<IEC104ServerRedGroup> redundancyGroup) const
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Config::importRedundancyGroupConnections -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Config::importRedundancyGroupConnections"); //LCOV_EXCL_LINE
 
     if(!connection.IsObject()) {
-        Iec104Utility::log_error("%s  connections element is not an object -> ignore", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_error("%s  connections element is not an object -> ignore", beforeLog); //LCOV_EXCL_LINE
         return;
     }
 
     if (!connection.HasMember("clt_ip") || !connection["clt_ip"].IsString()) {
-        Iec104Utility::log_error("%s  clt_ip does not exist or is not a string -> ignore", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_error("%s  clt_ip does not exist or is not a string -> ignore", beforeLog); //LCOV_EXCL_LINE
         return;
     }
     std::string cltIp = connection["clt_ip"].GetString();
 
-    if (!isValidIPAddress(cltIp)) {
-        Iec104Utility::log_error("%s  %s is not a valid IP address -> ignore", beforeLog.c_str(), cltIp.c_str()); //LCOV_EXCL_LINE
+    IEC104ClientAddress address;
+
+    // lib60870 only matches exact client addresses when dispatching connections to redundancy groups, subnets
+    // are refused
+    if (!IEC104ClientAddress::parse(cltIp.c_str(), cltIp.size(), address)) {
+        Iec104Utility::log_error("%s  %s is not a valid client IP address -> ignore", beforeLog, cltIp.c_str()); //LCOV_EXCL_LINE
         return;
     }
 
-    Iec104Utility::log_debug("%s  add to group: %s", beforeLog.c_str(), cltIp.c_str()); //LCOV_EXCL_LINE
+    Iec104Utility::log_debug("%s  add to group: %s", beforeLog, cltIp.c_str()); //LCOV_EXCL_LINE
+
     CS104_RedundancyGroup_addAllowedClient(redundancyGroup->CS104RedGroup(), cltIp.c_str());
+
     auto redundancyGroupConnection = std::make_shared<RedGroupCon>(cltIp);
     redundancyGroup->AddConnection(redundancyGroupConnection);
 }
@@ -101,11 +102,11 @@ IEC104Config::importRedundancyGroupConnections(const Value& connection, std::sha
 void
 IEC104Config::importRedundancyGroups(const Value& redundancyGroups)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Config::importRedundancyGroups -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Config::importRedundancyGroups"); //LCOV_EXCL_LINE
 
     for (const Value& redGroup : redundancyGroups.GetArray()) {           
         if (!redGroup.IsObject()) {
-            Iec104Utility::log_error("%s redundancy_groups element is not an object -> ignore", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_error("%s redundancy_groups element is not an object -> ignore", beforeLog); //LCOV_EXCL_LINE
             continue;
         }
         
@@ -119,13 +120,13 @@ IEC104Config::importRedundancyGroups(const Value& redundancyGroups)
             }
         }
         if (redGroupName == nullptr) {
-            Iec104Utility::log_error("%s rg_name does not exist or is not a string -> ignore", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_error("%s rg_name does not exist or is not a string -> ignore", beforeLog); //LCOV_EXCL_LINE
             continue;
         }
 
         CS104_RedundancyGroup cs104RedGroup = CS104_RedundancyGroup_create(redGroupName);
         auto redundancyGroup = std::make_shared<IEC104ServerRedGroup>(redGroupName, static_cast<int>(m_redundancyGroups.size()), cs104RedGroup);
-        Iec104Utility::log_debug("%s Adding red group with name: %s", beforeLog.c_str(), redGroupName); //LCOV_EXCL_LINE
+        Iec104Utility::log_debug("%s Adding red group with name: %s", beforeLog, redGroupName); //LCOV_EXCL_LINE
 
         free(redGroupName);
 
@@ -133,19 +134,57 @@ IEC104Config::importRedundancyGroups(const Value& redundancyGroups)
             for (const Value& connection : redGroup["connections"].GetArray()) {
                 importRedundancyGroupConnections(connection, redundancyGroup);
             }
+
+            /* without allowed client the group would accept every client (fallback group) */
+            if ((redGroup["connections"].Size() > 0) && redundancyGroup->Connections().empty()) {
+                Iec104Utility::log_error("%s  no valid connection in %s -> ignore redundancy group", beforeLog, //LCOV_EXCL_LINE
+                                         redundancyGroup->Name().c_str()); //LCOV_EXCL_LINE
+                CS104_RedundancyGroup_destroy(cs104RedGroup);
+                continue;
+            }
         }
         else {
-            Iec104Utility::log_debug("%s  connections does not exist or is not an array -> adding fallback group", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_debug("%s  connections does not exist or is not an array -> adding fallback group", beforeLog); //LCOV_EXCL_LINE
         }
 
         m_redundancyGroups.push_back(redundancyGroup);
     }
+
+    buildClientIpLookup();
+}
+
+void
+IEC104Config::buildClientIpLookup()
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Config::buildClientIpLookup"); //LCOV_EXCL_LINE
+
+    m_clientIpLookup.clear();
+    m_hasCatchAllRedGroup = false;
+
+    for (const auto& redGroup : m_redundancyGroups) {
+        if (redGroup->Connections().empty()) {
+            m_hasCatchAllRedGroup = true;
+        }
+
+        for (const auto& connection : redGroup->Connections()) {
+            IEC104ClientAddress address;
+
+            if (!IEC104ClientAddress::parse(connection->ClientIP().c_str(), connection->ClientIP().size(), address)) {
+                continue;
+            }
+
+            if (!m_clientIpLookup.add(address, redGroup.get(), connection.get())) {
+                Iec104Utility::log_warn("%s %s is already used by another redundancy group -> ignored for group %s", beforeLog, //LCOV_EXCL_LINE
+                                        connection->ClientIP().c_str(), redGroup->Name().c_str()); //LCOV_EXCL_LINE
+            }
+        }
+    }
 }
 
 void
 IEC104Config::importTransportLayer(const Value& transportLayer)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Config::importTransportLayer -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Config::importTransportLayer"); //LCOV_EXCL_LINE
 
     if (transportLayer.HasMember("redundancy_groups")) {
 
@@ -154,7 +193,7 @@ IEC104Config::importTransportLayer(const Value& transportLayer)
             importRedundancyGroups(redundancyGroups);
         }
         else {
-            Iec104Utility::log_fatal("%s redundancy_groups is not an array -> ignore redundancy groups", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_fatal("%s redundancy_groups is not an array -> ignore redundancy groups", beforeLog); //LCOV_EXCL_LINE
         }
     }
 
@@ -170,11 +209,11 @@ IEC104Config::importTransportLayer(const Value& transportLayer)
             }
             else {
                 Iec104Utility::log_warn("%s transport_layer.mode has unknown value '%s' -> using mode: connect always", //LCOV_EXCL_LINE
-                                        beforeLog.c_str(), modeValue.c_str()); //LCOV_EXCL_LINE
+                                        beforeLog, modeValue.c_str()); //LCOV_EXCL_LINE
             }
         }
         else {
-            Iec104Utility::log_warn("%s transport_layer.mode is not a string -> using mode: connect always", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_warn("%s transport_layer.mode is not a string -> using mode: connect always", beforeLog); //LCOV_EXCL_LINE
         }
     } 
 
@@ -187,11 +226,11 @@ IEC104Config::importTransportLayer(const Value& transportLayer)
             }
             else {
                 Iec104Utility::log_warn("%s transport_layer.port value out of range [1..65535]: %d -> using default port (%d)", //LCOV_EXCL_LINE
-                                        beforeLog.c_str(), tcpPort, m_defaultTcpPort); //LCOV_EXCL_LINE
+                                        beforeLog, tcpPort, m_defaultTcpPort); //LCOV_EXCL_LINE
             }
         }
         else {
-            Iec104Utility::log_warn("%s transport_layer.port in not an integer -> using default port (%d)", beforeLog.c_str(), //LCOV_EXCL_LINE
+            Iec104Utility::log_warn("%s transport_layer.port in not an integer -> using default port (%d)", beforeLog, //LCOV_EXCL_LINE
                                     m_defaultTcpPort); //LCOV_EXCL_LINE
         }
     }
@@ -205,11 +244,11 @@ IEC104Config::importTransportLayer(const Value& transportLayer)
             }
             else {
                 Iec104Utility::log_warn("%s transport_layer.k_value value out of range [1..32767]: %d -> using default value (%d)", //LCOV_EXCL_LINE
-                                        beforeLog.c_str(), kValue, m_k); //LCOV_EXCL_LINE
+                                        beforeLog, kValue, m_k); //LCOV_EXCL_LINE
             }
         }
         else {
-            Iec104Utility::log_warn("%s transport_layer.k_value is not an integer -> using default value (%d)", beforeLog.c_str(), m_k); //LCOV_EXCL_LINE
+            Iec104Utility::log_warn("%s transport_layer.k_value is not an integer -> using default value (%d)", beforeLog, m_k); //LCOV_EXCL_LINE
         }
     }
 
@@ -222,11 +261,11 @@ IEC104Config::importTransportLayer(const Value& transportLayer)
             }
             else {
                 Iec104Utility::log_warn("%s transport_layer.w_value value out of range [1..32767]: %d -> using default value (%d)", //LCOV_EXCL_LINE
-                                        beforeLog.c_str(), wValue, m_w); //LCOV_EXCL_LINE
+                                        beforeLog, wValue, m_w); //LCOV_EXCL_LINE
             }
         }
         else {
-            Iec104Utility::log_warn("%s transport_layer.w_value is not an integer -> using default value (%d)", beforeLog.c_str(), m_w); //LCOV_EXCL_LINE
+            Iec104Utility::log_warn("%s transport_layer.w_value is not an integer -> using default value (%d)", beforeLog, m_w); //LCOV_EXCL_LINE
         }
     }
 
@@ -239,12 +278,12 @@ IEC104Config::importTransportLayer(const Value& transportLayer)
             }
             else {
                 Iec104Utility::log_warn("%s transport_layer.t0_timeout value out of range [1..255]: %d -> using default value (%d)", //LCOV_EXCL_LINE
-                                        beforeLog.c_str(), t0Timeout, m_t0); //LCOV_EXCL_LINE
+                                        beforeLog, t0Timeout, m_t0); //LCOV_EXCL_LINE
             }
         }
         else {
             Iec104Utility::log_warn("%s transport_layer.t0_timeout is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
-                                    beforeLog.c_str(), m_t0); //LCOV_EXCL_LINE
+                                    beforeLog, m_t0); //LCOV_EXCL_LINE
         }
     }
 
@@ -257,12 +296,12 @@ IEC104Config::importTransportLayer(const Value& transportLayer)
             }
             else {
                 Iec104Utility::log_warn("%s transport_layer.t1_timeout value out of range [1..255]: %d -> using default value (%d)", //LCOV_EXCL_LINE
-                                        beforeLog.c_str(), t1Timeout, m_t1); //LCOV_EXCL_LINE
+                                        beforeLog, t1Timeout, m_t1); //LCOV_EXCL_LINE
             }
         }
         else {
             Iec104Utility::log_warn("%s transport_layer.t1_timeout is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
-                                    beforeLog.c_str(), m_t1); //LCOV_EXCL_LINE
+                                    beforeLog, m_t1); //LCOV_EXCL_LINE
         }
     }
 
@@ -275,12 +314,12 @@ IEC104Config::importTransportLayer(const Value& transportLayer)
             }
             else {
                 Iec104Utility::log_warn("%s transport_layer.t2_timeout value out of range [1..255]: %d -> using default value (%d)", //LCOV_EXCL_LINE
-                                        beforeLog.c_str(), t2Timeout, m_t2); //LCOV_EXCL_LINE
+                                        beforeLog, t2Timeout, m_t2); //LCOV_EXCL_LINE
             }
         }
         else {
             Iec104Utility::log_warn("%s transport_layer.t2_timeout is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
-                                    beforeLog.c_str(), m_t2); //LCOV_EXCL_LINE
+                                    beforeLog, m_t2); //LCOV_EXCL_LINE
         }
     }
 
@@ -293,12 +332,48 @@ IEC104Config::importTransportLayer(const Value& transportLayer)
             }
             else {
                 Iec104Utility::log_warn("%s transport_layer.t3_timeout value out of range [0..+Inf]: %d -> using default value (%d)", //LCOV_EXCL_LINE
-                                        beforeLog.c_str(), t3Timeout, m_t3); //LCOV_EXCL_LINE
+                                        beforeLog, t3Timeout, m_t3); //LCOV_EXCL_LINE
             }
         }
         else {
             Iec104Utility::log_warn("%s transport_layer.t3_timeout is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
-                                    beforeLog.c_str(), m_t3); //LCOV_EXCL_LINE
+                                    beforeLog, m_t3); //LCOV_EXCL_LINE
+        }
+    }
+
+    if (transportLayer.HasMember("conn_rate_limit")) {
+        if (transportLayer["conn_rate_limit"].IsInt()) {
+            int connRateLimit = transportLayer["conn_rate_limit"].GetInt();
+
+            if (connRateLimit > -1) {
+                m_connRateLimit = connRateLimit;
+            }
+            else {
+                Iec104Utility::log_warn("%s transport_layer.conn_rate_limit value out of range [0..+Inf]: %d -> using default value (%d)", //LCOV_EXCL_LINE
+                                        beforeLog, connRateLimit, m_connRateLimit); //LCOV_EXCL_LINE
+            }
+        }
+        else {
+            Iec104Utility::log_warn("%s transport_layer.conn_rate_limit is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
+                                    beforeLog, m_connRateLimit); //LCOV_EXCL_LINE
+        }
+    }
+
+    if (transportLayer.HasMember("conn_rate_burst")) {
+        if (transportLayer["conn_rate_burst"].IsInt()) {
+            int connRateBurst = transportLayer["conn_rate_burst"].GetInt();
+
+            if (connRateBurst > 0) {
+                m_connRateBurst = connRateBurst;
+            }
+            else {
+                Iec104Utility::log_warn("%s transport_layer.conn_rate_burst value out of range [1..+Inf]: %d -> using default value (%d)", //LCOV_EXCL_LINE
+                                        beforeLog, connRateBurst, m_connRateBurst); //LCOV_EXCL_LINE
+            }
+        }
+        else {
+            Iec104Utility::log_warn("%s transport_layer.conn_rate_burst is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
+                                    beforeLog, m_connRateBurst); //LCOV_EXCL_LINE
         }
     }
 
@@ -307,7 +382,7 @@ IEC104Config::importTransportLayer(const Value& transportLayer)
             m_useTls = transportLayer["tls"].GetBool();
         }
         else {
-            Iec104Utility::log_warn("%s transport_layer.tls is not a bool -> not using TLS", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_warn("%s transport_layer.tls is not a bool -> not using TLS", beforeLog); //LCOV_EXCL_LINE
         }
     }
 
@@ -315,11 +390,11 @@ IEC104Config::importTransportLayer(const Value& transportLayer)
         if (transportLayer["srv_ip"].IsString()) {
             if (isValidIPAddress(transportLayer["srv_ip"].GetString())) {
                 m_ip = transportLayer["srv_ip"].GetString();
-                Iec104Utility::log_info("%s Using local IP address: %s", beforeLog.c_str(), m_ip.c_str()); //LCOV_EXCL_LINE
+                Iec104Utility::log_info("%s Using local IP address: %s", beforeLog, m_ip.c_str()); //LCOV_EXCL_LINE
                 m_bindOnIp = true;
             }
             else {
-                Iec104Utility::log_warn("%s transport_layer.srv_ip is not a string -> not using TLS", beforeLog.c_str()); //LCOV_EXCL_LINE
+                Iec104Utility::log_warn("%s transport_layer.srv_ip is not a string -> not using TLS", beforeLog); //LCOV_EXCL_LINE
             }
         }
     }
@@ -328,7 +403,7 @@ IEC104Config::importTransportLayer(const Value& transportLayer)
 void
 IEC104Config::importApplicationLayer(const Value& applicationLayer)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Config::importApplicationLayer -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Config::importApplicationLayer"); //LCOV_EXCL_LINE
 
     if (applicationLayer.HasMember("ca_asdu_size")) {
         if (applicationLayer["ca_asdu_size"].IsInt()) {
@@ -339,12 +414,12 @@ IEC104Config::importApplicationLayer(const Value& applicationLayer)
             }
             else {
                 Iec104Utility::log_warn("%s application_layer.ca_asdu_size value out of range [1..2]: %d -> using default value (%d)", //LCOV_EXCL_LINE
-                                        beforeLog.c_str(), caSize, m_caSize); //LCOV_EXCL_LINE
+                                        beforeLog, caSize, m_caSize); //LCOV_EXCL_LINE
             }
         }
         else {
             Iec104Utility::log_warn("%s application_layer.ca_asdu_size is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
-                                    beforeLog.c_str(), m_caSize); //LCOV_EXCL_LINE
+                                    beforeLog, m_caSize); //LCOV_EXCL_LINE
         }
     }
 
@@ -357,12 +432,12 @@ IEC104Config::importApplicationLayer(const Value& applicationLayer)
             }
             else {
                 Iec104Utility::log_warn("%s application_layer.ioaddr_size value out of range [1..3]: %d -> using default value (%d)", //LCOV_EXCL_LINE
-                                        beforeLog.c_str(), ioaSize, m_ioaSize); //LCOV_EXCL_LINE
+                                        beforeLog, ioaSize, m_ioaSize); //LCOV_EXCL_LINE
             }
         }
         else {
             Iec104Utility::log_warn("%s application_layer.ioaddr_size is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
-                                    beforeLog.c_str(), m_ioaSize); //LCOV_EXCL_LINE
+                                    beforeLog, m_ioaSize); //LCOV_EXCL_LINE
         }
     }
 
@@ -375,12 +450,12 @@ IEC104Config::importApplicationLayer(const Value& applicationLayer)
             }
             else {
                 Iec104Utility::log_warn("%s application_layer.asdu_size value out of range [0,11..253]: %d -> using default value (%d)", //LCOV_EXCL_LINE
-                                        beforeLog.c_str(), asduSize, m_asduSize); //LCOV_EXCL_LINE
+                                        beforeLog, asduSize, m_asduSize); //LCOV_EXCL_LINE
             }
         }
         else {
             Iec104Utility::log_warn("%s application_layer.asdu_size is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
-                                    beforeLog.c_str(), m_asduSize); //LCOV_EXCL_LINE
+                                    beforeLog, m_asduSize); //LCOV_EXCL_LINE
         }
     }
 
@@ -389,7 +464,7 @@ IEC104Config::importApplicationLayer(const Value& applicationLayer)
             m_timeSync = applicationLayer["time_sync"].GetBool();
         }
         else {
-            Iec104Utility::log_warn("%s application_layer.time_sync is not a bool -> using default value (%s)", beforeLog.c_str(), //LCOV_EXCL_LINE
+            Iec104Utility::log_warn("%s application_layer.time_sync is not a bool -> using default value (%s)", beforeLog, //LCOV_EXCL_LINE
                                     (m_timeSync?"true":"false")); //LCOV_EXCL_LINE
         }
     }
@@ -407,21 +482,21 @@ IEC104Config::importApplicationLayer(const Value& applicationLayer)
                         }
                         else {
                             Iec104Utility::log_error("%s application_layer.filter_list: OA address value out of range [1..255]: %d", //LCOV_EXCL_LINE
-                                                    beforeLog.c_str(), oaValue); //LCOV_EXCL_LINE
+                                                    beforeLog, oaValue); //LCOV_EXCL_LINE
                         }
                     }
                     else {
                         Iec104Utility::log_error("%s application_layer.filter_list: orig_addr does not exist or is not an integer", //LCOV_EXCL_LINE
-                                                    beforeLog.c_str()); //LCOV_EXCL_LINE
+                                                    beforeLog); //LCOV_EXCL_LINE
                     }
                 }
                 else {
-                    Iec104Utility::log_error("%s application_layer.filter_list element is not an object", beforeLog.c_str()); //LCOV_EXCL_LINE
+                    Iec104Utility::log_error("%s application_layer.filter_list element is not an object", beforeLog); //LCOV_EXCL_LINE
                 }
             }
         }
         else {
-            Iec104Utility::log_error("%s application_layer.filter_list is not an array", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_error("%s application_layer.filter_list is not an array", beforeLog); //LCOV_EXCL_LINE
         }
     }
 
@@ -434,12 +509,66 @@ IEC104Config::importApplicationLayer(const Value& applicationLayer)
             else {
                 Iec104Utility::log_warn( //LCOV_EXCL_LINE
                     "%s application_layer.asdu_queue_size value out of range [1..+Inf]: %d -> using default value (%d)",              //LCOV_EXCL_LINE
-                    beforeLog.c_str(), asduQueueSize, m_asduQueueSize);
+                    beforeLog, asduQueueSize, m_asduQueueSize);
             }
         }
         else {
             Iec104Utility::log_warn("%s application_layer.asdu_queue_size is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
-                                    beforeLog.c_str(), m_asduQueueSize); //LCOV_EXCL_LINE
+                                    beforeLog, m_asduQueueSize); //LCOV_EXCL_LINE
+        }
+    }
+
+    if (applicationLayer.HasMember("bkg_scan_rate")) {
+        if (applicationLayer["bkg_scan_rate"].IsInt()) {
+            int bkgScanRate = applicationLayer["bkg_scan_rate"].GetInt();
+            if (bkgScanRate >= 0) {
+                m_bkgScanRate = bkgScanRate;
+            }
+            else {
+                Iec104Utility::log_warn( //LCOV_EXCL_LINE
+                    "%s application_layer.bkg_scan_rate value out of range [0..+Inf]: %d -> using default value (%d)",              //LCOV_EXCL_LINE
+                    beforeLog, bkgScanRate, m_bkgScanRate);
+            }
+        }
+        else {
+            Iec104Utility::log_warn("%s application_layer.bkg_scan_rate is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
+                                    beforeLog, m_bkgScanRate); //LCOV_EXCL_LINE
+        }
+    }
+
+    if (applicationLayer.HasMember("encoder_queue_size")) {
+        if (applicationLayer["encoder_queue_size"].IsInt()) {
+            int encoderQueueSize = applicationLayer["encoder_queue_size"].GetInt();
+            if ((encoderQueueSize >= 0) && (encoderQueueSize <= 1048576)) {
+                m_encoderQueueSize = encoderQueueSize;
+            }
+            else {
+                Iec104Utility::log_warn( //LCOV_EXCL_LINE
+                    "%s application_layer.encoder_queue_size value out of range [0..1048576]: %d -> using default value (%d)",              //LCOV_EXCL_LINE
+                    beforeLog, encoderQueueSize, m_encoderQueueSize);
+            }
+        }
+        else {
+            Iec104Utility::log_warn("%s application_layer.encoder_queue_size is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
+                                    beforeLog, m_encoderQueueSize); //LCOV_EXCL_LINE
+        }
+    }
+
+    if (applicationLayer.HasMember("decode_workers")) {
+        if (applicationLayer["decode_workers"].IsInt()) {
+            int decodeWorkers = applicationLayer["decode_workers"].GetInt();
+            if ((decodeWorkers >= 1) && (decodeWorkers <= 64)) {
+                m_decodeWorkers = decodeWorkers;
+            }
+            else {
+                Iec104Utility::log_warn( //LCOV_EXCL_LINE
+                    "%s application_layer.decode_workers value out of range [1..64]: %d -> using default value (%d)",              //LCOV_EXCL_LINE
+                    beforeLog, decodeWorkers, m_decodeWorkers);
+            }
+        }
+        else {
+            Iec104Utility::log_warn("%s application_layer.decode_workers is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
+                                    beforeLog, m_decodeWorkers); //LCOV_EXCL_LINE
         }
     }
 
@@ -452,13 +581,13 @@ IEC104Config::importApplicationLayer(const Value& applicationLayer)
             else {
                 Iec104Utility::log_warn( //LCOV_EXCL_LINE
                     "%s application_layer.accept_cmd_with_time value out of range [0..2]: %d -> using default: only commands with timestamp allowed (%d)", //LCOV_EXCL_LINE
-                    beforeLog.c_str(), acceptCmdWithTime, m_allowedCommands);
+                    beforeLog, acceptCmdWithTime, m_allowedCommands);
             }
         }
         else {
             Iec104Utility::log_warn( //LCOV_EXCL_LINE
                 "%s application_layer.accept_cmd_with_time is not an integer -> using default: only commands with timestamp allowed (%d)", //LCOV_EXCL_LINE
-                beforeLog.c_str(), m_allowedCommands);
+                beforeLog, m_allowedCommands);
         }
     }
 
@@ -470,12 +599,12 @@ IEC104Config::importApplicationLayer(const Value& applicationLayer)
             }
             else {
                 Iec104Utility::log_warn("%s application_layer.cmd_recv_timeout value out of range [0..+Inf]: %d -> using default: disabled (%d)", //LCOV_EXCL_LINE
-                                        beforeLog.c_str(), cmdRecvTimeout, m_cmdRecvTimeout); //LCOV_EXCL_LINE
+                                        beforeLog, cmdRecvTimeout, m_cmdRecvTimeout); //LCOV_EXCL_LINE
             }
         }
         else {
              Iec104Utility::log_warn("%s application_layer.cmd_recv_timeout is not an integer -> using default: disabled (%d)", //LCOV_EXCL_LINE
-                                    beforeLog.c_str(), m_cmdRecvTimeout); //LCOV_EXCL_LINE
+                                    beforeLog, m_cmdRecvTimeout); //LCOV_EXCL_LINE
         }
     }
 
@@ -487,12 +616,12 @@ IEC104Config::importApplicationLayer(const Value& applicationLayer)
             }
             else {
                 Iec104Utility::log_warn("%s application_layer.cmd_exec_timeout value out of range [0..+Inf]: %d -> using default: %d seconds", //LCOV_EXCL_LINE
-                                        beforeLog.c_str(), cmdExecTimeout, m_cmdExecTimeout); //LCOV_EXCL_LINE
+                                        beforeLog, cmdExecTimeout, m_cmdExecTimeout); //LCOV_EXCL_LINE
             }
         }
         else {
              Iec104Utility::log_warn("%s application_layer.cmd_exec_timeout is not an integer -> using default: %d seconds", //LCOV_EXCL_LINE
-                                    beforeLog.c_str(), m_cmdExecTimeout); //LCOV_EXCL_LINE
+                                    beforeLog, m_cmdExecTimeout); //LCOV_EXCL_LINE
         }
     }
 
@@ -501,7 +630,7 @@ IEC104Config::importApplicationLayer(const Value& applicationLayer)
             m_cmdDest = applicationLayer["cmd_dest"].GetString();
         }
         else {
-            Iec104Utility::log_warn("%s application_layer.cmd_dest is not a string -> broadcast commands", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_warn("%s application_layer.cmd_dest is not a string -> broadcast commands", beforeLog); //LCOV_EXCL_LINE
         }   
     }
 }
@@ -509,36 +638,39 @@ IEC104Config::importApplicationLayer(const Value& applicationLayer)
 void
 IEC104Config::importProtocolConfig(const std::string& protocolConfig)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Config::importProtocolConfig -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Config::importProtocolConfig"); //LCOV_EXCL_LINE
     m_protocolConfigComplete = false;
 
+    m_monitoredSouthPlugins.clear();
+    m_protocolArena.release();
+
     Document document;
 
     if (document.Parse(const_cast<char*>(protocolConfig.c_str())).HasParseError()) {
-        Iec104Utility::log_fatal("%s Parsing error in protocol_stack json, offset %u: %s", beforeLog.c_str(), //LCOV_EXCL_LINE
+        Iec104Utility::log_fatal("%s Parsing error in protocol_stack json, offset %u: %s", beforeLog, //LCOV_EXCL_LINE
                                     static_cast<unsigned>(document.GetErrorOffset()), GetParseError_En(document.GetParseError())); //LCOV_EXCL_LINE
         return;
     }
 
     if (!document.IsObject()) {
-        Iec104Utility::log_fatal("%s Root is not an object", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_fatal("%s Root is not an object", beforeLog); //LCOV_EXCL_LINE
         return;
     }
 
     if (!document.HasMember("protocol_stack") || !document["protocol_stack"].IsObject()) {
-        Iec104Utility::log_fatal("%s protocol_stack does not exist or is not an object", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_fatal("%s protocol_stack does not exist or is not an object", beforeLog); //LCOV_EXCL_LINE
         return;
     }
 
     const Value& protocolStack = document["protocol_stack"];
 
     if (!protocolStack.HasMember("transport_layer") || !protocolStack["transport_layer"].IsObject()) {
-        Iec104Utility::log_fatal("%s transport_layer does not exist or is not an object", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_fatal("%s transport_layer does not exist or is not an object", beforeLog); //LCOV_EXCL_LINE
         return;
     }
 
     if (!protocolStack.HasMember("application_layer") || !protocolStack["application_layer"].IsObject()) {
-        Iec104Utility::log_fatal("%s application_layer does not exist or is not an object", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_fatal("%s application_layer does not exist or is not an object", beforeLog); //LCOV_EXCL_LINE
         return;
     }
 
@@ -555,28 +687,28 @@ IEC104Config::importProtocolConfig(const std::string& protocolConfig)
             for (const Value& southMonInst : southMonitoring.GetArray()) {
 
                 if (!southMonInst.IsObject()) {
-                    Iec104Utility::log_error("%s south_monitoring element is not an object", beforeLog.c_str()); //LCOV_EXCL_LINE
+                    Iec104Utility::log_error("%s south_monitoring element is not an object", beforeLog); //LCOV_EXCL_LINE
                     continue;
                 }
                 if (southMonInst.HasMember("asset")) {
                     if (southMonInst["asset"].IsString()) {
                         std::string assetName = southMonInst["asset"].GetString();
 
-                        SouthPluginMonitor* monitor = new SouthPluginMonitor(assetName);
+                        SouthPluginMonitor* monitor = m_protocolArena.create<SouthPluginMonitor>(assetName);
 
                         m_monitoredSouthPlugins.push_back(monitor);
                     }
                     else {
-                        Iec104Utility::log_error("%s south_monitoring \"asset\" element is not a string", beforeLog.c_str()); //LCOV_EXCL_LINE
+                        Iec104Utility::log_error("%s south_monitoring \"asset\" element is not a string", beforeLog); //LCOV_EXCL_LINE
                     }
                 }
                 else {
-                    Iec104Utility::log_error("%s south_monitoring is missing \"asset\" element", beforeLog.c_str()); //LCOV_EXCL_LINE
+                    Iec104Utility::log_error("%s south_monitoring is missing \"asset\" element", beforeLog); //LCOV_EXCL_LINE
                 }
             }
         }
         else {
-            Iec104Utility::log_error("%s south_monitoring is not an array", beforeLog.c_str()); //LCOV_EXCL_LINE
+            Iec104Utility::log_error("%s south_monitoring is not an array", beforeLog); //LCOV_EXCL_LINE
         }
     }
 
@@ -586,69 +718,81 @@ IEC104Config::importProtocolConfig(const std::string& protocolConfig)
 void
 IEC104Config::importExchangeConfig(const std::string& exchangeConfig)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Config::importExchangeConfig -"; //LCOV_EXCL_LINE
     m_exchangeConfigComplete = false;
 
     deleteExchangeDefinitions();
 
-    m_exchangeDefinitions = new std::map<int, std::map<int, IEC104DataPoint*>>();
+    m_pointTable = std::make_shared<IEC104PointTable>();
+
+    importDataPoints(exchangeConfig);
+
+    /* also when the import stopped on an error, the points imported so far are used */
+    m_pointTable->finalize();
+}
+
+void
+IEC104Config::importDataPoints(const std::string& exchangeConfig)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Config::importDataPoints"); //LCOV_EXCL_LINE
 
     Document document;
 
     if (document.Parse(const_cast<char*>(exchangeConfig.c_str())).HasParseError()) {
-        Iec104Utility::log_fatal("%s Parsing error in exchanged_data json, offset %u: %s", beforeLog.c_str(), //LCOV_EXCL_LINE
+        Iec104Utility::log_fatal("%s Parsing error in exchanged_data json, offset %u: %s", beforeLog, //LCOV_EXCL_LINE
                                     static_cast<unsigned>(document.GetErrorOffset()), GetParseError_En(document.GetParseError())); //LCOV_EXCL_LINE
         return;
     }
 
     if (!document.IsObject()) {
-        Iec104Utility::log_fatal("%s Root is not an object", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_fatal("%s Root is not an object", beforeLog); //LCOV_EXCL_LINE
         return;
     }
         
 
     if (!document.HasMember(JSON_EXCHANGED_DATA) || !document[JSON_EXCHANGED_DATA].IsObject()) {
-        Iec104Utility::log_fatal("%s %s does not exist or is not an object", beforeLog.c_str(), JSON_EXCHANGED_DATA); //LCOV_EXCL_LINE
+        Iec104Utility::log_fatal("%s %s does not exist or is not an object", beforeLog, JSON_EXCHANGED_DATA); //LCOV_EXCL_LINE
         return;
     }
 
     const Value& exchangeData = document[JSON_EXCHANGED_DATA];
 
     if (!exchangeData.HasMember(JSON_DATAPOINTS) || !exchangeData[JSON_DATAPOINTS].IsArray()) {
-        Iec104Utility::log_fatal("%s %s does not exist or is not an array", beforeLog.c_str(), JSON_DATAPOINTS); //LCOV_EXCL_LINE
+        Iec104Utility::log_fatal("%s %s does not exist or is not an array", beforeLog, JSON_DATAPOINTS); //LCOV_EXCL_LINE
         return;
     }
 
     const Value& datapoints = exchangeData[JSON_DATAPOINTS];
 
+    std::vector<PackMembership> packMemberships;
+
     for (const Value& datapoint : datapoints.GetArray()) {
 
         if (!datapoint.IsObject()) {
-            Iec104Utility::log_error("%s %s element is not an object", beforeLog.c_str(), JSON_DATAPOINTS); //LCOV_EXCL_LINE
+            Iec104Utility::log_error("%s %s element is not an object", beforeLog, JSON_DATAPOINTS); //LCOV_EXCL_LINE
             return;
         } 
 
         if (!datapoint.HasMember(JSON_LABEL) || !datapoint[JSON_LABEL].IsString()) {
-            Iec104Utility::log_error("%s %s does not exist or is not a string", beforeLog.c_str(), JSON_LABEL); //LCOV_EXCL_LINE
+            Iec104Utility::log_error("%s %s does not exist or is not a string", beforeLog, JSON_LABEL); //LCOV_EXCL_LINE
             return;
         }
 
         std::string label = datapoint[JSON_LABEL].GetString();
 
         if (!datapoint.HasMember(JSON_PROTOCOLS) || !datapoint[JSON_PROTOCOLS].IsArray()) {
-            Iec104Utility::log_error("%s %s does not exist or is not an array", beforeLog.c_str(), JSON_PROTOCOLS); //LCOV_EXCL_LINE
+            Iec104Utility::log_error("%s %s does not exist or is not an array", beforeLog, JSON_PROTOCOLS); //LCOV_EXCL_LINE
             return;
         }
 
         for (const Value& protocol : datapoint[JSON_PROTOCOLS].GetArray()) {
             
             if (!protocol.IsObject()) {
-                Iec104Utility::log_error("%s %s element is not an object", beforeLog.c_str(), JSON_PROTOCOLS); //LCOV_EXCL_LINE
+                Iec104Utility::log_error("%s %s element is not an object", beforeLog, JSON_PROTOCOLS); //LCOV_EXCL_LINE
                 return;
             } 
             
             if (!protocol.HasMember(JSON_PROT_NAME) || !protocol[JSON_PROT_NAME].IsString()) {
-                Iec104Utility::log_error("%s %s does not exist or is not a string", beforeLog.c_str(), JSON_PROT_NAME); //LCOV_EXCL_LINE
+                Iec104Utility::log_error("%s %s does not exist or is not a string", beforeLog, JSON_PROT_NAME); //LCOV_EXCL_LINE
                 return;
             }
             
@@ -657,11 +801,11 @@ IEC104Config::importExchangeConfig(const std::string& exchangeConfig)
             if (protocolName == PROTOCOL_IEC104) {
 
                 if (!protocol.HasMember(JSON_PROT_ADDR) || !protocol[JSON_PROT_ADDR].IsString()) {
-                    Iec104Utility::log_error("%s %s does not exist or is not a string", beforeLog.c_str(), JSON_PROT_ADDR); //LCOV_EXCL_LINE
+                    Iec104Utility::log_error("%s %s does not exist or is not a string", beforeLog, JSON_PROT_ADDR); //LCOV_EXCL_LINE
                     return;
                 }
                 if (!protocol.HasMember(JSON_PROT_TYPEID) || !protocol[JSON_PROT_TYPEID].IsString()) {
-                    Iec104Utility::log_error("%s %s does not exist or is not a string", beforeLog.c_str(), JSON_PROT_TYPEID); //LCOV_EXCL_LINE
+                    Iec104Utility::log_error("%s %s does not exist or is not a string", beforeLog, JSON_PROT_TYPEID); //LCOV_EXCL_LINE
                     return;
                 }
 
@@ -693,23 +837,23 @@ IEC104Config::importExchangeConfig(const std::string& exchangeConfig)
                                         group = std::stoi(substr);
                                     } catch (const std::invalid_argument &e) {
                                         Iec104Utility::log_error("%s  Cannot convert group '%s' to integer: %s", //LCOV_EXCL_LINE
-                                                                beforeLog.c_str(), substr.c_str(), e.what()); //LCOV_EXCL_LINE
+                                                                beforeLog, substr.c_str(), e.what()); //LCOV_EXCL_LINE
                                         return;
                                     } catch (const std::out_of_range &e) {
                                         Iec104Utility::log_error("%s  Cannot convert group '%s' to integer: %s", //LCOV_EXCL_LINE
-                                                                beforeLog.c_str(), substr.c_str(), e.what()); //LCOV_EXCL_LINE
+                                                                beforeLog, substr.c_str(), e.what()); //LCOV_EXCL_LINE
                                         return;
                                     }
 
                                     if(group <= 0 || group >= 17){
                                         Iec104Utility::log_warn("%s %s value out of range [1..16]: %d, defaulting to station.", //LCOV_EXCL_LINE
-                                                                beforeLog.c_str(), JSON_PROT_GI_GROUPS, group, gi_groups); //LCOV_EXCL_LINE
+                                                                beforeLog, JSON_PROT_GI_GROUPS, group, gi_groups); //LCOV_EXCL_LINE
                                         gi_groups = 1;   
                                         break; //LCOV_EXCL_LINE
                                     }
                                 }
                                 else {
-                                    Iec104Utility::log_warn("%s %s value invalid, defaulting to station.", beforeLog.c_str(), //LCOV_EXCL_LINE
+                                    Iec104Utility::log_warn("%s %s value invalid, defaulting to station.", beforeLog, //LCOV_EXCL_LINE
                                                             JSON_PROT_GI_GROUPS); //LCOV_EXCL_LINE
                                     gi_groups = 1;   
                                     break; //LCOV_EXCL_LINE
@@ -720,7 +864,7 @@ IEC104Config::importExchangeConfig(const std::string& exchangeConfig)
                         }
                     }
                     else {
-                        Iec104Utility::log_warn("%s %s value is not a string, defaulting to station.", beforeLog.c_str(), //LCOV_EXCL_LINE
+                        Iec104Utility::log_warn("%s %s value is not a string, defaulting to station.", beforeLog, //LCOV_EXCL_LINE
                                                 JSON_PROT_GI_GROUPS); //LCOV_EXCL_LINE
                         gi_groups = 1;   
                         break; //LCOV_EXCL_LINE
@@ -730,12 +874,12 @@ IEC104Config::importExchangeConfig(const std::string& exchangeConfig)
                     gi_groups = 1;
                 }
 
-                Iec104Utility::log_debug("%s GI GROUPS = %i", beforeLog.c_str(), gi_groups);     //LCOV_EXCL_LINE
+                Iec104Utility::log_debug("%s GI GROUPS = %i", beforeLog, gi_groups);     //LCOV_EXCL_LINE
 
                 std::string address = protocol[JSON_PROT_ADDR].GetString();
                 std::string typeIdStr = protocol[JSON_PROT_TYPEID].GetString();
 
-                Iec104Utility::log_debug("%s  address: %s type: %s", beforeLog.c_str(), address.c_str(), typeIdStr.c_str()); //LCOV_EXCL_LINE
+                Iec104Utility::log_debug("%s  address: %s type: %s", beforeLog, address.c_str(), typeIdStr.c_str()); //LCOV_EXCL_LINE
 
                 size_t sepPos = address.find("-");
 
@@ -750,15 +894,15 @@ IEC104Config::importExchangeConfig(const std::string& exchangeConfig)
                         ioa = std::stoi(ioaStr);
                     } catch (const std::invalid_argument &e) {
                         Iec104Utility::log_error("%s  Cannot convert ca '%s' or ioa '%s' to integer: %s", //LCOV_EXCL_LINE
-                                                beforeLog.c_str(), caStr.c_str(), ioaStr.c_str(), e.what()); //LCOV_EXCL_LINE
+                                                beforeLog, caStr.c_str(), ioaStr.c_str(), e.what()); //LCOV_EXCL_LINE
                         return;
                     } catch (const std::out_of_range &e) {
                         Iec104Utility::log_error("%s  Cannot convert ca '%s' or ioa '%s' to integer: %s", //LCOV_EXCL_LINE
-                                                beforeLog.c_str(), caStr.c_str(), ioaStr.c_str(), e.what()); //LCOV_EXCL_LINE
+                                                beforeLog, caStr.c_str(), ioaStr.c_str(), e.what()); //LCOV_EXCL_LINE
                         return;
                     }
 
-                    Iec104Utility::log_debug("%s  CA: %i IOA: %i", beforeLog.c_str(), ca, ioa); //LCOV_EXCL_LINE
+                    Iec104Utility::log_debug("%s  CA: %i IOA: %i", beforeLog, ca, ioa); //LCOV_EXCL_LINE
 
                     int typeId = IEC104DataPoint::getTypeIdFromString(typeIdStr);
                     int dataType = IEC104DataPoint::typeIdToDataType(typeId);
@@ -767,17 +911,59 @@ IEC104Config::importExchangeConfig(const std::string& exchangeConfig)
                     bool isMonitoring = IEC104DataPoint::isSupportedMonitoringType(typeId);
 
                     if (isCommand || isMonitoring) {
-                        IEC104DataPoint* newDp = new IEC104DataPoint(label, ca, ioa, dataType, isCommand, gi_groups);
-               
-                        (*m_exchangeDefinitions)[ca][ioa] = newDp;
+                        IEC104DataPoint* newDp = m_pointTable->addDataPoint(label, ca, ioa, dataType, isCommand, gi_groups);
+                        newDp->m_cp24TimeTag = IEC104DataPoint::hasCP24TimeTag(typeId);
+
+                        if (protocol.HasMember(JSON_PROT_PACK_ADDR)) {
+                            int packCa = 0;
+                            int packIoa = 0;
+
+                            if (!protocol[JSON_PROT_PACK_ADDR].IsString() ||
+                                (sscanf(protocol[JSON_PROT_PACK_ADDR].GetString(), "%d-%d", &packCa, &packIoa) != 2)) {
+                                Iec104Utility::log_error("%s  %s of %i:%i does not follow format 'XXX-YYY' -> transmitted individually", //LCOV_EXCL_LINE
+                                                        beforeLog, JSON_PROT_PACK_ADDR, ca, ioa); //LCOV_EXCL_LINE
+                            }
+                            else if (!protocol.HasMember(JSON_PROT_PACK_BIT) || !protocol[JSON_PROT_PACK_BIT].IsInt()) {
+                                Iec104Utility::log_error("%s  %s of %i:%i does not exist or is not an integer -> transmitted individually", //LCOV_EXCL_LINE
+                                                        beforeLog, JSON_PROT_PACK_BIT, ca, ioa); //LCOV_EXCL_LINE
+                            }
+                            else {
+                                packMemberships.push_back({newDp, packCa, packIoa, protocol[JSON_PROT_PACK_BIT].GetInt()});
+                            }
+                        }
+
+                        if (isMonitoring && protocol.HasMember(JSON_PROT_CYCLIC_PERIOD)) {
+                            if (protocol[JSON_PROT_CYCLIC_PERIOD].IsInt() && (protocol[JSON_PROT_CYCLIC_PERIOD].GetInt() >= 0)) {
+                                newDp->m_cyclicPeriod = protocol[JSON_PROT_CYCLIC_PERIOD].GetInt();
+                            }
+                            else {
+                                Iec104Utility::log_warn("%s  %s of %i:%i is not a positive integer -> not transmitted cyclically", //LCOV_EXCL_LINE
+                                                        beforeLog, JSON_PROT_CYCLIC_PERIOD, ca, ioa); //LCOV_EXCL_LINE
+                            }
+                        }
+
+                        if ((dataType == IEC60870_TYPE_COUNTER) && protocol.HasMember(JSON_PROT_CI_GROUP)) {
+                            if (protocol[JSON_PROT_CI_GROUP].IsInt() && (protocol[JSON_PROT_CI_GROUP].GetInt() >= 1) &&
+                                (protocol[JSON_PROT_CI_GROUP].GetInt() <= 4)) {
+                                newDp->m_counterGroup = protocol[JSON_PROT_CI_GROUP].GetInt();
+                            }
+                            else {
+                                Iec104Utility::log_warn("%s  %s of %i:%i is not an integer in [1..4] -> only part of the general counter interrogation", //LCOV_EXCL_LINE
+                                                        beforeLog, JSON_PROT_CI_GROUP, ca, ioa); //LCOV_EXCL_LINE
+                            }
+                        }
+
+                        if (protocol.HasMember(JSON_PROT_CONVERSION)) {
+                            importConversion(protocol[JSON_PROT_CONVERSION], newDp);
+                        }
                     }
                     else {
                         Iec104Utility::log_debug("%s  Skip datapoint %i:%i as it is not a supported type: %s", //LCOV_EXCL_LINE
-                                                beforeLog.c_str(), ca, ioa, typeIdStr.c_str()); //LCOV_EXCL_LINE
+                                                beforeLog, ca, ioa, typeIdStr.c_str()); //LCOV_EXCL_LINE
                     }
                 }
                 else {
-                    Iec104Utility::log_error("%s  %s value does not follow format 'XXX-YYY': %s", beforeLog.c_str(), JSON_PROT_ADDR, //LCOV_EXCL_LINE
+                    Iec104Utility::log_error("%s  %s value does not follow format 'XXX-YYY': %s", beforeLog, JSON_PROT_ADDR, //LCOV_EXCL_LINE
                                             address.c_str()); //LCOV_EXCL_LINE
                     return;
                 }
@@ -785,29 +971,128 @@ IEC104Config::importExchangeConfig(const std::string& exchangeConfig)
         }
     }
 
+    linkPackedPoints(packMemberships);
+
     m_exchangeConfigComplete = true;
 }
 
+void
+IEC104Config::importConversion(const Value& conversion, IEC104DataPoint* dp)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Config::importConversion"); //LCOV_EXCL_LINE
+
+    int dataType = dp->m_type;
+
+    if ((dataType != IEC60870_TYPE_NORMALIZED) && (dataType != IEC60870_TYPE_SCALED) && (dataType != IEC60870_TYPE_SHORT)) {
+        Iec104Utility::log_warn("%s %s of %i:%i is only supported by measured values -> ignored", beforeLog, //LCOV_EXCL_LINE
+                                JSON_PROT_CONVERSION, dp->m_ca, dp->m_ioa); //LCOV_EXCL_LINE
+        return;
+    }
+
+    if (!conversion.IsObject()) {
+        Iec104Utility::log_warn("%s %s of %i:%i is not an object -> ignored", beforeLog, //LCOV_EXCL_LINE
+                                JSON_PROT_CONVERSION, dp->m_ca, dp->m_ioa); //LCOV_EXCL_LINE
+        return;
+    }
+
+    double scale = 1.0;
+    double offset = 0.0;
+
+    if (conversion.HasMember("scale")) {
+        if (conversion["scale"].IsNumber() && (conversion["scale"].GetDouble() != 0.0)) {
+            scale = conversion["scale"].GetDouble();
+        }
+        else {
+            Iec104Utility::log_warn("%s %s.scale of %i:%i is not a non-zero number -> 1 used", beforeLog, //LCOV_EXCL_LINE
+                                    JSON_PROT_CONVERSION, dp->m_ca, dp->m_ioa); //LCOV_EXCL_LINE
+        }
+    }
+
+    if (conversion.HasMember("offset")) {
+        if (conversion["offset"].IsNumber()) {
+            offset = conversion["offset"].GetDouble();
+        }
+        else {
+            Iec104Utility::log_warn("%s %s.offset of %i:%i is not a number -> 0 used", beforeLog, //LCOV_EXCL_LINE
+                                    JSON_PROT_CONVERSION, dp->m_ca, dp->m_ioa); //LCOV_EXCL_LINE
+        }
+    }
+
+    bool hasRange = false;
+    double min = 0.0;
+    double max = 0.0;
+
+    if (conversion.HasMember("min") || conversion.HasMember("max")) {
+        if (conversion.HasMember("min") && conversion["min"].IsNumber() &&
+            conversion.HasMember("max") && conversion["max"].IsNumber() &&
+            (conversion["min"].GetDouble() < conversion["max"].GetDouble())) {
+            hasRange = true;
+            min = conversion["min"].GetDouble();
+            max = conversion["max"].GetDouble();
+        }
+        else {
+            Iec104Utility::log_warn("%s %s.min and max of %i:%i are not numbers with min < max -> range of the type used", //LCOV_EXCL_LINE
+                                    beforeLog, JSON_PROT_CONVERSION, dp->m_ca, dp->m_ioa); //LCOV_EXCL_LINE
+        }
+    }
+
+    m_pointTable->setConversion(dp, IEC104Conversion::create(dataType, scale, offset, hasRange, min, max));
+}
+
+void
+IEC104Config::linkPackedPoints(const std::vector<PackMembership>& memberships)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Config::linkPackedPoints"); //LCOV_EXCL_LINE
+
+    for (const PackMembership& membership : memberships) {
+        IEC104DataPoint* member = membership.member;
+
+        if (member->isCommand() || (member->m_type != IEC60870_TYPE_SP)) {
+            Iec104Utility::log_error("%s Data point %i:%i is not a single point, it cannot be packed -> transmitted individually", //LCOV_EXCL_LINE
+                                    beforeLog, member->m_ca, member->m_ioa); //LCOV_EXCL_LINE
+            continue;
+        }
+
+        IEC104DataPoint* pack = m_pointTable->findDataPoint(membership.packCa, membership.packIoa);
+
+        if ((pack == nullptr) || (IEC104DataPoint::packedBitCount(pack->m_type) == 0)) {
+            Iec104Utility::log_error("%s Packed object %i:%i of %i:%i does not exist or is not a M_PS_NA_1/M_BO_NA_1 -> transmitted individually", //LCOV_EXCL_LINE
+                                    beforeLog, membership.packCa, membership.packIoa, member->m_ca, member->m_ioa); //LCOV_EXCL_LINE
+            continue;
+        }
+
+        if (!pack->addPackMember(member, membership.bit)) {
+            Iec104Utility::log_error("%s Bit %d of packed object %i:%i is out of range [0..%d] or already used -> %i:%i transmitted individually", //LCOV_EXCL_LINE
+                                    beforeLog, membership.bit, membership.packCa, membership.packIoa, //LCOV_EXCL_LINE
+                                    IEC104DataPoint::packedBitCount(pack->m_type) - 1, member->m_ca, member->m_ioa); //LCOV_EXCL_LINE
+            continue;
+        }
+
+        Iec104Utility::log_debug("%s Data point %i:%i packed in %i:%i bit %d", beforeLog, member->m_ca, member->m_ioa, //LCOV_EXCL_LINE
+                                membership.packCa, membership.packIoa, membership.bit); //LCOV_EXCL_LINE
+    }
+}
+
 void
 IEC104Config::importTlsConfig(const std::string& tlsConfig)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Config::importTlsConfig -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Config::importTlsConfig"); //LCOV_EXCL_LINE
     Document document;
 
     if (document.Parse(const_cast<char*>(tlsConfig.c_str())).HasParseError()) {
-        Iec104Utility::log_fatal("%s Parsing error in tls_conf json, offset %u: %s", beforeLog.c_str(), //LCOV_EXCL_LINE
+        Iec104Utility::log_fatal("%s Parsing error in tls_conf json, offset %u: %s", beforeLog, //LCOV_EXCL_LINE
                                 static_cast<unsigned>(document.GetErrorOffset()), GetParseError_En(document.GetParseError())); //LCOV_EXCL_LINE
         return;
     }
        
     if (!document.IsObject()) {
-        Iec104Utility::log_fatal("%s Root is not an object", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_fatal("%s Root is not an object", beforeLog); //LCOV_EXCL_LINE
         return;
     }
         
 
     if (!document.HasMember("tls_conf") || !document["tls_conf"].IsObject()) {
-        Iec104Utility::log_debug("%s tls_conf does not exist or is not an object", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_debug("%s tls_conf does not exist or is not an object", beforeLog); //LCOV_EXCL_LINE
         return;
     }
 
@@ -817,14 +1102,14 @@ IEC104Config::importTlsConfig(const std::string& tlsConfig)
         m_privateKey = tlsConf["private_key"].GetString();
     }
     else {
-        Iec104Utility::log_warn("%s private_key does not exist or is not a string", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_warn("%s private_key does not exist or is not a string", beforeLog); //LCOV_EXCL_LINE
     }
 
     if (tlsConf.HasMember("own_cert") && tlsConf["own_cert"].IsString()) {
         m_ownCertificate = tlsConf["own_cert"].GetString();
     }
     else {
-        Iec104Utility::log_warn("%s own_cert does not exist or is not a string", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_warn("%s own_cert does not exist or is not a string", beforeLog); //LCOV_EXCL_LINE
     }
 
     if (tlsConf.HasMember("ca_certs") && tlsConf["ca_certs"].IsArray()) {
@@ -833,7 +1118,7 @@ IEC104Config::importTlsConfig(const std::string& tlsConfig)
 
         for (const Value& caCert : caCerts.GetArray()) {
             if (!caCert.IsObject()) {
-                Iec104Utility::log_warn("%s ca_certs element is not an object", beforeLog.c_str()); //LCOV_EXCL_LINE
+                Iec104Utility::log_warn("%s ca_certs element is not an object", beforeLog); //LCOV_EXCL_LINE
                 continue;
             }
             
@@ -842,12 +1127,12 @@ IEC104Config::importTlsConfig(const std::string& tlsConfig)
                 m_caCertificates.push_back(certFileName);
             }
             else {
-                Iec104Utility::log_warn("%s ca_certs.cert_file does not exist or is not a string", beforeLog.c_str()); //LCOV_EXCL_LINE
+                Iec104Utility::log_warn("%s ca_certs.cert_file does not exist or is not a string", beforeLog); //LCOV_EXCL_LINE
             }
         }
     }
     else {
-        Iec104Utility::log_warn("%s ca_certs does not exist or is not an array", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_warn("%s ca_certs does not exist or is not an array", beforeLog); //LCOV_EXCL_LINE
     }
 
     if (tlsConf.HasMember("remote_certs") && tlsConf["remote_certs"].IsArray()) {
@@ -856,7 +1141,7 @@ IEC104Config::importTlsConfig(const std::string& tlsConfig)
 
         for (const Value& remoteCert : remoteCerts.GetArray()) {
             if (!remoteCert.IsObject()) {
-                Iec104Utility::log_warn("%s remote_certs element is not an object", beforeLog.c_str()); //LCOV_EXCL_LINE
+                Iec104Utility::log_warn("%s remote_certs element is not an object", beforeLog); //LCOV_EXCL_LINE
                 continue;
             }
 
@@ -865,12 +1150,12 @@ IEC104Config::importTlsConfig(const std::string& tlsConfig)
                 m_remoteCertificates.push_back(certFileName);
             }
             else {
-                Iec104Utility::log_warn("%s remote_certs.cert_file does not exist or is not a string", beforeLog.c_str()); //LCOV_EXCL_LINE
+                Iec104Utility::log_warn("%s remote_certs.cert_file does not exist or is not a string", beforeLog); //LCOV_EXCL_LINE
             }
         }
     }
     else {
-        Iec104Utility::log_warn("%s remote_certs does not exist or is not an array", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_warn("%s remote_certs does not exist or is not an array", beforeLog); //LCOV_EXCL_LINE
     }
 }
 
@@ -887,12 +1172,12 @@ int IEC104Config::TcpPort()
 
 bool IEC104Config::IsOriginatorAllowed(int oa)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - IEC104Config::IsOriginatorAllowed -"; //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("IEC104Config::IsOriginatorAllowed"); //LCOV_EXCL_LINE
     if (m_filterOriginators) {
         if (m_allowedOriginators.count(oa) > 0)
             return true;
         else {
-            Iec104Utility::log_warn("%s OA %i not allowed!", beforeLog.c_str(), oa); //LCOV_EXCL_LINE
+            Iec104Utility::log_warn("%s OA %i not allowed!", beforeLog, oa); //LCOV_EXCL_LINE
             return false;
         }
     }
@@ -921,19 +1206,177 @@ bool IEC104Config::AllowCmdWithoutTime()
     }
 }
 
-std::shared_ptr<IEC104ServerRedGroup> IEC104Config::GetRedundancyGroup(const std::string& ip)
+void
+IEC104Config::importDiagnosticsConfig(const std::string& diagnosticsConfig)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Config::importDiagnosticsConfig"); //LCOV_EXCL_LINE
+    Document document;
+
+    if (document.Parse(const_cast<char*>(diagnosticsConfig.c_str())).HasParseError()) {
+        Iec104Utility::log_error("%s Parsing error in diagnostics json, offset %u: %s", beforeLog, //LCOV_EXCL_LINE
+                                static_cast<unsigned>(document.GetErrorOffset()), GetParseError_En(document.GetParseError())); //LCOV_EXCL_LINE
+        return;
+    }
+
+    if (!document.IsObject() || !document.HasMember("diagnostics") || !document["diagnostics"].IsObject()) {
+        Iec104Utility::log_debug("%s diagnostics does not exist or is not an object", beforeLog); //LCOV_EXCL_LINE
+        return;
+    }
+
+    const Value& diagnostics = document["diagnostics"];
+
+    if (diagnostics.HasMember("capture")) {
+        if (diagnostics["capture"].IsObject()) {
+            importCaptureConfig(diagnostics["capture"]);
+        }
+        else {
+            Iec104Utility::log_warn("%s diagnostics.capture is not an object -> capture disabled", beforeLog); //LCOV_EXCL_LINE
+        }
+    }
+
+    /* parsed in a new instance, the current settings stay unchanged until it is published */
+    std::shared_ptr<IEC104DiagnosticsSettings> settings = std::make_shared<IEC104DiagnosticsSettings>();
+
+    if (diagnostics.HasMember("latency")) {
+        if (diagnostics["latency"].IsObject()) {
+            importPeriodicDiagnosticConfig(diagnostics["latency"], "latency", settings->latencyTracing, settings->latencyPeriod);
+        }
+        else {
+            Iec104Utility::log_warn("%s diagnostics.latency is not an object -> latency tracing disabled", beforeLog); //LCOV_EXCL_LINE
+        }
+    }
+
+    if (diagnostics.HasMember("statistics")) {
+        if (diagnostics["statistics"].IsObject()) {
+            importPeriodicDiagnosticConfig(diagnostics["statistics"], "statistics", settings->statisticsEnabled,
+                                           settings->statisticsPeriod);
+        }
+        else {
+            Iec104Utility::log_warn("%s diagnostics.statistics is not an object -> statistics disabled", beforeLog); //LCOV_EXCL_LINE
+        }
+    }
+
+    if (diagnostics.HasMember("audit_code")) {
+        if (diagnostics["audit_code"].IsString()) {
+            settings->auditCode = diagnostics["audit_code"].GetString();
+        }
+        else {
+            Iec104Utility::log_warn("%s diagnostics.audit_code is not a string -> diagnostics are only logged", beforeLog); //LCOV_EXCL_LINE
+        }
+    }
+
+    std::atomic_store(&m_diagnosticsSettings, std::shared_ptr<const IEC104DiagnosticsSettings>(settings));
+}
+
+void
+IEC104Config::importPeriodicDiagnosticConfig(const Value& diagnostic, const std::string& name, bool& enabled, int& period)
+{
+    const char* beforeLog = LOG_PREFIX("IEC104Config::importPeriodicDiagnosticConfig"); //LCOV_EXCL_LINE
+
+    if (diagnostic.HasMember("enabled")) {
+        if (diagnostic["enabled"].IsBool()) {
+            enabled = diagnostic["enabled"].GetBool();
+        }
+        else {
+            Iec104Utility::log_warn("%s %s.enabled is not a bool -> %s disabled", beforeLog, name.c_str(), name.c_str()); //LCOV_EXCL_LINE
+        }
+    }
+
+    if (diagnostic.HasMember("period")) {
+        if (diagnostic["period"].IsInt()) {
+            int value = diagnostic["period"].GetInt();
+
+            if (value > 0 && value <= 86400) {
+                period = value;
+            }
+            else {
+                Iec104Utility::log_warn("%s %s.period value out of range [1..86400]: %d -> using default value (%d)", //LCOV_EXCL_LINE
+                                        beforeLog, name.c_str(), value, period); //LCOV_EXCL_LINE
+            }
+        }
+        else {
+            Iec104Utility::log_warn("%s %s.period is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
+                                    beforeLog, name.c_str(), period); //LCOV_EXCL_LINE
+        }
+    }
+}
+
+void
+IEC104Config::importCaptureConfig(const Value& capture)
 {
-    std::shared_ptr<IEC104ServerRedGroup> currentRedGroup = nullptr;
-    auto redGroupIt = std::find_if(m_redundancyGroups.begin(), m_redundancyGroups.end(), [&ip](const std::shared_ptr<IEC104ServerRedGroup>& redGroup) {
-        auto redGroupCons = redGroup->Connections();
-        return std::any_of(redGroupCons.begin(), redGroupCons.end(), [&ip](const std::shared_ptr<RedGroupCon>& redGroupCon) {
-            return redGroupCon->ClientIP() == ip;
-        });
-    });
+    const char* beforeLog = LOG_PREFIX("IEC104Config::importCaptureConfig"); //LCOV_EXCL_LINE
+
+    m_captureSettings = IEC104CaptureSettings();
+
+    if (capture.HasMember("enabled")) {
+        if (capture["enabled"].IsBool()) {
+            m_captureSettings.enabled = capture["enabled"].GetBool();
+        }
+        else {
+            Iec104Utility::log_warn("%s capture.enabled is not a bool -> capture disabled", beforeLog); //LCOV_EXCL_LINE
+        }
+    }
+
+    if (capture.HasMember("path")) {
+        if (capture["path"].IsString()) {
+            m_captureSettings.path = capture["path"].GetString();
+        }
+        else {
+            Iec104Utility::log_warn("%s capture.path is not a string -> using default path", beforeLog); //LCOV_EXCL_LINE
+        }
+    }
+
+    if (capture.HasMember("max_file_size")) {
+        if (capture["max_file_size"].IsInt()) {
+            int maxFileSize = capture["max_file_size"].GetInt();
+
+            if (maxFileSize > 0) {
+                m_captureSettings.maxFileSize = maxFileSize;
+            }
+            else {
+                Iec104Utility::log_warn("%s capture.max_file_size value out of range [1..+Inf]: %d -> using default value (%d)", //LCOV_EXCL_LINE
+                                        beforeLog, maxFileSize, m_captureSettings.maxFileSize); //LCOV_EXCL_LINE
+            }
+        }
+        else {
+            Iec104Utility::log_warn("%s capture.max_file_size is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
+                                    beforeLog, m_captureSettings.maxFileSize); //LCOV_EXCL_LINE
+        }
+    }
+
+    if (capture.HasMember("max_files")) {
+        if (capture["max_files"].IsInt()) {
+            int maxFiles = capture["max_files"].GetInt();
 
-    if (redGroupIt != m_redundancyGroups.end()) {
-        currentRedGroup = *redGroupIt;
+            if (maxFiles > -1) {
+                m_captureSettings.maxFiles = maxFiles;
+            }
+            else {
+                Iec104Utility::log_warn("%s capture.max_files value out of range [0..+Inf]: %d -> using default value (%d)", //LCOV_EXCL_LINE
+                                        beforeLog, maxFiles, m_captureSettings.maxFiles); //LCOV_EXCL_LINE
+            }
+        }
+        else {
+            Iec104Utility::log_warn("%s capture.max_files is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
+                                    beforeLog, m_captureSettings.maxFiles); //LCOV_EXCL_LINE
+        }
     }
 
-    return currentRedGroup;
-}
\ No newline at end of file
+    if (capture.HasMember("ring_size")) {
+        if (capture["ring_size"].IsInt()) {
+            int ringSize = capture["ring_size"].GetInt();
+
+            if (ringSize > 0 && ringSize <= 1048576) {
+                m_captureSettings.ringSize = ringSize;
+            }
+            else {
+                Iec104Utility::log_warn("%s capture.ring_size value out of range [1..1048576]: %d -> using default value (%d)", //LCOV_EXCL_LINE
+                                        beforeLog, ringSize, m_captureSettings.ringSize); //LCOV_EXCL_LINE
+            }
+        }
+        else {
+            Iec104Utility::log_warn("%s capture.ring_size is not an integer -> using default value (%d)", //LCOV_EXCL_LINE
+                                    beforeLog, m_captureSettings.ringSize); //LCOV_EXCL_LINE
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <cfloat>
+
+#include "iec104_conversion.hpp"
+#include "iec104_datapoint.hpp"
+
+#define NORMALIZED_MAX (32767.0 / 32768.0) /* largest normalized value, 1 - 2^-15 */
+
+static IEC104Conversion
+saturation(double low, double high, double overflowHigh, bool integer)
+{
+    IEC104Conversion conversion;
+
+    conversion.low = low;
+    conversion.high = high;
+    conversion.overflowHigh = overflowHigh;
+    conversion.integer = integer;
+
+    return conversion;
+}
+
+IEC104Conversion
+IEC104Conversion::create(int dataType, double scale, double offset, bool hasRange, double min, double max)
+{
+    IEC104Conversion conversion = defaultFor(dataType);
+
+    conversion.a = scale;
+    conversion.b = offset;
+
+    switch (dataType) {
+        case IEC60870_TYPE_NORMALIZED:
+            if (hasRange) {
+                /* [min, max] -> [-1, 1], max is transmitted as the largest normalized value without overflow */
+                double k = 2.0 / (max - min);
+
+                conversion.a = scale * k;
+                conversion.b = (offset - min) * k - 1.0;
+            }
+            break;//LCOV_EXCL_LINE
+
+        case IEC60870_TYPE_SCALED:
+            if (hasRange) {
+                conversion.low = std::max(min, conversion.low);
+                conversion.high = std::min(max, conversion.high);
+                conversion.overflowHigh = conversion.high;
+            }
+            break;//LCOV_EXCL_LINE
+
+        case IEC60870_TYPE_SHORT:
+            if (hasRange) {
+                conversion.low = min;
+                conversion.high = max;
+                conversion.overflowHigh = max;
+            }
+            break;//LCOV_EXCL_LINE
+    }
+
+    return conversion;
+}
+
+const IEC104Conversion&
+IEC104Conversion::defaultFor(int dataType)
+{
+    static const IEC104Conversion normalized = saturation(-1.0, NORMALIZED_MAX, 1.0, false);
+    static const IEC104Conversion scaled = saturation(-32768.0, 32767.0, 32767.0, true);
+    static const IEC104Conversion shortFloat = saturation(-FLT_MAX, FLT_MAX, FLT_MAX, false);
+
+    switch (dataType) {
+        case IEC60870_TYPE_NORMALIZED:
+            return normalized;
+
+        case IEC60870_TYPE_SCALED:
+            return scaled;
+
+        default:
+            return shortFloat;
+    }
+}
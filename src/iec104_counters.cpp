@@ -0,0 +1,139 @@
+#include "iec104_counters.hpp"
+#include "iec104_datapoint.hpp"
+
+const int IEC104CounterStore::MAX_COUNTER_GROUP;
+
+#define COUNTER_SEQUENCE_MODULO 32
+
+void
+IEC104CounterStore::configure(const std::map<int, std::map<int, IEC104DataPoint*>>& exchangeDefinitions)
+{
+    m_banks.clear();
+
+    for (const auto& caDefinitions : exchangeDefinitions) {
+        for (const auto& ioaDefinition : caDefinitions.second) {
+            IEC104DataPoint* dp = ioaDefinition.second;
+
+            if ((dp == nullptr) || (dp->m_type != IEC60870_TYPE_COUNTER)) {
+                continue;
+            }
+
+            CaBanks& banks = m_banks[dp->m_ca];
+
+            if (banks.empty()) {
+                for (int group = 0; group <= MAX_COUNTER_GROUP; group++) {
+                    banks.push_back(std::unique_ptr<Bank>(new Bank()));
+                }
+            }
+
+            CounterArray& counters = *(banks[dp->m_counterGroup]->m_live);
+
+            dp->m_counterIndex = static_cast<int>(counters.size());
+
+            Counter counter = {};
+            counter.ioa = dp->m_ioa;
+            counter.typeId = M_IT_NA_1;
+            counter.invalid = true;
+
+            counters.push_back(counter);
+        }
+    }
+}
+
+std::vector<int>
+IEC104CounterStore::Cas() const
+{
+    std::vector<int> cas;
+
+    for (const auto& caBanks : m_banks) {
+        cas.push_back(caBanks.first);
+    }
+
+    return cas;
+}
+
+void
+IEC104CounterStore::update(const IEC104DataPoint* dp, int typeId)
+{
+    auto caBanks = m_banks.find(dp->m_ca);
+
+    if ((caBanks == m_banks.end()) || (dp->m_counterIndex < 0)) {
+        return;
+    }
+
+    Bank& bank = *(caBanks->second[dp->m_counterGroup]);
+
+    std::lock_guard<std::mutex> lock(bank.m_lock);
+
+    /* the array is shared with a frozen snapshot -> copy it once, the snapshot stays unchanged */
+    if (bank.m_live.use_count() > 1) {
+        bank.m_live = std::make_shared<CounterArray>(*bank.m_live);
+    }
+
+    Counter& counter = (*bank.m_live)[dp->m_counterIndex];
+
+    counter.typeId = typeId;
+    counter.value = dp->m_value->counter.value;
+    counter.carry = dp->m_value->counter.quality.cy;
+    counter.adjusted = dp->m_value->counter.quality.ca;
+    counter.invalid = dp->m_value->counter.quality.invalid;
+    counter.ts = *(dp->m_ts);
+}
+
+void
+IEC104CounterStore::freeze(int ca, int group)
+{
+    auto caBanks = m_banks.find(ca);
+
+    if (caBanks == m_banks.end()) {
+        return;
+    }
+
+    for (int i = 0; i <= MAX_COUNTER_GROUP; i++) {
+        if ((group != 0) && (i != group)) {
+            continue;
+        }
+
+        Bank& bank = *(caBanks->second[i]);
+
+        std::lock_guard<std::mutex> lock(bank.m_lock);
+
+        bank.m_frozen = bank.m_live;
+        bank.m_sequence = (bank.m_sequence + 1) % COUNTER_SEQUENCE_MODULO;
+    }
+}
+
+std::vector<IEC104CounterStore::Snapshot>
+IEC104CounterStore::snapshots(int ca, int group)
+{
+    std::vector<Snapshot> snapshots;
+
+    auto caBanks = m_banks.find(ca);
+
+    if (caBanks == m_banks.end()) {
+        return snapshots;
+    }
+
+    for (int i = 0; i <= MAX_COUNTER_GROUP; i++) {
+        if ((group != 0) && (i != group)) {
+            continue;
+        }
+
+        Bank& bank = *(caBanks->second[i]);
+
+        std::lock_guard<std::mutex> lock(bank.m_lock);
+
+        if (bank.m_live->empty()) {
+            continue;
+        }
+
+        if (bank.m_frozen) {
+            snapshots.push_back({bank.m_frozen, bank.m_sequence});
+        }
+        else {
+            snapshots.push_back({bank.m_live, bank.m_sequence});
+        }
+    }
+
+    return snapshots;
+}
@@ -0,0 +1,129 @@
+#include <algorithm>
+
+#include "iec104_cyclic.hpp"
+#include "iec104_datapoint.hpp"
+
+const int IEC104CyclicScheduler::TICK;
+const int IEC104CyclicScheduler::WHEEL_SIZE;
+
+#define ASDU_HEADER_SIZE 4 /* type ID, VSQ, COT and OA, the CA size is configured */
+
+int
+IEC104CyclicScheduler::objectsPerAsdu(int dataType, int maxSizeOfASDU, int sizeOfCA, int sizeOfIOA)
+{
+    int elementSize = IEC104DataPoint::encodedSize(dataType);
+
+    int objects = (maxSizeOfASDU - ASDU_HEADER_SIZE - sizeOfCA) / (sizeOfIOA + elementSize);
+
+    return std::max(objects, 1);
+}
+
+void
+IEC104CyclicScheduler::configure(const std::map<int, std::map<int, IEC104DataPoint*>>& exchangeDefinitions,
+                                 int maxSizeOfASDU, int sizeOfCA, int sizeOfIOA)
+{
+    m_batches.clear();
+
+    for (int i = 0; i < WHEEL_SIZE; i++) {
+        m_wheel[i].clear();
+    }
+
+    m_currentSlot = 0;
+    m_nextTick = 0;
+
+    /* period (ticks) -> CA -> data type -> points */
+    std::map<int, std::map<int, std::map<int, std::vector<IEC104DataPoint*>>>> cyclicPoints;
+
+    for (const auto& caDefinitions : exchangeDefinitions) {
+        for (const auto& ioaDefinition : caDefinitions.second) {
+            IEC104DataPoint* dp = ioaDefinition.second;
+
+            /* members of a packed object are transmitted with their packed object */
+            if ((dp == nullptr) || !dp->isMonitoringType() || (dp->m_cyclicPeriod <= 0) || (dp->m_pack != nullptr)) {
+                continue;
+            }
+
+            int period = std::max((dp->m_cyclicPeriod + TICK / 2) / TICK, 1);
+
+            cyclicPoints[period][dp->m_ca][dp->m_type].push_back(dp);
+        }
+    }
+
+    for (const auto& periodPoints : cyclicPoints) {
+        int period = periodPoints.first;
+
+        std::vector<Batch*> periodBatches;
+
+        for (const auto& caPoints : periodPoints.second) {
+            for (const auto& typePoints : caPoints.second) {
+                const std::vector<IEC104DataPoint*>& points = typePoints.second;
+
+                size_t batchSize = objectsPerAsdu(typePoints.first, maxSizeOfASDU, sizeOfCA, sizeOfIOA);
+
+                for (size_t first = 0; first < points.size(); first += batchSize) {
+                    Batch* batch = new Batch();
+
+                    batch->ca = caPoints.first;
+                    batch->period = period;
+                    batch->points.assign(points.begin() + first, points.begin() + std::min(first + batchSize, points.size()));
+                    batch->rounds = 0;
+
+                    m_batches.push_back(std::unique_ptr<Batch>(batch));
+                    periodBatches.push_back(batch);
+                }
+            }
+        }
+
+        /* spread the batches of the period evenly over the period */
+        int batches = static_cast<int>(periodBatches.size());
+
+        for (int i = 0; i < batches; i++) {
+            schedule(periodBatches[i], 1 + (period * i) / batches);
+        }
+    }
+}
+
+void
+IEC104CyclicScheduler::schedule(Batch* batch, int delay)
+{
+    batch->rounds = (delay - 1) / WHEEL_SIZE;
+
+    m_wheel[(m_currentSlot + delay) % WHEEL_SIZE].push_back(batch);
+}
+
+void
+IEC104CyclicScheduler::advance(uint64_t currentTime, std::vector<const Batch*>& due)
+{
+    if (m_batches.empty()) {
+        return;
+    }
+
+    if (m_nextTick == 0) {
+        m_nextTick = currentTime + TICK;
+    }
+
+    /* after a long stall the missed cycles are not caught up */
+    if (currentTime > m_nextTick + WHEEL_SIZE * TICK) {
+        m_nextTick = currentTime;
+    }
+
+    while (currentTime >= m_nextTick) {
+        m_currentSlot = (m_currentSlot + 1) % WHEEL_SIZE;
+        m_nextTick += TICK;
+
+        std::vector<Batch*> slot;
+
+        slot.swap(m_wheel[m_currentSlot]);
+
+        for (Batch* batch : slot) {
+            if (batch->rounds > 0) {
+                batch->rounds--;
+                m_wheel[m_currentSlot].push_back(batch);
+            }
+            else {
+                due.push_back(batch);
+                schedule(batch, batch->period);
+            }
+        }
+    }
+}
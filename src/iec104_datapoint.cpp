@@ -1,94 +1,144 @@
-#include <map>
+#include <cstdint>
+#include <cstring>
+
+#include <datapoint.h>
 
 #include "iec104_datapoint.hpp"
 
-// Map of all existing ASDU types
-static std::map<std::string, int> mapAsduTypeId = {
-    {"M_SP_TA_1", M_SP_TA_1},
-    {"M_SP_NA_1", M_SP_NA_1},
-    {"M_DP_NA_1", M_DP_NA_1},
-    {"M_DP_TA_1", M_DP_TA_1},
-    {"M_ST_NA_1", M_ST_NA_1},
-    {"M_ST_TA_1", M_ST_TA_1},
-    {"M_BO_NA_1", M_BO_NA_1},
-    {"M_BO_TA_1", M_BO_TA_1},
-    {"M_ME_NA_1", M_ME_NA_1},
-    {"M_ME_TA_1", M_ME_TA_1},
-    {"M_ME_NB_1", M_ME_NB_1},
-    {"M_ME_TB_1", M_ME_TB_1},
-    {"M_ME_NC_1", M_ME_NC_1},
-    {"M_ME_TC_1", M_ME_TC_1},
-    {"M_IT_NA_1", M_IT_NA_1},
-    {"M_IT_TA_1", M_IT_TA_1},
-    {"M_EP_TA_1", M_EP_TA_1},
-    {"M_EP_TB_1", M_EP_TB_1},
-    {"M_EP_TC_1", M_EP_TC_1},
-    {"M_PS_NA_1", M_PS_NA_1},
-    {"M_ME_ND_1", M_ME_ND_1},
-    {"M_SP_TB_1", M_SP_TB_1},
-    {"M_DP_TB_1", M_DP_TB_1},
-    {"M_ST_TB_1", M_ST_TB_1},
-    {"M_BO_TB_1", M_BO_TB_1},
-    {"M_ME_TD_1", M_ME_TD_1},
-    {"M_ME_TE_1", M_ME_TE_1},
-    {"M_ME_TF_1", M_ME_TF_1},
-    {"M_IT_TB_1", M_IT_TB_1},
-    {"M_EP_TD_1", M_EP_TD_1},
-    {"M_EP_TE_1", M_EP_TE_1},
-    {"M_EP_TF_1", M_EP_TF_1},
-    {"S_IT_TC_1", S_IT_TC_1},
-    {"C_SC_NA_1", C_SC_NA_1},
-    {"C_DC_NA_1", C_DC_NA_1},
-    {"C_RC_NA_1", C_RC_NA_1},
-    {"C_SE_NA_1", C_SE_NA_1},
-    {"C_SE_NB_1", C_SE_NB_1},
-    {"C_SE_NC_1", C_SE_NC_1},
-    {"C_BO_NA_1", C_BO_NA_1},
-    {"C_SC_TA_1", C_SC_TA_1},
-    {"C_DC_TA_1", C_DC_TA_1},
-    {"C_RC_TA_1", C_RC_TA_1},
-    {"C_SE_TA_1", C_SE_TA_1},
-    {"C_SE_TB_1", C_SE_TB_1},
-    {"C_SE_TC_1", C_SE_TC_1},
-    {"C_BO_TA_1", C_BO_TA_1},
-    {"M_EI_NA_1", M_EI_NA_1},
-    {"S_CH_NA_1", S_CH_NA_1},
-    {"S_RP_NA_1", S_RP_NA_1},
-    {"S_AR_NA_1", S_AR_NA_1},
-    {"S_KR_NA_1", S_KR_NA_1},
-    {"S_KS_NA_1", S_KS_NA_1},
-    {"S_KC_NA_1", S_KC_NA_1},
-    {"S_ER_NA_1", S_ER_NA_1},
-    {"S_US_NA_1", S_US_NA_1},
-    {"S_UQ_NA_1", S_UQ_NA_1},
-    {"S_UR_NA_1", S_UR_NA_1},
-    {"S_UK_NA_1", S_UK_NA_1},
-    {"S_UA_NA_1", S_UA_NA_1},
-    {"S_UC_NA_1", S_UC_NA_1},
-    {"C_IC_NA_1", C_IC_NA_1},
-    {"C_CI_NA_1", C_CI_NA_1},
-    {"C_RD_NA_1", C_RD_NA_1},
-    {"C_CS_NA_1", C_CS_NA_1},
-    {"C_TS_NA_1", C_TS_NA_1},
-    {"C_RP_NA_1", C_RP_NA_1},
-    {"C_CD_NA_1", C_CD_NA_1},
-    {"C_TS_TA_1", C_TS_TA_1},
-    {"P_ME_NA_1", P_ME_NA_1},
-    {"P_ME_NB_1", P_ME_NB_1},
-    {"P_ME_NC_1", P_ME_NC_1},
-    {"P_AC_NA_1", P_AC_NA_1},
-    {"F_FR_NA_1", F_FR_NA_1},
-    {"F_SR_NA_1", F_SR_NA_1},
-    {"F_SC_NA_1", F_SC_NA_1},
-    {"F_LS_NA_1", F_LS_NA_1},
-    {"F_AF_NA_1", F_AF_NA_1},
-    {"F_SG_NA_1", F_SG_NA_1},
-    {"F_DR_TA_1", F_DR_TA_1},
-    {"F_SC_NB_1", F_SC_NB_1}
+// Names of all existing ASDU types, indexed by type ID (nullptr: no such type)
+static constexpr const char* asduTypeNames[128] = {
+    nullptr, /* 0 */
+    "M_SP_NA_1", /* 1 */
+    "M_SP_TA_1", /* 2 */
+    "M_DP_NA_1", /* 3 */
+    "M_DP_TA_1", /* 4 */
+    "M_ST_NA_1", /* 5 */
+    "M_ST_TA_1", /* 6 */
+    "M_BO_NA_1", /* 7 */
+    "M_BO_TA_1", /* 8 */
+    "M_ME_NA_1", /* 9 */
+    "M_ME_TA_1", /* 10 */
+    "M_ME_NB_1", /* 11 */
+    "M_ME_TB_1", /* 12 */
+    "M_ME_NC_1", /* 13 */
+    "M_ME_TC_1", /* 14 */
+    "M_IT_NA_1", /* 15 */
+    "M_IT_TA_1", /* 16 */
+    "M_EP_TA_1", /* 17 */
+    "M_EP_TB_1", /* 18 */
+    "M_EP_TC_1", /* 19 */
+    "M_PS_NA_1", /* 20 */
+    "M_ME_ND_1", /* 21 */
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, /* 22..29 */
+    "M_SP_TB_1", /* 30 */
+    "M_DP_TB_1", /* 31 */
+    "M_ST_TB_1", /* 32 */
+    "M_BO_TB_1", /* 33 */
+    "M_ME_TD_1", /* 34 */
+    "M_ME_TE_1", /* 35 */
+    "M_ME_TF_1", /* 36 */
+    "M_IT_TB_1", /* 37 */
+    "M_EP_TD_1", /* 38 */
+    "M_EP_TE_1", /* 39 */
+    "M_EP_TF_1", /* 40 */
+    "S_IT_TC_1", /* 41 */
+    nullptr, nullptr, nullptr, /* 42..44 */
+    "C_SC_NA_1", /* 45 */
+    "C_DC_NA_1", /* 46 */
+    "C_RC_NA_1", /* 47 */
+    "C_SE_NA_1", /* 48 */
+    "C_SE_NB_1", /* 49 */
+    "C_SE_NC_1", /* 50 */
+    "C_BO_NA_1", /* 51 */
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, /* 52..57 */
+    "C_SC_TA_1", /* 58 */
+    "C_DC_TA_1", /* 59 */
+    "C_RC_TA_1", /* 60 */
+    "C_SE_TA_1", /* 61 */
+    "C_SE_TB_1", /* 62 */
+    "C_SE_TC_1", /* 63 */
+    "C_BO_TA_1", /* 64 */
+    nullptr, nullptr, nullptr, nullptr, nullptr, /* 65..69 */
+    "M_EI_NA_1", /* 70 */
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, /* 71..80 */
+    "S_CH_NA_1", /* 81 */
+    "S_RP_NA_1", /* 82 */
+    "S_AR_NA_1", /* 83 */
+    "S_KR_NA_1", /* 84 */
+    "S_KS_NA_1", /* 85 */
+    "S_KC_NA_1", /* 86 */
+    "S_ER_NA_1", /* 87 */
+    nullptr, nullptr, /* 88..89 */
+    "S_US_NA_1", /* 90 */
+    "S_UQ_NA_1", /* 91 */
+    "S_UR_NA_1", /* 92 */
+    "S_UK_NA_1", /* 93 */
+    "S_UA_NA_1", /* 94 */
+    "S_UC_NA_1", /* 95 */
+    nullptr, nullptr, nullptr, nullptr, /* 96..99 */
+    "C_IC_NA_1", /* 100 */
+    "C_CI_NA_1", /* 101 */
+    "C_RD_NA_1", /* 102 */
+    "C_CS_NA_1", /* 103 */
+    "C_TS_NA_1", /* 104 */
+    "C_RP_NA_1", /* 105 */
+    "C_CD_NA_1", /* 106 */
+    "C_TS_TA_1", /* 107 */
+    nullptr, nullptr, /* 108..109 */
+    "P_ME_NA_1", /* 110 */
+    "P_ME_NB_1", /* 111 */
+    "P_ME_NC_1", /* 112 */
+    "P_AC_NA_1", /* 113 */
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, /* 114..119 */
+    "F_FR_NA_1", /* 120 */
+    "F_SR_NA_1", /* 121 */
+    "F_SC_NA_1", /* 122 */
+    "F_LS_NA_1", /* 123 */
+    "F_AF_NA_1", /* 124 */
+    "F_SG_NA_1", /* 125 */
+    "F_DR_TA_1", /* 126 */
+    "F_SC_NB_1" /* 127 */
 };
 
-// Map is automatically initialized from mapAsduTypeId at first getStringFromTypeID() call
-static std::map<int, std::string> mapAsduTypeIdStr = {};
+// Perfect hash of the 9 characters type names (characters 0, 2, 3, 5 and 6), collision free for the names above
+static constexpr unsigned
+asduTypeNameHash(const char* name)
+{
+    return (25u * static_cast<unsigned char>(name[0]) + 2u * static_cast<unsigned char>(name[2]) +
+            19u * static_cast<unsigned char>(name[3]) + 47u * static_cast<unsigned char>(name[5]) +
+            48u * static_cast<unsigned char>(name[6])) & 0xffu;
+}
+
+// Type ID of each hash value (0: no type name with this hash)
+static constexpr uint8_t asduTypeSlots[256] = {
+      0,   0,  49,   6,   0,   0,   0,   0,   0,   0,  12, 110, 124,   0,   0,   0,
+    126,   0,   0,   0, 121,   0,   0,   0,   0, 123,  94,   0,  62,   0,   0,  37,
+     13,   0,   0,   0,   0,   0,   0, 127,   0,   0,   0,  38,  86,   0,   0,   0,
+      0,  82,  50,  32,   0,  83,   0,   0,   0,   0,  14, 111,   0,  87,   0,   0,
+     95,   0,   0, 125,   0,   0,   0,   0,   0,  84,  91,   0,  63,   0,   0,   0,
+     21,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  39,  85,  92,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   7,   0,  34, 112,   0,   0,  51,   0,
+     90,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  81,   0,   0,   0,   3,
+      0,   0,   8,   0,   0,   0,   0,   0,  64,   0,   0,  40,   0,   0,  46,   0,
+      0,   0,   0,   0,   0,   0,   0,   0, 100,   4,  35,  17,   0,   1,   0, 106,
+      0, 105,   0,   0,   0,   0,   0,   0,  59,   0,  47,   0,  45,   0,   0,   0,
+      0,   0,  33,   0,   0,   0,   0,   2,   0,   0,   0,   0, 103, 102,   0,   0,
+      9,   0,   0,   0,  60,   0,  58,   0,   0,  31,  36,  18,   0, 113,   0,   0,
+     20,   0,  48,   0,   0,  15,   0,   0,  93,   0,  10,   0,   0,   0, 104,   0,
+      0,   0,   0,   0,   0,  41,   0,  30,   0,   5,   0,   0,  61,   0,   0,  16,
+     11,   0,   0,   0,   0,   0,   0, 122, 107,   0, 120,  19,  70,   0, 101,   0
+};
+
+// Every type name is found in its slot, checked at compile time when a type is added
+static constexpr bool
+asduTypeSlotsValid(int typeId)
+{
+    return (typeId == 128) ||
+           (((asduTypeNames[typeId] == nullptr) || (asduTypeSlots[asduTypeNameHash(asduTypeNames[typeId])] == typeId)) &&
+            asduTypeSlotsValid(typeId + 1));
+}
+
+static_assert(asduTypeSlotsValid(0), "asduTypeSlots does not match asduTypeNames");
 
 bool
 IEC104DataPoint::isSupportedCommandType(int typeId)
@@ -152,6 +202,11 @@ IEC104DataPoint::isSupportedMonitoringType(int typeId)
         case M_ME_NC_1:
         case M_ME_TC_1:
         case M_ME_TF_1:
+        case M_BO_NA_1:
+        case M_PS_NA_1:
+        case M_IT_NA_1:
+        case M_IT_TA_1:
+        case M_IT_TB_1:
             return true; // LCOV_EXCL_LINE
 
         default:
@@ -159,6 +214,48 @@ IEC104DataPoint::isSupportedMonitoringType(int typeId)
     }
 }
 
+bool
+IEC104DataPoint::hasCP24TimeTag(int typeId)
+{
+    switch (typeId) {
+        case M_SP_TA_1:
+        case M_DP_TA_1:
+        case M_ST_TA_1:
+        case M_ME_TA_1:
+        case M_ME_TB_1:
+        case M_ME_TC_1:
+        case M_IT_TA_1:
+            return true; // LCOV_EXCL_LINE
+
+        default:
+            return false; // LCOV_EXCL_LINE
+    }
+}
+
+int
+IEC104DataPoint::cp24Variant(int typeId)
+{
+    switch (typeId) {
+        case M_SP_TB_1:
+            return M_SP_TA_1; // LCOV_EXCL_LINE
+        case M_DP_TB_1:
+            return M_DP_TA_1; // LCOV_EXCL_LINE
+        case M_ST_TB_1:
+            return M_ST_TA_1; // LCOV_EXCL_LINE
+        case M_ME_TD_1:
+            return M_ME_TA_1; // LCOV_EXCL_LINE
+        case M_ME_TE_1:
+            return M_ME_TB_1; // LCOV_EXCL_LINE
+        case M_ME_TF_1:
+            return M_ME_TC_1; // LCOV_EXCL_LINE
+        case M_IT_TB_1:
+            return M_IT_TA_1; // LCOV_EXCL_LINE
+
+        default:
+            return typeId; // LCOV_EXCL_LINE
+    }
+}
+
 int
 IEC104DataPoint::typeIdToDataType(int typeId)
 {
@@ -213,6 +310,20 @@ IEC104DataPoint::typeIdToDataType(int typeId)
             dataType = IEC60870_TYPE_SHORT;
             break;//LCOV_EXCL_LINE
 
+        case M_BO_NA_1:
+            dataType = IEC60870_TYPE_BITSTRING;
+            break;//LCOV_EXCL_LINE
+
+        case M_PS_NA_1:
+            dataType = IEC60870_TYPE_PACKED_SP;
+            break;//LCOV_EXCL_LINE
+
+        case M_IT_NA_1:
+        case M_IT_TA_1:
+        case M_IT_TB_1:
+            dataType = IEC60870_TYPE_COUNTER;
+            break;//LCOV_EXCL_LINE
+
         default:
             break;//LCOV_EXCL_LINE
     }
@@ -220,23 +331,222 @@ IEC104DataPoint::typeIdToDataType(int typeId)
     return dataType;
 }
 
+/* integer with optional sign and surrounding spaces, the end of the number is returned in end */
+static bool
+scanInteger(const char* str, const char** end, int& result)
+{
+    while (*str == ' ') str++;
+
+    bool negative = false;
+
+    if ((*str == '-') || (*str == '+')) {
+        negative = (*str == '-');
+        str++;
+    }
+
+    if ((*str < '0') || (*str > '9')) {
+        return false;
+    }
+
+    int value = 0;
+
+    while ((*str >= '0') && (*str <= '9')) {
+        value = value * 10 + (*str - '0');
+
+        if (value > 1000) {
+            return false;
+        }
+
+        str++;
+    }
+
+    while (*str == ' ') str++;
+
+    result = negative ? -value : value;
+    *end = str;
+
+    return true;
+}
+
+static bool
+scanKeyword(const char* str, const char* keyword, const char** end)
+{
+    while (*keyword != 0) {
+        if (*str++ != *keyword++) {
+            return false;
+        }
+    }
+
+    *end = str;
+
+    return true;
+}
+
+/* "[v,true]", "[v,false]", the transient flag may also be given as 0 or 1 */
+static bool
+scanStepPosition(const char* str, int& posValue, bool& transient)
+{
+    while (*str == ' ') str++;
+
+    if (*str++ != '[') {
+        return false;
+    }
+
+    if (!scanInteger(str, &str, posValue) || (*str++ != ',')) {
+        return false;
+    }
+
+    while (*str == ' ') str++;
+
+    int flag = 0;
+
+    if (scanKeyword(str, "true", &str)) {
+        transient = true;
+    }
+    else if (scanKeyword(str, "false", &str)) {
+        transient = false;
+    }
+    else if (scanInteger(str, &str, flag) && ((flag == 0) || (flag == 1))) {
+        transient = (flag == 1);
+    }
+    else {
+        return false;
+    }
+
+    while (*str == ' ') str++;
+
+    if (*str++ != ']') {
+        return false;
+    }
+
+    while (*str == ' ') str++;
+
+    return *str == 0;
+}
+
+bool
+IEC104DataPoint::parseStepPosition(DatapointValue& value, int& posValue, bool& transient)
+{
+    bool valid = false;
+
+    int position = 0;
+    bool isTransient = false;
+
+    switch (value.getType()) {
+        case DatapointValue::dataTagType::T_STRING:
+            {
+                /* short strings like "[12,true]" fit in the small string buffer */
+                std::string str = value.toStringValue();
+
+                valid = scanStepPosition(str.c_str(), position, isTransient);
+            }
+            break;//LCOV_EXCL_LINE
+
+        case DatapointValue::dataTagType::T_DP_DICT:
+            {
+                bool hasValue = false;
+
+                for (Datapoint* child : *value.getDpVec()) {
+                    DatapointValue& childValue = child->getData();
+
+                    if (childValue.getType() != DatapointValue::dataTagType::T_INTEGER) {
+                        continue;
+                    }
+
+                    if (child->getName() == "value") {
+                        position = static_cast<int>(childValue.toInt());
+                        hasValue = true;
+                    }
+                    else if (child->getName() == "transient") {
+                        isTransient = (childValue.toInt() != 0);
+                    }
+                }
+
+                valid = hasValue;
+            }
+            break;//LCOV_EXCL_LINE
+
+        case DatapointValue::dataTagType::T_DP_LIST:
+            {
+                std::vector<Datapoint*>* elements = value.getDpVec();
+
+                if ((elements->size() == 2) &&
+                    ((*elements)[0]->getData().getType() == DatapointValue::dataTagType::T_INTEGER) &&
+                    ((*elements)[1]->getData().getType() == DatapointValue::dataTagType::T_INTEGER)) {
+                    position = static_cast<int>((*elements)[0]->getData().toInt());
+                    isTransient = ((*elements)[1]->getData().toInt() != 0);
+                    valid = true;
+                }
+            }
+            break;//LCOV_EXCL_LINE
+
+        default:
+            break;//LCOV_EXCL_LINE
+    }
+
+    if (!valid || (position < -64) || (position > 63)) {
+        return false;
+    }
+
+    posValue = position;
+    transient = isTransient;
+
+    return true;
+}
+
+int
+IEC104DataPoint::encodedSize(int dataType)
+{
+    int size = 0;
+
+    switch (dataType) {
+        case IEC60870_TYPE_SP:
+        case IEC60870_TYPE_DP:
+            size = 1; /* SIQ/DIQ */
+            break;//LCOV_EXCL_LINE
+
+        case IEC60870_TYPE_STEP_POS:
+            size = 2; /* VTI + QDS */
+            break;//LCOV_EXCL_LINE
+
+        case IEC60870_TYPE_NORMALIZED:
+        case IEC60870_TYPE_SCALED:
+            size = 3; /* NVA/SVA + QDS */
+            break;//LCOV_EXCL_LINE
+
+        default:
+            size = 5; /* short float + QDS, BSI + QDS, SCD + QDS, BCR */
+            break;//LCOV_EXCL_LINE
+    }
+
+    return size;
+}
+
 int
-IEC104DataPoint::getTypeIdFromString(std::string typeIdStr)
+IEC104DataPoint::getTypeIdFromString(const std::string& typeIdStr)
 {
-    return mapAsduTypeId[typeIdStr];
+    /* constant tables, no lock or allocation: called concurrently by the decode workers */
+    if (typeIdStr.size() != 9) {
+        return 0;
+    }
+
+    int typeId = asduTypeSlots[asduTypeNameHash(typeIdStr.data())];
+
+    if ((typeId == 0) || (memcmp(asduTypeNames[typeId], typeIdStr.data(), 9) != 0)) {
+        return 0;
+    }
+
+    return typeId;
 }
 
-std::string
+const char*
 IEC104DataPoint::getStringFromTypeID(int typeId)
 {
-    // Build reverse mapping if not yet initialized
-    if (mapAsduTypeIdStr.empty()) {
-        for(const auto& kvp : mapAsduTypeId) {
-            mapAsduTypeIdStr[kvp.second]=kvp.first;
-        }
+    if ((typeId <= 0) || (typeId >= 128) || (asduTypeNames[typeId] == nullptr)) {
+        return "";
     }
-    
-    return mapAsduTypeIdStr[typeId];
+
+    return asduTypeNames[typeId];
 }
 
 bool
@@ -262,6 +572,7 @@ IEC104DataPoint::isMessageTypeMatching(int expectedType)
         switch (expectedType) {
 
         case M_SP_NA_1:
+        case M_SP_TA_1:
         case M_SP_TB_1:
             if (m_type == IEC60870_TYPE_SP) {
                 isMatching = true;
@@ -270,6 +581,7 @@ IEC104DataPoint::isMessageTypeMatching(int expectedType)
             break;//LCOV_EXCL_LINE
 
         case M_DP_NA_1:
+        case M_DP_TA_1:
         case M_DP_TB_1:
             if (m_type == IEC60870_TYPE_DP) {
                 isMatching = true;
@@ -278,6 +590,7 @@ IEC104DataPoint::isMessageTypeMatching(int expectedType)
             break;//LCOV_EXCL_LINE
 
         case M_ME_NA_1:
+        case M_ME_TA_1:
         case M_ME_TD_1:
             if (m_type == IEC60870_TYPE_NORMALIZED) {
                 isMatching = true;
@@ -286,6 +599,7 @@ IEC104DataPoint::isMessageTypeMatching(int expectedType)
             break;//LCOV_EXCL_LINE
 
         case M_ME_NB_1:
+        case M_ME_TB_1:
         case M_ME_TE_1:
             if (m_type == IEC60870_TYPE_SCALED) {
                 isMatching = true;
@@ -294,6 +608,7 @@ IEC104DataPoint::isMessageTypeMatching(int expectedType)
             break;//LCOV_EXCL_LINE
 
         case M_ME_NC_1:
+        case M_ME_TC_1:
         case M_ME_TF_1:
             if (m_type == IEC60870_TYPE_SHORT) {
                 isMatching = true;
@@ -302,6 +617,7 @@ IEC104DataPoint::isMessageTypeMatching(int expectedType)
             break;//LCOV_EXCL_LINE
 
         case M_ST_NA_1:
+        case M_ST_TA_1:
         case M_ST_TB_1:
             if (m_type == IEC60870_TYPE_STEP_POS) {
                 isMatching = true;
@@ -309,6 +625,15 @@ IEC104DataPoint::isMessageTypeMatching(int expectedType)
 
             break;//LCOV_EXCL_LINE
 
+        case M_IT_NA_1:
+        case M_IT_TA_1:
+        case M_IT_TB_1:
+            if (m_type == IEC60870_TYPE_COUNTER) {
+                isMatching = true;
+            }
+
+            break;//LCOV_EXCL_LINE
+
         default:
             //Type not supported
             break;//LCOV_EXCL_LINE
@@ -361,7 +686,90 @@ bool IEC104DataPoint::isMatchingCommand(int typeId)
     return false;
 }
 
+int
+IEC104DataPoint::packedBitCount(int dataType)
+{
+    if (dataType == IEC60870_TYPE_PACKED_SP) {
+        return 16;
+    }
+    else if (dataType == IEC60870_TYPE_BITSTRING) {
+        return 32;
+    }
+
+    return 0;
+}
+
+int
+IEC104DataPoint::packedTypeId() const
+{
+    return (m_type == IEC60870_TYPE_PACKED_SP) ? M_PS_NA_1 : M_BO_NA_1;
+}
 
+bool
+IEC104DataPoint::addPackMember(IEC104DataPoint* member, int bit)
+{
+    if ((bit < 0) || (bit >= packedBitCount(m_type))) {
+        return false;
+    }
+
+    for (IEC104DataPoint* other : m_packMembers) {
+        if (other->m_packBit == bit) {
+            return false;
+        }
+    }
+
+    member->m_pack = this;
+    member->m_packBit = bit;
+
+    m_packMembers.push_back(member);
+
+    return true;
+}
+
+void
+IEC104DataPoint::updatePackedBit(int bit, bool state)
+{
+    if (m_type == IEC60870_TYPE_PACKED_SP) {
+        uint16_t mask = static_cast<uint16_t>(1u << bit);
+        uint16_t st = state ? (m_value->packed_sp.st | mask) : (m_value->packed_sp.st & ~mask);
+
+        if (st != m_value->packed_sp.st) {
+            m_value->packed_sp.cd |= mask;
+        }
+
+        m_value->packed_sp.st = st;
+    }
+    else if (m_type == IEC60870_TYPE_BITSTRING) {
+        uint32_t mask = 1u << bit;
+
+        m_value->bitstring.value = state ? (m_value->bitstring.value | mask) : (m_value->bitstring.value & ~mask);
+    }
+}
+
+uint8_t
+IEC104DataPoint::packedQuality() const
+{
+    if (m_packMembers.empty()) {
+        return IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL;
+    }
+
+    uint8_t quality = IEC60870_QUALITY_GOOD;
+
+    for (const IEC104DataPoint* member : m_packMembers) {
+        quality |= member->m_value->sp.quality;
+    }
+
+    return quality;
+}
+
+void
+IEC104DataPoint::encodeStatusAndChangeDetection(StatusAndStatusChangeDetection scd) const
+{
+    scd->encodedValue[0] = static_cast<uint8_t>(m_value->packed_sp.st & 0xff);
+    scd->encodedValue[1] = static_cast<uint8_t>(m_value->packed_sp.st >> 8);
+    scd->encodedValue[2] = static_cast<uint8_t>(m_value->packed_sp.cd & 0xff);
+    scd->encodedValue[3] = static_cast<uint8_t>(m_value->packed_sp.cd >> 8);
+}
 
 IEC104DataPoint::IEC104DataPoint(std::string label, int ca, int ioa, int type, bool isCommand, int gi_groups)
 {
@@ -371,46 +779,72 @@ IEC104DataPoint::IEC104DataPoint(std::string label, int ca, int ioa, int type, b
     m_isCommand = isCommand;
     m_label = label;
     m_gi_groups = gi_groups;
-    m_value = {};
+}
+
+void
+IEC104DataPoint::attachStorage(Value* value, struct sCP56Time2a* ts)
+{
+    m_value = value;
+    m_ts = ts;
+
+    memset(m_value, 0, sizeof(Value));
+    memset(m_ts, 0, sizeof(struct sCP56Time2a));
 
     //TODO set intial value and quality to invalid
 
-    switch (type) {
+    switch (m_type) {
         case IEC60870_TYPE_SP:
-            m_value.sp.value = 0;
-            m_value.sp.quality = IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL;
+            m_value->sp.value = 0;
+            m_value->sp.quality = IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL;
             
             break;//LCOV_EXCL_LINE
 
         case IEC60870_TYPE_DP:
-            m_value.dp.value = 0;
-            m_value.dp.quality = IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL;
+            m_value->dp.value = 0;
+            m_value->dp.quality = IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL;
             
             break;//LCOV_EXCL_LINE
 
         case IEC60870_TYPE_STEP_POS:
-            m_value.stepPos.posValue = 0;
-            m_value.stepPos.transient = 0;
-            m_value.stepPos.quality = IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL;
+            m_value->stepPos.posValue = 0;
+            m_value->stepPos.transient = 0;
+            m_value->stepPos.quality = IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL;
             
             break;//LCOV_EXCL_LINE
 
         case IEC60870_TYPE_NORMALIZED:
-            m_value.mv_normalized.value = 0;
-            m_value.mv_normalized.quality = IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL;
+            m_value->mv_normalized.value = 0;
+            m_value->mv_normalized.quality = IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL;
 
             break;//LCOV_EXCL_LINE
 
         case IEC60870_TYPE_SCALED:
-            m_value.mv_scaled.value = 0;
-            m_value.mv_scaled.quality = IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL;
+            m_value->mv_scaled.value = 0;
+            m_value->mv_scaled.quality = IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL;
 
             break;//LCOV_EXCL_LINE
 
         case IEC60870_TYPE_SHORT:
-            m_value.mv_short.value = 0;
-            m_value.mv_short.quality = IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL;
+            m_value->mv_short.value = 0;
+            m_value->mv_short.quality = IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL;
 
             break;//LCOV_EXCL_LINE
-    } 
+
+        case IEC60870_TYPE_BITSTRING:
+            m_value->bitstring.value = 0;
+
+            break;//LCOV_EXCL_LINE
+
+        case IEC60870_TYPE_PACKED_SP:
+            m_value->packed_sp.st = 0;
+            m_value->packed_sp.cd = 0;
+
+            break;//LCOV_EXCL_LINE
+
+        case IEC60870_TYPE_COUNTER:
+            m_value->counter.value = 0;
+            m_value->counter.quality.invalid = 1;
+
+            break;//LCOV_EXCL_LINE
+    }
 }
@@ -0,0 +1,243 @@
+#include <cmath>
+#include <cstdio>
+
+#include "iec104_latency.hpp"
+#include "iec104_datapoint.hpp"
+
+const int IEC104LatencyHistogram::SUB_BUCKET_BITS;
+const int IEC104LatencyHistogram::SUB_BUCKET_COUNT;
+const int IEC104LatencyHistogram::MAX_MAGNITUDE;
+const int IEC104LatencyHistogram::BUCKET_COUNT;
+const int IEC104LatencyTracer::MAX_TYPE_ID;
+
+IEC104LatencyHistogram::IEC104LatencyHistogram()
+{
+    reset();
+}
+
+void
+IEC104LatencyHistogram::reset()
+{
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+int
+IEC104LatencyHistogram::bucketIndex(uint64_t value)
+{
+    if (value < static_cast<uint64_t>(SUB_BUCKET_COUNT)) {
+        return static_cast<int>(value);
+    }
+
+    if (value >> MAX_MAGNITUDE) {
+        return BUCKET_COUNT - 1;
+    }
+
+    int msb = 63 - __builtin_clzll(value);
+    int magnitude = msb - SUB_BUCKET_BITS + 1;
+
+    return (magnitude - 1) * SUB_BUCKET_COUNT + static_cast<int>(value >> (magnitude - 1));
+}
+
+uint64_t
+IEC104LatencyHistogram::bucketUpperBound(int index)
+{
+    if (index < SUB_BUCKET_COUNT) {
+        return static_cast<uint64_t>(index);
+    }
+
+    int magnitude = index / SUB_BUCKET_COUNT;
+    uint64_t lowerBound = static_cast<uint64_t>(index - (magnitude - 1) * SUB_BUCKET_COUNT) << (magnitude - 1);
+
+    return lowerBound + (1ULL << (magnitude - 1)) - 1;
+}
+
+void
+IEC104LatencyHistogram::record(uint64_t value)
+{
+    m_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t max = m_max.load(std::memory_order_relaxed);
+
+    while ((value > max) && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+}
+
+uint64_t
+IEC104LatencyHistogram::percentile(double percentile) const
+{
+    uint64_t count = Count();
+
+    if (count == 0) {
+        return 0;
+    }
+
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count)));
+
+    if (target == 0) {
+        target = 1;
+    }
+
+    uint64_t total = 0;
+
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        total += m_buckets[i].load(std::memory_order_relaxed);
+
+        if (total >= target) {
+            uint64_t upperBound = bucketUpperBound(i);
+            uint64_t max = Max();
+
+            return (upperBound < max) ? upperBound : max;
+        }
+    }
+
+    return Max();
+}
+
+IEC104LatencyTracer::IEC104LatencyTracer()
+{
+    for (int stage = 0; stage < STAGE_COUNT; stage++) {
+        for (int typeId = 0; typeId < MAX_TYPE_ID; typeId++) {
+            m_types[stage][typeId].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+}
+
+IEC104LatencyTracer::~IEC104LatencyTracer()
+{
+    for (int stage = 0; stage < STAGE_COUNT; stage++) {
+        for (int typeId = 0; typeId < MAX_TYPE_ID; typeId++) {
+            delete m_types[stage][typeId].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+const char*
+IEC104LatencyTracer::stageName(Stage stage)
+{
+    switch (stage) {
+        case INGEST_TO_ENQUEUE:
+            return "ingest_to_enqueue";
+        case ENQUEUE_TO_WIRE:
+            return "enqueue_to_wire";
+        case INGEST_TO_WIRE:
+            return "ingest_to_wire";
+        default:
+            return "unknown";
+    }
+}
+
+void
+IEC104LatencyTracer::record(Stage stage, int typeId, uint64_t latency)
+{
+    m_stages[stage].record(latency);
+
+    if ((typeId <= 0) || (typeId >= MAX_TYPE_ID)) {
+        return;
+    }
+
+    IEC104LatencyHistogram* histogram = m_types[stage][typeId].load(std::memory_order_acquire);
+
+    if (histogram == nullptr) {
+        IEC104LatencyHistogram* newHistogram = new IEC104LatencyHistogram();
+
+        if (m_types[stage][typeId].compare_exchange_strong(histogram, newHistogram, std::memory_order_acq_rel)) {
+            histogram = newHistogram;
+        }
+        else {
+            delete newHistogram;
+        }
+    }
+
+    histogram->record(latency);
+}
+
+const IEC104LatencyHistogram*
+IEC104LatencyTracer::Histogram(Stage stage, int typeId) const
+{
+    if ((typeId <= 0) || (typeId >= MAX_TYPE_ID)) {
+        return nullptr;
+    }
+
+    return m_types[stage][typeId].load(std::memory_order_acquire);
+}
+
+void
+IEC104LatencyTracer::reset()
+{
+    for (int stage = 0; stage < STAGE_COUNT; stage++) {
+        m_stages[stage].reset();
+
+        for (int typeId = 0; typeId < MAX_TYPE_ID; typeId++) {
+            IEC104LatencyHistogram* histogram = m_types[stage][typeId].load(std::memory_order_acquire);
+
+            if (histogram) {
+                histogram->reset();
+            }
+        }
+    }
+}
+
+static std::string histogramToJson(const IEC104LatencyHistogram& histogram)
+{
+    char buf[200];
+
+    snprintf(buf, sizeof(buf), "{\"count\":%llu,\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"p999\":%llu,\"max\":%llu}",
+             static_cast<unsigned long long>(histogram.Count()),
+             static_cast<unsigned long long>(histogram.percentile(50.0) / 1000),
+             static_cast<unsigned long long>(histogram.percentile(90.0) / 1000),
+             static_cast<unsigned long long>(histogram.percentile(99.0) / 1000),
+             static_cast<unsigned long long>(histogram.percentile(99.9) / 1000),
+             static_cast<unsigned long long>(histogram.Max() / 1000));
+
+    return std::string(buf);
+}
+
+std::string
+IEC104LatencyTracer::toJson() const
+{
+    std::string json = "{\"unit\":\"us\"";
+
+    for (int stage = 0; stage < STAGE_COUNT; stage++) {
+        json += ",\"";
+        json += stageName(static_cast<Stage>(stage));
+        json += "\":";
+
+        std::string stageJson = histogramToJson(m_stages[stage]);
+        stageJson.pop_back();
+        json += stageJson;
+        json += ",\"types\":{";
+
+        bool first = true;
+
+        for (int typeId = 0; typeId < MAX_TYPE_ID; typeId++) {
+            const IEC104LatencyHistogram* histogram = m_types[stage][typeId].load(std::memory_order_acquire);
+
+            if ((histogram == nullptr) || (histogram->Count() == 0)) {
+                continue;
+            }
+
+            if (!first) {
+                json += ",";
+            }
+            first = false;
+
+            json += "\"";
+            json += IEC104DataPoint::getStringFromTypeID(typeId);
+            json += "\":";
+            json += histogramToJson(*histogram);
+        }
+
+        json += "}}";
+    }
+
+    json += "}";
+
+    return json;
+}
@@ -0,0 +1,113 @@
+#include "iec104_log_limiter.hpp"
+#include "iec104_utility.hpp"
+
+namespace Iec104Utility {
+
+const uint64_t LogLimiter::DEFAULT_PERIOD;
+const int LogLimiter::DEFAULT_MAX_FIRST_PER_PERIOD;
+const size_t LogLimiter::DEFAULT_MAX_KEYS;
+
+LogLimiter::LogLimiter(uint64_t period, int maxFirstPerPeriod, size_t maxKeys) :
+    m_period(period),
+    m_maxFirstPerPeriod(maxFirstPerPeriod),
+    m_maxKeys(maxKeys)
+{
+}
+
+int
+LogLimiter::addSite(const char* prefix, const char* description)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    Site site;
+    site.prefix = prefix;
+    site.description = description;
+
+    m_sites.push_back(site);
+
+    return static_cast<int>(m_sites.size()) - 1;
+}
+
+bool
+LogLimiter::accept(int site, int ca, int ioa)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    Site& siteState = m_sites[site];
+
+    auto it = m_counts.find(key(site, ca, ioa));
+
+    if (it == m_counts.end()) {
+        if (m_counts.size() >= m_maxKeys) {
+            /* key table full: counted in the summary only */
+            siteState.suppressed++;
+            return false;
+        }
+
+        it = m_counts.emplace(key(site, ca, ioa), Count()).first;
+    }
+
+    Count& count = it->second;
+
+    if (!count.logged && (siteState.firstLogged < m_maxFirstPerPeriod)) {
+        count.logged = true;
+        siteState.firstLogged++;
+        return true;
+    }
+
+    if (count.suppressed == 0) {
+        siteState.keys++;
+    }
+
+    count.suppressed++;
+    siteState.suppressed++;
+
+    return false;
+}
+
+void
+LogLimiter::summarize(uint64_t currentTime)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (m_lastSummary == 0) {
+        m_lastSummary = currentTime; /* start of the first period */
+        return;
+    }
+
+    if (currentTime < m_lastSummary + m_period) {
+        return;
+    }
+
+    uint64_t elapsed = currentTime - m_lastSummary;
+
+    m_lastSummary = currentTime;
+
+    for (Site& site : m_sites) {
+        if (site.suppressed > 0) {
+            log_error("%s %s: %llu occurrences suppressed for %zu CA/IOA in the last %llu ms", //LCOV_EXCL_LINE
+                      site.prefix.c_str(), site.description.c_str(), //LCOV_EXCL_LINE
+                      static_cast<unsigned long long>(site.suppressed), site.keys, //LCOV_EXCL_LINE
+                      static_cast<unsigned long long>(elapsed)); //LCOV_EXCL_LINE
+        }
+
+        site.suppressed = 0;
+        site.keys = 0;
+        site.firstLogged = 0;
+    }
+
+    /* the keys are kept (a logged first occurrence is not logged again), only the counts restart */
+    for (auto& count : m_counts) {
+        count.second.suppressed = 0;
+    }
+}
+
+uint64_t
+LogLimiter::Suppressed(int site)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    return m_sites[site].suppressed;
+}
+
+}
@@ -0,0 +1,70 @@
+#include <algorithm>
+
+#include "iec104_point_store.hpp"
+
+const uint8_t IEC104PointStore::FLAG_MONITORING;
+const uint8_t IEC104PointStore::FLAG_PACKED;
+
+void
+IEC104PointStore::build(const std::map<int, std::map<int, IEC104DataPoint*>>& exchangeDefinitions)
+{
+    clear();
+
+    m_blocks.reserve(exchangeDefinitions.size());
+
+    for (const auto& caDefinitions : exchangeDefinitions) {
+        m_blocks.emplace_back();
+
+        Block& block = m_blocks.back();
+
+        block.ca = caDefinitions.first;
+        block.points.reserve(caDefinitions.second.size());
+
+        for (const auto& ioaDefinition : caDefinitions.second) {
+            if (ioaDefinition.second != nullptr) {
+                block.points.push_back(ioaDefinition.second);
+            }
+        }
+
+        block.types.reserve(block.points.size());
+        block.giGroups.reserve(block.points.size());
+        block.flags.reserve(block.points.size());
+
+        for (IEC104DataPoint* dp : block.points) {
+            block.types.push_back(dp->m_type);
+            block.giGroups.push_back(dp->m_gi_groups);
+            block.flags.push_back(static_cast<uint8_t>((dp->isMonitoringType() ? FLAG_MONITORING : 0) |
+                                                       ((dp->m_pack != nullptr) ? FLAG_PACKED : 0)));
+        }
+
+        /* sized once, the points keep pointers to the elements */
+        block.values.resize(block.points.size());
+        block.timestamps.resize(block.points.size());
+
+        for (size_t i = 0; i < block.points.size(); i++) {
+            block.points[i]->attachStorage(&(block.values[i]), &(block.timestamps[i]));
+        }
+
+        m_size += block.points.size();
+    }
+}
+
+void
+IEC104PointStore::clear()
+{
+    m_blocks.clear();
+    m_size = 0;
+}
+
+const IEC104PointStore::Block*
+IEC104PointStore::findBlock(int ca) const
+{
+    auto it = std::lower_bound(m_blocks.begin(), m_blocks.end(), ca,
+                               [](const Block& block, int value) {return block.ca < value;});
+
+    if ((it == m_blocks.end()) || (it->ca != ca)) {
+        return nullptr;
+    }
+
+    return &(*it);
+}
@@ -0,0 +1,26 @@
+#include "iec104_conversion.hpp"
+#include "iec104_datapoint.hpp"
+#include "iec104_point_table.hpp"
+
+IEC104DataPoint*
+IEC104PointTable::addDataPoint(const std::string& label, int ca, int ioa, int type, bool isCommand, int gi_groups)
+{
+    IEC104DataPoint* dp = m_arena.create<IEC104DataPoint>(label, ca, ioa, type, isCommand, gi_groups);
+
+    m_definitions[ca][ioa] = dp;
+    m_index[key(ca, ioa)] = dp;
+
+    return dp;
+}
+
+void
+IEC104PointTable::setConversion(IEC104DataPoint* dp, const IEC104Conversion& conversion)
+{
+    dp->m_conversion = m_arena.create<IEC104Conversion>(conversion);
+}
+
+void
+IEC104PointTable::finalize()
+{
+    m_store.build(m_definitions);
+}
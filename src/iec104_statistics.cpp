@@ -0,0 +1,319 @@
+#include <cstdio>
+
+#include "iec104_statistics.hpp"
+
+const int IEC104Statistics::MAX_LINKS;
+
+#define APCI_SEQUENCE_MODULO 32768
+
+IEC104Statistics::Link*
+IEC104Statistics::findLink(uint64_t connectionKey)
+{
+    for (int i = 0; i < MAX_LINKS; i++) {
+        if (m_links[i].key.load(std::memory_order_acquire) == connectionKey) {
+            return &m_links[i];
+        }
+    }
+
+    return nullptr;
+}
+
+void
+IEC104Statistics::setEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(m_linksLock);
+
+    if (enabled && !m_enabled.load(std::memory_order_relaxed)) {
+        /* the frames sent while disabled were not recorded, the window is tracked again from the next I-frame */
+        for (int i = 0; i < MAX_LINKS; i++) {
+            m_links[i].nextSendSequence.store(-1, std::memory_order_relaxed);
+            m_links[i].stalled.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void
+IEC104Statistics::countConnectionRequest(bool accepted)
+{
+    if (accepted) {
+        m_connectionsAccepted.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        m_connectionsRejected.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void
+IEC104Statistics::countCommand(uint64_t connectionKey, bool rejected)
+{
+    m_commands.fetch_add(1, std::memory_order_relaxed);
+
+    if (rejected) {
+        m_commandsRejected.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Link* link = findLink(connectionKey);
+
+    if (link) {
+        link->commands.fetch_add(1, std::memory_order_relaxed);
+
+        if (rejected) {
+            link->commandsRejected.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void
+IEC104Statistics::recordInterrogation(uint64_t connectionKey, uint64_t duration)
+{
+    m_interrogations.fetch_add(1, std::memory_order_relaxed);
+    m_interrogationDurations.record(duration);
+
+    Link* link = findLink(connectionKey);
+
+    if (link) {
+        link->interrogations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void
+IEC104Statistics::sampleQueueDepth(int depth, int capacity)
+{
+    m_queueDepth.store(depth, std::memory_order_relaxed);
+    m_queueCapacity.store(capacity, std::memory_order_relaxed);
+
+    if (depth > m_queueMaxDepth.load(std::memory_order_relaxed)) {
+        m_queueMaxDepth.store(depth, std::memory_order_relaxed);
+    }
+
+    if ((capacity > 0) && (depth >= capacity)) {
+        m_queueFullSamples.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void
+IEC104Statistics::openLink(uint64_t connectionKey, const std::string& peer)
+{
+    std::lock_guard<std::mutex> lock(m_linksLock);
+
+    m_connectionsOpened.fetch_add(1, std::memory_order_relaxed);
+
+    if (findLink(connectionKey)) {
+        return;
+    }
+
+    for (int i = 0; i < MAX_LINKS; i++) {
+        Link& link = m_links[i];
+
+        if (link.key.load(std::memory_order_relaxed) != 0) {
+            continue;
+        }
+
+        link.iFramesSent.store(0, std::memory_order_relaxed);
+        link.iFramesReceived.store(0, std::memory_order_relaxed);
+        link.sFramesSent.store(0, std::memory_order_relaxed);
+        link.sFramesReceived.store(0, std::memory_order_relaxed);
+        link.uFramesSent.store(0, std::memory_order_relaxed);
+        link.uFramesReceived.store(0, std::memory_order_relaxed);
+        link.bytesSent.store(0, std::memory_order_relaxed);
+        link.bytesReceived.store(0, std::memory_order_relaxed);
+        link.windowStalls.store(0, std::memory_order_relaxed);
+        link.commands.store(0, std::memory_order_relaxed);
+        link.commandsRejected.store(0, std::memory_order_relaxed);
+        link.interrogations.store(0, std::memory_order_relaxed);
+        link.nextSendSequence.store(0, std::memory_order_relaxed);
+        link.acknowledgedSequence.store(0, std::memory_order_relaxed);
+        link.stalled.store(false, std::memory_order_relaxed);
+        link.peer = peer;
+        link.lastIFramesSent = 0;
+        link.lastIFramesReceived = 0;
+
+        /* publish the slot once it is initialized */
+        link.key.store(connectionKey, std::memory_order_release);
+
+        return;
+    }
+}
+
+void
+IEC104Statistics::closeLink(uint64_t connectionKey)
+{
+    std::lock_guard<std::mutex> lock(m_linksLock);
+
+    Link* link = findLink(connectionKey);
+
+    if (link) {
+        link->key.store(0, std::memory_order_release);
+    }
+}
+
+void
+IEC104Statistics::updateWindow(Link* link, int outstanding)
+{
+    if (outstanding >= m_k.load(std::memory_order_relaxed)) {
+        if (!link->stalled.exchange(true, std::memory_order_relaxed)) {
+            link->windowStalls.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    else {
+        link->stalled.store(false, std::memory_order_relaxed);
+    }
+}
+
+void
+IEC104Statistics::recordFrame(uint64_t connectionKey, const uint8_t* msg, int msgSize, bool sent)
+{
+    if (msgSize < 6) {
+        return;
+    }
+
+    Link* link = findLink(connectionKey);
+
+    if (link == nullptr) {
+        return;
+    }
+
+    std::atomic<uint64_t>& bytes = sent ? link->bytesSent : link->bytesReceived;
+    bytes.fetch_add(msgSize, std::memory_order_relaxed);
+
+    int receiveSequence = (msg[4] >> 1) | (msg[5] << 7);
+
+    if ((msg[2] & 0x01) == 0) {
+        /* I-frame */
+        if (sent) {
+            link->iFramesSent.fetch_add(1, std::memory_order_relaxed);
+
+            int nextSendSequence = (((msg[2] >> 1) | (msg[3] << 7)) + 1) % APCI_SEQUENCE_MODULO;
+            link->nextSendSequence.store(nextSendSequence, std::memory_order_relaxed);
+        }
+        else {
+            link->iFramesReceived.fetch_add(1, std::memory_order_relaxed);
+            link->acknowledgedSequence.store(receiveSequence, std::memory_order_relaxed);
+        }
+    }
+    else if ((msg[2] & 0x03) == 0x01) {
+        /* S-frame */
+        std::atomic<uint64_t>& sFrames = sent ? link->sFramesSent : link->sFramesReceived;
+        sFrames.fetch_add(1, std::memory_order_relaxed);
+
+        if (!sent) {
+            link->acknowledgedSequence.store(receiveSequence, std::memory_order_relaxed);
+        }
+    }
+    else {
+        /* U-frame */
+        std::atomic<uint64_t>& uFrames = sent ? link->uFramesSent : link->uFramesReceived;
+        uFrames.fetch_add(1, std::memory_order_relaxed);
+
+        return;
+    }
+
+    int nextSendSequence = link->nextSendSequence.load(std::memory_order_relaxed);
+
+    if (nextSendSequence < 0) {
+        return;
+    }
+
+    int outstanding = (nextSendSequence - link->acknowledgedSequence.load(std::memory_order_relaxed) +
+                       APCI_SEQUENCE_MODULO) % APCI_SEQUENCE_MODULO;
+
+    updateWindow(link, outstanding);
+}
+
+static unsigned long long ratePerSecond(uint64_t count, uint64_t period)
+{
+    if (period == 0) {
+        return 0;
+    }
+
+    return static_cast<unsigned long long>((count * 1000 + period / 2) / period);
+}
+
+std::string
+IEC104Statistics::toJson(uint64_t period)
+{
+    std::lock_guard<std::mutex> lock(m_linksLock);
+
+    char buf[1024];
+
+    uint64_t readings = m_readings.load(std::memory_order_relaxed);
+
+    snprintf(buf, sizeof(buf),
+             "{\"period\":%llu,\"readings\":%llu,\"readings_per_s\":%llu,\"asdu_enqueued\":%llu,"
+             "\"asdu_queue\":{\"depth\":%d,\"max_depth\":%d,\"capacity\":%d,\"full_samples\":%llu},"
+             "\"connections\":{\"accepted\":%llu,\"rejected\":%llu,\"opened\":%llu},"
+             "\"commands\":{\"received\":%llu,\"rejected\":%llu},",
+             static_cast<unsigned long long>(period / 1000),
+             static_cast<unsigned long long>(readings),
+             ratePerSecond(readings - m_lastReadings, period),
+             static_cast<unsigned long long>(m_asdusEnqueued.load(std::memory_order_relaxed)),
+             m_queueDepth.load(std::memory_order_relaxed),
+             m_queueMaxDepth.load(std::memory_order_relaxed),
+             m_queueCapacity.load(std::memory_order_relaxed),
+             static_cast<unsigned long long>(m_queueFullSamples.load(std::memory_order_relaxed)),
+             static_cast<unsigned long long>(m_connectionsAccepted.load(std::memory_order_relaxed)),
+             static_cast<unsigned long long>(m_connectionsRejected.load(std::memory_order_relaxed)),
+             static_cast<unsigned long long>(m_connectionsOpened.load(std::memory_order_relaxed)),
+             static_cast<unsigned long long>(m_commands.load(std::memory_order_relaxed)),
+             static_cast<unsigned long long>(m_commandsRejected.load(std::memory_order_relaxed)));
+
+    std::string json = buf;
+
+    /* GI durations in ms */
+    snprintf(buf, sizeof(buf), "\"interrogations\":{\"count\":%llu,\"p50\":%llu,\"p99\":%llu,\"max\":%llu},\"links\":[",
+             static_cast<unsigned long long>(m_interrogations.load(std::memory_order_relaxed)),
+             static_cast<unsigned long long>(m_interrogationDurations.percentile(50.0) / 1000000),
+             static_cast<unsigned long long>(m_interrogationDurations.percentile(99.0) / 1000000),
+             static_cast<unsigned long long>(m_interrogationDurations.Max() / 1000000));
+
+    json += buf;
+
+    bool first = true;
+
+    for (int i = 0; i < MAX_LINKS; i++) {
+        Link& link = m_links[i];
+
+        if (link.key.load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+
+        uint64_t iFramesSent = link.iFramesSent.load(std::memory_order_relaxed);
+        uint64_t iFramesReceived = link.iFramesReceived.load(std::memory_order_relaxed);
+
+        snprintf(buf, sizeof(buf),
+                 "%s{\"peer\":\"%s\",\"i_sent\":%llu,\"i_received\":%llu,\"i_sent_per_s\":%llu,\"i_received_per_s\":%llu,"
+                 "\"s_sent\":%llu,\"s_received\":%llu,\"u_sent\":%llu,\"u_received\":%llu,\"bytes_sent\":%llu,\"bytes_received\":%llu,"
+                 "\"k_stalls\":%llu,\"commands\":%llu,\"commands_rejected\":%llu,\"interrogations\":%llu}",
+                 first ? "" : ",", link.peer.c_str(),
+                 static_cast<unsigned long long>(iFramesSent),
+                 static_cast<unsigned long long>(iFramesReceived),
+                 ratePerSecond(iFramesSent - link.lastIFramesSent, period),
+                 ratePerSecond(iFramesReceived - link.lastIFramesReceived, period),
+                 static_cast<unsigned long long>(link.sFramesSent.load(std::memory_order_relaxed)),
+                 static_cast<unsigned long long>(link.sFramesReceived.load(std::memory_order_relaxed)),
+                 static_cast<unsigned long long>(link.uFramesSent.load(std::memory_order_relaxed)),
+                 static_cast<unsigned long long>(link.uFramesReceived.load(std::memory_order_relaxed)),
+                 static_cast<unsigned long long>(link.bytesSent.load(std::memory_order_relaxed)),
+                 static_cast<unsigned long long>(link.bytesReceived.load(std::memory_order_relaxed)),
+                 static_cast<unsigned long long>(link.windowStalls.load(std::memory_order_relaxed)),
+                 static_cast<unsigned long long>(link.commands.load(std::memory_order_relaxed)),
+                 static_cast<unsigned long long>(link.commandsRejected.load(std::memory_order_relaxed)),
+                 static_cast<unsigned long long>(link.interrogations.load(std::memory_order_relaxed)));
+
+        json += buf;
+        first = false;
+
+        link.lastIFramesSent = iFramesSent;
+        link.lastIFramesReceived = iFramesReceived;
+    }
+
+    json += "]}";
+
+    m_lastReadings = readings;
+    m_queueMaxDepth.store(m_queueDepth.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_interrogationDurations.reset();
+
+    return json;
+}
@@ -0,0 +1,51 @@
+#include "iec104_time_encoder.hpp"
+
+const uint64_t IEC104TimeEncoder::MS_PER_MINUTE;
+const uint64_t IEC104TimeEncoder::MS_PER_HOUR;
+
+IEC104TimeEncoder&
+IEC104TimeEncoder::threadInstance()
+{
+    static thread_local IEC104TimeEncoder encoder;
+
+    return encoder;
+}
+
+void
+IEC104TimeEncoder::refresh(uint64_t timestamp)
+{
+    struct sCP56Time2a time;
+
+    CP56Time2a_createFromMsTimestamp(&time, timestamp);
+
+    m_hourStart = timestamp - (timestamp % MS_PER_HOUR);
+
+    for (int i = 0; i < 4; i++) {
+        m_hourFields[i] = time.encodedValue[3 + i];
+    }
+}
+
+void
+IEC104TimeEncoder::encode(const uint64_t* timestamps, size_t count, struct sCP56Time2a* dest)
+{
+    size_t first = 0;
+
+    while (first < count) {
+        /* run of timestamps in the cached hour, encoded without branches */
+        if (timestamps[first] - m_hourStart >= MS_PER_HOUR) {
+            refresh(timestamps[first]);
+        }
+
+        size_t last = first + 1;
+
+        while ((last < count) && (timestamps[last] - m_hourStart < MS_PER_HOUR)) {
+            last++;
+        }
+
+        for (size_t i = first; i < last; i++) {
+            encodeInHour(&dest[i], static_cast<uint32_t>(timestamps[i] - m_hourStart));
+        }
+
+        first = last;
+    }
+}
@@ -0,0 +1,101 @@
+#include "iec104_worker_pool.hpp"
+
+IEC104WorkerPool::IEC104WorkerPool(int workers)
+{
+    for (int worker = 1; worker < workers; worker++) {
+        m_threads.push_back(std::thread(&IEC104WorkerPool::workerLoop, this, worker));
+    }
+}
+
+IEC104WorkerPool::~IEC104WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stopping = true;
+    }
+
+    m_taskAvailable.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void
+IEC104WorkerPool::chunk(int worker, size_t& first, size_t& last) const
+{
+    size_t workers = m_threads.size() + 1;
+
+    first = m_count * worker / workers;
+    last = m_count * (worker + 1) / workers;
+}
+
+void
+IEC104WorkerPool::run(size_t count, const std::function<void(size_t, size_t)>& task)
+{
+    if (m_threads.empty()) {
+        task(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        m_task = &task;
+        m_count = count;
+        m_pending = static_cast<int>(m_threads.size());
+        m_generation++;
+    }
+
+    m_taskAvailable.notify_all();
+
+    size_t first = 0;
+    size_t last = 0;
+
+    chunk(0, first, last);
+
+    task(first, last);
+
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    m_taskDone.wait(lock, [this] {return m_pending == 0;});
+
+    m_task = nullptr;
+}
+
+void
+IEC104WorkerPool::workerLoop(int worker)
+{
+    uint64_t generation = 0;
+
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    while (true) {
+        m_taskAvailable.wait(lock, [this, generation] {return m_stopping || (m_generation != generation);});
+
+        if (m_stopping) {
+            break;
+        }
+
+        generation = m_generation;
+
+        const std::function<void(size_t, size_t)>* task = m_task;
+
+        size_t first = 0;
+        size_t last = 0;
+
+        chunk(worker, first, last);
+
+        lock.unlock();
+
+        if (first < last) {
+            (*task)(first, last);
+        }
+
+        lock.lock();
+
+        if (--m_pending == 0) {
+            m_taskDone.notify_one();
+        }
+    }
+}
@@ -86,7 +86,9 @@ static const char* default_config = QUOTE({
                     "t0_timeout":10,
                     "t1_timeout":15,
                     "t2_timeout":10,
-                    "t3_timeout":20
+                    "t3_timeout":20,
+                    "conn_rate_limit":0,
+                    "conn_rate_burst":5
                 },
                 "application_layer" : {
                     "ca_asdu_size":2,
@@ -192,6 +194,32 @@ static const char* default_config = QUOTE({
                 ]
             }       
         })
+    },
+    "diagnostics" : {
+        "description" : "diagnostics parameters, can be changed without restarting the service",
+        "type" : "JSON",
+        "displayName" : "Diagnostics parameters",
+        "order" : "5",
+        "default" : QUOTE({
+            "diagnostics" : {
+                "capture" : {
+                    "enabled" : false,
+                    "path" : "",
+                    "max_file_size" : 10240,
+                    "max_files" : 5,
+                    "ring_size" : 4096
+                },
+                "latency" : {
+                    "enabled" : false,
+                    "period" : 60
+                },
+                "statistics" : {
+                    "enabled" : false,
+                    "period" : 60
+                },
+                "audit_code" : ""
+            }
+        })
     }
 });
 
@@ -216,8 +244,8 @@ static PLUGIN_INFORMATION info = {
  */
 PLUGIN_INFORMATION *plugin_info()
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - plugin_info -"; //LCOV_EXCL_LINE
-    Iec104Utility::log_info("%s IEC104 Config is %s", beforeLog.c_str(), info.config); //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("plugin_info"); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s IEC104 Config is %s", beforeLog, info.config); //LCOV_EXCL_LINE
 	return &info;
 }
 
@@ -228,11 +256,11 @@ PLUGIN_INFORMATION *plugin_info()
  */
 PLUGIN_HANDLE plugin_init(ConfigCategory* configData)
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - plugin_init -"; //LCOV_EXCL_LINE
-    Iec104Utility::log_info("%s Initializing the plugin", beforeLog.c_str()); //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("plugin_init"); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s Initializing the plugin", beforeLog); //LCOV_EXCL_LINE
 
     if (configData == nullptr) {
-        Iec104Utility::log_warn("%s No config provided for plugin, using default config", beforeLog.c_str()); //LCOV_EXCL_LINE
+        Iec104Utility::log_warn("%s No config provided for plugin, using default config", beforeLog); //LCOV_EXCL_LINE
         auto pluginInfo = plugin_info();
         configData = new ConfigCategory("newConfig", pluginInfo->config);
         configData->setItemsValueFromDefault();
@@ -245,7 +273,7 @@ PLUGIN_HANDLE plugin_init(ConfigCategory* configData)
     	iec104->configure(configData);
     }
 
-    Iec104Utility::log_info("%s Plugin initialized", beforeLog.c_str()); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s Plugin initialized", beforeLog); //LCOV_EXCL_LINE
 
 	return (PLUGIN_HANDLE)iec104;
 }
@@ -257,8 +285,8 @@ PLUGIN_HANDLE plugin_init(ConfigCategory* configData)
  * @param storedData	The stored plugin_data
  */
 void plugin_start(const PLUGIN_HANDLE handle, const string& storedData){
-    std::string beforeLog = Iec104Utility::PluginName + " - plugin_start -"; //LCOV_EXCL_LINE
-    Iec104Utility::log_info("%s Plugin start called", beforeLog.c_str()); //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("plugin_start"); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s Plugin start called", beforeLog); //LCOV_EXCL_LINE
     IEC104Server* iec104 = (IEC104Server*)handle;
     if(iec104){
         iec104->startSlave();
@@ -271,8 +299,8 @@ void plugin_start(const PLUGIN_HANDLE handle, const string& storedData){
 uint32_t plugin_send(const PLUGIN_HANDLE handle,
 		     const vector<Reading *>& readings)
 {
-	std::string beforeLog = Iec104Utility::PluginName + " - plugin_send -"; //LCOV_EXCL_LINE
-    Iec104Utility::log_info("%s Try sending %d readings to IEC104 server", beforeLog.c_str(), readings.size()); //LCOV_EXCL_LINE
+	const char* beforeLog = LOG_PREFIX("plugin_send"); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s Try sending %d readings to IEC104 server", beforeLog, readings.size()); //LCOV_EXCL_LINE
 
     IEC104Server* iec104 = (IEC104Server *)handle;
 
@@ -284,14 +312,36 @@ void plugin_register(PLUGIN_HANDLE handle,
 		bool ( *write)(const char *name, const char *value, ControlDestination destination, ...),
 		int (* operation)(char *operation, int paramCount, char *names[], char *parameters[], ControlDestination destination, ...))
 {
-    std::string beforeLog = Iec104Utility::PluginName + " - plugin_register -"; //LCOV_EXCL_LINE
-    Iec104Utility::log_info("%s Received new write and operation callbacks to regiter", beforeLog.c_str()); //LCOV_EXCL_LINE
+    const char* beforeLog = LOG_PREFIX("plugin_register"); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s Received new write and operation callbacks to regiter", beforeLog); //LCOV_EXCL_LINE
 
     IEC104Server* iec104 = (IEC104Server*)handle;
 
     iec104->registerControl(operation);
 }
 
+/**
+ * Reconfigure the plugin
+ *
+ * @param handle    The plugin handle
+ * @param newConfig The new configuration of the plugin
+ */
+void plugin_reconfigure(PLUGIN_HANDLE* handle, const string& newConfig)
+{
+    const char* beforeLog = LOG_PREFIX("plugin_reconfigure"); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s Reconfiguring the plugin", beforeLog); //LCOV_EXCL_LINE
+
+    if (handle == nullptr || *handle == nullptr) {
+        return;
+    }
+
+    IEC104Server* iec104 = (IEC104Server*)*handle;
+
+    ConfigCategory config("newConfig", newConfig);
+
+    iec104->reconfigure(&config);
+}
+
 /**
  * Shutdown the plugin
  *
@@ -301,8 +351,8 @@ void plugin_register(PLUGIN_HANDLE handle,
  */
 void plugin_shutdown(PLUGIN_HANDLE handle)
 {
-	std::string beforeLog = Iec104Utility::PluginName + " - plugin_shutdown -"; //LCOV_EXCL_LINE
-    Iec104Utility::log_info("%s Shutting down the plugin...", beforeLog.c_str()); //LCOV_EXCL_LINE
+	const char* beforeLog = LOG_PREFIX("plugin_shutdown"); //LCOV_EXCL_LINE
+    Iec104Utility::log_info("%s Shutting down the plugin...", beforeLog); //LCOV_EXCL_LINE
 
     IEC104Server* iec104 = (IEC104Server*)handle;
 
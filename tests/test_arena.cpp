@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "iec104_arena.hpp"
+
+using namespace std;
+
+static vector<int> destroyed;
+
+class Tracked
+{
+public:
+    explicit Tracked(int id) : m_id(id), m_name(60, 'x') {};
+    ~Tracked() {destroyed.push_back(m_id);};
+
+    int m_id;
+    string m_name; /* allocated by the object, freed by its destructor */
+};
+
+TEST(Arena, CreateAndRelease)
+{
+    IEC104Arena arena(1024);
+
+    destroyed.clear();
+
+    vector<Tracked*> objects;
+
+    for (int id = 0; id < 100; id++) {
+        objects.push_back(arena.create<Tracked>(id));
+    }
+
+    for (int id = 0; id < 100; id++) {
+        ASSERT_EQ(id, objects[id]->m_id);
+        ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(objects[id]) % alignof(Tracked));
+    }
+
+    ASSERT_GT(arena.Blocks(), 1u);
+
+    arena.release();
+
+    /* all destroyed, last created first */
+    ASSERT_EQ(100u, destroyed.size());
+
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(99 - i, destroyed[i]);
+    }
+
+    /* the first block is kept for the next objects */
+    ASSERT_EQ(1u, arena.Blocks());
+    ASSERT_EQ(0u, arena.BytesUsed());
+
+    int* value = arena.create<int>(42);
+    ASSERT_EQ(42, *value);
+    ASSERT_EQ(1u, arena.Blocks());
+}
+
+TEST(Arena, Alignment)
+{
+    IEC104Arena arena(256);
+
+    arena.allocate(1, 1);
+    void* aligned = arena.allocate(8, 64);
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(aligned) % 64);
+
+    /* larger than a block */
+    void* large = arena.allocate(4096, 16);
+    ASSERT_NE(nullptr, large);
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(large) % 16);
+    ASSERT_EQ(2u, arena.Blocks());
+}
+
+TEST(Arena, DestroyedWithArena)
+{
+    destroyed.clear();
+
+    {
+        IEC104Arena arena;
+        arena.create<Tracked>(1);
+        arena.create<Tracked>(2);
+    }
+
+    ASSERT_EQ(2u, destroyed.size());
+}
@@ -0,0 +1,309 @@
+#include <gtest/gtest.h>
+
+#include <lib60870/hal_thread.h>
+#include <lib60870/hal_time.h>
+
+#include "iec104.h"
+#include "iec104_background_scan.hpp"
+#include "iec104_config.hpp"
+#include "iec104_datapoint.hpp"
+#include "cs104_connection.h"
+
+using namespace std;
+
+static string protocol_stack = QUOTE({
+        "protocol_stack" : {
+            "name" : "iec104server",
+            "version" : "1.0",
+            "transport_layer" : {
+                "bind_on_ip":false,
+                "srv_ip":"0.0.0.0",
+                "port":2404,
+                "tls":false,
+                "k_value":12,
+                "w_value":8,
+                "t0_timeout":10,
+                "t1_timeout":15,
+                "t2_timeout":10,
+                "t3_timeout":20
+            },
+            "application_layer" : {
+                "ca_asdu_size":2,
+                "ioaddr_size":3,
+                "asdu_size":0,
+                "time_sync":false,
+                "cmd_exec_timeout":5,
+                "cmd_recv_timeout":1,
+                "accept_cmd_with_time":2,
+                "bkg_scan_rate":2000
+            }
+        }
+    });
+
+static string tls = QUOTE({
+        "tls_conf:" : {
+            "private_key" : "server-key.pem",
+            "server_cert" : "server.cer",
+            "ca_cert" : "root.cer"
+        }
+    });
+
+static string exchanged_data = QUOTE({
+        "exchanged_data" : {
+            "name" : "iec104client",
+            "version" : "1.0",
+            "datapoints":[
+                {
+                    "label":"TM1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-984",
+                          "typeid":"M_ME_NC_1"
+                       }
+                    ]
+                },
+                {
+                    "label":"TM2",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-985",
+                          "typeid":"M_ME_NC_1"
+                       }
+                    ]
+                },
+                {
+                    "label":"TS1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-672",
+                          "typeid":"M_SP_NA_1"
+                       }
+                    ]
+                },
+                {
+                    "label":"IT1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-1100",
+                          "typeid":"M_IT_NA_1"
+                       }
+                    ]
+                }
+            ]
+        }
+    });
+
+class BackgroundScanTest : public testing::Test
+{
+protected:
+    IEC104Server* iec104Server;  // Object on which we call for tests
+    CS104_Connection connection;
+
+    vector<CS101_ASDU> receivedAsdu;
+
+    // Setup is ran for every tests, so each variable are reinitialised
+    void SetUp() override
+    {
+        // Init iec104server object
+        iec104Server = new IEC104Server();
+        const char* ip = "127.0.0.1";
+        uint16_t port = IEC_60870_5_104_DEFAULT_PORT;
+        // Create connection
+        connection = CS104_Connection_create(ip, port);
+        ASSERT_NE(connection, nullptr);
+    }
+
+    // TearDown is ran for every tests, so each variable are destroyed again
+    void TearDown() override
+    {
+        CS104_Connection_destroy(connection);
+
+        clearReceived();
+
+        iec104Server->stop();
+
+        delete iec104Server;
+    }
+
+    static bool asduReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
+    {
+        BackgroundScanTest* self = (BackgroundScanTest*)parameter;
+
+        self->receivedAsdu.push_back(CS101_ASDU_clone(asdu, NULL));
+
+        return true;
+    }
+
+    void clearReceived()
+    {
+        for (CS101_ASDU asdu : receivedAsdu)
+        {
+            CS101_ASDU_destroy(asdu);
+        }
+
+        receivedAsdu.clear();
+    }
+
+    int countAsdu(int ca, int typeId, int cot)
+    {
+        int count = 0;
+
+        for (CS101_ASDU asdu : receivedAsdu) {
+            if ((CS101_ASDU_getCA(asdu) == ca) && (CS101_ASDU_getTypeID(asdu) == typeId) && (CS101_ASDU_getCOT(asdu) == cot)) {
+                count++;
+            }
+        }
+
+        return count;
+    }
+};
+
+TEST(BackgroundScan, ScanOrder)
+{
+    IEC104DataPoint ts1("TS1", 45, 1, IEC60870_TYPE_SP, false, 1);
+    IEC104DataPoint ts2("TS2", 45, 2, IEC60870_TYPE_SP, false, 1);
+    IEC104DataPoint tm1("TM1", 45, 3, IEC60870_TYPE_SHORT, false, 1);
+    IEC104DataPoint ts3("TS3", 45, 4, IEC60870_TYPE_SP, false, 1);
+    IEC104DataPoint it1("IT1", 45, 5, IEC60870_TYPE_COUNTER, false, 1);
+    IEC104DataPoint tm2("TM2", 46, 1, IEC60870_TYPE_SCALED, false, 1);
+
+    std::map<int, std::map<int, IEC104DataPoint*>> definitions;
+    definitions[45][1] = &ts1;
+    definitions[45][2] = &ts2;
+    definitions[45][3] = &tm1;
+    definitions[45][4] = &ts3;
+    definitions[45][5] = &it1;
+    definitions[46][1] = &tm2;
+
+    IEC104BackgroundScan scan;
+
+    scan.configure(definitions, 100000, 253, 2, 3);
+
+    ASSERT_TRUE(scan.isEnabled());
+
+    uint64_t start = 1000000;
+
+    scan.refill(start);
+    scan.refill(start + 1000);
+
+    std::vector<IEC104DataPoint*> batch;
+
+    /* the points of the same CA and type are sent together, the counters are not scanned */
+    ASSERT_TRUE(scan.nextBatch(batch));
+    ASSERT_EQ(3, batch.size());
+    ASSERT_EQ(&ts1, batch[0]);
+    ASSERT_EQ(&ts2, batch[1]);
+    ASSERT_EQ(&ts3, batch[2]);
+
+    ASSERT_TRUE(scan.nextBatch(batch));
+    ASSERT_EQ(1, batch.size());
+    ASSERT_EQ(&tm1, batch[0]);
+
+    ASSERT_TRUE(scan.nextBatch(batch));
+    ASSERT_EQ(1, batch.size());
+    ASSERT_EQ(&tm2, batch[0]);
+
+    /* end of the scan -> next scan */
+    ASSERT_EQ(0, scan.Cursor());
+
+    ASSERT_TRUE(scan.nextBatch(batch));
+    ASSERT_EQ(&ts1, batch[0]);
+}
+
+TEST(BackgroundScan, RateLimit)
+{
+    std::vector<IEC104DataPoint*> points;
+    std::map<int, std::map<int, IEC104DataPoint*>> definitions;
+
+    /* 120 single points: ASDUs of 61 and 59 objects */
+    for (int ioa = 1; ioa <= 120; ioa++) {
+        IEC104DataPoint* dp = new IEC104DataPoint("TS", 45, ioa, IEC60870_TYPE_SP, false, 1);
+
+        points.push_back(dp);
+        definitions[45][ioa] = dp;
+    }
+
+    IEC104BackgroundScan scan;
+
+    scan.configure(definitions, 1000, 253, 2, 3);
+
+    std::vector<IEC104DataPoint*> batch;
+
+    uint64_t start = 1000000;
+
+    scan.refill(start);
+    ASSERT_FALSE(scan.nextBatch(batch));
+
+    scan.refill(start + 100);
+    ASSERT_FALSE(scan.nextBatch(batch));
+    ASSERT_TRUE(batch.empty());
+
+    /* 10 + 2 + 61 * 4 = 256 octets */
+    scan.refill(start + 300);
+    ASSERT_TRUE(scan.nextBatch(batch));
+    ASSERT_EQ(61, batch.size());
+    ASSERT_EQ(44, scan.Budget());
+    ASSERT_FALSE(scan.nextBatch(batch));
+
+    /* 10 + 2 + 59 * 4 = 248 octets */
+    scan.refill(start + 500);
+    ASSERT_FALSE(scan.nextBatch(batch));
+
+    scan.refill(start + 600);
+    ASSERT_TRUE(scan.nextBatch(batch));
+    ASSERT_EQ(59, batch.size());
+    ASSERT_EQ(0, scan.Cursor());
+
+    /* no burst after an idle period: the budget is capped to one second */
+    scan.refill(start + 100000);
+    ASSERT_EQ(1000, scan.Budget());
+
+    for (IEC104DataPoint* dp : points) {
+        delete dp;
+    }
+}
+
+TEST(BackgroundScan, Disabled)
+{
+    IEC104DataPoint ts1("TS1", 45, 1, IEC60870_TYPE_SP, false, 1);
+
+    std::map<int, std::map<int, IEC104DataPoint*>> definitions;
+    definitions[45][1] = &ts1;
+
+    IEC104BackgroundScan scan;
+
+    scan.configure(definitions, 0, 253, 2, 3);
+
+    ASSERT_FALSE(scan.isEnabled());
+}
+
+TEST_F(BackgroundScanTest, BackgroundScanTransmission)
+{
+    iec104Server->setJsonConfig(protocol_stack, exchanged_data, tls);
+    ASSERT_TRUE(iec104Server->startSlave());
+
+    Thread_sleep(500); /* wait for the server to start */
+
+    CS104_Connection_setASDUReceivedHandler(connection, asduReceivedHandler, this);
+
+    ASSERT_TRUE(CS104_Connection_connect(connection));
+
+    CS104_Connection_sendStartDT(connection);
+
+    Thread_sleep(1500);
+
+    /* the whole point image is refreshed, except the counters */
+    ASSERT_GE(countAsdu(45, M_ME_NC_1, CS101_COT_BACKGROUND_SCAN), 1);
+    ASSERT_GE(countAsdu(45, M_SP_NA_1, CS101_COT_BACKGROUND_SCAN), 1);
+    ASSERT_EQ(0, countAsdu(45, M_IT_NA_1, CS101_COT_BACKGROUND_SCAN));
+
+    for (CS101_ASDU asdu : receivedAsdu) {
+        if ((CS101_ASDU_getTypeID(asdu) == M_ME_NC_1) && (CS101_ASDU_getCOT(asdu) == CS101_COT_BACKGROUND_SCAN)) {
+            ASSERT_EQ(2, CS101_ASDU_getNumberOfElements(asdu));
+        }
+    }
+}
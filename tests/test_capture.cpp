@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "iec104_capture.hpp"
+
+using namespace std;
+
+static vector<uint8_t> readFile(const string& path)
+{
+    vector<uint8_t> content;
+    FILE* file = fopen(path.c_str(), "rb");
+
+    if (file) {
+        uint8_t buf[4096];
+        size_t len;
+
+        while ((len = fread(buf, 1, sizeof(buf), file)) > 0) {
+            content.insert(content.end(), buf, buf + len);
+        }
+
+        fclose(file);
+    }
+
+    return content;
+}
+
+static uint32_t readU32(const vector<uint8_t>& content, size_t offset)
+{
+    uint32_t value;
+    memcpy(&value, &content[offset], sizeof(value));
+    return value;
+}
+
+// Return the type of every block of a pcapng file
+static vector<uint32_t> readBlockTypes(const vector<uint8_t>& content)
+{
+    vector<uint32_t> types;
+    size_t offset = 0;
+
+    while (offset + 12 <= content.size()) {
+        uint32_t type = readU32(content, offset);
+        uint32_t length = readU32(content, offset + 4);
+
+        if ((length < 12) || (offset + length > content.size()) || (readU32(content, offset + length - 4) != length)) {
+            break;
+        }
+
+        types.push_back(type);
+        offset += length;
+    }
+
+    return types;
+}
+
+static const uint8_t startDtAct[] = {0x68, 0x04, 0x07, 0x00, 0x00, 0x00};
+static const uint8_t startDtCon[] = {0x68, 0x04, 0x0b, 0x00, 0x00, 0x00};
+
+TEST(CaptureTest, RingPushPop)
+{
+    IEC104CaptureRing ring(5);
+
+    ASSERT_EQ(8, ring.Capacity());
+
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(ring.push(i, startDtAct, sizeof(startDtAct), false, 1000 + i));
+    }
+
+    ASSERT_FALSE(ring.push(8, startDtCon, sizeof(startDtCon), true, 2000));
+    ASSERT_EQ(1, ring.Dropped());
+
+    IEC104CaptureRing::Record record;
+
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(ring.pop(record));
+        ASSERT_EQ(i, record.connectionKey);
+        ASSERT_EQ(1000 + i, record.timestamp);
+        ASSERT_EQ(sizeof(startDtAct), record.length);
+        ASSERT_EQ(0, memcmp(startDtAct, record.data, sizeof(startDtAct)));
+        ASSERT_FALSE(record.sent);
+    }
+
+    ASSERT_FALSE(ring.pop(record));
+
+    ASSERT_TRUE(ring.push(9, startDtCon, sizeof(startDtCon), true, 3000));
+    ASSERT_TRUE(ring.pop(record));
+    ASSERT_TRUE(record.sent);
+}
+
+TEST(CaptureTest, RingMultipleProducers)
+{
+    IEC104CaptureRing ring(1024);
+
+    vector<thread> producers;
+
+    for (int p = 0; p < 4; p++) {
+        producers.push_back(thread([&ring, p]() {
+            for (int i = 0; i < 200; i++) {
+                ring.push(p, startDtAct, sizeof(startDtAct), false, i);
+            }
+        }));
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    IEC104CaptureRing::Record record;
+    int count[4] = {0, 0, 0, 0};
+    uint64_t last[4] = {0, 0, 0, 0};
+
+    while (ring.pop(record)) {
+        // Each producer records are kept in order
+        if (count[record.connectionKey] > 0) {
+            ASSERT_GT(record.timestamp, last[record.connectionKey]);
+        }
+        last[record.connectionKey] = record.timestamp;
+        count[record.connectionKey]++;
+    }
+
+    for (int p = 0; p < 4; p++) {
+        ASSERT_EQ(200, count[p]);
+    }
+
+    ASSERT_EQ(0, ring.Dropped());
+}
+
+TEST(CaptureTest, PcapngFile)
+{
+    string path = "iec104_test_capture.pcapng";
+
+    IEC104PcapngWriter writer;
+    ASSERT_TRUE(writer.open(path, 1024, 0));
+
+    IEC104ClientAddress client;
+    ASSERT_TRUE(IEC104ClientAddress::parse("127.0.0.1", 9, client));
+
+    IEC104CaptureRing::Record record;
+    record.timestamp = 1700000000000000000ULL;
+    record.connectionKey = 1;
+    record.length = sizeof(startDtAct);
+    record.sent = false;
+    memcpy(record.data, startDtAct, sizeof(startDtAct));
+
+    uint32_t serverSeq = 1;
+    uint32_t clientSeq = 1;
+
+    writer.writeApdu(record, client, 50000, serverSeq, clientSeq);
+
+    record.sent = true;
+    memcpy(record.data, startDtCon, sizeof(startDtCon));
+
+    writer.writeApdu(record, client, 50000, serverSeq, clientSeq);
+    writer.close();
+
+    ASSERT_EQ(1 + sizeof(startDtCon), serverSeq);
+    ASSERT_EQ(1 + sizeof(startDtAct), clientSeq);
+
+    vector<uint8_t> content = readFile(path);
+    ASSERT_EQ(0x1A2B3C4D, readU32(content, 8));
+
+    vector<uint32_t> types = readBlockTypes(content);
+    ASSERT_EQ(4, types.size());
+    ASSERT_EQ(0x0A0D0D0A, types[0]);
+    ASSERT_EQ(1, types[1]);
+    ASSERT_EQ(6, types[2]);
+    ASSERT_EQ(6, types[3]);
+
+    remove(path.c_str());
+}
+
+TEST(CaptureTest, PcapngRotation)
+{
+    string path = "iec104_test_rotation.pcapng";
+
+    IEC104PcapngWriter writer;
+    ASSERT_TRUE(writer.open(path, 1, 2));
+
+    IEC104ClientAddress client;
+    ASSERT_TRUE(IEC104ClientAddress::parse("fd00::1", 7, client));
+
+    IEC104CaptureRing::Record record;
+    record.timestamp = 0;
+    record.connectionKey = 1;
+    record.length = sizeof(startDtAct);
+    record.sent = false;
+    memcpy(record.data, startDtAct, sizeof(startDtAct));
+
+    uint32_t serverSeq = 1;
+    uint32_t clientSeq = 1;
+
+    for (int i = 0; i < 100; i++) {
+        writer.writeApdu(record, client, 50000, serverSeq, clientSeq);
+    }
+
+    writer.close();
+
+    // Every file starts with its own section header and stays under the size limit
+    for (const string& file : {path, path + ".1", path + ".2"}) {
+        vector<uint8_t> content = readFile(file);
+        ASSERT_FALSE(content.empty());
+        ASSERT_LE(content.size(), 1024);
+
+        vector<uint32_t> types = readBlockTypes(content);
+        ASSERT_GE(types.size(), 3);
+        ASSERT_EQ(0x0A0D0D0A, types[0]);
+
+        remove(file.c_str());
+    }
+
+    ASSERT_TRUE(readFile(path + ".3").empty());
+}
+
+TEST(CaptureTest, EnableDisable)
+{
+    string path = "iec104_test_enable.pcapng";
+
+    IEC104Capture capture;
+    capture.setServerEndpoint("0.0.0.0", 2404);
+
+    ASSERT_FALSE(capture.isEnabled());
+
+    IEC104CaptureSettings settings;
+    settings.enabled = true;
+    settings.path = path;
+    settings.ringSize = 64;
+
+    capture.configure(settings, "");
+    ASSERT_TRUE(capture.isEnabled());
+
+    capture.registerConnection(0x1234, "127.0.0.1:50000");
+    capture.recordApdu(0x1234, startDtAct, sizeof(startDtAct), false);
+    capture.recordApdu(0x1234, startDtCon, sizeof(startDtCon), true);
+    capture.unregisterConnection(0x1234);
+
+    settings.enabled = false;
+    capture.configure(settings, "");
+    ASSERT_FALSE(capture.isEnabled());
+
+    vector<uint32_t> types = readBlockTypes(readFile(path));
+    ASSERT_EQ(4, types.size());
+    ASSERT_EQ(0, capture.Dropped());
+
+    remove(path.c_str());
+}
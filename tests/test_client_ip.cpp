@@ -0,0 +1,254 @@
+#include <gtest/gtest.h>
+
+#include <plugin_api.h>
+
+#include "iec104_client_ip.hpp"
+#include "iec104_config.hpp"
+#include "iec104_redgroup.hpp"
+
+using namespace std;
+
+static IEC104ClientAddress parseAddress(const string& text)
+{
+    IEC104ClientAddress address;
+    EXPECT_TRUE(IEC104ClientAddress::parse(text.c_str(), text.size(), address));
+    return address;
+}
+
+TEST(ClientIpTest, ParseAddress)
+{
+    IEC104ClientAddress address;
+
+    ASSERT_TRUE(IEC104ClientAddress::parse("192.168.0.11", 12, address));
+    ASSERT_TRUE(address.isV4());
+    ASSERT_EQ(192, address.Bytes()[12]);
+    ASSERT_EQ(11, address.Bytes()[15]);
+
+    ASSERT_TRUE(IEC104ClientAddress::parse("fd00::1", 7, address));
+    ASSERT_FALSE(address.isV4());
+
+    ASSERT_TRUE(IEC104ClientAddress::parse("[fd00::1]", 9, address));
+    ASSERT_EQ(parseAddress("fd00::1"), address);
+
+    ASSERT_EQ(parseAddress("::ffff:10.0.0.1"), parseAddress("10.0.0.1"));
+
+    ASSERT_FALSE(IEC104ClientAddress::parse("192.168.0.256", 13, address));
+    ASSERT_FALSE(IEC104ClientAddress::parse("", 0, address));
+    ASSERT_FALSE(IEC104ClientAddress::parse("not an ip", 9, address));
+}
+
+TEST(ClientIpTest, ParsePeer)
+{
+    IEC104ClientAddress address;
+    int port = 0;
+
+    ASSERT_TRUE(IEC104ClientAddress::parsePeer("127.0.0.1:53422", address, port));
+    ASSERT_EQ(parseAddress("127.0.0.1"), address);
+    ASSERT_EQ(53422, port);
+
+    ASSERT_TRUE(IEC104ClientAddress::parsePeer("[fd00::12]:2405", address, port));
+    ASSERT_EQ(parseAddress("fd00::12"), address);
+    ASSERT_EQ(2405, port);
+
+    ASSERT_FALSE(IEC104ClientAddress::parsePeer("127.0.0.1", address, port));
+    ASSERT_FALSE(IEC104ClientAddress::parsePeer("127.0.0.1:", address, port));
+    ASSERT_FALSE(IEC104ClientAddress::parsePeer("127.0.0.1:70000", address, port));
+    ASSERT_FALSE(IEC104ClientAddress::parsePeer("fd00::12", address, port));
+}
+
+TEST(ClientIpTest, Lookup)
+{
+    IEC104ServerRedGroup redGroup1("red-group-1", 0, nullptr);
+    IEC104ServerRedGroup redGroup2("red-group-2", 1, nullptr);
+
+    RedGroupCon conA("127.0.0.1");
+    RedGroupCon conB("127.0.0.1");
+    RedGroupCon conHost("10.1.2.3");
+
+    IEC104ClientIpLookup lookup;
+    ASSERT_TRUE(lookup.empty());
+
+    ASSERT_TRUE(lookup.add(parseAddress(conA.ClientIP()), &redGroup1, &conA));
+    ASSERT_TRUE(lookup.add(parseAddress(conB.ClientIP()), &redGroup1, &conB));
+    ASSERT_FALSE(lookup.add(parseAddress(conB.ClientIP()), &redGroup2, &conB));
+    ASSERT_TRUE(lookup.add(parseAddress(conHost.ClientIP()), &redGroup2, &conHost));
+
+    ASSERT_FALSE(lookup.empty());
+
+    const IEC104ClientIpEntry* entry = lookup.find(parseAddress("127.0.0.1"));
+    ASSERT_NE(nullptr, entry);
+    ASSERT_EQ(&redGroup1, entry->redGroup);
+    ASSERT_EQ(2, entry->connections.size());
+
+    entry = lookup.find(parseAddress("::ffff:10.1.2.3"));
+    ASSERT_NE(nullptr, entry);
+    ASSERT_EQ(&conHost, entry->connections[0]);
+
+    ASSERT_EQ(nullptr, lookup.find(parseAddress("10.1.2.4")));
+    ASSERT_EQ(nullptr, lookup.find(parseAddress("192.168.0.11")));
+    ASSERT_EQ(nullptr, lookup.find(parseAddress("fd00::1")));
+}
+
+static string protocol_stack_subnets = QUOTE({
+        "protocol_stack" : {
+            "name" : "iec104server",
+            "version" : "1.0",
+            "transport_layer" : {
+                "redundancy_groups":[
+                    {
+                       "connections":[
+                          {
+                             "clt_ip":"10.0.0.0/8"
+                          }
+                       ],
+                       "rg_name":"subnets-only"
+                    },
+                    {
+                       "connections":[
+                          {
+                             "clt_ip":"192.168.0.11"
+                          },
+                          {
+                             "clt_ip":"172.16.0.0/12"
+                          }
+                       ],
+                       "rg_name":"mixed"
+                    }
+                ],
+                "srv_ip":"0.0.0.0",
+                "port":2404
+            },
+            "application_layer" : {
+                "ca_asdu_size":2,
+                "ioaddr_size":3
+            }
+        }
+    });
+
+TEST(ClientIpTest, SubnetsRefusedInRedundancyGroups)
+{
+    IEC104Config config;
+
+    config.importProtocolConfig(protocol_stack_subnets);
+
+    // only subnets: the group is ignored, it must not accept every client as a fallback group
+    ASSERT_EQ(1, config.RedundancyGroups().size());
+    ASSERT_EQ("mixed", config.RedundancyGroups()[0]->Name());
+    ASSERT_FALSE(config.HasCatchAllRedGroup());
+    ASSERT_EQ(nullptr, config.ClientIpLookup().find(parseAddress("10.1.2.3")));
+
+    // mixed: the client address is kept, the subnet is refused
+    ASSERT_EQ(1, config.RedundancyGroups()[0]->Connections().size());
+
+    const IEC104ClientIpEntry* entry = config.ClientIpLookup().find(parseAddress("192.168.0.11"));
+    ASSERT_NE(nullptr, entry);
+    ASSERT_EQ(config.RedundancyGroups()[0].get(), entry->redGroup);
+
+    ASSERT_EQ(nullptr, config.ClientIpLookup().find(parseAddress("172.16.1.1")));
+}
+
+TEST(ClientIpTest, ConnectionSlots)
+{
+    IEC104ServerRedGroup redGroup("red-group-1", 0, nullptr);
+
+    RedGroupCon conA("127.0.0.1");
+    RedGroupCon conB("127.0.0.1");
+
+    IEC104ClientIpEntry entry;
+    entry.redGroup = &redGroup;
+    entry.connections.push_back(&conA);
+    entry.connections.push_back(&conB);
+
+    RedGroupCon* slot = entry.GetSlot(50001);
+    ASSERT_EQ(&conA, slot);
+    slot->SetPort(50001);
+
+    ASSERT_EQ(&conA, entry.GetSlot(50001));
+
+    slot = entry.GetSlot(50002);
+    ASSERT_EQ(&conB, slot);
+    slot->SetPort(50002);
+
+    ASSERT_EQ(nullptr, entry.GetSlot(50003));
+
+    conA.SetPort(0);
+    ASSERT_EQ(&conA, entry.GetSlot(50003));
+}
+
+TEST(ClientIpTest, RateLimiter)
+{
+    IEC104ClientRateLimiter limiter;
+
+    IEC104ClientAddress client1 = parseAddress("192.168.0.11");
+    IEC104ClientAddress client2 = parseAddress("192.168.0.12");
+
+    // Disabled by default
+    ASSERT_FALSE(limiter.isEnabled());
+    for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(limiter.allow(client1, 1000));
+    }
+
+    // 6 connections per minute (one every 10s), burst of 3
+    limiter.configure(6, 3);
+    ASSERT_TRUE(limiter.isEnabled());
+
+    uint64_t now = 1000;
+    ASSERT_TRUE(limiter.allow(client1, now));
+    ASSERT_TRUE(limiter.allow(client1, now));
+    ASSERT_TRUE(limiter.allow(client1, now));
+    ASSERT_FALSE(limiter.allow(client1, now));
+
+    // Buckets are per source IP
+    ASSERT_TRUE(limiter.allow(client2, now));
+
+    now += 5000;
+    ASSERT_FALSE(limiter.allow(client1, now));
+
+    now += 5000;
+    ASSERT_TRUE(limiter.allow(client1, now));
+    ASSERT_FALSE(limiter.allow(client1, now));
+
+    // The bucket never holds more than the burst
+    now += 3600000;
+    ASSERT_TRUE(limiter.allow(client1, now));
+    ASSERT_TRUE(limiter.allow(client1, now));
+    ASSERT_TRUE(limiter.allow(client1, now));
+    ASSERT_FALSE(limiter.allow(client1, now));
+
+    limiter.configure(0, 3);
+    ASSERT_TRUE(limiter.allow(client1, now));
+}
+
+TEST(ClientIpTest, RateLimiterTrackedClients)
+{
+    IEC104ClientRateLimiter limiter;
+
+    // 6 connections per minute (one every 10s), burst of 3: a bucket is full again 30s after its last connection
+    limiter.configure(6, 3);
+
+    uint64_t now = 1000;
+
+    for (size_t i = 0; i < IEC104ClientRateLimiter::MAX_TRACKED_CLIENTS; i++) {
+        IEC104ClientAddress client = parseAddress("10.0." + to_string(i / 256) + "." + to_string(i % 256));
+        ASSERT_TRUE(limiter.allow(client, now));
+    }
+
+    // the table is full and no bucket is full again: new clients are refused, known clients are still served
+    ASSERT_FALSE(limiter.allow(parseAddress("192.168.0.11"), now));
+    ASSERT_TRUE(limiter.allow(parseAddress("10.0.0.0"), now));
+
+    // 10.0.0.1 is now the least recently seen client, its bucket is full again
+    now += 30000;
+    ASSERT_TRUE(limiter.allow(parseAddress("192.168.0.11"), now));
+
+    // then 10.0.0.2, the table never grows above its size
+    ASSERT_TRUE(limiter.allow(parseAddress("192.168.0.12"), now));
+
+    // the buckets of the new clients are in use, they are not dropped
+    for (int i = 0; i < 2; i++) {
+        ASSERT_TRUE(limiter.allow(parseAddress("192.168.0.11"), now));
+        ASSERT_TRUE(limiter.allow(parseAddress("192.168.0.12"), now));
+    }
+
+    ASSERT_FALSE(limiter.allow(parseAddress("192.168.0.11"), now));
+}
@@ -1732,6 +1732,125 @@ TEST_F(ConnectionHandlerTest, SyncConnectionWithSouth)
 }
 
 
+// protocol stack of the admission tests (connectionRequestHandler)
+static string
+admissionProtocolStack(const string& redundancyGroups, int connRateLimit, int connRateBurst)
+{
+    return string("{\"protocol_stack\":{\"name\":\"iec104server\",\"version\":\"1.0\",\"transport_layer\":{") +
+           "\"redundancy_groups\":" + redundancyGroups + "," +
+           "\"srv_ip\":\"0.0.0.0\",\"port\":2404,\"tls\":false," +
+           "\"conn_rate_limit\":" + to_string(connRateLimit) + ",\"conn_rate_burst\":" + to_string(connRateBurst) + "}," +
+           "\"application_layer\":{\"ca_asdu_size\":2,\"ioaddr_size\":3}}}";
+}
+
+struct AdmissionEvents
+{
+    bool startDtConfirmed = false;
+    bool closed = false;
+};
+
+static void
+admissionConnectionHandler(void* parameter, CS104_Connection connection, CS104_ConnectionEvent event)
+{
+    AdmissionEvents* events = static_cast<AdmissionEvents*>(parameter);
+
+    if (event == CS104_CONNECTION_STARTDT_CON_RECEIVED) {
+        events->startDtConfirmed = true;
+    }
+    else if (event == CS104_CONNECTION_CLOSED) {
+        events->closed = true;
+    }
+}
+
+// A refused client is disconnected by the server right after the TCP connection is established
+static bool
+isConnectionAdmitted()
+{
+    AdmissionEvents events;
+
+    CS104_Connection connection = CS104_Connection_create("127.0.0.1", IEC_60870_5_104_DEFAULT_PORT);
+    CS104_Connection_setConnectionHandler(connection, admissionConnectionHandler, &events);
+
+    bool admitted = false;
+
+    if (CS104_Connection_connect(connection)) {
+        CS104_Connection_sendStartDT(connection);
+
+        Thread_sleep(500);
+
+        admitted = events.startDtConfirmed && !events.closed;
+    }
+
+    CS104_Connection_destroy(connection);
+
+    Thread_sleep(200); /* wait for the server to release the connection */
+
+    return admitted;
+}
+
+TEST_F(ConnectionHandlerTest, AdmissionAllowedIp)
+{
+    string redGroups = QUOTE([{"rg_name":"red-group-1","connections":[{"clt_ip":"127.0.0.1"},{"clt_ip":"127.0.0.1"}]}]);
+
+    iec104Server->setJsonConfig(admissionProtocolStack(redGroups, 0, 1), exchanged_data, tls);
+    ASSERT_TRUE(iec104Server->startSlave());
+
+    Thread_sleep(500); /* wait for the server to start */
+
+    ASSERT_TRUE(isConnectionAdmitted());
+}
+
+TEST_F(ConnectionHandlerTest, AdmissionRefusedIp)
+{
+    string redGroups = QUOTE([{"rg_name":"red-group-1","connections":[{"clt_ip":"192.168.0.11"},{"clt_ip":"192.168.0.12"}]}]);
+
+    iec104Server->setJsonConfig(admissionProtocolStack(redGroups, 0, 1), exchanged_data, tls);
+    ASSERT_TRUE(iec104Server->startSlave());
+
+    Thread_sleep(500); /* wait for the server to start */
+
+    ASSERT_FALSE(isConnectionAdmitted());
+}
+
+TEST_F(ConnectionHandlerTest, AdmissionCatchAllGroup)
+{
+    // 127.0.0.1 is not listed, it is accepted by the group without connections
+    string redGroups = QUOTE([{"rg_name":"red-group-1","connections":[{"clt_ip":"192.168.0.11"}]},{"rg_name":"catch-all"}]);
+
+    iec104Server->setJsonConfig(admissionProtocolStack(redGroups, 0, 1), exchanged_data, tls);
+    ASSERT_TRUE(iec104Server->startSlave());
+
+    Thread_sleep(500); /* wait for the server to start */
+
+    ASSERT_TRUE(iec104Server->Config()->HasCatchAllRedGroup());
+    ASSERT_TRUE(isConnectionAdmitted());
+}
+
+TEST_F(ConnectionHandlerTest, AdmissionWithoutRedundancyGroups)
+{
+    iec104Server->setJsonConfig(admissionProtocolStack("[]", 0, 1), exchanged_data, tls);
+    ASSERT_TRUE(iec104Server->startSlave());
+
+    Thread_sleep(500); /* wait for the server to start */
+
+    ASSERT_TRUE(isConnectionAdmitted());
+}
+
+TEST_F(ConnectionHandlerTest, AdmissionRateLimit)
+{
+    string redGroups = QUOTE([{"rg_name":"red-group-1","connections":[{"clt_ip":"127.0.0.1"},{"clt_ip":"127.0.0.1"}]}]);
+
+    // one connection per minute after a burst of two
+    iec104Server->setJsonConfig(admissionProtocolStack(redGroups, 1, 2), exchanged_data, tls);
+    ASSERT_TRUE(iec104Server->startSlave());
+
+    Thread_sleep(500); /* wait for the server to start */
+
+    ASSERT_TRUE(isConnectionAdmitted());
+    ASSERT_TRUE(isConnectionAdmitted());
+    ASSERT_FALSE(isConnectionAdmitted());
+}
+
 TEST_F(ConnectionHandlerTest, BrokenProtocolStack1)
 {
     iec104Server->setJsonConfig(broken_protocol_stack_1, exchanged_data, tls);
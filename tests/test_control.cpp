@@ -575,7 +575,7 @@ ControlTest::m_asduReceivedHandler(void* parameter, int address, CS101_ASDU asdu
     self->asduHandlerCalled++;
 
     int typeId = CS101_ASDU_getTypeID(asdu);
-    printf("CS101_ASDU: type: %s (%d) ca: %i cot: %i\n", IEC104DataPoint::getStringFromTypeID(typeId).c_str(), typeId,
+    printf("CS101_ASDU: type: %s (%d) ca: %i cot: %i\n", IEC104DataPoint::getStringFromTypeID(typeId), typeId,
             CS101_ASDU_getCA(asdu), CS101_ASDU_getCOT(asdu));
     
     self->isNegative = false;
@@ -2455,9 +2455,9 @@ TEST_F(ControlTest, ValidateCommands)
         M_DP_TA_1, M_DP_TB_1, M_ST_NA_1, M_ST_TA_1,
         M_ST_TB_1, M_ME_NA_1, M_ME_TA_1, M_ME_TD_1,
         M_ME_NB_1, M_ME_TB_1, M_ME_TE_1, M_ME_NC_1,
-        M_ME_TC_1, M_ME_TF_1
+        M_ME_TC_1, M_ME_TF_1, M_BO_NA_1, M_PS_NA_1, M_IT_NA_1, M_IT_TA_1, M_IT_TB_1
     };
-    int unsupportedMonitoringTypes = M_BO_NA_1;
+    int unsupportedMonitoringTypes = M_EP_TA_1;
     for (int i = 0; i < sizeof(supportedMonitoringTypes) / sizeof(int); i++) {
         ASSERT_TRUE(IEC104DataPoint::isSupportedMonitoringType(supportedMonitoringTypes[i]));
     }
@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+
+#include <cfloat>
+#include <limits>
+
+#include "iec104.h"
+#include "iec104_config.hpp"
+#include "iec104_conversion.hpp"
+#include "iec104_datapoint.hpp"
+#include "iec104_point_table.hpp"
+
+using namespace std;
+
+static string exchanged_data = QUOTE({
+        "exchanged_data" : {
+            "name" : "iec104client",
+            "version" : "1.0",
+            "datapoints":[
+                {
+                    "label":"TM1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-984",
+                          "typeid":"M_ME_NA_1",
+                          "conversion":{"min":4, "max":20}
+                       }
+                    ]
+                },
+                {
+                    "label":"TM2",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-985",
+                          "typeid":"M_ME_TE_1",
+                          "conversion":{"scale":100, "offset":-5}
+                       }
+                    ]
+                },
+                {
+                    "label":"TM3",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-986",
+                          "typeid":"M_ME_NC_1",
+                          "conversion":{"min":10, "max":0}
+                       }
+                    ]
+                },
+                {
+                    "label":"TM4",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-987",
+                          "typeid":"M_ME_NC_1"
+                       }
+                    ]
+                },
+                {
+                    "label":"TS1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-672",
+                          "typeid":"M_SP_NA_1",
+                          "conversion":{"scale":2}
+                       }
+                    ]
+                }
+            ]
+        }
+    });
+
+TEST(Conversion, NormalizedDefault)
+{
+    const IEC104Conversion& conversion = IEC104Conversion::defaultFor(IEC60870_TYPE_NORMALIZED);
+    bool overflow = false;
+
+    ASSERT_FLOAT_EQ(0.5f, conversion.apply(0.5, overflow));
+    ASSERT_FALSE(overflow);
+
+    ASSERT_FLOAT_EQ(-1.0f, conversion.apply(-1.0, overflow));
+    ASSERT_FALSE(overflow);
+
+    /* full scale, transmitted as the largest normalized value */
+    ASSERT_FLOAT_EQ(32767.0f / 32768.0f, conversion.apply(1.0, overflow));
+    ASSERT_FALSE(overflow);
+
+    ASSERT_FLOAT_EQ(32767.0f / 32768.0f, conversion.apply(1.001, overflow));
+    ASSERT_TRUE(overflow);
+
+    ASSERT_FLOAT_EQ(-1.0f, conversion.apply(-3.0, overflow));
+    ASSERT_TRUE(overflow);
+}
+
+TEST(Conversion, NormalizedRange)
+{
+    /* 4..20 mA -> [-1, 1) */
+    IEC104Conversion conversion = IEC104Conversion::create(IEC60870_TYPE_NORMALIZED, 1.0, 0.0, true, 4.0, 20.0);
+    bool overflow = false;
+
+    ASSERT_FLOAT_EQ(-1.0f, conversion.apply(4.0, overflow));
+    ASSERT_FALSE(overflow);
+
+    ASSERT_FLOAT_EQ(0.0f, conversion.apply(12.0, overflow));
+    ASSERT_FALSE(overflow);
+
+    ASSERT_FLOAT_EQ(0.5f, conversion.apply(16.0, overflow));
+    ASSERT_FALSE(overflow);
+
+    /* full scale */
+    ASSERT_FLOAT_EQ(32767.0f / 32768.0f, conversion.apply(20.0, overflow));
+    ASSERT_FALSE(overflow);
+
+    ASSERT_FLOAT_EQ(32767.0f / 32768.0f, conversion.apply(25.0, overflow));
+    ASSERT_TRUE(overflow);
+
+    /* raw counts 0..1000 scaled to 0..100 % before the range */
+    conversion = IEC104Conversion::create(IEC60870_TYPE_NORMALIZED, 0.1, 0.0, true, 0.0, 100.0);
+
+    ASSERT_FLOAT_EQ(0.0f, conversion.apply(500.0, overflow));
+    ASSERT_FALSE(overflow);
+}
+
+TEST(Conversion, Scaled)
+{
+    const IEC104Conversion& saturation = IEC104Conversion::defaultFor(IEC60870_TYPE_SCALED);
+    bool overflow = false;
+
+    ASSERT_FLOAT_EQ(-1234.0f, saturation.apply(-1234.0, overflow));
+    ASSERT_FALSE(overflow);
+
+    ASSERT_FLOAT_EQ(32767.0f, saturation.apply(32767.0, overflow));
+    ASSERT_FALSE(overflow);
+
+    ASSERT_FLOAT_EQ(32767.0f, saturation.apply(100000.0, overflow));
+    ASSERT_TRUE(overflow);
+
+    ASSERT_FLOAT_EQ(-32768.0f, saturation.apply(-40000.0, overflow));
+    ASSERT_TRUE(overflow);
+
+    /* kV -> V/10, rounded to the nearest integer */
+    IEC104Conversion conversion = IEC104Conversion::create(IEC60870_TYPE_SCALED, 100.0, 0.0, false, 0.0, 0.0);
+
+    ASSERT_FLOAT_EQ(2254.0f, conversion.apply(22.538, overflow));
+    ASSERT_FALSE(overflow);
+
+    ASSERT_FLOAT_EQ(-2254.0f, conversion.apply(-22.538, overflow));
+    ASSERT_FALSE(overflow);
+
+    /* clamp inside the int16 range */
+    conversion = IEC104Conversion::create(IEC60870_TYPE_SCALED, 1.0, -10.0, true, 0.0, 1000.0);
+
+    ASSERT_FLOAT_EQ(990.0f, conversion.apply(1000.0, overflow));
+    ASSERT_FALSE(overflow);
+
+    ASSERT_FLOAT_EQ(0.0f, conversion.apply(5.0, overflow));
+    ASSERT_TRUE(overflow);
+}
+
+TEST(Conversion, Short)
+{
+    const IEC104Conversion& saturation = IEC104Conversion::defaultFor(IEC60870_TYPE_SHORT);
+    bool overflow = false;
+
+    ASSERT_FLOAT_EQ(-0.01f, saturation.apply(-0.01, overflow));
+    ASSERT_FALSE(overflow);
+
+    /* out of the float range */
+    ASSERT_FLOAT_EQ(FLT_MAX, saturation.apply(1e300, overflow));
+    ASSERT_TRUE(overflow);
+
+    IEC104Conversion conversion = IEC104Conversion::create(IEC60870_TYPE_SHORT, 2.0, 1.0, true, -100.0, 100.0);
+
+    ASSERT_FLOAT_EQ(21.0f, conversion.apply(10.0, overflow));
+    ASSERT_FALSE(overflow);
+
+    ASSERT_FLOAT_EQ(100.0f, conversion.apply(49.5, overflow));
+    ASSERT_FALSE(overflow);
+
+    ASSERT_FLOAT_EQ(100.0f, conversion.apply(60.0, overflow));
+    ASSERT_TRUE(overflow);
+}
+
+TEST(Conversion, NotANumber)
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    bool overflow = false;
+
+    ASSERT_FLOAT_EQ(0.0f, IEC104Conversion::defaultFor(IEC60870_TYPE_SHORT).apply(nan, overflow));
+    ASSERT_TRUE(overflow);
+
+    ASSERT_FLOAT_EQ(0.0f, IEC104Conversion::defaultFor(IEC60870_TYPE_SCALED).apply(nan, overflow));
+    ASSERT_TRUE(overflow);
+
+    ASSERT_FLOAT_EQ(32767.0f, IEC104Conversion::defaultFor(IEC60870_TYPE_SCALED).apply(
+                                  std::numeric_limits<double>::infinity(), overflow));
+    ASSERT_TRUE(overflow);
+}
+
+TEST(Conversion, ImportConfig)
+{
+    IEC104Config config;
+
+    config.importExchangeConfig(exchanged_data);
+
+    shared_ptr<const IEC104PointTable> table = config.getPointTable();
+    ASSERT_NE(nullptr, table);
+
+    bool overflow = false;
+
+    IEC104DataPoint* tm1 = table->findDataPoint(45, 984);
+    ASSERT_NE(nullptr, tm1);
+    ASSERT_NE(nullptr, tm1->m_conversion);
+    ASSERT_FLOAT_EQ(0.0f, tm1->m_conversion->apply(12.0, overflow));
+    ASSERT_FALSE(overflow);
+
+    IEC104DataPoint* tm2 = table->findDataPoint(45, 985);
+    ASSERT_NE(nullptr, tm2);
+    ASSERT_NE(nullptr, tm2->m_conversion);
+    ASSERT_FLOAT_EQ(1245.0f, tm2->m_conversion->apply(12.5, overflow));
+    ASSERT_FALSE(overflow);
+
+    /* invalid range: scale and offset only, saturated to the float range */
+    IEC104DataPoint* tm3 = table->findDataPoint(45, 986);
+    ASSERT_NE(nullptr, tm3);
+    ASSERT_NE(nullptr, tm3->m_conversion);
+    ASSERT_FLOAT_EQ(50.0f, tm3->m_conversion->apply(50.0, overflow));
+    ASSERT_FALSE(overflow);
+
+    IEC104DataPoint* tm4 = table->findDataPoint(45, 987);
+    ASSERT_NE(nullptr, tm4);
+    ASSERT_EQ(nullptr, tm4->m_conversion);
+
+    /* only for measured values */
+    IEC104DataPoint* ts1 = table->findDataPoint(45, 672);
+    ASSERT_NE(nullptr, ts1);
+    ASSERT_EQ(nullptr, ts1->m_conversion);
+}
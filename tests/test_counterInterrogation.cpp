@@ -0,0 +1,484 @@
+#include <gtest/gtest.h>
+
+#include <reading.h>
+
+#include <lib60870/hal_thread.h>
+#include <lib60870/hal_time.h>
+
+#include "iec104.h"
+#include "iec104_config.hpp"
+#include "iec104_counters.hpp"
+#include "iec104_datapoint.hpp"
+#include "iec104_point_store.hpp"
+#include "cs104_connection.h"
+
+using namespace std;
+
+static string protocol_stack = QUOTE({
+        "protocol_stack" : {
+            "name" : "iec104server",
+            "version" : "1.0",
+            "transport_layer" : {
+                "bind_on_ip":false,
+                "srv_ip":"0.0.0.0",
+                "port":2404,
+                "tls":false,
+                "k_value":12,
+                "w_value":8,
+                "t0_timeout":10,
+                "t1_timeout":15,
+                "t2_timeout":10,
+                "t3_timeout":20
+            },
+            "application_layer" : {
+                "ca_asdu_size":2,
+                "ioaddr_size":3,
+                "asdu_size":0,
+                "time_sync":false,
+                "cmd_exec_timeout":5,
+                "cmd_recv_timeout":1,
+                "accept_cmd_with_time":2
+            }
+        }
+    });
+
+static string tls = QUOTE({
+        "tls_conf:" : {
+            "private_key" : "server-key.pem",
+            "server_cert" : "server.cer",
+            "ca_cert" : "root.cer"
+        }
+    });
+
+static string exchanged_data = QUOTE({
+        "exchanged_data" : {
+            "name" : "iec104client",
+            "version" : "1.0",
+            "datapoints":[
+                {
+                    "label":"IT1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-3000",
+                          "typeid":"M_IT_NA_1",
+                          "ci_group":1
+                       }
+                    ]
+                },
+                {
+                    "label":"IT2",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-3001",
+                          "typeid":"M_IT_TB_1",
+                          "ci_group":2
+                       }
+                    ]
+                },
+                {
+                    "label":"IT3",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-3002",
+                          "typeid":"M_IT_NA_1",
+                          "ci_group":7
+                       }
+                    ]
+                },
+                {
+                    "label":"TS1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-672",
+                          "typeid":"M_SP_NA_1"
+                       }
+                    ]
+                }
+            ]
+        }
+    });
+
+class CounterInterrogationTest : public testing::Test
+{
+protected:
+    IEC104Server* iec104Server;  // Object on which we call for tests
+    CS104_Connection connection;
+
+    vector<CS101_ASDU> receivedAsdu;
+
+    // Setup is ran for every tests, so each variable are reinitialised
+    void SetUp() override
+    {
+        // Init iec104server object
+        iec104Server = new IEC104Server();
+        const char* ip = "127.0.0.1";
+        uint16_t port = IEC_60870_5_104_DEFAULT_PORT;
+        // Create connection
+        connection = CS104_Connection_create(ip, port);
+        ASSERT_NE(connection, nullptr);
+    }
+
+    // TearDown is ran for every tests, so each variable are destroyed again
+    void TearDown() override
+    {
+        CS104_Connection_destroy(connection);
+
+        clearReceived();
+
+        iec104Server->stop();
+
+        delete iec104Server;
+    }
+
+    static bool asduReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
+    {
+        CounterInterrogationTest* self = (CounterInterrogationTest*)parameter;
+
+        self->receivedAsdu.push_back(CS101_ASDU_clone(asdu, NULL));
+
+        return true;
+    }
+
+    void clearReceived()
+    {
+        for (CS101_ASDU asdu : receivedAsdu)
+        {
+            CS101_ASDU_destroy(asdu);
+        }
+
+        receivedAsdu.clear();
+    }
+
+    CS101_ASDU findAsdu(int typeId, int cot)
+    {
+        for (CS101_ASDU asdu : receivedAsdu) {
+            if ((CS101_ASDU_getTypeID(asdu) == typeId) && (CS101_ASDU_getCOT(asdu) == cot)) {
+                return asdu;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void startAndConnect()
+    {
+        iec104Server->setJsonConfig(protocol_stack, exchanged_data, tls);
+        ASSERT_TRUE(iec104Server->startSlave());
+
+        Thread_sleep(500); /* wait for the server to start */
+
+        CS104_Connection_setASDUReceivedHandler(connection, asduReceivedHandler, this);
+
+        ASSERT_TRUE(CS104_Connection_connect(connection));
+
+        CS104_Connection_sendStartDT(connection);
+
+        Thread_sleep(200);
+    }
+
+    void sendCounter(int ioa, const string& typeId, int64_t value)
+    {
+        vector<Datapoint*> dataobjects;
+
+        dataobjects.push_back(createDataObject(45, ioa, typeId, value));
+
+        Reading* reading = new Reading(std::string("IT"), dataobjects);
+
+        vector<Reading*> readings;
+
+        readings.push_back(reading);
+
+        iec104Server->send(readings);
+
+        delete reading;
+    }
+
+    template <class T>
+    static Datapoint* createDatapoint(const std::string& dataname, const T value)
+    {
+        DatapointValue dp_value = DatapointValue(value);
+        return new Datapoint(dataname, dp_value);
+    }
+
+    static Datapoint* createDataObject(int ca, int ioa, const string& typeId, int64_t value)
+    {
+        auto* datapoints = new vector<Datapoint*>;
+
+        datapoints->push_back(createDatapoint("do_type", typeId));
+        datapoints->push_back(createDatapoint("do_ca", (int64_t)ca));
+        datapoints->push_back(createDatapoint("do_oa", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_cot", (int64_t)CS101_COT_SPONTANEOUS));
+        datapoints->push_back(createDatapoint("do_test", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_negative", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_ioa", (int64_t)ioa));
+        datapoints->push_back(createDatapoint("do_value", value));
+        datapoints->push_back(createDatapoint("do_quality_iv", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_quality_bl", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_quality_ov", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_quality_sb", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_quality_nt", (int64_t)0));
+
+        if (typeId == "M_IT_TB_1") {
+            datapoints->push_back(createDatapoint("do_ts", (long)Hal_getTimeInMs()));
+        }
+
+        DatapointValue dpv(datapoints, true);
+
+        return new Datapoint("data_object", dpv);
+    }
+
+    static int32_t counterValue(CS101_ASDU asdu, int index)
+    {
+        IntegratedTotals io = (IntegratedTotals)CS101_ASDU_getElement(asdu, index);
+
+        int32_t value = BinaryCounterReading_getValue(IntegratedTotals_getBCR(io));
+
+        InformationObject_destroy((InformationObject)io);
+
+        return value;
+    }
+};
+
+TEST(CounterStore, FreezeSnapshot)
+{
+    IEC104DataPoint it1("IT1", 45, 3000, IEC60870_TYPE_COUNTER, false, 1);
+    IEC104DataPoint it2("IT2", 45, 3001, IEC60870_TYPE_COUNTER, false, 1);
+    IEC104DataPoint it3("IT3", 46, 3000, IEC60870_TYPE_COUNTER, false, 1);
+
+    it2.m_counterGroup = 2;
+
+    std::map<int, std::map<int, IEC104DataPoint*>> definitions;
+
+    definitions[45][3000] = &it1;
+    definitions[45][3001] = &it2;
+    definitions[46][3000] = &it3;
+
+    IEC104PointStore pointStore;
+    pointStore.build(definitions);
+
+    IEC104CounterStore store;
+
+    store.configure(definitions);
+
+    ASSERT_TRUE(store.hasCounters(45));
+    ASSERT_TRUE(store.hasCounters(46));
+    ASSERT_FALSE(store.hasCounters(47));
+    ASSERT_EQ(2, store.Cas().size());
+    ASSERT_EQ(0, it1.m_counterIndex);
+    ASSERT_EQ(0, it2.m_counterIndex);
+
+    it1.m_value->counter.value = 100;
+    it1.m_value->counter.quality.invalid = 0;
+    store.update(&it1, M_IT_NA_1);
+
+    /* never frozen: current values */
+    std::vector<IEC104CounterStore::Snapshot> snapshots = store.snapshots(45, 0);
+
+    ASSERT_EQ(2, snapshots.size());
+    ASSERT_EQ(100, (*snapshots[0].counters)[0].value);
+    ASSERT_FALSE((*snapshots[0].counters)[0].invalid);
+    ASSERT_TRUE((*snapshots[1].counters)[0].invalid);
+
+    store.freeze(45, 0);
+
+    it1.m_value->counter.value = 200;
+    store.update(&it1, M_IT_NA_1);
+
+    /* the frozen values are not changed by the following updates */
+    IEC104CounterStore::Snapshot frozen = store.snapshots(45, 0)[0];
+
+    ASSERT_EQ(100, (*frozen.counters)[0].value);
+    ASSERT_EQ(1, frozen.sequence);
+
+    /* group 2 only */
+    store.freeze(45, 2);
+
+    snapshots = store.snapshots(45, 2);
+
+    ASSERT_EQ(1, snapshots.size());
+    ASSERT_EQ(3001, (*snapshots[0].counters)[0].ioa);
+    ASSERT_EQ(2, snapshots[0].sequence);
+
+    store.freeze(45, 0);
+
+    ASSERT_EQ(200, (*store.snapshots(45, 0)[0].counters)[0].value);
+
+    /* the snapshot taken before is still valid */
+    ASSERT_EQ(100, (*frozen.counters)[0].value);
+
+    /* no counter in group 3 */
+    ASSERT_EQ(0, store.snapshots(45, 3).size());
+}
+
+TEST(CounterStore, ImportConfig)
+{
+    IEC104Config config;
+
+    config.importExchangeConfig(exchanged_data);
+
+    auto& definitions = *config.getExchangeDefinitions();
+
+    ASSERT_EQ(IEC60870_TYPE_COUNTER, definitions.at(45).at(3000)->m_type);
+    ASSERT_EQ(IEC60870_TYPE_COUNTER, definitions.at(45).at(3001)->m_type);
+    ASSERT_EQ(1, definitions.at(45).at(3000)->m_counterGroup);
+    ASSERT_EQ(2, definitions.at(45).at(3001)->m_counterGroup);
+
+    /* out of range: only part of the general request */
+    ASSERT_EQ(0, definitions.at(45).at(3002)->m_counterGroup);
+}
+
+TEST_F(CounterInterrogationTest, SpontaneousCounters)
+{
+    startAndConnect();
+
+    sendCounter(3000, "M_IT_NA_1", 1234);
+    sendCounter(3001, "M_IT_TB_1", -5);
+
+    Thread_sleep(500);
+
+    CS101_ASDU asdu = findAsdu(M_IT_NA_1, CS101_COT_SPONTANEOUS);
+    ASSERT_NE(nullptr, asdu);
+    ASSERT_EQ(1234, counterValue(asdu, 0));
+
+    asdu = findAsdu(M_IT_TB_1, CS101_COT_SPONTANEOUS);
+    ASSERT_NE(nullptr, asdu);
+    ASSERT_EQ(-5, counterValue(asdu, 0));
+}
+
+TEST_F(CounterInterrogationTest, GeneralCounterInterrogation)
+{
+    startAndConnect();
+
+    sendCounter(3000, "M_IT_NA_1", 10);
+    sendCounter(3001, "M_IT_TB_1", 20);
+
+    Thread_sleep(200);
+
+    clearReceived();
+
+    ASSERT_TRUE(CS104_Connection_sendCounterInterrogationCommand(connection, CS101_COT_ACTIVATION, 45,
+                                                                 IEC60870_QCC_RQT_GENERAL | IEC60870_QCC_FRZ_FREEZE_WITHOUT_RESET));
+
+    Thread_sleep(500);
+
+    CS101_ASDU actCon = findAsdu(C_CI_NA_1, CS101_COT_ACTIVATION_CON);
+    ASSERT_NE(nullptr, actCon);
+    ASSERT_FALSE(CS101_ASDU_isNegative(actCon));
+    ASSERT_NE(nullptr, findAsdu(C_CI_NA_1, CS101_COT_ACTIVATION_TERMINATION));
+
+    /* the freeze does not transmit the counters */
+    ASSERT_EQ(nullptr, findAsdu(M_IT_NA_1, CS101_COT_REQUESTED_BY_GENERAL_COUNTER));
+    ASSERT_EQ(nullptr, findAsdu(M_IT_TB_1, CS101_COT_REQUESTED_BY_GENERAL_COUNTER));
+
+    clearReceived();
+
+    ASSERT_TRUE(CS104_Connection_sendCounterInterrogationCommand(connection, CS101_COT_ACTIVATION, 45,
+                                                                 IEC60870_QCC_RQT_GENERAL | IEC60870_QCC_FRZ_READ));
+
+    Thread_sleep(500);
+
+    actCon = findAsdu(C_CI_NA_1, CS101_COT_ACTIVATION_CON);
+    ASSERT_NE(nullptr, actCon);
+    ASSERT_FALSE(CS101_ASDU_isNegative(actCon));
+    ASSERT_NE(nullptr, findAsdu(C_CI_NA_1, CS101_COT_ACTIVATION_TERMINATION));
+
+    CS101_ASDU asdu = findAsdu(M_IT_NA_1, CS101_COT_REQUESTED_BY_GENERAL_COUNTER);
+    ASSERT_NE(nullptr, asdu);
+    ASSERT_EQ(10, counterValue(asdu, 0));
+
+    asdu = findAsdu(M_IT_TB_1, CS101_COT_REQUESTED_BY_GENERAL_COUNTER);
+    ASSERT_NE(nullptr, asdu);
+    ASSERT_EQ(20, counterValue(asdu, 0));
+
+    /* counters are not part of the station interrogation */
+    clearReceived();
+
+    CS104_Connection_sendInterrogationCommand(connection, CS101_COT_ACTIVATION, 45, IEC60870_QOI_STATION);
+
+    Thread_sleep(500);
+
+    ASSERT_EQ(nullptr, findAsdu(M_IT_NA_1, CS101_COT_INTERROGATED_BY_STATION));
+    ASSERT_EQ(nullptr, findAsdu(M_IT_TB_1, CS101_COT_INTERROGATED_BY_STATION));
+}
+
+TEST_F(CounterInterrogationTest, ReadFrozenCounters)
+{
+    startAndConnect();
+
+    sendCounter(3000, "M_IT_NA_1", 10);
+
+    CS104_Connection_sendCounterInterrogationCommand(connection, CS101_COT_ACTIVATION, 45,
+                                                     1 | IEC60870_QCC_FRZ_FREEZE_WITHOUT_RESET);
+
+    Thread_sleep(500);
+
+    ASSERT_EQ(nullptr, findAsdu(M_IT_NA_1, CS101_COT_REQUESTED_BY_GROUP_1_COUNTER));
+
+    sendCounter(3000, "M_IT_NA_1", 11);
+
+    Thread_sleep(200);
+
+    clearReceived();
+
+    /* read: the value frozen before the update is transmitted */
+    CS104_Connection_sendCounterInterrogationCommand(connection, CS101_COT_ACTIVATION, 45, 1 | IEC60870_QCC_FRZ_READ);
+
+    Thread_sleep(500);
+
+    CS101_ASDU asdu = findAsdu(M_IT_NA_1, CS101_COT_REQUESTED_BY_GROUP_1_COUNTER);
+    ASSERT_NE(nullptr, asdu);
+    ASSERT_EQ(1, CS101_ASDU_getNumberOfElements(asdu));
+    ASSERT_EQ(10, counterValue(asdu, 0));
+
+    /* group 2 holds the M_IT_TB_1 counter only */
+    clearReceived();
+
+    CS104_Connection_sendCounterInterrogationCommand(connection, CS101_COT_ACTIVATION, 45, 2 | IEC60870_QCC_FRZ_READ);
+
+    Thread_sleep(500);
+
+    ASSERT_EQ(nullptr, findAsdu(M_IT_NA_1, CS101_COT_REQUESTED_BY_GROUP_2_COUNTER));
+    ASSERT_NE(nullptr, findAsdu(M_IT_TB_1, CS101_COT_REQUESTED_BY_GROUP_2_COUNTER));
+}
+
+TEST_F(CounterInterrogationTest, RejectedCounterInterrogation)
+{
+    startAndConnect();
+
+    /* counter reset */
+    CS104_Connection_sendCounterInterrogationCommand(connection, CS101_COT_ACTIVATION, 45,
+                                                     IEC60870_QCC_RQT_GENERAL | IEC60870_QCC_FRZ_COUNTER_RESET);
+
+    Thread_sleep(500);
+
+    CS101_ASDU actCon = findAsdu(C_CI_NA_1, CS101_COT_ACTIVATION_CON);
+    ASSERT_NE(nullptr, actCon);
+    ASSERT_TRUE(CS101_ASDU_isNegative(actCon));
+
+    /* freeze with reset */
+    clearReceived();
+
+    CS104_Connection_sendCounterInterrogationCommand(connection, CS101_COT_ACTIVATION, 45,
+                                                     IEC60870_QCC_RQT_GENERAL | IEC60870_QCC_FRZ_FREEZE_WITH_RESET);
+
+    Thread_sleep(500);
+
+    ASSERT_EQ(1, receivedAsdu.size());
+    ASSERT_EQ(C_CI_NA_1, CS101_ASDU_getTypeID(receivedAsdu[0]));
+    ASSERT_TRUE(CS101_ASDU_isNegative(receivedAsdu[0]));
+
+    /* unknown CA */
+    clearReceived();
+
+    CS104_Connection_sendCounterInterrogationCommand(connection, CS101_COT_ACTIVATION, 46, IEC60870_QCC_RQT_GENERAL);
+
+    Thread_sleep(500);
+
+    ASSERT_EQ(1, receivedAsdu.size());
+    ASSERT_EQ(C_CI_NA_1, CS101_ASDU_getTypeID(receivedAsdu[0]));
+    ASSERT_TRUE(CS101_ASDU_isNegative(receivedAsdu[0]));
+}
@@ -0,0 +1,301 @@
+#include <gtest/gtest.h>
+
+#include <lib60870/hal_thread.h>
+#include <lib60870/hal_time.h>
+
+#include "iec104.h"
+#include "iec104_config.hpp"
+#include "iec104_cyclic.hpp"
+#include "iec104_datapoint.hpp"
+#include "cs104_connection.h"
+
+using namespace std;
+
+static string protocol_stack = QUOTE({
+        "protocol_stack" : {
+            "name" : "iec104server",
+            "version" : "1.0",
+            "transport_layer" : {
+                "bind_on_ip":false,
+                "srv_ip":"0.0.0.0",
+                "port":2404,
+                "tls":false,
+                "k_value":12,
+                "w_value":8,
+                "t0_timeout":10,
+                "t1_timeout":15,
+                "t2_timeout":10,
+                "t3_timeout":20
+            },
+            "application_layer" : {
+                "ca_asdu_size":2,
+                "ioaddr_size":3,
+                "asdu_size":0,
+                "time_sync":false,
+                "cmd_exec_timeout":5,
+                "cmd_recv_timeout":1,
+                "accept_cmd_with_time":2
+            }
+        }
+    });
+
+static string tls = QUOTE({
+        "tls_conf:" : {
+            "private_key" : "server-key.pem",
+            "server_cert" : "server.cer",
+            "ca_cert" : "root.cer"
+        }
+    });
+
+static string exchanged_data = QUOTE({
+        "exchanged_data" : {
+            "name" : "iec104client",
+            "version" : "1.0",
+            "datapoints":[
+                {
+                    "label":"TM1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-984",
+                          "typeid":"M_ME_NC_1",
+                          "cyclic_period_ms":1000
+                       }
+                    ]
+                },
+                {
+                    "label":"TM2",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-985",
+                          "typeid":"M_ME_NC_1",
+                          "cyclic_period_ms":1000
+                       }
+                    ]
+                },
+                {
+                    "label":"TM3",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"46-986",
+                          "typeid":"M_ME_NB_1",
+                          "cyclic_period_ms":1000
+                       }
+                    ]
+                },
+                {
+                    "label":"TS1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-672",
+                          "typeid":"M_SP_NA_1"
+                       }
+                    ]
+                }
+            ]
+        }
+    });
+
+class CyclicTransmissionTest : public testing::Test
+{
+protected:
+    IEC104Server* iec104Server;  // Object on which we call for tests
+    CS104_Connection connection;
+
+    vector<CS101_ASDU> receivedAsdu;
+
+    // Setup is ran for every tests, so each variable are reinitialised
+    void SetUp() override
+    {
+        // Init iec104server object
+        iec104Server = new IEC104Server();
+        const char* ip = "127.0.0.1";
+        uint16_t port = IEC_60870_5_104_DEFAULT_PORT;
+        // Create connection
+        connection = CS104_Connection_create(ip, port);
+        ASSERT_NE(connection, nullptr);
+    }
+
+    // TearDown is ran for every tests, so each variable are destroyed again
+    void TearDown() override
+    {
+        CS104_Connection_destroy(connection);
+
+        clearReceived();
+
+        iec104Server->stop();
+
+        delete iec104Server;
+    }
+
+    static bool asduReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
+    {
+        CyclicTransmissionTest* self = (CyclicTransmissionTest*)parameter;
+
+        self->receivedAsdu.push_back(CS101_ASDU_clone(asdu, NULL));
+
+        return true;
+    }
+
+    void clearReceived()
+    {
+        for (CS101_ASDU asdu : receivedAsdu)
+        {
+            CS101_ASDU_destroy(asdu);
+        }
+
+        receivedAsdu.clear();
+    }
+
+    int countAsdu(int ca, int typeId, int cot)
+    {
+        int count = 0;
+
+        for (CS101_ASDU asdu : receivedAsdu) {
+            if ((CS101_ASDU_getCA(asdu) == ca) && (CS101_ASDU_getTypeID(asdu) == typeId) && (CS101_ASDU_getCOT(asdu) == cot)) {
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    void startAndConnect()
+    {
+        iec104Server->setJsonConfig(protocol_stack, exchanged_data, tls);
+        ASSERT_TRUE(iec104Server->startSlave());
+
+        Thread_sleep(500); /* wait for the server to start */
+
+        CS104_Connection_setASDUReceivedHandler(connection, asduReceivedHandler, this);
+
+        ASSERT_TRUE(CS104_Connection_connect(connection));
+
+        CS104_Connection_sendStartDT(connection);
+
+        Thread_sleep(200);
+    }
+};
+
+TEST(CyclicScheduler, ObjectsPerAsdu)
+{
+    /* 253 - 4 - 2 = 247 octets of information objects */
+    ASSERT_EQ(61, IEC104CyclicScheduler::objectsPerAsdu(IEC60870_TYPE_SP, 253, 2, 3));
+    ASSERT_EQ(41, IEC104CyclicScheduler::objectsPerAsdu(IEC60870_TYPE_SCALED, 253, 2, 3));
+    ASSERT_EQ(30, IEC104CyclicScheduler::objectsPerAsdu(IEC60870_TYPE_SHORT, 253, 2, 3));
+    ASSERT_EQ(1, IEC104CyclicScheduler::objectsPerAsdu(IEC60870_TYPE_SHORT, 10, 2, 3));
+}
+
+TEST(CyclicScheduler, SpreadOverPeriod)
+{
+    std::vector<IEC104DataPoint*> points;
+    std::map<int, std::map<int, IEC104DataPoint*>> definitions;
+
+    /* 120 single points: 2 ASDUs per period */
+    for (int ioa = 1; ioa <= 120; ioa++) {
+        IEC104DataPoint* dp = new IEC104DataPoint("TS", 45, ioa, IEC60870_TYPE_SP, false, 1);
+        dp->m_cyclicPeriod = 1000;
+
+        points.push_back(dp);
+        definitions[45][ioa] = dp;
+    }
+
+    /* not cyclic */
+    IEC104DataPoint other("TM", 45, 1000, IEC60870_TYPE_SHORT, false, 1);
+    definitions[45][1000] = &other;
+
+    IEC104CyclicScheduler scheduler;
+
+    scheduler.configure(definitions, 253, 2, 3);
+
+    ASSERT_FALSE(scheduler.isEmpty());
+
+    std::vector<const IEC104CyclicScheduler::Batch*> due;
+    std::vector<uint64_t> dueTimes;
+    size_t objects = 0;
+
+    uint64_t start = 1000000;
+
+    scheduler.advance(start, due);
+    ASSERT_EQ(0, due.size());
+
+    for (uint64_t time = start; time <= start + 3000; time += IEC104CyclicScheduler::TICK) {
+        size_t before = due.size();
+
+        scheduler.advance(time, due);
+
+        for (size_t i = before; i < due.size(); i++) {
+            dueTimes.push_back(time - start);
+            objects += due[i]->points.size();
+        }
+    }
+
+    /* 2 batches every second, half a period apart */
+    ASSERT_EQ(6, due.size());
+    ASSERT_EQ(360, objects);
+    ASSERT_EQ(61, due[0]->points.size());
+    ASSERT_EQ(59, due[1]->points.size());
+    ASSERT_EQ(100, dueTimes[0]);
+    ASSERT_EQ(600, dueTimes[1]);
+    ASSERT_EQ(1100, dueTimes[2]);
+    ASSERT_EQ(1600, dueTimes[3]);
+
+    for (IEC104DataPoint* dp : points) {
+        delete dp;
+    }
+}
+
+TEST(CyclicScheduler, LongPeriod)
+{
+    IEC104DataPoint dp("TM", 45, 1, IEC60870_TYPE_SHORT, false, 1);
+    dp.m_cyclicPeriod = 60000; /* longer than one turn of the wheel */
+
+    std::map<int, std::map<int, IEC104DataPoint*>> definitions;
+    definitions[45][1] = &dp;
+
+    IEC104CyclicScheduler scheduler;
+
+    scheduler.configure(definitions, 253, 2, 3);
+
+    std::vector<const IEC104CyclicScheduler::Batch*> due;
+    std::vector<uint64_t> dueTimes;
+
+    uint64_t start = 1000000;
+
+    for (uint64_t time = start; time <= start + 130000; time += IEC104CyclicScheduler::TICK) {
+        size_t before = due.size();
+
+        scheduler.advance(time, due);
+
+        if (due.size() > before) {
+            dueTimes.push_back(time - start);
+        }
+    }
+
+    ASSERT_EQ(3, dueTimes.size());
+    ASSERT_EQ(100, dueTimes[0]);
+    ASSERT_EQ(60100, dueTimes[1]);
+    ASSERT_EQ(120100, dueTimes[2]);
+}
+
+TEST_F(CyclicTransmissionTest, PeriodicTransmission)
+{
+    startAndConnect();
+
+    Thread_sleep(2500);
+
+    /* one ASDU per CA and type every second, nothing for the points without cycle */
+    ASSERT_GE(countAsdu(45, M_ME_NC_1, CS101_COT_PERIODIC), 2);
+    ASSERT_LE(countAsdu(45, M_ME_NC_1, CS101_COT_PERIODIC), 3);
+    ASSERT_GE(countAsdu(46, M_ME_NB_1, CS101_COT_PERIODIC), 2);
+    ASSERT_EQ(0, countAsdu(45, M_SP_NA_1, CS101_COT_PERIODIC));
+
+    for (CS101_ASDU asdu : receivedAsdu) {
+        if ((CS101_ASDU_getCA(asdu) == 45) && (CS101_ASDU_getCOT(asdu) == CS101_COT_PERIODIC)) {
+            ASSERT_EQ(2, CS101_ASDU_getNumberOfElements(asdu));
+        }
+    }
+}
@@ -435,7 +435,7 @@ struct sASDU_testInfo
 static bool test1_ASDUReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
 {   
     IEC60870_5_TypeID typeId = CS101_ASDU_getTypeID(asdu);
-    printf("ASDU received - type: %s (%i) CA: %i COT: %i\n", IEC104DataPoint::getStringFromTypeID(typeId).c_str(),
+    printf("ASDU received - type: %s (%i) CA: %i COT: %i\n", IEC104DataPoint::getStringFromTypeID(typeId),
             static_cast<int>(typeId), CS101_ASDU_getCA(asdu), CS101_ASDU_getCOT(asdu));
 
     InterrogationHandlerTest* self = (InterrogationHandlerTest*)parameter;
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "iec104_latency.hpp"
+#include "iec104_datapoint.hpp"
+
+using namespace std;
+
+TEST(LatencyTest, BucketBoundaries)
+{
+    // Small values are exact
+    for (uint64_t value = 0; value < IEC104LatencyHistogram::SUB_BUCKET_COUNT; value++) {
+        ASSERT_EQ(value, IEC104LatencyHistogram::bucketUpperBound(IEC104LatencyHistogram::bucketIndex(value)));
+    }
+
+    // Every value lies in its bucket, with a bounded relative error
+    for (uint64_t value = 32; value < 10000000000ULL; value = value * 3 / 2 + 7) {
+        int index = IEC104LatencyHistogram::bucketIndex(value);
+        ASSERT_LT(index, IEC104LatencyHistogram::BUCKET_COUNT);
+
+        uint64_t upperBound = IEC104LatencyHistogram::bucketUpperBound(index);
+        ASSERT_GE(upperBound, value);
+        ASSERT_LE(upperBound - value, value / IEC104LatencyHistogram::SUB_BUCKET_COUNT);
+
+        if (index > 0) {
+            ASSERT_LT(IEC104LatencyHistogram::bucketUpperBound(index - 1), value);
+        }
+    }
+
+    ASSERT_EQ(IEC104LatencyHistogram::BUCKET_COUNT - 1, IEC104LatencyHistogram::bucketIndex(UINT64_MAX));
+}
+
+TEST(LatencyTest, Percentiles)
+{
+    IEC104LatencyHistogram histogram;
+
+    ASSERT_EQ(0, histogram.percentile(99.0));
+
+    for (uint64_t value = 1; value <= 1000; value++) {
+        histogram.record(value * 1000);
+    }
+
+    ASSERT_EQ(1000, histogram.Count());
+    ASSERT_EQ(1000000, histogram.Max());
+
+    uint64_t p50 = histogram.percentile(50.0);
+    ASSERT_GE(p50, 500000);
+    ASSERT_LE(p50, 500000 + 500000 / 32);
+
+    uint64_t p99 = histogram.percentile(99.0);
+    ASSERT_GE(p99, 990000);
+    ASSERT_LE(p99, 1000000);
+
+    ASSERT_EQ(1000000, histogram.percentile(100.0));
+
+    histogram.reset();
+    ASSERT_EQ(0, histogram.Count());
+    ASSERT_EQ(0, histogram.Max());
+}
+
+TEST(LatencyTest, ConcurrentRecords)
+{
+    IEC104LatencyHistogram histogram;
+    vector<thread> threads;
+
+    for (int t = 0; t < 4; t++) {
+        threads.push_back(thread([&histogram, t]() {
+            for (int i = 0; i < 10000; i++) {
+                histogram.record(static_cast<uint64_t>(t + 1) * 1000);
+            }
+        }));
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    ASSERT_EQ(40000, histogram.Count());
+    ASSERT_EQ(4000, histogram.Max());
+    ASSERT_EQ(100000000, histogram.Sum());
+}
+
+TEST(LatencyTest, Tracer)
+{
+    IEC104LatencyTracer tracer;
+
+    ASSERT_FALSE(tracer.isEnabled());
+    tracer.setEnabled(true);
+    ASSERT_TRUE(tracer.isEnabled());
+
+    tracer.record(IEC104LatencyTracer::INGEST_TO_ENQUEUE, M_SP_TB_1, 2000);
+    tracer.record(IEC104LatencyTracer::INGEST_TO_ENQUEUE, M_ME_NC_1, 4000);
+    tracer.record(IEC104LatencyTracer::INGEST_TO_WIRE, M_ME_NC_1, 8000);
+
+    ASSERT_EQ(2, tracer.Histogram(IEC104LatencyTracer::INGEST_TO_ENQUEUE).Count());
+    ASSERT_EQ(1, tracer.Histogram(IEC104LatencyTracer::INGEST_TO_ENQUEUE, M_SP_TB_1)->Count());
+    ASSERT_EQ(nullptr, tracer.Histogram(IEC104LatencyTracer::ENQUEUE_TO_WIRE, M_SP_TB_1));
+
+    string json = tracer.toJson();
+    ASSERT_NE(string::npos, json.find("\"ingest_to_enqueue\":{\"count\":2"));
+    ASSERT_NE(string::npos, json.find("\"M_SP_TB_1\":{\"count\":1,\"p50\":2"));
+    ASSERT_NE(string::npos, json.find("\"ingest_to_wire\":{\"count\":1,\"p50\":8"));
+
+    tracer.reset();
+    ASSERT_EQ(0, tracer.Histogram(IEC104LatencyTracer::INGEST_TO_ENQUEUE).Count());
+    ASSERT_EQ(string::npos, tracer.toJson().find("M_SP_TB_1"));
+}
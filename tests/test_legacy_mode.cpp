@@ -269,7 +269,7 @@ LegacyModeTest::m_asduReceivedHandler(void* parameter, int address, CS101_ASDU a
     self->asduHandlerCalled++;
 
     int typeId = CS101_ASDU_getTypeID(asdu);
-    printf("CS101_ASDU: type: %s (%i) ca: %i cot: %i\n", IEC104DataPoint::getStringFromTypeID(typeId).c_str(), typeId,
+    printf("CS101_ASDU: type: %s (%i) ca: %i cot: %i\n", IEC104DataPoint::getStringFromTypeID(typeId), typeId,
             CS101_ASDU_getCA(asdu), CS101_ASDU_getCOT(asdu));
     
     self->actConNegative = false;
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "iec104_log_limiter.hpp"
+
+using namespace std;
+
+TEST(LogLimiter, FirstOccurrenceOnly)
+{
+    Iec104Utility::LogLimiter limiter(10000, 10, 1000);
+
+    int site1 = limiter.addSite("test -", "site 1");
+    int site2 = limiter.addSite("test -", "site 2");
+
+    ASSERT_TRUE(limiter.accept(site1, 41025, 4202832));
+    ASSERT_FALSE(limiter.accept(site1, 41025, 4202832));
+    ASSERT_FALSE(limiter.accept(site1, 41025, 4202832));
+
+    /* other point and same point on another site are new keys */
+    ASSERT_TRUE(limiter.accept(site1, 41025, 4202833));
+    ASSERT_TRUE(limiter.accept(site2, 41025, 4202832));
+
+    ASSERT_EQ(2, limiter.Suppressed(site1));
+    ASSERT_EQ(0, limiter.Suppressed(site2));
+
+    limiter.summarize(1000); /* start of the first period */
+    limiter.summarize(5000);
+    ASSERT_EQ(2, limiter.Suppressed(site1));
+
+    limiter.summarize(11000);
+    ASSERT_EQ(0, limiter.Suppressed(site1));
+
+    /* the first occurrence is not logged again after the summary */
+    ASSERT_FALSE(limiter.accept(site1, 41025, 4202832));
+    ASSERT_EQ(1, limiter.Suppressed(site1));
+}
+
+TEST(LogLimiter, FirstOccurrencesPerPeriod)
+{
+    Iec104Utility::LogLimiter limiter(10000, 3, 1000);
+
+    int site = limiter.addSite("test -", "site");
+
+    limiter.summarize(1000);
+
+    int logged = 0;
+
+    for (int ioa = 1; ioa <= 100; ioa++) {
+        if (limiter.accept(site, 1, ioa)) {
+            logged++;
+        }
+    }
+
+    ASSERT_EQ(3, logged);
+    ASSERT_EQ(97, limiter.Suppressed(site));
+
+    limiter.summarize(11000);
+
+    /* the points not logged yet get their first occurrence logged in the next periods */
+    ASSERT_TRUE(limiter.accept(site, 1, 50));
+    ASSERT_FALSE(limiter.accept(site, 1, 1));
+}
+
+TEST(LogLimiter, MaxKeys)
+{
+    Iec104Utility::LogLimiter limiter(10000, 1000, 10);
+
+    int site = limiter.addSite("test -", "site");
+
+    for (int ioa = 1; ioa <= 10; ioa++) {
+        ASSERT_TRUE(limiter.accept(site, 1, ioa));
+    }
+
+    /* key table full: only counted */
+    ASSERT_FALSE(limiter.accept(site, 1, 11));
+    ASSERT_FALSE(limiter.accept(site, 1, 12));
+    ASSERT_EQ(2, limiter.Suppressed(site));
+}
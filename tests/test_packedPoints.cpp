@@ -0,0 +1,524 @@
+#include <gtest/gtest.h>
+
+#include <reading.h>
+
+#include <lib60870/hal_thread.h>
+#include <lib60870/hal_time.h>
+
+#include "iec104.h"
+#include "iec104_config.hpp"
+#include "iec104_datapoint.hpp"
+#include "iec104_point_store.hpp"
+#include "cs104_connection.h"
+
+using namespace std;
+
+static string protocol_stack = QUOTE({
+        "protocol_stack" : {
+            "name" : "iec104server",
+            "version" : "1.0",
+            "transport_layer" : {
+                "bind_on_ip":false,
+                "srv_ip":"0.0.0.0",
+                "port":2404,
+                "tls":false,
+                "k_value":12,
+                "w_value":8,
+                "t0_timeout":10,
+                "t1_timeout":15,
+                "t2_timeout":10,
+                "t3_timeout":20
+            },
+            "application_layer" : {
+                "ca_asdu_size":2,
+                "ioaddr_size":3,
+                "asdu_size":0,
+                "time_sync":false,
+                "cmd_exec_timeout":5,
+                "cmd_recv_timeout":1,
+                "accept_cmd_with_time":2
+            }
+        }
+    });
+
+static string tls = QUOTE({
+        "tls_conf:" : {
+            "private_key" : "server-key.pem",
+            "server_cert" : "server.cer",
+            "ca_cert" : "root.cer"
+        }
+    });
+
+static string exchanged_data = QUOTE({
+        "exchanged_data" : {
+            "name" : "iec104client",
+            "version" : "1.0",
+            "datapoints":[
+                {
+                    "label":"PS1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-1000",
+                          "typeid":"M_PS_NA_1"
+                       }
+                    ]
+                },
+                {
+                    "label":"BO1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-2000",
+                          "typeid":"M_BO_NA_1"
+                       }
+                    ]
+                },
+                {
+                    "label":"TS1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-672",
+                          "typeid":"M_SP_NA_1",
+                          "pack_address":"45-1000",
+                          "pack_bit":0
+                       }
+                    ]
+                },
+                {
+                    "label":"TS2",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-673",
+                          "typeid":"M_SP_TB_1",
+                          "pack_address":"45-1000",
+                          "pack_bit":15
+                       }
+                    ]
+                },
+                {
+                    "label":"TS3",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-674",
+                          "typeid":"M_SP_NA_1",
+                          "pack_address":"45-2000",
+                          "pack_bit":31
+                       }
+                    ]
+                },
+                {
+                    "label":"TS4",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-675",
+                          "typeid":"M_SP_NA_1",
+                          "pack_address":"45-1000",
+                          "pack_bit":16
+                       }
+                    ]
+                },
+                {
+                    "label":"TS5",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-676",
+                          "typeid":"M_SP_NA_1",
+                          "pack_address":"45-1000",
+                          "pack_bit":0
+                       }
+                    ]
+                },
+                {
+                    "label":"TS6",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-677",
+                          "typeid":"M_SP_NA_1",
+                          "pack_address":"45-3000",
+                          "pack_bit":1
+                       }
+                    ]
+                },
+                {
+                    "label":"TM1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-984",
+                          "typeid":"M_ME_NC_1",
+                          "pack_address":"45-1000",
+                          "pack_bit":2
+                       }
+                    ]
+                }
+            ]
+        }
+    });
+
+class PackedPointsTest : public testing::Test
+{
+protected:
+    IEC104Server* iec104Server;  // Object on which we call for tests
+    CS104_Connection connection;
+
+    vector<CS101_ASDU> receivedAsdu;
+
+    // Setup is ran for every tests, so each variable are reinitialised
+    void SetUp() override
+    {
+        // Init iec104server object
+        iec104Server = new IEC104Server();
+        const char* ip = "127.0.0.1";
+        uint16_t port = IEC_60870_5_104_DEFAULT_PORT;
+        // Create connection
+        connection = CS104_Connection_create(ip, port);
+        ASSERT_NE(connection, nullptr);
+    }
+
+    // TearDown is ran for every tests, so each variable are destroyed again
+    void TearDown() override
+    {
+        CS104_Connection_destroy(connection);
+
+        for (CS101_ASDU asdu : receivedAsdu)
+        {
+            CS101_ASDU_destroy(asdu);
+        }
+
+        receivedAsdu.clear();
+
+        iec104Server->stop();
+
+        delete iec104Server;
+    }
+
+    static bool asduReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
+    {
+        PackedPointsTest* self = (PackedPointsTest*)parameter;
+
+        self->receivedAsdu.push_back(CS101_ASDU_clone(asdu, NULL));
+
+        return true;
+    }
+
+    CS101_ASDU findAsdu(int typeId)
+    {
+        for (CS101_ASDU asdu : receivedAsdu) {
+            if (CS101_ASDU_getTypeID(asdu) == typeId) {
+                return asdu;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void startAndConnect()
+    {
+        iec104Server->setJsonConfig(protocol_stack, exchanged_data, tls);
+        ASSERT_TRUE(iec104Server->startSlave());
+
+        Thread_sleep(500); /* wait for the server to start */
+
+        CS104_Connection_setASDUReceivedHandler(connection, asduReceivedHandler, this);
+
+        ASSERT_TRUE(CS104_Connection_connect(connection));
+
+        CS104_Connection_sendStartDT(connection);
+
+        Thread_sleep(200);
+    }
+
+    void sendSinglePoints(const vector<pair<int, int64_t>>& values)
+    {
+        vector<Datapoint*> dataobjects;
+
+        for (const pair<int, int64_t>& value : values) {
+            dataobjects.push_back(createDataObject(45, value.first, value.second));
+        }
+
+        Reading* reading = new Reading(std::string("TS"), dataobjects);
+
+        vector<Reading*> readings;
+
+        readings.push_back(reading);
+
+        iec104Server->send(readings);
+
+        delete reading;
+    }
+
+    template <class T>
+    static Datapoint* createDatapoint(const std::string& dataname, const T value)
+    {
+        DatapointValue dp_value = DatapointValue(value);
+        return new Datapoint(dataname, dp_value);
+    }
+
+    static Datapoint* createDataObject(int ca, int ioa, int64_t value)
+    {
+        auto* datapoints = new vector<Datapoint*>;
+
+        datapoints->push_back(createDatapoint("do_type", (ioa == 673) ? "M_SP_TB_1" : "M_SP_NA_1"));
+        datapoints->push_back(createDatapoint("do_ca", (int64_t)ca));
+        datapoints->push_back(createDatapoint("do_oa", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_cot", (int64_t)CS101_COT_SPONTANEOUS));
+        datapoints->push_back(createDatapoint("do_test", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_negative", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_ioa", (int64_t)ioa));
+        datapoints->push_back(createDatapoint("do_value", value));
+        datapoints->push_back(createDatapoint("do_quality_iv", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_quality_bl", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_quality_ov", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_quality_sb", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_quality_nt", (int64_t)0));
+
+        if (ioa == 673) {
+            datapoints->push_back(createDatapoint("do_ts", (long)Hal_getTimeInMs()));
+        }
+
+        DatapointValue dpv(datapoints, true);
+
+        return new Datapoint("data_object", dpv);
+    }
+};
+
+TEST(PackedPoints, PackedBits)
+{
+    IEC104DataPoint pack("PS1", 45, 1000, IEC60870_TYPE_PACKED_SP, false, 1);
+    IEC104DataPoint sp1("TS1", 45, 672, IEC60870_TYPE_SP, false, 1);
+    IEC104DataPoint sp2("TS2", 45, 673, IEC60870_TYPE_SP, false, 1);
+    IEC104DataPoint sp3("TS3", 45, 674, IEC60870_TYPE_SP, false, 1);
+    IEC104DataPoint bitstring("BO1", 45, 2000, IEC60870_TYPE_BITSTRING, false, 1);
+
+    ASSERT_EQ(16, IEC104DataPoint::packedBitCount(IEC60870_TYPE_PACKED_SP));
+    ASSERT_EQ(32, IEC104DataPoint::packedBitCount(IEC60870_TYPE_BITSTRING));
+    ASSERT_EQ(0, IEC104DataPoint::packedBitCount(IEC60870_TYPE_SP));
+    ASSERT_EQ(M_PS_NA_1, pack.packedTypeId());
+
+    /* no member yet */
+    ASSERT_EQ(IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL, pack.packedQuality());
+
+    ASSERT_TRUE(pack.addPackMember(&sp1, 0));
+    ASSERT_TRUE(pack.addPackMember(&sp2, 15));
+    ASSERT_FALSE(pack.addPackMember(&sp3, 16));
+    ASSERT_FALSE(pack.addPackMember(&sp3, 0));
+    ASSERT_FALSE(pack.addPackMember(&sp3, -1));
+
+    ASSERT_EQ(&pack, sp1.m_pack);
+    ASSERT_EQ(15, sp2.m_packBit);
+    ASSERT_EQ(nullptr, sp3.m_pack);
+
+    map<int, map<int, IEC104DataPoint*>> definitions;
+
+    definitions[45][1000] = &pack;
+    definitions[45][672] = &sp1;
+    definitions[45][673] = &sp2;
+    definitions[45][674] = &sp3;
+    definitions[45][2000] = &bitstring;
+
+    IEC104PointStore store;
+    store.build(definitions);
+
+    /* members not received yet */
+    ASSERT_EQ(IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL, pack.packedQuality());
+
+    sp1.m_value->sp.quality = IEC60870_QUALITY_GOOD;
+    sp2.m_value->sp.quality = IEC60870_QUALITY_BLOCKED;
+
+    ASSERT_EQ(IEC60870_QUALITY_BLOCKED, pack.packedQuality());
+
+    pack.updatePackedBit(15, true);
+    pack.updatePackedBit(0, false);
+
+    ASSERT_EQ(0x8000, pack.m_value->packed_sp.st);
+    ASSERT_EQ(0x8000, pack.m_value->packed_sp.cd);
+
+    struct sStatusAndStatusChangeDetection scd;
+
+    pack.encodeStatusAndChangeDetection(&scd);
+
+    ASSERT_EQ(0x00, scd.encodedValue[0]);
+    ASSERT_EQ(0x80, scd.encodedValue[1]);
+    ASSERT_EQ(0x00, scd.encodedValue[2]);
+    ASSERT_EQ(0x80, scd.encodedValue[3]);
+
+    /* the change detection is kept until the packed object is transmitted */
+    pack.updatePackedBit(15, true);
+    pack.updatePackedBit(0, true);
+
+    ASSERT_EQ(0x8001, pack.m_value->packed_sp.st);
+    ASSERT_EQ(0x8001, pack.m_value->packed_sp.cd);
+
+    ASSERT_EQ(M_BO_NA_1, bitstring.packedTypeId());
+    ASSERT_TRUE(bitstring.addPackMember(&sp3, 31));
+
+    bitstring.updatePackedBit(31, true);
+    ASSERT_EQ(0x80000000u, bitstring.m_value->bitstring.value);
+
+    bitstring.updatePackedBit(31, false);
+    ASSERT_EQ(0u, bitstring.m_value->bitstring.value);
+}
+
+TEST(PackedPoints, ImportConfig)
+{
+    IEC104Config config;
+
+    config.importExchangeConfig(exchanged_data);
+
+    auto& definitions = *config.getExchangeDefinitions();
+
+    IEC104DataPoint* ps = definitions.at(45).at(1000);
+    IEC104DataPoint* bo = definitions.at(45).at(2000);
+
+    ASSERT_NE(nullptr, ps);
+    ASSERT_NE(nullptr, bo);
+    ASSERT_EQ(IEC60870_TYPE_PACKED_SP, ps->m_type);
+    ASSERT_EQ(IEC60870_TYPE_BITSTRING, bo->m_type);
+
+    ASSERT_EQ(ps, definitions.at(45).at(672)->m_pack);
+    ASSERT_EQ(ps, definitions.at(45).at(673)->m_pack);
+    ASSERT_EQ(bo, definitions.at(45).at(674)->m_pack);
+    ASSERT_EQ(2, ps->m_packMembers.size());
+    ASSERT_EQ(1, bo->m_packMembers.size());
+
+    /* bit out of range, bit already used, unknown packed object, not a single point */
+    ASSERT_EQ(nullptr, definitions.at(45).at(675)->m_pack);
+    ASSERT_EQ(nullptr, definitions.at(45).at(676)->m_pack);
+    ASSERT_EQ(nullptr, definitions.at(45).at(677)->m_pack);
+    ASSERT_EQ(nullptr, definitions.at(45).at(984)->m_pack);
+}
+
+TEST_F(PackedPointsTest, SpontaneousPackedObjects)
+{
+    startAndConnect();
+
+    /* all the updates of a send() call are reported in one packed object */
+    sendSinglePoints({{672, 1}, {673, 1}, {674, 1}, {675, 1}});
+
+    Thread_sleep(500);
+
+    /* M_PS_NA_1 + M_BO_NA_1 + TS4 transmitted individually */
+    ASSERT_EQ(3, receivedAsdu.size());
+
+    CS101_ASDU asdu = findAsdu(M_PS_NA_1);
+    ASSERT_NE(nullptr, asdu);
+    ASSERT_EQ(CS101_COT_SPONTANEOUS, CS101_ASDU_getCOT(asdu));
+    ASSERT_EQ(1, CS101_ASDU_getNumberOfElements(asdu));
+
+    InformationObject io = CS101_ASDU_getElement(asdu, 0);
+    ASSERT_EQ(1000, InformationObject_getObjectAddress(io));
+
+    StatusAndStatusChangeDetection scd = PackedSinglePointWithSCD_getSCD((PackedSinglePointWithSCD)io);
+    ASSERT_EQ(0x8001, StatusAndStatusChangeDetection_getSTn(scd));
+    ASSERT_EQ(0x8001, StatusAndStatusChangeDetection_getCDn(scd));
+    ASSERT_EQ(IEC60870_QUALITY_GOOD, PackedSinglePointWithSCD_getQuality((PackedSinglePointWithSCD)io));
+
+    InformationObject_destroy(io);
+
+    asdu = findAsdu(M_BO_NA_1);
+    ASSERT_NE(nullptr, asdu);
+
+    io = CS101_ASDU_getElement(asdu, 0);
+    ASSERT_EQ(2000, InformationObject_getObjectAddress(io));
+    ASSERT_EQ(0x80000000u, BitString32_getValue((BitString32)io));
+    ASSERT_EQ(IEC60870_QUALITY_GOOD, BitString32_getQuality((BitString32)io));
+
+    InformationObject_destroy(io);
+
+    asdu = findAsdu(M_SP_NA_1);
+    ASSERT_NE(nullptr, asdu);
+
+    io = CS101_ASDU_getElement(asdu, 0);
+    ASSERT_EQ(675, InformationObject_getObjectAddress(io));
+
+    InformationObject_destroy(io);
+
+    for (CS101_ASDU received : receivedAsdu) {
+        CS101_ASDU_destroy(received);
+    }
+
+    receivedAsdu.clear();
+
+    /* only TS1 changes, the change detection was reset by the previous transmission */
+    sendSinglePoints({{672, 0}, {673, 1}});
+
+    Thread_sleep(500);
+
+    ASSERT_EQ(1, receivedAsdu.size());
+
+    asdu = findAsdu(M_PS_NA_1);
+    ASSERT_NE(nullptr, asdu);
+
+    io = CS101_ASDU_getElement(asdu, 0);
+
+    scd = PackedSinglePointWithSCD_getSCD((PackedSinglePointWithSCD)io);
+    ASSERT_EQ(0x8000, StatusAndStatusChangeDetection_getSTn(scd));
+    ASSERT_EQ(0x0001, StatusAndStatusChangeDetection_getCDn(scd));
+
+    InformationObject_destroy(io);
+}
+
+TEST_F(PackedPointsTest, InterrogationPackedObjects)
+{
+    startAndConnect();
+
+    sendSinglePoints({{672, 1}, {674, 1}});
+
+    Thread_sleep(500);
+
+    for (CS101_ASDU received : receivedAsdu) {
+        CS101_ASDU_destroy(received);
+    }
+
+    receivedAsdu.clear();
+
+    ASSERT_TRUE(CS104_Connection_sendInterrogationCommand(connection, CS101_COT_ACTIVATION, 45, IEC60870_QOI_STATION));
+
+    Thread_sleep(500);
+
+    int packedObjects = 0;
+
+    for (CS101_ASDU asdu : receivedAsdu) {
+        if (CS101_ASDU_getCOT(asdu) != CS101_COT_INTERROGATED_BY_STATION) {
+            continue;
+        }
+
+        for (int i = 0; i < CS101_ASDU_getNumberOfElements(asdu); i++) {
+            InformationObject io = CS101_ASDU_getElement(asdu, i);
+            int ioa = InformationObject_getObjectAddress(io);
+
+            /* the members are only reported in their packed object */
+            ASSERT_NE(672, ioa);
+            ASSERT_NE(673, ioa);
+            ASSERT_NE(674, ioa);
+
+            if (ioa == 1000) {
+                ASSERT_EQ(M_PS_NA_1, CS101_ASDU_getTypeID(asdu));
+
+                StatusAndStatusChangeDetection scd = PackedSinglePointWithSCD_getSCD((PackedSinglePointWithSCD)io);
+                ASSERT_EQ(0x0001, StatusAndStatusChangeDetection_getSTn(scd));
+                ASSERT_EQ(0x0000, StatusAndStatusChangeDetection_getCDn(scd));
+
+                /* TS2 was never received */
+                ASSERT_TRUE((PackedSinglePointWithSCD_getQuality((PackedSinglePointWithSCD)io) & IEC60870_QUALITY_INVALID) != 0);
+                packedObjects++;
+            }
+            else if (ioa == 2000) {
+                ASSERT_EQ(M_BO_NA_1, CS101_ASDU_getTypeID(asdu));
+                ASSERT_EQ(0x80000000u, BitString32_getValue((BitString32)io));
+                packedObjects++;
+            }
+
+            InformationObject_destroy(io);
+        }
+    }
+
+    ASSERT_EQ(2, packedObjects);
+}
@@ -0,0 +1,405 @@
+#include <gtest/gtest.h>
+
+#include <reading.h>
+
+#include <lib60870/hal_thread.h>
+#include <lib60870/hal_time.h>
+
+#include "iec104.h"
+#include "iec104_config.hpp"
+#include "iec104_datapoint.hpp"
+#include "iec104_spsc_ring.hpp"
+#include "iec104_worker_pool.hpp"
+#include "cs104_connection.h"
+
+using namespace std;
+
+// protocol stack of the tests, the decode workers and the encoder queue size are set per test
+static string
+pipelineProtocolStack(int decodeWorkers, int encoderQueueSize)
+{
+    return string("{\"protocol_stack\":{\"name\":\"iec104server\",\"version\":\"1.0\",") +
+           "\"transport_layer\":{\"bind_on_ip\":false,\"srv_ip\":\"0.0.0.0\",\"port\":2404,\"tls\":false," +
+           "\"k_value\":12,\"w_value\":8,\"t0_timeout\":10,\"t1_timeout\":15,\"t2_timeout\":10,\"t3_timeout\":20}," +
+           "\"application_layer\":{\"ca_asdu_size\":2,\"ioaddr_size\":3,\"asdu_size\":0,\"time_sync\":false," +
+           "\"cmd_exec_timeout\":5,\"cmd_recv_timeout\":1,\"accept_cmd_with_time\":2,\"asdu_queue_size\":2000," +
+           "\"decode_workers\":" + to_string(decodeWorkers) + ",\"encoder_queue_size\":" + to_string(encoderQueueSize) + "}}}";
+}
+
+static string tls = QUOTE({
+        "tls_conf:" : {
+            "private_key" : "server-key.pem",
+            "server_cert" : "server.cer",
+            "ca_cert" : "root.cer"
+        }
+    });
+
+static string exchanged_data = QUOTE({
+        "exchanged_data" : {
+            "name" : "iec104client",
+            "version" : "1.0",
+            "datapoints":[
+                {
+                    "label":"TM1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-984",
+                          "typeid":"M_ME_NB_1"
+                       }
+                    ]
+                },
+                {
+                    "label":"TM2",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-985",
+                          "typeid":"M_ME_NB_1"
+                       }
+                    ]
+                },
+                {
+                    "label":"TM3",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"46-986",
+                          "typeid":"M_ME_NB_1"
+                       }
+                    ]
+                }
+            ]
+        }
+    });
+
+class ParallelDecodeTest : public testing::Test
+{
+protected:
+    IEC104Server* iec104Server;  // Object on which we call for tests
+    CS104_Connection connection;
+
+    vector<CS101_ASDU> receivedAsdu;
+
+    // Setup is ran for every tests, so each variable are reinitialised
+    void SetUp() override
+    {
+        // Init iec104server object
+        iec104Server = new IEC104Server();
+        const char* ip = "127.0.0.1";
+        uint16_t port = IEC_60870_5_104_DEFAULT_PORT;
+        // Create connection
+        connection = CS104_Connection_create(ip, port);
+        ASSERT_NE(connection, nullptr);
+    }
+
+    // TearDown is ran for every tests, so each variable are destroyed again
+    void TearDown() override
+    {
+        CS104_Connection_destroy(connection);
+
+        for (CS101_ASDU asdu : receivedAsdu)
+        {
+            CS101_ASDU_destroy(asdu);
+        }
+
+        iec104Server->stop();
+
+        delete iec104Server;
+    }
+
+    static bool asduReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
+    {
+        ParallelDecodeTest* self = (ParallelDecodeTest*)parameter;
+
+        self->receivedAsdu.push_back(CS101_ASDU_clone(asdu, NULL));
+
+        return true;
+    }
+
+    void startAndConnect(int decodeWorkers, int encoderQueueSize)
+    {
+        iec104Server->setJsonConfig(pipelineProtocolStack(decodeWorkers, encoderQueueSize), exchanged_data, tls);
+        ASSERT_TRUE(iec104Server->startSlave());
+
+        Thread_sleep(500); /* wait for the server to start */
+
+        CS104_Connection_setASDUReceivedHandler(connection, asduReceivedHandler, this);
+
+        ASSERT_TRUE(CS104_Connection_connect(connection));
+
+        CS104_Connection_sendStartDT(connection);
+
+        Thread_sleep(200);
+    }
+
+    /* the readings that are not accepted are sent again, as done by the north service */
+    size_t sendAll(const vector<Reading*>& readings)
+    {
+        size_t sent = 0;
+        int calls = 0;
+
+        while ((sent < readings.size()) && (calls < 10000)) {
+            vector<Reading*> remaining(readings.begin() + sent, readings.end());
+
+            uint32_t accepted = iec104Server->send(remaining);
+
+            EXPECT_LE(accepted, remaining.size());
+
+            sent += accepted;
+            calls++;
+
+            if (sent < readings.size()) {
+                Thread_sleep(1);
+            }
+        }
+
+        return sent;
+    }
+
+    /* values received for each IOA, in the order of reception */
+    std::map<int, std::vector<int>> receivedValues()
+    {
+        std::map<int, std::vector<int>> values;
+
+        for (CS101_ASDU asdu : receivedAsdu) {
+            if (CS101_ASDU_getTypeID(asdu) != M_ME_NB_1) {
+                continue;
+            }
+
+            for (int i = 0; i < CS101_ASDU_getNumberOfElements(asdu); i++) {
+                InformationObject io = CS101_ASDU_getElement(asdu, i);
+
+                values[InformationObject_getObjectAddress(io)].push_back(MeasuredValueScaled_getValue((MeasuredValueScaled)io));
+
+                InformationObject_destroy(io);
+            }
+        }
+
+        return values;
+    }
+
+    void checkOrderPreserved(int events)
+    {
+        std::map<int, std::vector<int>> values = receivedValues();
+
+        ASSERT_EQ(3, values.size());
+
+        for (const auto& pointValues : values) {
+            ASSERT_EQ(events, pointValues.second.size());
+
+            for (int i = 0; i < events; i++) {
+                ASSERT_EQ(i + 1, pointValues.second[i]);
+            }
+        }
+    }
+};
+
+static const int addresses[3][2] = {{45, 984}, {45, 985}, {46, 986}};
+
+template <class T>
+static Datapoint* createDatapoint(const std::string& dataname,
+                                    const T value)
+{
+    DatapointValue dp_value = DatapointValue(value);
+    return new Datapoint(dataname, dp_value);
+}
+
+static Datapoint* createDataObject(const char* type, int ca, int ioa, int cot, int64_t value)
+{
+    auto* datapoints = new vector<Datapoint*>;
+
+    datapoints->push_back(createDatapoint("do_type", type));
+    datapoints->push_back(createDatapoint("do_ca", (int64_t)ca));
+    datapoints->push_back(createDatapoint("do_oa", (int64_t)0));
+    datapoints->push_back(createDatapoint("do_cot", (int64_t)cot));
+    datapoints->push_back(createDatapoint("do_test", (int64_t)0));
+    datapoints->push_back(createDatapoint("do_negative", (int64_t)0));
+    datapoints->push_back(createDatapoint("do_ioa", (int64_t)ioa));
+    datapoints->push_back(createDatapoint("do_value", value));
+    datapoints->push_back(createDatapoint("do_quality_iv", (int64_t)0));
+    datapoints->push_back(createDatapoint("do_quality_bl", (int64_t)0));
+    datapoints->push_back(createDatapoint("do_quality_ov", (int64_t)0));
+    datapoints->push_back(createDatapoint("do_quality_sb", (int64_t)0));
+    datapoints->push_back(createDatapoint("do_quality_nt", (int64_t)0));
+
+    DatapointValue dpv(datapoints, true);
+
+    return new Datapoint("data_object", dpv);
+}
+
+TEST(WorkerPool, ProcessesWholeRange)
+{
+    for (int workers = 1; workers <= 8; workers++) {
+        IEC104WorkerPool pool(workers);
+
+        ASSERT_EQ(workers, pool.Workers());
+
+        for (size_t count : {0, 1, 7, 1000}) {
+            std::vector<int> processed(count, 0);
+
+            pool.run(count, [&processed](size_t first, size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    processed[i]++;
+                }
+            });
+
+            for (int p : processed) {
+                ASSERT_EQ(1, p);
+            }
+        }
+    }
+}
+
+TEST(SpscRing, FifoAndCapacity)
+{
+    IEC104SpscRing<int> ring(5);
+
+    /* rounded up to a power of two */
+    ASSERT_EQ(8, ring.Capacity());
+    ASSERT_TRUE(ring.isEmpty());
+    ASSERT_EQ(8, ring.FreeSpace());
+
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(ring.push(int(i)));
+    }
+
+    /* full: backpressure to the producer */
+    ASSERT_FALSE(ring.push(8));
+    ASSERT_EQ(0, ring.FreeSpace());
+
+    int item = -1;
+
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(ring.pop(item));
+        ASSERT_EQ(i, item);
+    }
+
+    ASSERT_FALSE(ring.pop(item));
+    ASSERT_TRUE(ring.isEmpty());
+}
+
+TEST(SpscRing, ProducerConsumerThreads)
+{
+    IEC104SpscRing<std::unique_ptr<int>> ring(64);
+
+    const int items = 20000;
+
+    std::thread consumer([&ring, items] {
+        std::unique_ptr<int> item;
+
+        for (int expected = 0; expected < items; ) {
+            if (ring.pop(item)) {
+                ASSERT_EQ(expected, *item);
+                expected++;
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (int i = 0; i < items; i++) {
+        std::unique_ptr<int> item(new int(i));
+
+        while (!ring.push(std::move(item))) {
+            std::this_thread::yield();
+        }
+    }
+
+    consumer.join();
+
+    ASSERT_TRUE(ring.isEmpty());
+}
+
+TEST_F(ParallelDecodeTest, OrderPreservedPerPoint)
+{
+    startAndConnect(4, 0);
+
+    /* 3 x 200 events in one block: decoded by the 4 workers */
+    const int events = 200;
+
+    vector<Datapoint*> dataobjects;
+
+    for (int value = 1; value <= events; value++) {
+        for (const auto& address : addresses) {
+            dataobjects.push_back(createDataObject("M_ME_NB_1", address[0], address[1], CS101_COT_SPONTANEOUS, (int64_t)value));
+        }
+    }
+
+    Reading* reading = new Reading(std::string("TM"), dataobjects);
+
+    vector<Reading*> readings;
+
+    readings.push_back(reading);
+
+    ASSERT_EQ(1, iec104Server->send(readings));
+
+    Thread_sleep(2000);
+
+    checkOrderPreserved(events);
+
+    delete reading;
+}
+
+TEST_F(ParallelDecodeTest, OrderPreservedWithBackpressure)
+{
+    startAndConnect(1, 8);
+
+    /* one data object per reading, far more than the 8 slots of the encoder queue */
+    const int events = 100;
+
+    vector<Reading*> readings;
+
+    for (int value = 1; value <= events; value++) {
+        for (const auto& address : addresses) {
+            vector<Datapoint*> dataobjects;
+            dataobjects.push_back(createDataObject("M_ME_NB_1", address[0], address[1], CS101_COT_SPONTANEOUS, (int64_t)value));
+
+            readings.push_back(new Reading(std::string("TM"), dataobjects));
+        }
+    }
+
+    ASSERT_EQ(readings.size(), sendAll(readings));
+
+    Thread_sleep(2000);
+
+    checkOrderPreserved(events);
+
+    for (Reading* reading : readings) {
+        delete reading;
+    }
+}
+
+TEST_F(ParallelDecodeTest, OrderPreservedWithWorkersAndEncoderQueue)
+{
+    startAndConnect(4, 8);
+
+    /* blocks of 3 x 20 events: decoded by the 4 workers, then larger than the encoder queue */
+    const int events = 200;
+    const int eventsPerReading = 20;
+
+    vector<Reading*> readings;
+
+    for (int first = 1; first <= events; first += eventsPerReading) {
+        vector<Datapoint*> dataobjects;
+
+        for (int value = first; value < first + eventsPerReading; value++) {
+            for (const auto& address : addresses) {
+                dataobjects.push_back(createDataObject("M_ME_NB_1", address[0], address[1], CS101_COT_SPONTANEOUS, (int64_t)value));
+            }
+        }
+
+        readings.push_back(new Reading(std::string("TM"), dataobjects));
+    }
+
+    ASSERT_EQ(readings.size(), sendAll(readings));
+
+    Thread_sleep(2000);
+
+    checkOrderPreserved(events);
+
+    for (Reading* reading : readings) {
+        delete reading;
+    }
+}
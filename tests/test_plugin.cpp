@@ -18,6 +18,7 @@ extern "C"
 		bool ( *write)(const char *name, const char *value, ControlDestination destination, ...),
 		int (* operation)(char *operation, int paramCount, char *names[], char *parameters[], ControlDestination destination, ...));
     void plugin_shutdown(PLUGIN_HANDLE handle);
+    void plugin_reconfigure(PLUGIN_HANDLE* handle, const string& newConfig);
     uint32_t plugin_send(const PLUGIN_HANDLE handle,
 		     const vector<Reading *>& readings);
     PLUGIN_INFORMATION *plugin_info();
@@ -144,4 +145,28 @@ TEST(PluginTest, PluginStop)
     ASSERT_NO_THROW(plugin_shutdown((PLUGIN_HANDLE *)handle)); 
 
     delete emptyConfig;
-}
\ No newline at end of file
+}
+
+TEST(PluginTest, PluginReconfigure)
+{
+    ConfigCategory *config = new ConfigCategory("Test_Config", default_config);
+    config->setItemsValueFromDefault();
+
+    PLUGIN_HANDLE handle = plugin_init(config);
+    ASSERT_NE(nullptr, handle);
+
+    IEC104Server* server = (IEC104Server*)handle;
+    shared_ptr<const IEC104PointTable> pointTable = server->Config()->getPointTable();
+
+    // exchanged_data can only be changed by restarting the service: the running configuration is kept
+    ConfigCategory newConfig("Test_Config", default_config);
+    newConfig.setItemsValueFromDefault();
+    newConfig.setValue("exchanged_data", QUOTE({"exchanged_data" : {"name" : "changed"}}));
+
+    ASSERT_NO_THROW(plugin_reconfigure(&handle, newConfig.itemsToJSON()));
+    ASSERT_EQ(pointTable, server->Config()->getPointTable());
+
+    plugin_shutdown((PLUGIN_HANDLE*)handle);
+
+    delete config;
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "iec104_point_store.hpp"
+
+using namespace std;
+
+TEST(PointStore, ContiguousPerCa)
+{
+    map<int, map<int, IEC104DataPoint*>> exchangeDefinitions;
+
+    for (int ioa = 100; ioa > 0; ioa--) {
+        exchangeDefinitions[45][ioa] = new IEC104DataPoint("TM", 45, ioa, IEC60870_TYPE_SHORT, false, 1);
+        exchangeDefinitions[41][ioa] = new IEC104DataPoint("TS", 41, ioa, IEC60870_TYPE_SP, false, 1);
+    }
+
+    exchangeDefinitions[41][1]->m_isCommand = true;
+    exchangeDefinitions[41][2]->m_gi_groups = 3;
+    exchangeDefinitions[41][3]->m_pack = exchangeDefinitions[41][4];
+
+    IEC104PointStore store;
+    store.build(exchangeDefinitions);
+
+    ASSERT_EQ(200, store.Size());
+    ASSERT_EQ(2, store.Blocks().size());
+    ASSERT_EQ(41, store.Blocks()[0].ca);
+    ASSERT_EQ(45, store.Blocks()[1].ca);
+    ASSERT_EQ(nullptr, store.findBlock(42));
+
+    const IEC104PointStore::Block* block = store.findBlock(45);
+    ASSERT_NE(nullptr, block);
+    ASSERT_EQ(100, block->points.size());
+
+    /* ordered by IOA, each point uses the element of its index */
+    for (size_t i = 0; i < block->points.size(); i++) {
+        ASSERT_EQ(static_cast<int>(i) + 1, block->points[i]->m_ioa);
+        ASSERT_EQ(&(block->values[i]), block->points[i]->m_value);
+        ASSERT_EQ(&(block->timestamps[i]), block->points[i]->m_ts);
+    }
+
+    /* initialized to the invalid state of the type */
+    IEC104DataPoint* tm = exchangeDefinitions[45][10];
+    ASSERT_EQ(0.0f, tm->m_value->mv_short.value);
+    ASSERT_EQ(IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL, tm->m_value->mv_short.quality);
+    ASSERT_EQ(0, tm->m_ts->encodedValue[2]);
+
+    IEC104DataPoint* ts = exchangeDefinitions[41][5];
+    ASSERT_EQ(IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL, ts->m_value->sp.quality);
+
+    /* metadata of the scans next to the values */
+    block = store.findBlock(41);
+    ASSERT_EQ(IEC60870_TYPE_SP, block->types[0]);
+    ASSERT_EQ(0, block->flags[0]);
+    ASSERT_EQ(3, block->giGroups[1]);
+    ASSERT_EQ(IEC104PointStore::FLAG_MONITORING, block->flags[1]);
+    ASSERT_EQ(IEC104PointStore::FLAG_MONITORING | IEC104PointStore::FLAG_PACKED, block->flags[2]);
+    ASSERT_EQ(1, store.findBlock(45)->giGroups[0]);
+
+    for (auto& caDefinitions : exchangeDefinitions) {
+        for (auto& ioaDefinition : caDefinitions.second) {
+            delete ioaDefinition.second;
+        }
+    }
+
+    store.clear();
+    ASSERT_EQ(0, store.Size());
+}
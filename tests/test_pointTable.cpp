@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "iec104.h"
+#include "iec104_config.hpp"
+#include "iec104_datapoint.hpp"
+#include "iec104_point_table.hpp"
+
+using namespace std;
+
+static string exchanged_data = QUOTE({
+        "exchanged_data" : {
+            "name" : "iec104client",
+            "version" : "1.0",
+            "datapoints":[
+                {
+                    "label":"TS1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-672",
+                          "typeid":"M_SP_TB_1"
+                       }
+                    ]
+                },
+                {
+                    "label":"TM1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-984",
+                          "typeid":"M_ME_NC_1"
+                       }
+                    ]
+                },
+                {
+                    "label":"TM2",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"46-984",
+                          "typeid":"M_ME_NC_1"
+                       }
+                    ]
+                }
+            ]
+        }
+    });
+
+TEST(PointTable, AddAndFind)
+{
+    IEC104PointTable table;
+
+    IEC104DataPoint* ts = table.addDataPoint("TS1", 45, 672, IEC60870_TYPE_SP, false, 1);
+    IEC104DataPoint* tm = table.addDataPoint("TM1", 45, 984, IEC60870_TYPE_SHORT, false, 1);
+
+    table.finalize();
+
+    ASSERT_EQ(2, table.Size());
+    ASSERT_EQ(ts, table.findDataPoint(45, 672));
+    ASSERT_EQ(tm, table.findDataPoint(45, 984));
+    ASSERT_EQ(nullptr, table.findDataPoint(46, 672));
+    ASSERT_EQ(tm, table.Definitions().at(45).at(984));
+
+    const IEC104PointStore::Block* block = table.Store().findBlock(45);
+    ASSERT_NE(nullptr, block);
+    ASSERT_EQ(&(block->values[1]), tm->m_value);
+}
+
+TEST(PointTable, SharedWithServer)
+{
+    IEC104Config config;
+
+    config.importExchangeConfig(exchanged_data);
+
+    shared_ptr<const IEC104PointTable> table = config.getPointTable();
+
+    ASSERT_NE(nullptr, table);
+    ASSERT_EQ(3, table->Size());
+
+    /* no copy: the configuration and its user see the same points */
+    ASSERT_EQ(&(table->Definitions()), config.getExchangeDefinitions());
+
+    IEC104DataPoint* tm = table->findDataPoint(45, 984);
+    ASSERT_NE(nullptr, tm);
+    ASSERT_EQ("TM1", tm->m_label);
+
+    /* a new import replaces the table, the previous one stays valid while it is referenced */
+    config.importExchangeConfig(exchanged_data);
+
+    ASSERT_NE(table, config.getPointTable());
+    ASSERT_EQ(1, table.use_count());
+    ASSERT_EQ("TM1", tm->m_label);
+    ASSERT_EQ(tm, table->findDataPoint(45, 984));
+}
@@ -0,0 +1,292 @@
+#include <gtest/gtest.h>
+
+#include <reading.h>
+
+#include <lib60870/hal_thread.h>
+#include <lib60870/hal_time.h>
+
+#include "iec104.h"
+#include "iec104_config.hpp"
+#include "iec104_datapoint.hpp"
+#include "cs104_connection.h"
+
+using namespace std;
+
+static string protocol_stack = QUOTE({
+        "protocol_stack" : {
+            "name" : "iec104server",
+            "version" : "1.0",
+            "transport_layer" : {
+                "bind_on_ip":false,
+                "srv_ip":"0.0.0.0",
+                "port":2404,
+                "tls":false,
+                "k_value":12,
+                "w_value":8,
+                "t0_timeout":10,
+                "t1_timeout":15,
+                "t2_timeout":10,
+                "t3_timeout":20
+            },
+            "application_layer" : {
+                "ca_asdu_size":2,
+                "ioaddr_size":3,
+                "asdu_size":0,
+                "time_sync":false,
+                "cmd_exec_timeout":5,
+                "cmd_recv_timeout":1,
+                "accept_cmd_with_time":2
+            }
+        }
+    });
+
+static string tls = QUOTE({
+        "tls_conf:" : {
+            "private_key" : "server-key.pem",
+            "server_cert" : "server.cer",
+            "ca_cert" : "root.cer"
+        }
+    });
+
+static string exchanged_data = QUOTE({
+        "exchanged_data" : {
+            "name" : "iec104client",
+            "version" : "1.0",
+            "datapoints":[
+                {
+                    "label":"TS1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-672",
+                          "typeid":"M_SP_NA_1"
+                       }
+                    ]
+                },
+                {
+                    "label":"TM1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-984",
+                          "typeid":"M_ME_TF_1"
+                       }
+                    ]
+                },
+                {
+                    "label":"IT1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-3000",
+                          "typeid":"M_IT_NA_1"
+                       }
+                    ]
+                },
+                {
+                    "label":"C1",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-2000",
+                          "typeid":"C_SC_NA_1"
+                       }
+                    ]
+                }
+            ]
+        }
+    });
+
+class ReadHandlerTest : public testing::Test
+{
+protected:
+    IEC104Server* iec104Server;  // Object on which we call for tests
+    CS104_Connection connection;
+
+    vector<CS101_ASDU> receivedAsdu;
+
+    // Setup is ran for every tests, so each variable are reinitialised
+    void SetUp() override
+    {
+        // Init iec104server object
+        iec104Server = new IEC104Server();
+        const char* ip = "127.0.0.1";
+        uint16_t port = IEC_60870_5_104_DEFAULT_PORT;
+        // Create connection
+        connection = CS104_Connection_create(ip, port);
+        ASSERT_NE(connection, nullptr);
+    }
+
+    // TearDown is ran for every tests, so each variable are destroyed again
+    void TearDown() override
+    {
+        CS104_Connection_destroy(connection);
+
+        clearReceived();
+
+        iec104Server->stop();
+
+        delete iec104Server;
+    }
+
+    static bool asduReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
+    {
+        ReadHandlerTest* self = (ReadHandlerTest*)parameter;
+
+        self->receivedAsdu.push_back(CS101_ASDU_clone(asdu, NULL));
+
+        return true;
+    }
+
+    void clearReceived()
+    {
+        for (CS101_ASDU asdu : receivedAsdu)
+        {
+            CS101_ASDU_destroy(asdu);
+        }
+
+        receivedAsdu.clear();
+    }
+
+    CS101_ASDU findAsdu(int typeId, int cot)
+    {
+        for (CS101_ASDU asdu : receivedAsdu) {
+            if ((CS101_ASDU_getTypeID(asdu) == typeId) && (CS101_ASDU_getCOT(asdu) == cot)) {
+                return asdu;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void startAndConnect()
+    {
+        iec104Server->setJsonConfig(protocol_stack, exchanged_data, tls);
+        ASSERT_TRUE(iec104Server->startSlave());
+
+        Thread_sleep(500); /* wait for the server to start */
+
+        CS104_Connection_setASDUReceivedHandler(connection, asduReceivedHandler, this);
+
+        ASSERT_TRUE(CS104_Connection_connect(connection));
+
+        CS104_Connection_sendStartDT(connection);
+
+        Thread_sleep(200);
+    }
+
+    void sendValue(int ioa, const string& typeId, Datapoint* value)
+    {
+        vector<Datapoint*> dataobjects;
+
+        dataobjects.push_back(createDataObject(45, ioa, typeId, value));
+
+        Reading* reading = new Reading(std::string("TS"), dataobjects);
+
+        vector<Reading*> readings;
+
+        readings.push_back(reading);
+
+        iec104Server->send(readings);
+
+        delete reading;
+    }
+
+    template <class T>
+    static Datapoint* createDatapoint(const std::string& dataname, const T value)
+    {
+        DatapointValue dp_value = DatapointValue(value);
+        return new Datapoint(dataname, dp_value);
+    }
+
+    static Datapoint* createDataObject(int ca, int ioa, const string& typeId, Datapoint* value)
+    {
+        auto* datapoints = new vector<Datapoint*>;
+
+        datapoints->push_back(createDatapoint("do_type", typeId));
+        datapoints->push_back(createDatapoint("do_ca", (int64_t)ca));
+        datapoints->push_back(createDatapoint("do_oa", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_cot", (int64_t)CS101_COT_SPONTANEOUS));
+        datapoints->push_back(createDatapoint("do_test", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_negative", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_ioa", (int64_t)ioa));
+        datapoints->push_back(value);
+        datapoints->push_back(createDatapoint("do_quality_iv", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_quality_bl", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_quality_ov", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_quality_sb", (int64_t)0));
+        datapoints->push_back(createDatapoint("do_quality_nt", (int64_t)0));
+
+        if (typeId == "M_ME_TF_1") {
+            datapoints->push_back(createDatapoint("do_ts", (long)Hal_getTimeInMs()));
+        }
+
+        DatapointValue dpv(datapoints, true);
+
+        return new Datapoint("data_object", dpv);
+    }
+};
+
+TEST_F(ReadHandlerTest, ReadDataPoint)
+{
+    startAndConnect();
+
+    sendValue(672, "M_SP_NA_1", createDatapoint("do_value", (int64_t)1));
+    sendValue(984, "M_ME_TF_1", createDatapoint("do_value", 12.5));
+
+    Thread_sleep(200);
+
+    clearReceived();
+
+    ASSERT_TRUE(CS104_Connection_sendReadCommand(connection, 45, 672));
+    ASSERT_TRUE(CS104_Connection_sendReadCommand(connection, 45, 984));
+
+    Thread_sleep(500);
+
+    CS101_ASDU asdu = findAsdu(M_SP_NA_1, CS101_COT_REQUEST);
+    ASSERT_NE(nullptr, asdu);
+    ASSERT_EQ(1, CS101_ASDU_getNumberOfElements(asdu));
+
+    SinglePointInformation sp = (SinglePointInformation)CS101_ASDU_getElement(asdu, 0);
+    ASSERT_EQ(672, InformationObject_getObjectAddress((InformationObject)sp));
+    ASSERT_TRUE(SinglePointInformation_getValue(sp));
+    InformationObject_destroy((InformationObject)sp);
+
+    /* current value, sent without time tag */
+    asdu = findAsdu(M_ME_NC_1, CS101_COT_REQUEST);
+    ASSERT_NE(nullptr, asdu);
+
+    MeasuredValueShort mv = (MeasuredValueShort)CS101_ASDU_getElement(asdu, 0);
+    ASSERT_EQ(984, InformationObject_getObjectAddress((InformationObject)mv));
+    ASSERT_NEAR(12.5, MeasuredValueShort_getValue(mv), 0.001);
+    InformationObject_destroy((InformationObject)mv);
+
+    /* counter */
+    clearReceived();
+
+    ASSERT_TRUE(CS104_Connection_sendReadCommand(connection, 45, 3000));
+
+    Thread_sleep(500);
+
+    ASSERT_NE(nullptr, findAsdu(M_IT_NA_1, CS101_COT_REQUEST));
+}
+
+TEST_F(ReadHandlerTest, ReadUnknownDataPoint)
+{
+    startAndConnect();
+
+    /* unknown IOA, unknown CA, command */
+    ASSERT_TRUE(CS104_Connection_sendReadCommand(connection, 45, 673));
+    ASSERT_TRUE(CS104_Connection_sendReadCommand(connection, 46, 672));
+    ASSERT_TRUE(CS104_Connection_sendReadCommand(connection, 45, 2000));
+
+    Thread_sleep(500);
+
+    ASSERT_EQ(3, receivedAsdu.size());
+
+    for (CS101_ASDU asdu : receivedAsdu) {
+        ASSERT_EQ(C_RD_NA_1, CS101_ASDU_getTypeID(asdu));
+        ASSERT_EQ(CS101_COT_UNKNOWN_IOA, CS101_ASDU_getCOT(asdu));
+        ASSERT_TRUE(CS101_ASDU_isNegative(asdu));
+    }
+}
@@ -217,6 +217,26 @@ static string exchanged_data = QUOTE({
                           "typeid":"M_ME_TF_1"
                        }
                     ]
+                },
+                {
+                    "label":"TS4",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-676",
+                          "typeid":"M_SP_TA_1"
+                       }
+                    ]
+                },
+                {
+                    "label":"TM7",
+                    "protocols":[
+                       {
+                          "name":"iec104",
+                          "address":"45-990",
+                          "typeid":"M_ME_TC_1"
+                       }
+                    ]
                 }
             ]
         }
@@ -308,7 +328,7 @@ static Datapoint* createDataObject(const char* type, int ca, int ioa, int cot,
 bool SendSpontDataTest::test1_ASDUReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
 {
     int typeId = CS101_ASDU_getTypeID(asdu);
-    printf("ASDU received - type: %s (%i) CA: %i COT: %i\n", IEC104DataPoint::getStringFromTypeID(typeId).c_str(), typeId,
+    printf("ASDU received - type: %s (%i) CA: %i COT: %i\n", IEC104DataPoint::getStringFromTypeID(typeId), typeId,
             CS101_ASDU_getCA(asdu), CS101_ASDU_getCOT(asdu));
 
     SendSpontDataTest* self = (SendSpontDataTest*)parameter;
@@ -1036,6 +1056,125 @@ TEST_F(SendSpontDataTest, CreateReading_M_ME_TF_1)
     delete dataobjects;
 }
 
+TEST_F(SendSpontDataTest, CreateReading_M_SP_TA_1)
+{
+    iec104Server->setJsonConfig(protocol_stack, exchanged_data, tls);
+    ASSERT_TRUE(iec104Server->startSlave());
+
+    Thread_sleep(500); /* wait for the server to start */
+
+    CS104_Connection_setASDUReceivedHandler(connection, test1_ASDUReceivedHandler, this);
+
+    bool result = CS104_Connection_connect(connection);
+    ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(connection);
+
+    auto* dataobjects = new vector<Datapoint*>;
+
+    struct sCP56Time2a ts;
+
+    uint64_t timeVal = Hal_getTimeInMs();
+
+    CP56Time2a_createFromMsTimestamp(&ts, timeVal);
+
+    /* the point is configured with the CP24Time2a type: the CP56Time2a time tag is shortened */
+    dataobjects->push_back(createDataObject("M_SP_TB_1", 45, 676, CS101_COT_SPONTANEOUS, (int64_t)1, false, false, false, false, false, &ts));
+
+    Reading* reading = new Reading(std::string("TS4"), *dataobjects);
+
+    vector<Reading*> readings;
+
+    readings.push_back(reading);
+
+    iec104Server->send(readings);
+
+    Thread_sleep(500);
+
+    ASSERT_EQ(1, receivedAsdu.size());
+
+    CS101_ASDU asdu = receivedAsdu.at(0);
+
+    ASSERT_EQ(M_SP_TA_1, CS101_ASDU_getTypeID(asdu));
+    ASSERT_EQ(1, CS101_ASDU_getNumberOfElements(asdu));
+
+    InformationObject io = CS101_ASDU_getElement(asdu, 0);
+    ASSERT_EQ(676, InformationObject_getObjectAddress(io));
+    ASSERT_TRUE(SinglePointInformation_getValue((SinglePointInformation)io));
+
+    CP24Time2a rcvdTimestamp = SinglePointWithCP24Time2a_getTimestamp((SinglePointWithCP24Time2a)io);
+
+    ASSERT_EQ(CP56Time2a_getMinute(&ts), CP24Time2a_getMinute(rcvdTimestamp));
+    ASSERT_EQ(CP56Time2a_getSecond(&ts), CP24Time2a_getSecond(rcvdTimestamp));
+    ASSERT_EQ(CP56Time2a_getMillisecond(&ts), CP24Time2a_getMillisecond(rcvdTimestamp));
+
+    InformationObject_destroy(io);
+
+    delete reading;
+
+    delete dataobjects;
+}
+
+TEST_F(SendSpontDataTest, CreateReading_M_ME_TC_1)
+{
+    iec104Server->setJsonConfig(protocol_stack, exchanged_data, tls);
+    ASSERT_TRUE(iec104Server->startSlave());
+
+    Thread_sleep(500); /* wait for the server to start */
+
+    CS104_Connection_setASDUReceivedHandler(connection, test1_ASDUReceivedHandler, this);
+
+    bool result = CS104_Connection_connect(connection);
+    ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(connection);
+
+    auto* dataobjects = new vector<Datapoint*>;
+
+    struct sCP56Time2a ts;
+
+    CP56Time2a_createFromMsTimestamp(&ts, Hal_getTimeInMs());
+    CP56Time2a_setInvalid(&ts, true);
+
+    dataobjects->push_back(createDataObject("M_ME_TC_1", 45, 990, CS101_COT_SPONTANEOUS, (float)2.f, false, false, false, false, false, &ts));
+
+    /* without time tag */
+    dataobjects->push_back(createDataObject("M_ME_NC_1", 45, 990, CS101_COT_SPONTANEOUS, (float)3.f, false, false, false, false, false, nullptr));
+
+    Reading* reading = new Reading(std::string("TM7"), *dataobjects);
+
+    vector<Reading*> readings;
+
+    readings.push_back(reading);
+
+    iec104Server->send(readings);
+
+    Thread_sleep(500);
+
+    ASSERT_EQ(2, receivedAsdu.size());
+
+    CS101_ASDU asdu = receivedAsdu.at(0);
+
+    ASSERT_EQ(M_ME_TC_1, CS101_ASDU_getTypeID(asdu));
+
+    InformationObject io = CS101_ASDU_getElement(asdu, 0);
+    ASSERT_EQ(990, InformationObject_getObjectAddress(io));
+    ASSERT_NEAR(2.f, MeasuredValueShort_getValue((MeasuredValueShort)io), 0.001f);
+
+    CP24Time2a rcvdTimestamp = MeasuredValueShortWithCP24Time2a_getTimestamp((MeasuredValueShortWithCP24Time2a)io);
+
+    ASSERT_EQ(CP56Time2a_getMinute(&ts), CP24Time2a_getMinute(rcvdTimestamp));
+    ASSERT_TRUE(CP24Time2a_isInvalid(rcvdTimestamp));
+
+    InformationObject_destroy(io);
+
+    ASSERT_EQ(M_ME_NC_1, CS101_ASDU_getTypeID(receivedAsdu.at(1)));
+
+    delete reading;
+
+    delete dataobjects;
+}
+
 TEST_F(SendSpontDataTest, CreateReading_differentSpontaneousCOTs)
 {
     iec104Server->setJsonConfig(protocol_stack, exchanged_data, tls);
@@ -1128,6 +1267,68 @@ TEST_F(SendSpontDataTest, CreateReading_M_ST_NA_1)
     delete dataobjects;
 }
 
+TEST_F(SendSpontDataTest, CreateReading_M_ST_NA_1_Structured)
+{
+    iec104Server->setJsonConfig(protocol_stack, exchanged_data, tls);
+    ASSERT_TRUE(iec104Server->startSlave());
+
+    Thread_sleep(500); /* wait for the server to start */
+
+    CS104_Connection_setASDUReceivedHandler(connection, test1_ASDUReceivedHandler, this);
+
+    bool result = CS104_Connection_connect(connection);
+    ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(connection);
+
+    /* {"value": -5, "transient": 0} */
+    auto* dict = new vector<Datapoint*>;
+    dict->push_back(createDatapoint("value", (int64_t)-5));
+    dict->push_back(createDatapoint("transient", (int64_t)0));
+    DatapointValue dictValue(dict, true);
+
+    /* [12, 1] */
+    auto* list = new vector<Datapoint*>;
+    list->push_back(createDatapoint("0", (int64_t)12));
+    list->push_back(createDatapoint("1", (int64_t)1));
+    DatapointValue listValue(list, false);
+
+    auto* dataobjects = new vector<Datapoint*>;
+
+    dataobjects->push_back(createDataObject("M_ST_NA_1", 45, 1701, CS101_COT_SPONTANEOUS, dictValue, false, false, false, false, false, NULL));
+    dataobjects->push_back(createDataObject("M_ST_NA_1", 45, 1701, CS101_COT_SPONTANEOUS, listValue, false, false, false, false, false, NULL));
+
+    Reading* reading = new Reading(std::string("TS6"), *dataobjects);
+
+    vector<Reading*> readings;
+
+    readings.push_back(reading);
+
+    iec104Server->send(readings);
+
+    Thread_sleep(1000);
+
+    ASSERT_EQ(2, receivedAsdu.size());
+
+    InformationObject io = CS101_ASDU_getElement(receivedAsdu.at(0), 0);
+
+    ASSERT_EQ(-5, StepPositionInformation_getValue((StepPositionInformation)io));
+    ASSERT_FALSE(StepPositionInformation_isTransient((StepPositionInformation)io));
+
+    InformationObject_destroy(io);
+
+    io = CS101_ASDU_getElement(receivedAsdu.at(1), 0);
+
+    ASSERT_EQ(12, StepPositionInformation_getValue((StepPositionInformation)io));
+    ASSERT_TRUE(StepPositionInformation_isTransient((StepPositionInformation)io));
+
+    InformationObject_destroy(io);
+
+    delete reading;
+
+    delete dataobjects;
+}
+
 TEST_F(SendSpontDataTest, CreateReading_M_ST_TB_1)
 {
     iec104Server->setJsonConfig(protocol_stack, exchanged_data, tls);
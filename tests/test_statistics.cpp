@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "iec104_config.hpp"
+#include "iec104_statistics.hpp"
+
+using namespace std;
+
+// I-frame with N(S) and N(R), the ASDU content is not relevant for the statistics
+static void iFrame(uint8_t* frame, int sendSequence, int receiveSequence)
+{
+    frame[0] = 0x68;
+    frame[1] = 14;
+    frame[2] = static_cast<uint8_t>((sendSequence << 1) & 0xfe);
+    frame[3] = static_cast<uint8_t>(sendSequence >> 7);
+    frame[4] = static_cast<uint8_t>((receiveSequence << 1) & 0xfe);
+    frame[5] = static_cast<uint8_t>(receiveSequence >> 7);
+
+    for (int i = 6; i < 16; i++) {
+        frame[i] = 0;
+    }
+}
+
+static void sFrame(uint8_t* frame, int receiveSequence)
+{
+    frame[0] = 0x68;
+    frame[1] = 4;
+    frame[2] = 0x01;
+    frame[3] = 0x00;
+    frame[4] = static_cast<uint8_t>((receiveSequence << 1) & 0xfe);
+    frame[5] = static_cast<uint8_t>(receiveSequence >> 7);
+}
+
+static const uint8_t testFrAct[] = {0x68, 0x04, 0x43, 0x00, 0x00, 0x00};
+
+TEST(StatisticsTest, FrameCounters)
+{
+    IEC104Statistics statistics;
+    statistics.openLink(0x10, "127.0.0.1:50000");
+
+    uint8_t frame[16];
+
+    for (int i = 0; i < 5; i++) {
+        iFrame(frame, i, 0);
+        statistics.recordFrame(0x10, frame, sizeof(frame), true);
+    }
+
+    iFrame(frame, 0, 5);
+    statistics.recordFrame(0x10, frame, sizeof(frame), false);
+    sFrame(frame, 1);
+    statistics.recordFrame(0x10, frame, 6, true);
+    statistics.recordFrame(0x10, testFrAct, sizeof(testFrAct), false);
+
+    // unknown connections are ignored
+    statistics.recordFrame(0x20, testFrAct, sizeof(testFrAct), false);
+
+    string json = statistics.toJson(1000);
+
+    ASSERT_NE(string::npos, json.find("\"peer\":\"127.0.0.1:50000\",\"i_sent\":5,\"i_received\":1,\"i_sent_per_s\":5,\"i_received_per_s\":1"));
+    ASSERT_NE(string::npos, json.find("\"s_sent\":1,\"s_received\":0,\"u_sent\":0,\"u_received\":1,\"bytes_sent\":86,\"bytes_received\":22"));
+    ASSERT_NE(string::npos, json.find("\"k_stalls\":0"));
+
+    // rates are computed over the period since the previous snapshot
+    json = statistics.toJson(1000);
+    ASSERT_NE(string::npos, json.find("\"i_sent_per_s\":0"));
+
+    statistics.closeLink(0x10);
+    ASSERT_NE(string::npos, statistics.toJson(1000).find("\"links\":[]"));
+}
+
+TEST(StatisticsTest, WindowStalls)
+{
+    IEC104Statistics statistics;
+    statistics.setWindowSize(3);
+    statistics.openLink(0x10, "127.0.0.1:50000");
+
+    uint8_t frame[16];
+
+    sFrame(frame, 32766);
+    statistics.recordFrame(0x10, frame, 6, false);
+
+    // 32767 -> 0 wraps around the sequence numbers
+    for (int i = 0; i < 3; i++) {
+        iFrame(frame, (32766 + i) % 32768, 0);
+        statistics.recordFrame(0x10, frame, sizeof(frame), true);
+    }
+
+    ASSERT_NE(string::npos, statistics.toJson(1000).find("\"k_stalls\":1"));
+
+    // the stall ends with the acknowledgement, a new stall is counted once
+    sFrame(frame, 0);
+    statistics.recordFrame(0x10, frame, 6, false);
+
+    for (int i = 1; i < 5; i++) {
+        iFrame(frame, i, 0);
+        statistics.recordFrame(0x10, frame, sizeof(frame), true);
+    }
+
+    ASSERT_NE(string::npos, statistics.toJson(1000).find("\"k_stalls\":2"));
+}
+
+TEST(StatisticsTest, WindowResyncWhenEnabled)
+{
+    IEC104Statistics statistics;
+    statistics.setWindowSize(3);
+    statistics.setEnabled(true);
+    statistics.openLink(0x10, "127.0.0.1:50000");
+
+    uint8_t frame[16];
+
+    iFrame(frame, 0, 0);
+    statistics.recordFrame(0x10, frame, sizeof(frame), true);
+
+    ASSERT_TRUE(statistics.isEnabled());
+
+    // frames 1..99 are exchanged while disabled and not recorded
+    statistics.setEnabled(false);
+    statistics.setEnabled(true);
+
+    // the acknowledgement of frames not recorded is no stall
+    sFrame(frame, 100);
+    statistics.recordFrame(0x10, frame, 6, false);
+
+    iFrame(frame, 100, 0);
+    statistics.recordFrame(0x10, frame, sizeof(frame), true);
+
+    ASSERT_NE(string::npos, statistics.toJson(1000).find("\"k_stalls\":0"));
+}
+
+TEST(StatisticsTest, GlobalCounters)
+{
+    IEC104Statistics statistics;
+    statistics.openLink(0x10, "[fd00::1]:50000");
+
+    statistics.countReadings(20);
+    statistics.countAsduEnqueued();
+    statistics.countConnectionRequest(true);
+    statistics.countConnectionRequest(false);
+    statistics.countCommand(0x10, false);
+    statistics.countCommand(0x10, true);
+    statistics.recordInterrogation(0x10, 25000000);
+    statistics.sampleQueueDepth(100, 100);
+    statistics.sampleQueueDepth(10, 100);
+
+    string json = statistics.toJson(2000);
+
+    ASSERT_NE(string::npos, json.find("\"period\":2,\"readings\":20,\"readings_per_s\":10,\"asdu_enqueued\":1"));
+    ASSERT_NE(string::npos, json.find("\"asdu_queue\":{\"depth\":10,\"max_depth\":100,\"capacity\":100,\"full_samples\":1}"));
+    ASSERT_NE(string::npos, json.find("\"connections\":{\"accepted\":1,\"rejected\":1,\"opened\":1}"));
+    ASSERT_NE(string::npos, json.find("\"commands\":{\"received\":2,\"rejected\":1}"));
+    ASSERT_NE(string::npos, json.find("\"interrogations\":{\"count\":1,\"p50\":2"));
+    ASSERT_NE(string::npos, json.find("\"commands\":2,\"commands_rejected\":1,\"interrogations\":1}"));
+
+    // period values are reset after a snapshot
+    json = statistics.toJson(2000);
+    ASSERT_NE(string::npos, json.find("\"max_depth\":10"));
+    ASSERT_NE(string::npos, json.find("\"interrogations\":{\"count\":1,\"p50\":0"));
+}
+
+TEST(StatisticsTest, DiagnosticsSettingsSnapshot)
+{
+    IEC104Config config;
+
+    config.importDiagnosticsConfig("{\"diagnostics\":{\"statistics\":{\"enabled\":true,\"period\":10},"
+                                   "\"audit_code\":\"SRVDIAG\"}}");
+
+    shared_ptr<const IEC104DiagnosticsSettings> snapshot = config.DiagnosticsSettings();
+
+    ASSERT_TRUE(snapshot->statisticsEnabled);
+    ASSERT_EQ(10, snapshot->statisticsPeriod);
+    ASSERT_EQ("SRVDIAG", snapshot->auditCode);
+
+    config.importDiagnosticsConfig("{\"diagnostics\":{\"latency\":{\"enabled\":true}}}");
+
+    // a snapshot taken before the change is not modified
+    ASSERT_TRUE(snapshot->statisticsEnabled);
+    ASSERT_EQ("SRVDIAG", snapshot->auditCode);
+
+    shared_ptr<const IEC104DiagnosticsSettings> current = config.DiagnosticsSettings();
+
+    ASSERT_TRUE(current->latencyTracing);
+    ASSERT_EQ(60, current->latencyPeriod);
+    ASSERT_FALSE(current->statisticsEnabled);
+    ASSERT_TRUE(current->auditCode.empty());
+
+    // parsing error: the settings are kept
+    config.importDiagnosticsConfig("{");
+
+    ASSERT_EQ(current, config.DiagnosticsSettings());
+}
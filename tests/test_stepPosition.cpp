@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <datapoint.h>
+
+#include "iec104_datapoint.hpp"
+
+using namespace std;
+
+static bool
+parseString(const std::string& str, int& posValue, bool& transient)
+{
+    DatapointValue value(str);
+
+    return IEC104DataPoint::parseStepPosition(value, posValue, transient);
+}
+
+TEST(StepPosition, StringForm)
+{
+    int posValue = 0;
+    bool transient = false;
+
+    ASSERT_TRUE(parseString("[12,true]", posValue, transient));
+    ASSERT_EQ(12, posValue);
+    ASSERT_TRUE(transient);
+
+    ASSERT_TRUE(parseString("[-64,false]", posValue, transient));
+    ASSERT_EQ(-64, posValue);
+    ASSERT_FALSE(transient);
+
+    ASSERT_TRUE(parseString(" [ 63 , 1 ] ", posValue, transient));
+    ASSERT_EQ(63, posValue);
+    ASSERT_TRUE(transient);
+}
+
+TEST(StepPosition, InvalidStringKeepsValue)
+{
+    int posValue = 7;
+    bool transient = true;
+
+    const char* invalid[] = {"", "[]", "12", "[12]", "[12,maybe]", "[12,true", "[12,true]x", "[a,true]", "[64,false]",
+                             "[-65,false]", "[99999999999,true]", "[12,2]"};
+
+    for (const char* str : invalid) {
+        ASSERT_FALSE(parseString(str, posValue, transient)) << str;
+        ASSERT_EQ(7, posValue);
+        ASSERT_TRUE(transient);
+    }
+}
+
+TEST(StepPosition, StructuredForms)
+{
+    int posValue = 0;
+    bool transient = false;
+
+    auto* dict = new vector<Datapoint*>;
+    DatapointValue transientValue((long)1);
+    dict->push_back(new Datapoint("transient", transientValue));
+    DatapointValue positionValue((long)-3);
+    dict->push_back(new Datapoint("value", positionValue));
+    DatapointValue dictValue(dict, true);
+
+    ASSERT_TRUE(IEC104DataPoint::parseStepPosition(dictValue, posValue, transient));
+    ASSERT_EQ(-3, posValue);
+    ASSERT_TRUE(transient);
+
+    auto* list = new vector<Datapoint*>;
+    DatapointValue first((long)5);
+    list->push_back(new Datapoint("0", first));
+    DatapointValue second((long)0);
+    list->push_back(new Datapoint("1", second));
+    DatapointValue listValue(list, false);
+
+    ASSERT_TRUE(IEC104DataPoint::parseStepPosition(listValue, posValue, transient));
+    ASSERT_EQ(5, posValue);
+    ASSERT_FALSE(transient);
+
+    /* the value is mandatory in the dict form */
+    auto* incomplete = new vector<Datapoint*>;
+    DatapointValue onlyTransient((long)1);
+    incomplete->push_back(new Datapoint("transient", onlyTransient));
+    DatapointValue incompleteValue(incomplete, true);
+
+    ASSERT_FALSE(IEC104DataPoint::parseStepPosition(incompleteValue, posValue, transient));
+
+    DatapointValue number((long)5);
+
+    ASSERT_FALSE(IEC104DataPoint::parseStepPosition(number, posValue, transient));
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <string.h>
+#include <vector>
+
+#include <lib60870/hal_time.h>
+
+#include "iec104_time_encoder.hpp"
+
+static void
+expectSameEncoding(uint64_t timestamp, const struct sCP56Time2a* encoded)
+{
+    struct sCP56Time2a expected;
+
+    CP56Time2a_createFromMsTimestamp(&expected, timestamp);
+
+    ASSERT_EQ(0, memcmp(expected.encodedValue, encoded->encodedValue, sizeof(expected.encodedValue))) << "timestamp " << timestamp;
+}
+
+TEST(TimeEncoder, SameEncodingAsLib60870)
+{
+    IEC104TimeEncoder encoder;
+
+    struct sCP56Time2a encoded;
+
+    /* 2024-02-29 23:59:59.999 UTC, end of a leap day */
+    uint64_t leapDay = 1709251199999ULL;
+
+    std::vector<uint64_t> timestamps = {
+        0, 1, 59999, 60000, 3599999, 3600000,
+        leapDay - 1, leapDay, leapDay + 1, leapDay + 60000, leapDay - 3600000,
+        Hal_getTimeInMs()
+    };
+
+    for (uint64_t timestamp : timestamps) {
+        encoder.encode(&encoded, timestamp);
+        expectSameEncoding(timestamp, &encoded);
+    }
+
+    /* every 7 s for two days, hour and day changes included */
+    for (uint64_t timestamp = leapDay - 86400000ULL; timestamp < leapDay + 86400000ULL; timestamp += 7001) {
+        encoder.encode(&encoded, timestamp);
+        expectSameEncoding(timestamp, &encoded);
+    }
+}
+
+TEST(TimeEncoder, FlagsCleared)
+{
+    IEC104TimeEncoder encoder;
+
+    struct sCP56Time2a encoded;
+
+    uint64_t timestamp = 1709251199999ULL;
+
+    encoder.encode(&encoded, timestamp);
+
+    CP56Time2a_setInvalid(&encoded, true);
+    CP56Time2a_setSummerTime(&encoded, true);
+    CP56Time2a_setSubstituted(&encoded, true);
+
+    encoder.encode(&encoded, timestamp);
+
+    ASSERT_FALSE(CP56Time2a_isInvalid(&encoded));
+    ASSERT_FALSE(CP56Time2a_isSummerTime(&encoded));
+    ASSERT_FALSE(CP56Time2a_isSubstituted(&encoded));
+}
+
+TEST(TimeEncoder, Batch)
+{
+    IEC104TimeEncoder encoder;
+
+    std::vector<uint64_t> timestamps;
+
+    /* mostly the same hour, with a step back and an hour change in the batch */
+    uint64_t start = 1709247600000ULL;
+
+    for (int i = 0; i < 1000; i++) {
+        timestamps.push_back(start + 3500000 + i * 150);
+    }
+
+    timestamps.push_back(start);
+
+    std::vector<struct sCP56Time2a> encoded(timestamps.size());
+
+    encoder.encode(timestamps.data(), timestamps.size(), encoded.data());
+
+    for (size_t i = 0; i < timestamps.size(); i++) {
+        expectSameEncoding(timestamps[i], &encoded[i]);
+    }
+
+    encoder.encode(timestamps.data(), 0, encoded.data());
+}
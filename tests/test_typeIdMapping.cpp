@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "iec104_datapoint.hpp"
+
+using namespace std;
+
+TEST(TypeIdMapping, RoundTrip)
+{
+    int knownTypes = 0;
+
+    for (int typeId = 0; typeId < 256; typeId++) {
+        const char* typeStr = IEC104DataPoint::getStringFromTypeID(typeId);
+
+        ASSERT_NE(nullptr, typeStr);
+
+        if (strlen(typeStr) > 0) {
+            ASSERT_EQ(typeId, IEC104DataPoint::getTypeIdFromString(typeStr));
+            knownTypes++;
+        }
+    }
+
+    ASSERT_EQ(81, knownTypes);
+
+    ASSERT_STREQ("M_SP_NA_1", IEC104DataPoint::getStringFromTypeID(M_SP_NA_1));
+    ASSERT_STREQ("M_ME_TF_1", IEC104DataPoint::getStringFromTypeID(M_ME_TF_1));
+    ASSERT_STREQ("C_SE_TC_1", IEC104DataPoint::getStringFromTypeID(C_SE_TC_1));
+    ASSERT_STREQ("F_SC_NB_1", IEC104DataPoint::getStringFromTypeID(F_SC_NB_1));
+}
+
+TEST(TypeIdMapping, UnknownValues)
+{
+    ASSERT_STREQ("", IEC104DataPoint::getStringFromTypeID(0));
+    ASSERT_STREQ("", IEC104DataPoint::getStringFromTypeID(22));
+    ASSERT_STREQ("", IEC104DataPoint::getStringFromTypeID(128));
+    ASSERT_STREQ("", IEC104DataPoint::getStringFromTypeID(-1));
+
+    ASSERT_EQ(0, IEC104DataPoint::getTypeIdFromString(""));
+    ASSERT_EQ(0, IEC104DataPoint::getTypeIdFromString("M_SP_NA"));
+    ASSERT_EQ(0, IEC104DataPoint::getTypeIdFromString("M_SP_NA_10"));
+    ASSERT_EQ(0, IEC104DataPoint::getTypeIdFromString("m_sp_na_1"));
+    ASSERT_EQ(0, IEC104DataPoint::getTypeIdFromString("M_SP_NX_1"));
+    ASSERT_EQ(0, IEC104DataPoint::getTypeIdFromString("M_SP_NA_2"));
+}
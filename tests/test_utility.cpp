@@ -12,6 +12,49 @@ TEST(UtilityTest, Logs)
     ASSERT_NO_THROW(Iec104Utility::log_fatal(text.c_str(), "fatal"));
 }
 
+static int evaluations = 0;
+
+static const char*
+countedArgument()
+{
+    evaluations++;
+    return "argument";
+}
+
+TEST(UtilityTest, LogLevelGating)
+{
+    std::string previousLevel = Logger::getLogger()->getMinLevel();
+
+    Logger::getLogger()->setMinLevel("warning");
+    Iec104Utility::refreshLogLevel();
+
+    ASSERT_FALSE(Iec104Utility::isLogEnabled(Iec104Utility::LOG_LEVEL_DEBUG));
+    ASSERT_FALSE(Iec104Utility::isLogEnabled(Iec104Utility::LOG_LEVEL_INFO));
+    ASSERT_TRUE(Iec104Utility::isLogEnabled(Iec104Utility::LOG_LEVEL_WARNING));
+    ASSERT_TRUE(Iec104Utility::isLogEnabled(Iec104Utility::LOG_LEVEL_ERROR));
+
+    evaluations = 0;
+    IEC104_HOT_LOG_DEBUG("%s Hot path debug %s", LOG_PREFIX("UtilityTest"), countedArgument());
+    IEC104_HOT_LOG_INFO("%s Hot path info %s", LOG_PREFIX("UtilityTest"), countedArgument());
+    ASSERT_EQ(0, evaluations);
+
+    Logger::getLogger()->setMinLevel("debug");
+    Iec104Utility::refreshLogLevel();
+
+    ASSERT_TRUE(Iec104Utility::isLogEnabled(Iec104Utility::LOG_LEVEL_DEBUG));
+
+    IEC104_HOT_LOG_DEBUG("%s Hot path debug %s", LOG_PREFIX("UtilityTest"), countedArgument());
+    IEC104_HOT_LOG_INFO("%s Hot path info %s", LOG_PREFIX("UtilityTest"), countedArgument());
+#ifdef IEC104_STRIP_HOT_PATH_LOGS
+    ASSERT_EQ(0, evaluations);
+#else
+    ASSERT_EQ(2, evaluations);
+#endif
+
+    Logger::getLogger()->setMinLevel(previousLevel);
+    Iec104Utility::refreshLogLevel();
+}
+
 TEST(PivotIEC104PluginUtility, Audit)
 {
     std::string text{"This audit is of type "};
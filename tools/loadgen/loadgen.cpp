@@ -0,0 +1,726 @@
+#include <dlfcn.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <config_category.h>
+#include <logger.h>
+#include <plugin_api.h>
+#include <reading.h>
+
+#include "iec104_latency.hpp"
+#include "bench_utility.hpp"
+
+using namespace std;
+
+/*
+ * Soak test load generator for the IEC 104 north plugin.
+ *
+ * The plugin shared library is loaded through its C API (plugin_info/plugin_init/plugin_start/plugin_send),
+ * exactly as the north service does. A sender thread replays time tagged data_object readings at the target
+ * rate while loopback masters, each in its own redundancy group, receive the spontaneous data, interrogate
+ * and send single commands. The commands forwarded by the plugin are confirmed (ACT-CON, ACT-TERM) through
+ * the same send() path as a south plugin would do.
+ *
+ * A JSON line is printed on stdout every report period: achieved rate, readings rejected by send(), losses
+ * and latency (do_ts to reception, ms resolution) per master, command round trip and process memory.
+ */
+
+typedef PLUGIN_INFORMATION* (*PluginInfoFunc)();
+typedef PLUGIN_HANDLE (*PluginInitFunc)(ConfigCategory*);
+typedef void (*PluginStartFunc)(PLUGIN_HANDLE, const string&);
+typedef uint32_t (*PluginSendFunc)(PLUGIN_HANDLE, const vector<Reading*>&);
+typedef bool (*WriteFunc)(const char*, const char*, ControlDestination, ...);
+typedef int (*OperationFunc)(char*, int, char*[], char*[], ControlDestination, ...);
+typedef void (*PluginRegisterFunc)(PLUGIN_HANDLE, WriteFunc, OperationFunc);
+typedef void (*PluginShutdownFunc)(PLUGIN_HANDLE);
+
+static const char* const SOUTH_ASSET = "loadgen-south";
+static const int COMMAND_IOA_BASE = 100000;
+static const int COMMAND_POINTS = 16;
+static const int RECONNECT_PERIOD = 1000; /* in ms */
+static const int DRAIN_TIME = 2000; /* in ms */
+
+struct Options
+{
+    string plugin = "./libiec104.so";
+    int points = 1000;
+    int cas = 4;
+    vector<string> types = {"M_ME_TF_1", "M_SP_TB_1", "M_DP_TB_1"};
+    int rate = 1000;          /* data_objects per second */
+    int batch = 10;           /* readings per send() call */
+    int masters = 1;
+    int duration = 0;         /* in s, 0 to run until interrupted */
+    int report = 10;          /* in s */
+    int giPeriod = 60;        /* in s, 0 to disable */
+    int commandPeriod = 1000; /* in ms per master, 0 to disable */
+    int queueSize = 10000;
+};
+
+static atomic<bool> s_stop{false};
+
+static void
+signalHandler(int signal)
+{
+    (void)signal;
+    s_stop.store(true);
+}
+
+static void
+usage(const char* program)
+{
+    Options defaults;
+
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --plugin=PATH            plugin shared library (%s)\n"
+            "  --points=N               monitoring points (%d)\n"
+            "  --cas=N                  common addresses the points are spread over (%d)\n"
+            "  --types=T1,T2,...        time tagged monitoring types (M_ME_TF_1,M_SP_TB_1,M_DP_TB_1)\n"
+            "  --rate=N                 data_objects sent per second (%d)\n"
+            "  --batch=N                readings per send() call (%d)\n"
+            "  --masters=N              loopback masters, bound to 127.0.1.1..N (%d)\n"
+            "  --duration=S             run time in s, 0 until interrupted (%d)\n"
+            "  --report=S               report period in s (%d)\n"
+            "  --gi-period=S            general interrogation period per master in s, 0 to disable (%d)\n"
+            "  --command-period=MS      single command period per master in ms, 0 to disable (%d)\n"
+            "  --queue=N                asdu_queue_size of the plugin (%d)\n",
+            program, defaults.plugin.c_str(), defaults.points, defaults.cas, defaults.rate, defaults.batch,
+            defaults.masters, defaults.duration, defaults.report, defaults.giPeriod, defaults.commandPeriod,
+            defaults.queueSize);
+}
+
+static bool
+parseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        size_t separator = arg.find('=');
+
+        if ((arg.compare(0, 2, "--") != 0) || (separator == string::npos)) {
+            return false;
+        }
+
+        string name = arg.substr(2, separator - 2);
+        string value = arg.substr(separator + 1);
+
+        if (name == "plugin") {
+            options.plugin = value;
+        }
+        else if (name == "types") {
+            options.types.clear();
+
+            size_t start = 0;
+
+            while (start <= value.size()) {
+                size_t end = value.find(',', start);
+
+                if (end == string::npos) {
+                    end = value.size();
+                }
+
+                if (end > start) {
+                    options.types.push_back(value.substr(start, end - start));
+                }
+
+                start = end + 1;
+            }
+
+            if (options.types.empty()) {
+                return false;
+            }
+        }
+        else {
+            char* end = nullptr;
+            long number = strtol(value.c_str(), &end, 10);
+
+            if ((end == value.c_str()) || (*end != 0) || (number < 0) || (number > 100000000)) {
+                return false;
+            }
+
+            int n = static_cast<int>(number);
+
+            if (name == "points") options.points = n;
+            else if (name == "cas") options.cas = n;
+            else if (name == "rate") options.rate = n;
+            else if (name == "batch") options.batch = n;
+            else if (name == "masters") options.masters = n;
+            else if (name == "duration") options.duration = n;
+            else if (name == "report") options.report = n;
+            else if (name == "gi-period") options.giPeriod = n;
+            else if (name == "command-period") options.commandPeriod = n;
+            else if (name == "queue") options.queueSize = n;
+            else return false;
+        }
+    }
+
+    return (options.points > 0) && (options.cas > 0) && (options.rate > 0) && (options.batch > 0) &&
+           (options.masters > 0) && (options.masters < 255) && (options.report > 0);
+}
+
+/// @brief Timestamp of a time tagged monitoring information object in ms, 0 for other types
+static uint64_t
+informationObjectTimestamp(IEC60870_5_TypeID typeId, InformationObject io)
+{
+    switch (typeId) {
+        case M_SP_TB_1: return CP56Time2a_toMsTimestamp(SinglePointWithCP56Time2a_getTimestamp((SinglePointWithCP56Time2a)io));
+        case M_DP_TB_1: return CP56Time2a_toMsTimestamp(DoublePointWithCP56Time2a_getTimestamp((DoublePointWithCP56Time2a)io));
+        case M_ST_TB_1: return CP56Time2a_toMsTimestamp(StepPositionWithCP56Time2a_getTimestamp((StepPositionWithCP56Time2a)io));
+        case M_ME_TD_1: return CP56Time2a_toMsTimestamp(MeasuredValueNormalizedWithCP56Time2a_getTimestamp((MeasuredValueNormalizedWithCP56Time2a)io));
+        case M_ME_TE_1: return CP56Time2a_toMsTimestamp(MeasuredValueScaledWithCP56Time2a_getTimestamp((MeasuredValueScaledWithCP56Time2a)io));
+        case M_ME_TF_1: return CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp((MeasuredValueShortWithCP56Time2a)io));
+        default: return 0;
+    }
+}
+
+static string
+percentilesJson(const IEC104LatencyHistogram& histogram)
+{
+    char buffer[160];
+
+    snprintf(buffer, sizeof(buffer), "{\"count\":%llu,\"p50\":%.3f,\"p99\":%.3f,\"p999\":%.3f,\"max\":%.3f}",
+             static_cast<unsigned long long>(histogram.Count()), static_cast<double>(histogram.percentile(50.0)) / 1e6,
+             static_cast<double>(histogram.percentile(99.0)) / 1e6, static_cast<double>(histogram.percentile(99.9)) / 1e6,
+             static_cast<double>(histogram.Max()) / 1e6);
+
+    return buffer;
+}
+
+/// @brief Master of the soak test, bound to its own loopback address so that it gets its own redundancy group
+class SoakMaster
+{
+public:
+    SoakMaster(const string& localIp, const atomic<uint64_t>& generated) : m_localIp(localIp), m_generated(generated)
+    {
+        m_connection = CS104_Connection_create("127.0.0.1", Iec104Bench::PORT);
+
+        CS104_Connection_setLocalAddress(m_connection, m_localIp.c_str(), 0);
+        CS104_Connection_setConnectionHandler(m_connection, connectionHandler, this);
+        CS104_Connection_setASDUReceivedHandler(m_connection, asduHandler, this);
+    }
+
+    ~SoakMaster()
+    {
+        CS104_Connection_destroy(m_connection);
+    }
+
+    const string& LocalIp() const {return m_localIp;};
+    bool IsActive() const {return m_active.load();};
+
+    /// @brief Connect and activate the data transfer, does nothing while connected
+    void connect(uint64_t currentTime)
+    {
+        if (m_connected.load() || (currentTime < m_nextConnect)) {
+            return;
+        }
+
+        m_nextConnect = currentTime + RECONNECT_PERIOD;
+
+        if (CS104_Connection_connect(m_connection)) {
+            m_connects++;
+            CS104_Connection_sendStartDT(m_connection);
+        }
+    }
+
+    void interrogate()
+    {
+        if (m_active.load() && CS104_Connection_sendInterrogationCommand(m_connection, CS101_COT_ACTIVATION, 0xffff, IEC60870_QOI_STATION)) {
+            m_interrogations++;
+        }
+    }
+
+    void sendCommand(int ca, int ioa, bool state)
+    {
+        if (!m_active.load()) {
+            return;
+        }
+
+        InformationObject command = (InformationObject)SingleCommand_create(NULL, ioa, state, false, 0);
+
+        m_commandSent.store(Hal_getTimeInNs());
+
+        if (CS104_Connection_sendProcessCommandEx(m_connection, CS101_COT_ACTIVATION, ca, command)) {
+            m_commands++;
+        }
+
+        InformationObject_destroy(command);
+    }
+
+    /// @brief Close the report period: JSON object of the master, the interval histograms are reset
+    string report()
+    {
+        uint64_t received = m_received.load();
+        uint64_t base = m_generatedBase.load();
+        uint64_t generated = m_generated.load();
+        uint64_t expected = m_active.load() && (generated > base) ? generated - base : 0;
+        uint64_t pending = (expected > received) ? expected - received : 0;
+
+        string json = "{\"ip\":\"" + m_localIp + "\",\"active\":" + (m_active.load() ? "true" : "false") +
+                      ",\"connects\":" + to_string(m_connects.load()) +
+                      ",\"received\":" + to_string(m_receivedTotal.load()) +
+                      ",\"pending\":" + to_string(pending) +
+                      ",\"lost\":" + to_string(m_lost.load()) +
+                      ",\"gi\":{\"requested\":" + to_string(m_interrogations.load()) +
+                      ",\"terminated\":" + to_string(m_interrogationTerms.load()) +
+                      ",\"points\":" + to_string(m_interrogated.load()) + "}" +
+                      ",\"commands\":{\"sent\":" + to_string(m_commands.load()) +
+                      ",\"confirmed\":" + to_string(m_commandCons.load()) +
+                      ",\"negative\":" + to_string(m_commandNegatives.load()) +
+                      ",\"terminated\":" + to_string(m_commandTerms.load()) +
+                      ",\"rtt_ms\":" + percentilesJson(m_commandRtt) + "}" +
+                      ",\"latency_ms\":" + percentilesJson(m_latency) + "}";
+
+        m_latency.reset();
+        m_commandRtt.reset();
+
+        return json;
+    }
+
+private:
+    /// @brief Data objects generated before the activation are not expected, the ones missing at deactivation are lost
+    static void connectionHandler(void* parameter, CS104_Connection connection, CS104_ConnectionEvent event)
+    {
+        (void)connection;
+        SoakMaster* self = static_cast<SoakMaster*>(parameter);
+
+        if (event == CS104_CONNECTION_OPENED) {
+            self->m_connected.store(true);
+        }
+        else if (event == CS104_CONNECTION_STARTDT_CON_RECEIVED) {
+            self->m_received.store(0);
+            self->m_generatedBase.store(self->m_generated.load());
+            self->m_active.store(true);
+        }
+        else if ((event == CS104_CONNECTION_CLOSED) || (event == CS104_CONNECTION_FAILED)) {
+            if (self->m_active.exchange(false)) {
+                uint64_t expected = self->m_generated.load() - self->m_generatedBase.load();
+                uint64_t received = self->m_received.load();
+
+                if (expected > received) {
+                    self->m_lost += expected - received;
+                }
+            }
+
+            self->m_connected.store(false);
+        }
+    }
+
+    static bool asduHandler(void* parameter, int address, CS101_ASDU asdu)
+    {
+        (void)address;
+        SoakMaster* self = static_cast<SoakMaster*>(parameter);
+
+        IEC60870_5_TypeID typeId = CS101_ASDU_getTypeID(asdu);
+        CS101_CauseOfTransmission cot = CS101_ASDU_getCOT(asdu);
+        int elements = CS101_ASDU_getNumberOfElements(asdu);
+
+        if (cot == CS101_COT_SPONTANEOUS) {
+            self->m_received += elements;
+            self->m_receivedTotal += elements;
+
+            uint64_t now = Hal_getTimeInMs();
+
+            for (int i = 0; i < elements; i++) {
+                InformationObject io = CS101_ASDU_getElement(asdu, i);
+
+                if (io) {
+                    uint64_t timestamp = informationObjectTimestamp(typeId, io);
+
+                    if (timestamp != 0) {
+                        self->m_latency.record((now > timestamp) ? (now - timestamp) * 1000000 : 0);
+                    }
+
+                    InformationObject_destroy(io);
+                }
+            }
+        }
+        else if ((cot >= CS101_COT_INTERROGATED_BY_STATION) && (cot <= CS101_COT_INTERROGATED_BY_GROUP_16)) {
+            self->m_interrogated += elements;
+        }
+        else if ((typeId == C_IC_NA_1) && (cot == CS101_COT_ACTIVATION_TERMINATION)) {
+            self->m_interrogationTerms++;
+        }
+        else if (typeId == C_SC_NA_1) {
+            if (cot == CS101_COT_ACTIVATION_CON) {
+                if (CS101_ASDU_isNegative(asdu)) {
+                    self->m_commandNegatives++;
+                }
+                else {
+                    self->m_commandCons++;
+                    self->m_commandRtt.record(Hal_getTimeInNs() - self->m_commandSent.load());
+                }
+            }
+            else if (cot == CS101_COT_ACTIVATION_TERMINATION) {
+                self->m_commandTerms++;
+            }
+        }
+
+        return true;
+    }
+
+    CS104_Connection m_connection;
+    string m_localIp;
+    const atomic<uint64_t>& m_generated;
+
+    atomic<bool> m_connected{false};
+    atomic<bool> m_active{false};
+    uint64_t m_nextConnect = 0;
+
+    atomic<uint64_t> m_connects{0};
+    atomic<uint64_t> m_generatedBase{0};
+    atomic<uint64_t> m_received{0};
+    atomic<uint64_t> m_receivedTotal{0};
+    atomic<uint64_t> m_lost{0};
+
+    atomic<uint64_t> m_interrogations{0};
+    atomic<uint64_t> m_interrogationTerms{0};
+    atomic<uint64_t> m_interrogated{0};
+
+    atomic<uint64_t> m_commandSent{0};
+    atomic<uint64_t> m_commands{0};
+    atomic<uint64_t> m_commandCons{0};
+    atomic<uint64_t> m_commandNegatives{0};
+    atomic<uint64_t> m_commandTerms{0};
+
+    IEC104LatencyHistogram m_latency;
+    IEC104LatencyHistogram m_commandRtt;
+};
+
+/// @brief Commands forwarded by the plugin, confirmed by the sender thread as a south plugin would
+struct ForwardedCommand
+{
+    string typeId;
+    int ca;
+    int ioa;
+};
+
+static mutex s_commandsLock;
+static vector<ForwardedCommand> s_commands;
+static atomic<uint64_t> s_forwarded{0};
+
+static int
+operationCallback(char* operation, int paramCount, char* names[], char* parameters[], ControlDestination destination, ...)
+{
+    (void)destination;
+
+    if (strcmp(operation, "IEC104Command") != 0) {
+        return 1;
+    }
+
+    ForwardedCommand command = {"", 0, 0};
+
+    for (int i = 0; i < paramCount; i++) {
+        if (strcmp(names[i], "co_type") == 0) {
+            command.typeId = parameters[i];
+        }
+        else if (strcmp(names[i], "co_ca") == 0) {
+            command.ca = atoi(parameters[i]);
+        }
+        else if (strcmp(names[i], "co_ioa") == 0) {
+            command.ioa = atoi(parameters[i]);
+        }
+    }
+
+    s_forwarded++;
+
+    lock_guard<mutex> lock(s_commandsLock);
+    s_commands.push_back(command);
+
+    return 1;
+}
+
+static bool
+writeCallback(const char* name, const char* value, ControlDestination destination, ...)
+{
+    (void)name;
+    (void)value;
+    (void)destination;
+
+    return true;
+}
+
+static Reading*
+createSouthEvent()
+{
+    vector<Datapoint*>* attributes = new vector<Datapoint*>;
+
+    attributes->push_back(Iec104Bench::createDatapoint("connx_status", string("started")));
+    attributes->push_back(Iec104Bench::createDatapoint("gi_status", string("finished")));
+
+    DatapointValue dpv(attributes, true);
+
+    return new Reading(SOUTH_ASSET, new Datapoint("south_event", dpv));
+}
+
+/// @brief Resident and peak resident memory from /proc/self/status in kB
+static void
+readMemory(uint64_t& rss, uint64_t& peakRss)
+{
+    rss = 0;
+    peakRss = 0;
+
+    ifstream status("/proc/self/status");
+    string line;
+
+    while (getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) {
+            rss = strtoull(line.c_str() + 6, nullptr, 10);
+        }
+        else if (line.compare(0, 6, "VmHWM:") == 0) {
+            peakRss = strtoull(line.c_str() + 6, nullptr, 10);
+        }
+    }
+}
+
+int
+main(int argc, char** argv)
+{
+    Options options;
+
+    if (!parseOptions(argc, argv, options)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    void* library = dlopen(options.plugin.c_str(), RTLD_NOW | RTLD_LOCAL);
+
+    if (library == nullptr) {
+        fprintf(stderr, "Cannot load %s: %s\n", options.plugin.c_str(), dlerror());
+        return 1;
+    }
+
+    PluginInfoFunc pluginInfo = (PluginInfoFunc)dlsym(library, "plugin_info");
+    PluginInitFunc pluginInit = (PluginInitFunc)dlsym(library, "plugin_init");
+    PluginStartFunc pluginStart = (PluginStartFunc)dlsym(library, "plugin_start");
+    PluginRegisterFunc pluginRegister = (PluginRegisterFunc)dlsym(library, "plugin_register");
+    PluginSendFunc pluginSend = (PluginSendFunc)dlsym(library, "plugin_send");
+    PluginShutdownFunc pluginShutdown = (PluginShutdownFunc)dlsym(library, "plugin_shutdown");
+
+    if (!pluginInfo || !pluginInit || !pluginStart || !pluginRegister || !pluginSend || !pluginShutdown) {
+        fprintf(stderr, "%s does not export the north plugin API\n", options.plugin.c_str());
+        return 1;
+    }
+
+    // Same log level as a production service
+    Logger::getLogger()->setMinLevel("warning");
+
+    /* configuration: default category of the plugin with generated protocol stack and data points */
+    vector<string> clientIps;
+    vector<Iec104Bench::PointDefinition> points;
+
+    for (int i = 0; i < options.masters; i++) {
+        clientIps.push_back("127.0.1." + to_string(i + 1));
+    }
+
+    for (int i = 0; i < options.points; i++) {
+        int ca = (i % options.cas) + 1;
+        int ioa = (i / options.cas) + 1;
+
+        points.push_back({ca, ioa, options.types[i % options.types.size()], "station"});
+    }
+
+    for (int i = 0; i < COMMAND_POINTS; i++) {
+        points.push_back({1, COMMAND_IOA_BASE + i, "C_SC_NA_1", ""});
+    }
+
+    ConfigCategory config("loadgen", pluginInfo()->config);
+    config.setItemsValueFromDefault();
+    config.setValue("protocol_stack", Iec104Bench::protocolStack(options.queueSize, clientIps, SOUTH_ASSET));
+    config.setValue("exchanged_data", Iec104Bench::exchangedData(points));
+    config.setValue("tls_conf", Iec104Bench::tlsConfig());
+
+    PLUGIN_HANDLE handle = pluginInit(&config);
+
+    if (handle == nullptr) {
+        fprintf(stderr, "plugin_init failed\n");
+        return 1;
+    }
+
+    pluginRegister(handle, writeCallback, operationCallback);
+    pluginStart(handle, "");
+
+    signal(SIGINT, signalHandler);
+    signal(SIGTERM, signalHandler);
+
+    /* the south plugin is reported connected so that the commands are accepted */
+    {
+        vector<Reading*> readings = {createSouthEvent()};
+        pluginSend(handle, readings);
+        delete readings[0];
+    }
+
+    atomic<uint64_t> generated{0};
+    atomic<uint64_t> sent{0};
+    atomic<uint64_t> rejected{0};
+    atomic<uint64_t> confirmed{0};
+
+    vector<SoakMaster*> masters;
+
+    for (const string& ip : clientIps) {
+        masters.push_back(new SoakMaster(ip, generated));
+    }
+
+    /* sender: paced data_objects, plus the ACT-CON/ACT-TERM of the forwarded commands */
+    thread sender([&]() {
+        uint64_t start = Hal_getTimeInNs();
+        uint64_t seq = 0;
+        vector<Reading*> readings;
+        vector<ForwardedCommand> commands;
+
+        readings.reserve(options.batch);
+
+        while (!s_stop.load()) {
+            {
+                lock_guard<mutex> lock(s_commandsLock);
+                commands.swap(s_commands);
+            }
+
+            for (const ForwardedCommand& command : commands) {
+                readings.push_back(new Reading(SOUTH_ASSET, Iec104Bench::createDataObject(command.typeId, command.ca,
+                                                                                          command.ioa, CS101_COT_ACTIVATION_CON, 0, 0)));
+                readings.push_back(new Reading(SOUTH_ASSET, Iec104Bench::createDataObject(command.typeId, command.ca,
+                                                                                          command.ioa, CS101_COT_ACTIVATION_TERMINATION, 0, 0)));
+            }
+
+            confirmed += commands.size();
+            commands.clear();
+
+            uint64_t due = (Hal_getTimeInNs() - start) * static_cast<uint64_t>(options.rate) / 1000000000ULL;
+            uint64_t timestamp = Hal_getTimeInMs();
+
+            while ((seq < due) && (readings.size() < static_cast<size_t>(options.batch))) {
+                const Iec104Bench::PointDefinition& point = points[seq % options.points];
+
+                readings.push_back(new Reading(SOUTH_ASSET, Iec104Bench::createDataObject(point.typeId, point.ca, point.ioa,
+                                                                                          CS101_COT_SPONTANEOUS, seq, timestamp)));
+                seq++;
+            }
+
+            if (readings.empty()) {
+                Thread_sleep(1);
+                continue;
+            }
+
+            uint64_t accepted = pluginSend(handle, readings);
+
+            generated.store(seq);
+            sent += readings.size();
+            rejected += (readings.size() > accepted) ? readings.size() - accepted : 0;
+
+            for (Reading* reading : readings) {
+                delete reading;
+            }
+
+            readings.clear();
+        }
+    });
+
+    /* masters: reconnection, periodic interrogations and commands */
+    thread driver([&]() {
+        uint64_t nextInterrogation = Hal_getTimeInMs() + static_cast<uint64_t>(options.giPeriod) * 1000;
+        uint64_t nextCommand = Hal_getTimeInMs() + options.commandPeriod;
+        int commandIndex = 0;
+
+        while (!s_stop.load()) {
+            uint64_t now = Hal_getTimeInMs();
+
+            for (SoakMaster* master : masters) {
+                master->connect(now);
+            }
+
+            if ((options.giPeriod > 0) && (now >= nextInterrogation)) {
+                nextInterrogation = now + static_cast<uint64_t>(options.giPeriod) * 1000;
+
+                for (SoakMaster* master : masters) {
+                    master->interrogate();
+                }
+            }
+
+            if ((options.commandPeriod > 0) && (now >= nextCommand)) {
+                nextCommand = now + options.commandPeriod;
+
+                for (SoakMaster* master : masters) {
+                    master->sendCommand(1, COMMAND_IOA_BASE + (commandIndex % COMMAND_POINTS), (commandIndex & 1) != 0);
+                    commandIndex++;
+                }
+            }
+
+            Thread_sleep(10);
+        }
+    });
+
+    /* reports */
+    uint64_t start = Hal_getTimeInMs();
+    uint64_t lastReport = start;
+    uint64_t lastGenerated = 0;
+
+    auto report = [&](bool final) {
+        uint64_t now = Hal_getTimeInMs();
+        uint64_t generatedNow = generated.load();
+        double interval = static_cast<double>(now - lastReport) / 1000.0;
+        uint64_t rss = 0;
+        uint64_t peakRss = 0;
+
+        readMemory(rss, peakRss);
+
+        string json = "{\"elapsed_s\":" + to_string((now - start) / 1000) + ",\"final\":" + (final ? "true" : "false") +
+                      ",\"rate\":{\"target\":" + to_string(options.rate) +
+                      ",\"achieved\":" + to_string(interval > 0 ? static_cast<uint64_t>((generatedNow - lastGenerated) / interval) : 0) + "}" +
+                      ",\"generated\":" + to_string(generatedNow) +
+                      ",\"readings_sent\":" + to_string(sent.load()) +
+                      ",\"readings_rejected\":" + to_string(rejected.load()) +
+                      ",\"commands_forwarded\":" + to_string(s_forwarded.load()) +
+                      ",\"commands_confirmed\":" + to_string(confirmed.load()) +
+                      ",\"rss_kb\":" + to_string(rss) +
+                      ",\"peak_rss_kb\":" + to_string(peakRss) +
+                      ",\"masters\":[";
+
+        for (size_t i = 0; i < masters.size(); i++) {
+            json += (i > 0 ? "," : "") + masters[i]->report();
+        }
+
+        json += "]}";
+
+        printf("%s\n", json.c_str());
+        fflush(stdout);
+
+        lastReport = now;
+        lastGenerated = generatedNow;
+    };
+
+    while (!s_stop.load()) {
+        Thread_sleep(100);
+
+        uint64_t now = Hal_getTimeInMs();
+
+        if ((options.duration > 0) && (now - start >= static_cast<uint64_t>(options.duration) * 1000)) {
+            s_stop.store(true);
+        }
+        else if (now - lastReport >= static_cast<uint64_t>(options.report) * 1000) {
+            report(false);
+        }
+    }
+
+    sender.join();
+    driver.join();
+
+    /* the data objects still pending after the queues are drained are the losses of the run */
+    Thread_sleep(DRAIN_TIME);
+    report(true);
+
+    for (SoakMaster* master : masters) {
+        delete master;
+    }
+
+    pluginShutdown(handle);
+
+    return 0;
+}